@@ -67,11 +67,12 @@ int main (void)
 	/* pthreads allocates its own memory for task stacks. This UCOS linux port needs a minimum stack size
 		in order to pass the function information within the port. */
 	hardware_init();
-	INT8U Stk1[ OSMinStkSize() ];
-	INT8U Stk2[ OSMinStkSize() ];
-	INT8U Stk3[ OSMinStkSize() ];
-	INT8U Stk4[ OSMinStkSize() ];
-	INT8U Stk5[ OSMinStkSize() ];
+	int nStkSize = OSMinStkSize() / sizeof( OS_STK );
+	OS_STK Stk1[ nStkSize ];
+	OS_STK Stk2[ nStkSize ];
+	OS_STK Stk3[ nStkSize ];
+	OS_STK Stk4[ nStkSize ];
+	OS_STK Stk5[ nStkSize ];
 
 	char sTask1[] = "Task 1";
 	char sTask2[] = "Task 2";
@@ -81,11 +82,11 @@ int main (void)
 
 	OSInit();
 
-	OSTaskCreate( MyTask, sTask1, (void*)Stk1, 4 );
-//	OSTaskCreate( MyTask, sTask2, (void*)Stk2, 5 );
-//	OSTaskCreate( MyTask, sTask3, (void*)Stk3, 6 );
-//	OSTaskCreate( MyTask, sTask4, (void*)Stk4, 7 );
-//	OSTaskCreate( MyTask, sTask5, (void*)Stk5, 8 );
+	OSTaskCreate( MyTask, sTask1, &Stk1[ nStkSize - 1 ], 4 );
+//	OSTaskCreate( MyTask, sTask2, &Stk2[ nStkSize - 1 ], 5 );
+//	OSTaskCreate( MyTask, sTask3, &Stk3[ nStkSize - 1 ], 6 );
+//	OSTaskCreate( MyTask, sTask4, &Stk4[ nStkSize - 1 ], 7 );
+//	OSTaskCreate( MyTask, sTask5, &Stk5[ nStkSize - 1 ], 8 );
 
     OSStart();
 
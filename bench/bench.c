@@ -0,0 +1,78 @@
+/*
+*********************************************************************************************************
+*                                               bench.c
+*
+* Description:	Time source and result reporting of the ucos linux port benchmarks, see bench.h.
+*
+*********************************************************************************************************
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include "bench.h"
+
+/* The kernel calls the arduino init() from OSInit(), the benchmarks do not use the arduino library */
+void init(void)
+{
+}
+
+/*
+*********************************************************************************************************
+*                                               BenchNs
+*
+* Description:	Returns CLOCK_MONOTONIC in nanoseconds.
+*********************************************************************************************************
+*/
+INT64U BenchNs(void)
+{
+	struct timespec ts;
+
+	clock_gettime( CLOCK_MONOTONIC, &ts );
+	return( (INT64U)ts.tv_sec * 1000000000ULL + (INT64U)ts.tv_nsec );
+}
+
+static int CompareINT32U( const void* pA, const void* pB )
+{
+	INT32U nA = *(const INT32U*)pA;
+	INT32U nB = *(const INT32U*)pB;
+
+	return( ( nA > nB ) - ( nA < nB ) );
+}
+
+/*
+*********************************************************************************************************
+*                                               BenchReport
+*
+* Description:	Sorts the latency samples and prints the result line. Runs in a critical section, with the
+*				single threaded port the C library must not be entered by two tasks at once.
+*
+* Arguments  :	pBench		name of the benchmark.
+*				pParams		extra JSON members describing the run, e.g. "\"method\":\"futex\"", or "".
+*				pSamples	latency samples in nanoseconds, sorted in place.
+*				nSamples	number of samples.
+*				nOps		number of operations done in nElapsedNs.
+*				nElapsedNs	duration of the measured loop.
+*********************************************************************************************************
+*/
+void BenchReport(const char* pBench, const char* pParams, INT32U* pSamples, INT32U nSamples,
+				 INT64U nOps, INT64U nElapsedNs)
+{
+#if OS_CRITICAL_METHOD == 3
+	OS_CPU_SR cpu_sr = 0;
+#endif
+
+	OS_ENTER_CRITICAL();
+
+	qsort( pSamples, nSamples, sizeof( pSamples[ 0 ] ), CompareINT32U );
+
+	printf( "{\"bench\":\"%s\",%s%s\"iterations\":%u,\"p50_ns\":%u,\"p99_ns\":%u,\"max_ns\":%u,\"ops_per_sec\":%.0f}\n",
+			pBench, pParams, ( pParams[ 0 ] != '\0' ) ? "," : "", nSamples,
+			pSamples[ nSamples / 2 ],
+			pSamples[ ( (INT64U)nSamples * 99 ) / 100 ],
+			pSamples[ nSamples - 1 ],
+			( (double)nOps * 1e9 ) / (double)nElapsedNs );
+	fflush( stdout );
+
+	OS_EXIT_CRITICAL();
+}
@@ -0,0 +1,25 @@
+/*
+*********************************************************************************************************
+*                                               bench.h
+*
+* Description:	Helpers shared by the benchmarks of the ucos linux port. Every benchmark result is printed as
+*				one JSON line on stdout so the results can be collected and compared between port changes:
+*
+*				{"bench":"sem_pingpong",<params>,"iterations":N,"p50_ns":..,"p99_ns":..,"max_ns":..,"ops_per_sec":..}
+*
+*********************************************************************************************************
+*/
+
+#ifndef BENCH_H
+#define BENCH_H
+
+#include "ucos_ii.h"
+
+/* Stack size of the benchmark tasks, large enough for the single threaded port, see OSMinStkSize() */
+#define BENCH_STK_SIZE		8192
+
+INT64U	BenchNs(void);
+void	BenchReport(const char* pBench, const char* pParams, INT32U* pSamples, INT32U nSamples,
+					INT64U nOps, INT64U nElapsedNs);
+
+#endif
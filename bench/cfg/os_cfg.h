@@ -0,0 +1,43 @@
+/*
+*********************************************************************************************************
+*                                               os_cfg.h
+*
+* Description:	Kernel configuration of the scheduler benchmark variants. The kernel, the port and the benchmark
+*				are compiled with this directory in front of the include path, so this file takes the place
+*				of ucos/os_cfg.h and replaces the settings the variant defines, see the SCHED_xxx, SET_CFLAGS,
+*				MUTEX_CFLAGS and INTQ_CFLAGS variables in the Makefile.
+*
+*********************************************************************************************************
+*/
+
+#include_next <os_cfg.h>
+
+#ifdef BENCH_SCHED_CTZ_EN
+#undef  OS_SCHED_CTZ_EN
+#define OS_SCHED_CTZ_EN		BENCH_SCHED_CTZ_EN
+#endif
+
+#ifdef BENCH_LOWEST_PRIO
+#undef  OS_LOWEST_PRIO
+#define OS_LOWEST_PRIO		BENCH_LOWEST_PRIO
+#endif
+
+#ifdef BENCH_SCHED_RR_EN
+#undef  OS_SCHED_RR_EN
+#define OS_SCHED_RR_EN		BENCH_SCHED_RR_EN
+#endif
+
+#ifdef BENCH_MAX_EVENTS
+#undef  OS_MAX_EVENTS
+#define OS_MAX_EVENTS		BENCH_MAX_EVENTS
+#endif
+
+#ifdef BENCH_MUTEX_PROTOCOL_EN
+#undef  OS_MUTEX_PROTOCOL_EN
+#define OS_MUTEX_PROTOCOL_EN	BENCH_MUTEX_PROTOCOL_EN
+#endif
+
+#ifdef BENCH_INT_Q_EN
+#undef  OS_INT_Q_EN
+#define OS_INT_Q_EN			BENCH_INT_Q_EN
+#endif
@@ -0,0 +1,82 @@
+/*
+*********************************************************************************************************
+*                                               ctxsw.c
+*
+* Description:	Context switch benchmark of the ucos linux port. A high priority task suspends itself and a
+*				low priority task resumes it again, so every iteration is two context switches. The time
+*				from OSTaskResume() in the low priority task to the high priority task running again is
+*				recorded as the switch latency. The port is built with every OS_CPU_CTX_SW_METHOD by the
+*				Makefile and each build prints one JSON line.
+*
+*********************************************************************************************************
+*/
+
+#include <stdlib.h>
+#include "bench.h"
+
+#define BENCH_ITERATIONS	20000
+#define BENCH_WARMUP		1000
+
+#define BENCH_PRIO_HIGH		10
+#define BENCH_PRIO_LOW		11
+
+#if OS_CPU_CTX_SW_METHOD == 3
+#define BENCH_METHOD		"single_thread"
+#elif OS_CPU_CTX_SW_METHOD == 2
+#define BENCH_METHOD		"futex"
+#else
+#define BENCH_METHOD		"condvar"
+#endif
+
+static OS_STK StkHigh[ BENCH_STK_SIZE ];
+static OS_STK StkLow[ BENCH_STK_SIZE ];
+
+static volatile INT64U	nResumeNs;
+static INT32U		grnLatencyNs[ BENCH_ITERATIONS ];
+
+static void TaskHigh( void* p_arg )
+{
+	INT64U	nStart = 0;
+	INT64U	nEnd;
+	int	i;
+
+	for( i = -BENCH_WARMUP; i < BENCH_ITERATIONS; i++ )
+	{
+		if( i == 0 )
+			nStart = BenchNs();
+
+		/* Switch to the low priority task, which resumes this task again */
+		OSTaskSuspend( OS_PRIO_SELF );
+
+		if( i >= 0 )
+			grnLatencyNs[ i ] = (INT32U)( BenchNs() - nResumeNs );
+	}
+	nEnd = BenchNs();
+
+	/* Every iteration is two switches */
+	BenchReport( "ctxsw", "\"method\":\"" BENCH_METHOD "\"", grnLatencyNs, BENCH_ITERATIONS,
+				 2 * BENCH_ITERATIONS, nEnd - nStart );
+
+	exit( 0 );
+}
+
+static void TaskLow( void* p_arg )
+{
+	while(1)
+	{
+		nResumeNs = BenchNs();
+		OSTaskResume( BENCH_PRIO_HIGH );
+	}
+}
+
+int main (void)
+{
+	OSInit();
+
+	OSTaskCreate( TaskHigh, NULL, &StkHigh[ BENCH_STK_SIZE - 1 ], BENCH_PRIO_HIGH );
+	OSTaskCreate( TaskLow, NULL, &StkLow[ BENCH_STK_SIZE - 1 ], BENCH_PRIO_LOW );
+
+	OSStart();
+
+	return 0;
+}
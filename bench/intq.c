@@ -0,0 +1,133 @@
+/*
+*********************************************************************************************************
+*                                                intq.c
+*
+* Description:	Benchmark of the ISR deferred posts (OS_INT_Q_EN). The Makefile builds the kernel and this file
+*				with cfg/os_cfg.h and the single threaded port, like the scheduler benchmark, with OS_INT_Q_EN.
+*				The ISR is run by the task it interrupts, between OS_ENTER_CRITICAL() and OS_EXIT_CRITICAL(),
+*				exactly as the port runs the tick ISR. It sets the flags BENCH_INTQ_WAITERS tasks wait on,
+*				with OSFlagPost() ("mode":"direct") or with OSIntQFlagPost() ("mode":"deferred").
+*
+*				isr_post		Time the ISR spends in the post, with interrupts disabled. The operations per
+*								second only count the time spent in the posts.
+*				isr_wake		Time from the start of the ISR until every waiting task ran.
+*
+*********************************************************************************************************
+*/
+
+#include <stdlib.h>
+#include <stdio.h>
+#include "bench.h"
+
+#define BENCH_ITERATIONS	20000
+#define BENCH_WARMUP		1000
+
+#define BENCH_INTQ_WAITERS	16
+#define BENCH_INTQ_SIZE		8
+
+#define BENCH_PRIO_RUNNER	10
+#define BENCH_PRIO_WAITER	20
+
+static OS_STK StkRunner[ BENCH_STK_SIZE ];
+static OS_STK StkWaiter[ BENCH_INTQ_WAITERS ][ BENCH_STK_SIZE ];
+
+static INT32U		grnPostNs[ BENCH_ITERATIONS ];
+static INT32U		grnWakeNs[ BENCH_ITERATIONS ];
+static char		szParams[ 64 ];
+
+static OS_FLAG_GRP*	pFlags;
+static OS_EVENT*	pSemAck;
+static OS_INT_Q*	pIntQ;
+static OS_INT_Q_ENTRY	grIntQEntries[ BENCH_INTQ_SIZE ];
+
+/* The lowest priority waiter runs last and acknowledges the ISR */
+static void TaskWaiter( void* p_arg )
+{
+	int	nIdx = (int)(long)p_arg;
+	INT8U	err;
+
+	while(1)
+	{
+		OSFlagPend( pFlags, (OS_FLAGS)1 << nIdx, OS_FLAG_WAIT_SET_ANY + OS_FLAG_CONSUME, 0, &err );
+		if( nIdx == BENCH_INTQ_WAITERS - 1 )
+			OSSemPost( pSemAck );
+	}
+}
+
+static void PostDirect( void )
+{
+	INT8U	err;
+
+	OSFlagPost( pFlags, (OS_FLAGS)( ( 1UL << BENCH_INTQ_WAITERS ) - 1 ), OS_FLAG_SET, &err );
+}
+
+static void PostDeferred( void )
+{
+	OSIntQFlagPost( pIntQ, pFlags, (OS_FLAGS)( ( 1UL << BENCH_INTQ_WAITERS ) - 1 ), OS_FLAG_SET );
+}
+
+static void BenchIsr( const char* pMode, void (*pPost)( void ) )
+{
+	INT64U	nStart = 0;
+	INT64U	nPostNs = 0;
+	INT64U	nT0;
+	INT64U	nT1;
+	INT8U	err;
+	int	i;
+#if OS_CRITICAL_METHOD == 3
+	OS_CPU_SR	cpu_sr = 0;
+#endif
+
+	for( i = -BENCH_WARMUP; i < BENCH_ITERATIONS; i++ )
+	{
+		if( i == 0 )
+			nStart = BenchNs();
+		OS_ENTER_CRITICAL();
+		OSIntEnter();
+		nT0 = BenchNs();
+		pPost();
+		nT1 = BenchNs();
+		OSIntExit();
+		OS_EXIT_CRITICAL();
+		OSSemPend( pSemAck, 0, &err );
+		if( i >= 0 )
+		{
+			grnPostNs[ i ] = (INT32U)( nT1 - nT0 );
+			grnWakeNs[ i ] = (INT32U)( BenchNs() - nT0 );
+			nPostNs       += nT1 - nT0;
+		}
+	}
+	nT0 = BenchNs() - nStart;
+	snprintf( szParams, sizeof( szParams ), "\"mode\":\"%s\",\"waiters\":%d", pMode, BENCH_INTQ_WAITERS );
+	BenchReport( "isr_post", szParams, grnPostNs, BENCH_ITERATIONS, BENCH_ITERATIONS, nPostNs );
+	BenchReport( "isr_wake", szParams, grnWakeNs, BENCH_ITERATIONS, BENCH_ITERATIONS, nT0 );
+}
+
+static void TaskRunner( void* p_arg )
+{
+	INT8U	err;
+	int	i;
+
+	pFlags  = OSFlagCreate( 0, &err );
+	pSemAck = OSSemCreate( 0 );
+	pIntQ   = OSIntQCreate( grIntQEntries, BENCH_INTQ_SIZE, &err );
+	for( i = 0; i < BENCH_INTQ_WAITERS; i++ )
+		OSTaskCreate( TaskWaiter, (void*)(long)i, &StkWaiter[ i ][ BENCH_STK_SIZE - 1 ], BENCH_PRIO_WAITER + i );
+	OSTimeDly( 1 );
+
+	BenchIsr( "direct", PostDirect );
+	BenchIsr( "deferred", PostDeferred );
+
+	exit( 0 );
+}
+
+int main (void)
+{
+	OSInit();
+
+	OSTaskCreate( TaskRunner, NULL, &StkRunner[ BENCH_STK_SIZE - 1 ], BENCH_PRIO_RUNNER );
+
+	OSStart();
+
+	return 0;
+}
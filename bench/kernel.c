@@ -0,0 +1,1329 @@
+/*
+*********************************************************************************************************
+*                                               kernel.c
+*
+* Description:	Benchmark suite of the kernel services, linked with build/ucos.o as an application would be.
+*				A runner task measures one service after the other and prints one JSON line per benchmark:
+*
+*				sem_pingpong	OSSemPost() to an echo task and OSSemPend() for its answer, two switches.
+*				mbox_roundtrip	The same with OSMboxPost()/OSMboxPend().
+*				q_roundtrip		The same with OSQPost()/OSQPend().
+*				q_batch			BENCH_Q_BATCH messages to the echo task, which takes them with OSQPendN(), sent
+*								with as many OSQPost() ("mode":"single") or one OSQPostN() ("mode":"batch").
+*								The samples are per message.
+*				q_urgent		Time from posting a command to a queue that holds BENCH_Q_BULK - 1 bulk
+*								messages until OSQPend() returns it. "mode":"fifo" posts it behind them with
+*								OSQPost(), "mode":"prio" with OSQPostPrio() at priority 0 to a queue of
+*								OSQCreatePrio() where the bulk messages have the lowest priority.
+*				topic_fanout	One message to BENCH_TOPIC_SUBS queues, with one OSQPost() per queue
+*								("mode":"loop") or one OSTopicPublish() to a topic they subscribed to
+*								("mode":"topic").
+*				frame_pipe		BENCH_Q_BATCH frames of BENCH_FRAME_MIN .. BENCH_FRAME_MAX bytes to the echo
+*								task, which sums their bytes. "mode":"mem_q" builds a frame in a buffer of
+*								the producer, copies it to an OSMemGet() block sent with OSQPost() and the echo
+*								task puts the block back. "mode":"ring" builds it in place in an OSRingReserve()
+*								space and the echo task reads it in place from OSRingPend(). The samples are
+*								per frame.
+*				flag_fanout		OSFlagPost() readying BENCH_FLAG_WAITERS higher priority tasks, until all ran.
+*				mem_getput		OSMemGet() followed by OSMemPut(), averaged over a batch of BENCH_MEM_BATCH.
+*				dly_jitter		Deviation of the time between two OSTimeDly(1) wakeups from the tick period.
+*				tick_cost		One OSTimeTick() with 0 .. BENCH_SLEEPERS tasks waiting on a delay.
+*				pend_timeout	Lateness of a BENCH_TIMEOUT_NS pend timeout, for the smallest timeout in ticks
+*								that covers it ("mode":"ticks") and for OSSemPendNs() ("mode":"ns").
+*				chan			OSChanPost() from a thread that is not a task to the runner in OSChanPend().
+*								"mode":"wake" posts every BENCH_CHAN_GAP_US, so the runner always waits, and
+*								samples the time from the post until the runner runs. "mode":"stream" posts as
+*								fast as the channel takes the messages and samples every OSChanPend().
+*
+*				Before the benchmarks of a service the runner checks its behaviour with CHECK(). A failed check
+*				prints its line and exits with 1, which stops "make bench".
+*
+*				The context switch itself is measured by ctxsw.c for every switch method of the port.
+*
+*********************************************************************************************************
+*/
+
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <pthread.h>
+#include <sched.h>
+#include <unistd.h>
+#include "bench.h"
+
+#define BENCH_ITERATIONS	20000
+#define BENCH_WARMUP		1000
+
+#define BENCH_FLAG_WAITERS	4
+#define BENCH_MEM_BATCH		64
+#define BENCH_Q_BATCH		16
+#define BENCH_Q_BULK		64
+#define BENCH_TOPIC_SUBS	3
+#define BENCH_FRAME_MIN		16
+#define BENCH_FRAME_MAX		256
+#define BENCH_RING_SIZE		4096
+#define BENCH_DLY_ITERATIONS	200
+#define BENCH_TICK_ITERATIONS	2000
+#define BENCH_TIMEOUT_NS		200000
+#define BENCH_CHAN_SIZE		64
+#define BENCH_CHAN_GAP_US	50
+#define BENCH_CHAN_CHECK_US	20000
+#define BENCH_CHK_RING_SIZE	128
+#define BENCH_CHK_SLAB_SEMS	(4 * OS_MAX_EVENTS)
+#define BENCH_CHK_SLAB_QS	(2 * OS_MAX_QS)
+
+/* Tasks: the runner, its echo task, the flag waiters and the sleepers. The sleepers use up the rest of
+   OS_MAX_TASKS, tick_cost is measured at BENCH_TICK_STEPS + 1 evenly spaced numbers of them. */
+#define BENCH_SLEEPERS		( OS_MAX_TASKS - 2 - BENCH_FLAG_WAITERS )
+#define BENCH_TICK_STEPS	4
+
+#define BENCH_PRIO_SLEEPER	8	/* BENCH_SLEEPERS priorities from here on */
+#define BENCH_PRIO_ECHO		( BENCH_PRIO_SLEEPER + BENCH_SLEEPERS )
+#define BENCH_PRIO_WAITER	( BENCH_PRIO_ECHO + 1 )
+#define BENCH_PRIO_RUNNER	( BENCH_PRIO_WAITER + BENCH_FLAG_WAITERS )
+
+/* Delay of the sleepers, longer than the whole tick_cost benchmark */
+#define BENCH_SLEEP_TICKS	60000
+
+/* Service the echo task answers, see TaskEcho() */
+#define ECHO_SEM		0
+#define ECHO_MBOX		1
+#define ECHO_Q			2
+#define ECHO_Q_N		3
+#define ECHO_FRAME_MEM	4
+#define ECHO_FRAME_RING	5
+
+static OS_STK StkRunner[ BENCH_STK_SIZE ];
+static OS_STK StkEcho[ BENCH_STK_SIZE ];
+static OS_STK StkWaiter[ BENCH_FLAG_WAITERS ][ BENCH_STK_SIZE ];
+static OS_STK StkSleeper[ BENCH_SLEEPERS ][ BENCH_STK_SIZE ];
+
+static INT32U		grnLatencyNs[ BENCH_ITERATIONS ];
+
+static volatile INT8U	nEchoMode;
+static OS_EVENT*	pSemReq;
+static OS_EVENT*	pSemRep;
+static OS_EVENT*	pMboxReq;
+static OS_EVENT*	pMboxRep;
+static OS_EVENT*	pQReq;
+static OS_EVENT*	pQRep;
+static OS_EVENT*	pSemNever;
+static void*		grpQReq[ BENCH_Q_BATCH ];
+static void*		grpQRep[ 4 ];
+
+static OS_FLAG_GRP*	pFlagGrp;
+
+static OS_MEM*		pMem;
+static INT32U		grnMemBlk[ 16 ][ 16 ];
+
+static INT32U		nMsg = 1;
+static void*		grpQBatch[ BENCH_Q_BATCH ];
+
+#if OS_Q_PRIO_EN > 0
+static INT32U		nCmd = 2;
+static OS_EVENT*	pQBulkFifo;
+static OS_EVENT*	pQBulkPrio;
+static void*		grpQBulkFifo[ BENCH_Q_BULK ];
+static OS_Q_MSG		grQBulkPrio[ BENCH_Q_BULK ];
+#endif
+
+#if (OS_TOPIC_EN > 0) && (OS_MAX_TOPICS > 0) && (OS_TOPIC_SUBS >= BENCH_TOPIC_SUBS)
+static OS_TOPIC*	pTopic;
+static OS_EVENT*	grpQSub[ BENCH_TOPIC_SUBS ];
+static void*		grpQSubMsg[ BENCH_TOPIC_SUBS ][ 1 ];
+#endif
+
+#if (OS_RING_EN > 0) && (OS_MAX_RINGS > 0)
+/* A frame block of the mem_q mode holds the length of the frame and the frame */
+static OS_MEM*		pFrameMem;
+static INT32U		grnFrameBlk[ BENCH_Q_BATCH ][ 1 + BENCH_FRAME_MAX / 4 ];
+static INT8U		grbFrame[ BENCH_FRAME_MAX ];
+static OS_EVENT*	pRing;
+static INT8U		grbRing[ BENCH_RING_SIZE ];
+static volatile INT32U	nFrameSum;
+#endif
+
+#if (OS_CHAN_EN > 0) && (OS_MAX_CHANS > 0)
+/* Mode of the producer thread of the chan benchmark, see ThreadChan() */
+#define CHAN_IDLE		0
+#define CHAN_WAKE		1
+#define CHAN_STREAM		2
+#define CHAN_CHECK		3
+
+static OS_CHAN*		pChan;
+static void*		grpChan[ BENCH_CHAN_SIZE ];
+static INT64U		grnChanTs[ BENCH_WARMUP + BENCH_ITERATIONS ];
+static volatile INT32U	nChanMode;
+static pthread_t	threadChan;
+#endif
+
+#if (OS_RING_EN > 0) && (OS_MAX_RINGS > 0)
+/* Frame j of a batch, as a driver would receive it */
+static INT32U FrameLen( int j )
+{
+	return BENCH_FRAME_MIN + ( j * 61 ) % ( BENCH_FRAME_MAX - BENCH_FRAME_MIN + 1 );
+}
+
+static void FrameFill( INT8U* pFrame, INT32U nLen )
+{
+	INT32U	k;
+
+	for( k = 0; k < nLen; k++ )
+		pFrame[ k ] = (INT8U)( nLen + k );
+}
+
+static INT32U FrameSum( const INT8U* pFrame, INT32U nLen )
+{
+	INT32U	nSum = 0;
+	INT32U	k;
+
+	for( k = 0; k < nLen; k++ )
+		nSum += pFrame[ k ];
+	return nSum;
+}
+#endif
+
+/*
+*********************************************************************************************************
+*                                               TaskEcho
+*
+* Description:	Answers every request of the runner on the service selected by nEchoMode. The echo task has a
+*				higher priority than the runner, so it always waits on the old service when the runner changes
+*				the mode. The runner then sends one more request on the old service and the echo task picks up
+*				the new mode.
+*********************************************************************************************************
+*/
+static void TaskEcho( void* p_arg )
+{
+	INT8U	err;
+	void*	pMsg;
+#if OS_Q_PEND_N_EN > 0
+	void*	grpMsgs[ BENCH_Q_BATCH ];
+	int	nRecv = 0;
+#endif
+#if (OS_RING_EN > 0) && (OS_MAX_RINGS > 0)
+	INT32U*	pBlk;
+	INT8U*	pFrame;
+	INT32U	nLen;
+	int	j;
+#endif
+
+	while(1)
+	{
+		switch( nEchoMode )
+		{
+		case ECHO_SEM:
+			OSSemPend( pSemReq, 0, &err );
+			OSSemPost( pSemRep );
+			break;
+
+		case ECHO_MBOX:
+			pMsg = OSMboxPend( pMboxReq, 0, &err );
+			OSMboxPost( pMboxRep, pMsg );
+			break;
+
+		default:
+			pMsg = OSQPend( pQReq, 0, &err );
+			OSQPost( pQRep, pMsg );
+			break;
+
+#if OS_Q_PEND_N_EN > 0
+		case ECHO_Q_N:
+			nRecv += OSQPendN( pQReq, grpMsgs, BENCH_Q_BATCH, 0, &err );
+			if( nRecv >= BENCH_Q_BATCH )
+			{
+				nRecv = 0;
+				OSQPost( pQRep, &nMsg );
+			}
+			break;
+#endif
+
+#if (OS_RING_EN > 0) && (OS_MAX_RINGS > 0)
+		/* The frame modes take a whole batch, the mode only changes between batches */
+		case ECHO_FRAME_MEM:
+			for( j = 0; j < BENCH_Q_BATCH; j++ )
+			{
+				pBlk = (INT32U*)OSQPend( pQReq, 0, &err );
+				nFrameSum += FrameSum( (INT8U*)( pBlk + 1 ), pBlk[ 0 ] );
+				OSMemPut( pFrameMem, pBlk );
+			}
+			OSQPost( pQRep, &nMsg );
+			break;
+
+		case ECHO_FRAME_RING:
+			for( j = 0; j < BENCH_Q_BATCH; j++ )
+			{
+				pFrame = (INT8U*)OSRingPend( pRing, &nLen, 0, &err );
+				nFrameSum += FrameSum( pFrame, nLen );
+				OSRingRelease( pRing, pFrame );
+			}
+			OSQPost( pQRep, &nMsg );
+			break;
+#endif
+		}
+	}
+}
+
+/*
+*********************************************************************************************************
+*                                               TaskWaiter
+*
+* Description:	Flag fan-out target, waits for its own bit of the flag group over and over.
+*********************************************************************************************************
+*/
+static void TaskWaiter( void* p_arg )
+{
+	OS_FLAGS	flags = (OS_FLAGS)1 << (int)(long)p_arg;
+	INT8U		err;
+
+	while(1)
+		OSFlagPend( pFlagGrp, flags, OS_FLAG_WAIT_SET_ALL + OS_FLAG_CONSUME, 0, &err );
+}
+
+/*
+*********************************************************************************************************
+*                                               TaskSleeper
+*
+* Description:	Load for the tick: waits on a long delay when resumed by the runner, suspends itself again
+*				when the runner ends the delay with OSTimeDlyResume().
+*********************************************************************************************************
+*/
+static void TaskSleeper( void* p_arg )
+{
+	while(1)
+	{
+		OSTaskSuspend( OS_PRIO_SELF );
+		OSTimeDly( BENCH_SLEEP_TICKS );
+	}
+}
+
+/*
+*********************************************************************************************************
+*                                               Check
+*
+* Description:	Ends the run with an error if a behaviour check of a service failed.
+*
+* Arguments  :	pCheck		name of the check.
+*				bOk			result of the check.
+*				nLine		line of the check, see CHECK().
+*********************************************************************************************************
+*/
+#define CHECK( pCheck, bOk )	Check( pCheck, bOk, __LINE__ )
+
+static void Check( const char* pCheck, BOOLEAN bOk, int nLine )
+{
+	if( !bOk )
+	{
+		printf( "%s: check at line %d failed\n", pCheck, nLine );
+		exit( 1 );
+	}
+}
+
+#if OS_SLAB_EN > 0
+/*
+*********************************************************************************************************
+*                                               CheckSlab
+*
+* Description:	Checks the slab pages behind the object tables: BENCH_CHK_SLAB_SEMS semaphores and
+*				BENCH_CHK_SLAB_QS queues are more than OS_MAX_EVENTS and OS_MAX_QS allow. Deleted, their
+*				blocks go back to the free lists, created again they are the same blocks and take no page.
+*********************************************************************************************************
+*/
+static BOOLEAN CheckSlabFound( OS_EVENT** ppEvent, int nEvents, OS_EVENT* pEvent )
+{
+	int	i;
+
+	for( i = 0; i < nEvents; i++ )
+		if( ppEvent[ i ] == pEvent )
+			return( OS_TRUE );
+	return( OS_FALSE );
+}
+
+static void CheckSlab( void )
+{
+	static OS_EVENT*	grpSem[ 2 ][ BENCH_CHK_SLAB_SEMS ];
+	static OS_EVENT*	grpQ[ BENCH_CHK_SLAB_QS ];
+	static void*		grpQMsg[ BENCH_CHK_SLAB_QS ][ 1 ];
+	OS_EVENT*	pEvent;
+	INT32U		nPages;
+	INT8U		err;
+	int		nPass;
+	int		i;
+
+	for( nPass = 0; nPass < 2; nPass++ )
+	{
+		nPages = OSSlabPageCtr;
+		for( i = 0; i < BENCH_CHK_SLAB_SEMS; i++ )
+		{
+			pEvent = OSSemCreate( 0 );
+			CHECK( "slab", pEvent != NULL && !CheckSlabFound( grpSem[ nPass ], i, pEvent ) );
+			CHECK( "slab", nPass == 0 || CheckSlabFound( grpSem[ 0 ], BENCH_CHK_SLAB_SEMS, pEvent ) );
+			grpSem[ nPass ][ i ] = pEvent;
+		}
+		for( i = 0; i < BENCH_CHK_SLAB_QS; i++ )
+		{
+			grpQ[ i ] = OSQCreate( grpQMsg[ i ], 1 );
+			CHECK( "slab", grpQ[ i ] != NULL && OSQPost( grpQ[ i ], &nMsg ) == OS_ERR_NONE );
+		}
+		CHECK( "slab", nPass == 0 ? OSSlabPageCtr > nPages : OSSlabPageCtr == nPages );
+
+		/* The semaphores are freed last, the free list hands their blocks out first */
+		for( i = 0; i < BENCH_CHK_SLAB_QS; i++ )
+		{
+			CHECK( "slab", OSQAccept( grpQ[ i ], &err ) == &nMsg );
+			OSQDel( grpQ[ i ], OS_DEL_ALWAYS, &err );
+			CHECK( "slab", err == OS_ERR_NONE );
+		}
+		for( i = 0; i < BENCH_CHK_SLAB_SEMS; i++ )
+		{
+			OSSemDel( grpSem[ nPass ][ i ], OS_DEL_ALWAYS, &err );
+			CHECK( "slab", err == OS_ERR_NONE );
+		}
+	}
+}
+#endif
+
+#if OS_Q_PRIO_EN > 0
+/*
+*********************************************************************************************************
+*                                               CheckQPrio
+*
+* Description:	Checks the priority queue pQBulkPrio of the q_urgent benchmark: the messages come out by
+*				priority and in FIFO order within a priority, OSQQuery() counts them per priority and
+*				OSQFlush() empties all the priorities.
+*********************************************************************************************************
+*/
+static void CheckQPrio( void )
+{
+	static INT32U	grnMsg[ 2 * OS_Q_PRIO_LEVELS ];
+	OS_Q_DATA	qData;
+	INT8U		err;
+	INT8U		nPrio;
+	int		i;
+
+	/* Two messages per priority, posted from the lowest priority up, the second lot after the first */
+	for( i = 0; i < 2 * OS_Q_PRIO_LEVELS; i++ )
+	{
+		nPrio = (INT8U)( OS_Q_PRIO_LEVELS - 1 - i % OS_Q_PRIO_LEVELS );
+		CHECK( "q_prio", OSQPostPrio( pQBulkPrio, &grnMsg[ i ], nPrio ) == OS_ERR_NONE );
+	}
+	CHECK( "q_prio", OSQQuery( pQBulkPrio, &qData ) == OS_ERR_NONE );
+	CHECK( "q_prio", qData.OSNMsgs == 2 * OS_Q_PRIO_LEVELS && qData.OSMsg == &grnMsg[ OS_Q_PRIO_LEVELS - 1 ] );
+	for( nPrio = 0; nPrio < OS_Q_PRIO_LEVELS; nPrio++ )
+		CHECK( "q_prio", qData.OSNMsgsPrio[ nPrio ] == 2 );
+	for( nPrio = 0; nPrio < OS_Q_PRIO_LEVELS; nPrio++ )
+	{
+		i = OS_Q_PRIO_LEVELS - 1 - nPrio;
+		CHECK( "q_prio", OSQAccept( pQBulkPrio, &err ) == &grnMsg[ i ] );
+		CHECK( "q_prio", OSQPend( pQBulkPrio, 0, &err ) == &grnMsg[ i + OS_Q_PRIO_LEVELS ] );
+	}
+	CHECK( "q_prio", OSQAccept( pQBulkPrio, &err ) == NULL && err == OS_ERR_Q_EMPTY );
+
+	/* OSQPostFront() goes ahead of priority 0, OSQPost() behind the lowest priority */
+	OSQPost( pQBulkPrio, &grnMsg[ 0 ] );
+	OSQPostPrio( pQBulkPrio, &grnMsg[ 1 ], 0 );
+	OSQPostFront( pQBulkPrio, &grnMsg[ 2 ] );
+	OSQPostPrio( pQBulkPrio, &grnMsg[ 3 ], OS_Q_PRIO_LEVELS - 1 );
+	CHECK( "q_prio", OSQAccept( pQBulkPrio, &err ) == &grnMsg[ 2 ] );
+	CHECK( "q_prio", OSQAccept( pQBulkPrio, &err ) == &grnMsg[ 1 ] );
+	CHECK( "q_prio", OSQAccept( pQBulkPrio, &err ) == &grnMsg[ 0 ] );
+	CHECK( "q_prio", OSQAccept( pQBulkPrio, &err ) == &grnMsg[ 3 ] );
+
+	/* A full queue refuses the post, a flush empties every priority and frees all the entries */
+	for( i = 0; i < BENCH_Q_BULK; i++ )
+	{
+		nPrio = (INT8U)( i % OS_Q_PRIO_LEVELS );
+		CHECK( "q_prio", OSQPostPrio( pQBulkPrio, &grnMsg[ nPrio ], nPrio ) == OS_ERR_NONE );
+	}
+	CHECK( "q_prio", OSQPostPrio( pQBulkPrio, &grnMsg[ 0 ], 0 ) == OS_ERR_Q_FULL );
+	CHECK( "q_prio", OSQFlush( pQBulkPrio ) == OS_ERR_NONE );
+	CHECK( "q_prio", OSQQuery( pQBulkPrio, &qData ) == OS_ERR_NONE && qData.OSNMsgs == 0 && qData.OSMsg == NULL );
+	for( nPrio = 0; nPrio < OS_Q_PRIO_LEVELS; nPrio++ )
+		CHECK( "q_prio", qData.OSNMsgsPrio[ nPrio ] == 0 );
+	for( i = 0; i < BENCH_Q_BULK; i++ )
+		CHECK( "q_prio", OSQPostPrio( pQBulkPrio, &grnMsg[ 0 ], 0 ) == OS_ERR_NONE );
+	OSQFlush( pQBulkPrio );
+}
+#endif
+
+#if (OS_TOPIC_EN > 0) && (OS_MAX_TOPICS > 0) && (OS_TOPIC_SUBS >= BENCH_TOPIC_SUBS) && (OS_TOPIC_REF_EN > 0)
+/*
+*********************************************************************************************************
+*                                               CheckTopic
+*
+* Description:	Checks the reference counted messages of the topics: a message published to 0, 1 and
+*				BENCH_TOPIC_SUBS subscribers, one of them full, goes back to its partition once, after the
+*				last subscriber that got it released it. A block of the partition stays taken, so a message
+*				put back twice would show in the count of free blocks.
+*********************************************************************************************************
+*/
+static INT16U CheckTopicFree( OS_MEM* pPart )
+{
+	OS_MEM_DATA	memData;
+
+	OSMemQuery( pPart, &memData );
+	return memData.OSNFree;
+}
+
+static void CheckTopic( void )
+{
+	static INT64U	grnBlk[ 4 ][ 4 ];
+	OS_MEM*		pPart;
+	OS_TOPIC*	pTopicChk;
+	void*		pHeld;
+	void*		pData;
+	INT8U		err;
+	int		i;
+
+	pPart     = OSMemCreate( grnBlk, 4, sizeof( grnBlk[ 0 ] ), &err );
+	pTopicChk = OSTopicCreate( &err );
+	CHECK( "topic", pPart != NULL && pTopicChk != NULL );
+	pHeld = OSMemGet( pPart, &err );
+
+	/* Never published */
+	pData = OSTopicMsgGet( pPart, &err );
+	CHECK( "topic", pData != NULL && CheckTopicFree( pPart ) == 2 );
+	CHECK( "topic", OSTopicMsgPut( pData ) == OS_ERR_NONE && CheckTopicFree( pPart ) == 3 );
+
+	/* No subscriber, the publish puts the message back */
+	pData = OSTopicMsgGet( pPart, &err );
+	CHECK( "topic", OSTopicPublish( pTopicChk, pData, OS_POST_OPT_REF, &err ) == 0 && err == OS_ERR_NONE );
+	CHECK( "topic", CheckTopicFree( pPart ) == 3 );
+
+	/* One subscriber */
+	OSTopicSubscribe( pTopicChk, grpQSub[ 0 ], &err );
+	CHECK( "topic", err == OS_ERR_NONE );
+	pData = OSTopicMsgGet( pPart, &err );
+	CHECK( "topic", OSTopicPublish( pTopicChk, pData, OS_POST_OPT_REF, &err ) == 1 && err == OS_ERR_NONE );
+	CHECK( "topic", CheckTopicFree( pPart ) == 2 && OSQAccept( grpQSub[ 0 ], &err ) == pData );
+	CHECK( "topic", OSTopicMsgPut( pData ) == OS_ERR_NONE && CheckTopicFree( pPart ) == 3 );
+	OSTopicUnsubscribe( pTopicChk, grpQSub[ 0 ], &err );
+	CHECK( "topic", err == OS_ERR_NONE && OSTopicDel( pTopicChk, &err ) == NULL );
+
+	/* BENCH_TOPIC_SUBS subscribers, the last one full, only the others hold a reference */
+	OSQPost( grpQSub[ BENCH_TOPIC_SUBS - 1 ], &nMsg );
+	pData = OSTopicMsgGet( pPart, &err );
+	CHECK( "topic", OSTopicPublish( pTopic, pData, OS_POST_OPT_REF, &err ) == BENCH_TOPIC_SUBS - 1 );
+	CHECK( "topic", err == OS_ERR_Q_FULL );
+	for( i = 0; i < BENCH_TOPIC_SUBS - 1; i++ )
+	{
+		CHECK( "topic", CheckTopicFree( pPart ) == 2 && OSQAccept( grpQSub[ i ], &err ) == pData );
+		CHECK( "topic", OSTopicMsgPut( pData ) == OS_ERR_NONE );
+	}
+	CHECK( "topic", CheckTopicFree( pPart ) == 3 );
+	CHECK( "topic", OSQAccept( grpQSub[ BENCH_TOPIC_SUBS - 1 ], &err ) == &nMsg );
+
+	OSMemPut( pPart, pHeld );
+}
+#endif
+
+#if (OS_RING_EN > 0) && (OS_MAX_RINGS > 0)
+/*
+*********************************************************************************************************
+*                                               CheckRing
+*
+* Description:	Checks the byte ring on a ring of BENCH_CHK_RING_SIZE bytes where every message of 40 bytes
+*				takes a slot of 48 bytes with its header: the wrap of a message that does not fit at the end
+*				of the storage, a message committed before the one reserved ahead of it and messages released
+*				out of order.
+*********************************************************************************************************
+*/
+static void CheckRingFill( INT8U* pData, INT32U nLen, INT8U bFill )
+{
+	INT32U	k;
+
+	for( k = 0; k < nLen; k++ )
+		pData[ k ] = (INT8U)( bFill + k );
+}
+
+static void CheckRingMsg( OS_EVENT* pEvent, INT8U* pExpected, INT32U nLen, INT8U bFill )
+{
+	INT8U*	pData;
+	INT32U	nGot;
+	INT8U	err;
+	INT32U	k;
+
+	pData = (INT8U*)OSRingAccept( pEvent, &nGot, &err );
+	CHECK( "ring", err == OS_ERR_NONE && pData == pExpected && nGot == nLen );
+	for( k = 0; k < nLen; k++ )
+		CHECK( "ring", pData[ k ] == (INT8U)( bFill + k ) );
+}
+
+static void CheckRing( void )
+{
+	static INT64U	grnStorage[ BENCH_CHK_RING_SIZE / 8 ];
+	OS_EVENT*	pEvent;
+	OS_RING*	pR;
+	INT8U*		pStart;
+	INT8U*		pA;
+	INT8U*		pB;
+	INT8U*		pC;
+	INT32U		nLen;
+	INT8U		err;
+
+	pEvent = OSRingCreate( grnStorage, sizeof( grnStorage ), &err );
+	CHECK( "ring", pEvent != NULL );
+	pR     = (OS_RING*)pEvent->OSEventPtr;
+	pStart = pR->OSRingStart;
+
+	/* A and B fill 96 bytes, C does not fit in the 32 bytes left at the end and wraps to the start */
+	pA = (INT8U*)OSRingReserve( pEvent, 40, 0, &err );
+	pB = (INT8U*)OSRingReserve( pEvent, 40, 0, &err );
+	CHECK( "ring", pA == pStart + 8 && pB == pStart + 56 );
+	CheckRingFill( pA, 40, 1 );
+	CheckRingFill( pB, 40, 2 );
+	CHECK( "ring", OSRingCommit( pEvent, pB, 41 ) == OS_ERR_RING_SIZE );
+	CHECK( "ring", OSRingCommit( pEvent, pA, 40 ) == OS_ERR_NONE );
+	CHECK( "ring", OSRingCommit( pEvent, pA, 40 ) == OS_ERR_RING_INVALID );
+	CHECK( "ring", OSRingCommit( pEvent, pB, 40 ) == OS_ERR_NONE );
+	CheckRingMsg( pEvent, pA, 40, 1 );
+	CHECK( "ring", OSRingReserve( pEvent, 40, 1, &err ) == NULL && err == OS_ERR_TIMEOUT );
+	CHECK( "ring", OSRingRelease( pEvent, pA ) == OS_ERR_NONE );
+	CHECK( "ring", OSRingRelease( pEvent, pA ) == OS_ERR_RING_INVALID );
+	pC = (INT8U*)OSRingReserve( pEvent, 40, 0, &err );
+	CHECK( "ring", pC == pStart + 8 && pR->OSRingUsed == 128 );
+	CheckRingFill( pC, 40, 3 );
+	CHECK( "ring", OSRingCommit( pEvent, pC, 40 ) == OS_ERR_NONE );
+
+	/* B is read at the end of the storage, the read crosses the wrap record to C at the start */
+	CheckRingMsg( pEvent, pB, 40, 2 );
+	CheckRingMsg( pEvent, pC, 40, 3 );
+	CHECK( "ring", OSRingAccept( pEvent, &nLen, &err ) == NULL && err == OS_ERR_RING_EMPTY && nLen == 0 );
+
+	/* C released before B leaves B and the wrap record in use, B then frees it all */
+	CHECK( "ring", OSRingRelease( pEvent, pC ) == OS_ERR_NONE && pR->OSRingUsed == 128 );
+	CHECK( "ring", OSRingRelease( pEvent, pB ) == OS_ERR_NONE && pR->OSRingUsed == 0 );
+
+	/* B committed before A is held back until A is committed, a hole never reorders the messages */
+	pA = (INT8U*)OSRingReserve( pEvent, 16, 0, &err );
+	pB = (INT8U*)OSRingReserve( pEvent, 24, 0, &err );
+	CHECK( "ring", pA == pStart + 8 && pB == pStart + 32 );
+	CheckRingFill( pA, 16, 4 );
+	CheckRingFill( pB, 24, 5 );
+	CHECK( "ring", OSRingCommit( pEvent, pB, 24 ) == OS_ERR_NONE );
+	CHECK( "ring", OSRingAccept( pEvent, &nLen, &err ) == NULL && err == OS_ERR_RING_EMPTY );
+	CHECK( "ring", OSRingCommit( pEvent, pA, 16 ) == OS_ERR_NONE );
+	CheckRingMsg( pEvent, pA, 16, 4 );
+	CheckRingMsg( pEvent, pB, 24, 5 );
+	CHECK( "ring", OSRingRelease( pEvent, pB ) == OS_ERR_NONE && pR->OSRingUsed == 56 );
+	CHECK( "ring", OSRingRelease( pEvent, pA ) == OS_ERR_NONE && pR->OSRingUsed == 0 );
+
+	OSRingDel( pEvent, OS_DEL_ALWAYS, &err );
+	CHECK( "ring", err == OS_ERR_NONE );
+}
+#endif
+
+/*
+*********************************************************************************************************
+*                                               Round trip benchmarks
+*********************************************************************************************************
+*/
+static void BenchSem( void )
+{
+	INT64U	nStart = 0;
+	INT64U	nT0;
+	INT8U	err;
+	int	i;
+
+	for( i = -BENCH_WARMUP; i < BENCH_ITERATIONS; i++ )
+	{
+		if( i == 0 )
+			nStart = BenchNs();
+		nT0 = BenchNs();
+		OSSemPost( pSemReq );
+		OSSemPend( pSemRep, 0, &err );
+		if( i >= 0 )
+			grnLatencyNs[ i ] = (INT32U)( BenchNs() - nT0 );
+	}
+	BenchReport( "sem_pingpong", "", grnLatencyNs, BENCH_ITERATIONS, BENCH_ITERATIONS, BenchNs() - nStart );
+
+	nEchoMode = ECHO_MBOX;
+	OSSemPost( pSemReq );
+	OSSemPend( pSemRep, 0, &err );
+}
+
+static void BenchMbox( void )
+{
+	INT64U	nStart = 0;
+	INT64U	nT0;
+	INT8U	err;
+	int	i;
+
+	for( i = -BENCH_WARMUP; i < BENCH_ITERATIONS; i++ )
+	{
+		if( i == 0 )
+			nStart = BenchNs();
+		nT0 = BenchNs();
+		OSMboxPost( pMboxReq, &nMsg );
+		OSMboxPend( pMboxRep, 0, &err );
+		if( i >= 0 )
+			grnLatencyNs[ i ] = (INT32U)( BenchNs() - nT0 );
+	}
+	BenchReport( "mbox_roundtrip", "", grnLatencyNs, BENCH_ITERATIONS, BENCH_ITERATIONS, BenchNs() - nStart );
+
+	nEchoMode = ECHO_Q;
+	OSMboxPost( pMboxReq, &nMsg );
+	OSMboxPend( pMboxRep, 0, &err );
+}
+
+static void BenchQ( void )
+{
+	INT64U	nStart = 0;
+	INT64U	nT0;
+	INT8U	err;
+	int	i;
+
+	for( i = -BENCH_WARMUP; i < BENCH_ITERATIONS; i++ )
+	{
+		if( i == 0 )
+			nStart = BenchNs();
+		nT0 = BenchNs();
+		OSQPost( pQReq, &nMsg );
+		OSQPend( pQRep, 0, &err );
+		if( i >= 0 )
+			grnLatencyNs[ i ] = (INT32U)( BenchNs() - nT0 );
+	}
+	BenchReport( "q_roundtrip", "", grnLatencyNs, BENCH_ITERATIONS, BENCH_ITERATIONS, BenchNs() - nStart );
+
+#if (OS_Q_PEND_N_EN > 0) && (OS_Q_POST_N_EN > 0)
+	nEchoMode = ECHO_Q_N;
+	OSQPost( pQReq, &nMsg );
+	OSQPend( pQRep, 0, &err );
+#elif (OS_RING_EN > 0) && (OS_MAX_RINGS > 0)
+	nEchoMode = ECHO_FRAME_MEM;
+	OSQPost( pQReq, &nMsg );
+	OSQPend( pQRep, 0, &err );
+#endif
+}
+
+#if (OS_Q_PEND_N_EN > 0) && (OS_Q_POST_N_EN > 0)
+/*
+*********************************************************************************************************
+*                                               BenchQBatch
+*
+* Description:	The echo task has a higher priority than the runner. Each OSQPost() switches to it for one
+*				message, OSQPostN() switches once and the echo task takes all the messages in one OSQPendN().
+*********************************************************************************************************
+*/
+static void BenchQBatch( const char* pMode )
+{
+	INT64U	nStart = 0;
+	INT64U	nT0;
+	INT8U	err;
+	char	szParams[ 48 ];
+	int	i;
+	int	j;
+
+	for( i = -BENCH_WARMUP; i < BENCH_ITERATIONS; i++ )
+	{
+		if( i == 0 )
+			nStart = BenchNs();
+		nT0 = BenchNs();
+		if( pMode[ 0 ] == 's' )
+		{
+			for( j = 0; j < BENCH_Q_BATCH; j++ )
+				OSQPost( pQReq, grpQBatch[ j ] );
+		}
+		else
+			OSQPostN( pQReq, grpQBatch, BENCH_Q_BATCH, &err );
+		OSQPend( pQRep, 0, &err );
+		if( i >= 0 )
+			grnLatencyNs[ i ] = (INT32U)( ( BenchNs() - nT0 ) / BENCH_Q_BATCH );
+	}
+	snprintf( szParams, sizeof( szParams ), "\"mode\":\"%s\",\"batch\":%d", pMode, BENCH_Q_BATCH );
+	BenchReport( "q_batch", szParams, grnLatencyNs, BENCH_ITERATIONS, (INT64U)BENCH_ITERATIONS * BENCH_Q_BATCH,
+				 BenchNs() - nStart );
+
+#if (OS_RING_EN > 0) && (OS_MAX_RINGS > 0)
+	if( pMode[ 0 ] == 'b' )
+	{
+		nEchoMode = ECHO_FRAME_MEM;
+		OSQPostN( pQReq, grpQBatch, BENCH_Q_BATCH, &err );
+		OSQPend( pQRep, 0, &err );
+	}
+#endif
+}
+#endif
+
+#if OS_Q_PRIO_EN > 0
+/*
+*********************************************************************************************************
+*                                               BenchQUrgent
+*
+* Description:	The runner is its own consumer and does no work on the bulk messages, so the fifo samples are
+*				the cost of taking the messages ahead of the command out of the queue. A real consumer adds the
+*				time it spends on each of them.
+*********************************************************************************************************
+*/
+static void BenchQUrgent( const char* pMode )
+{
+	BOOLEAN		bPrio = ( pMode[ 0 ] == 'p' );
+	OS_EVENT*	pQ = bPrio ? pQBulkPrio : pQBulkFifo;
+	INT64U		nStart = 0;
+	INT64U		nT0;
+	INT8U		err;
+	char		szParams[ 48 ];
+	int		i;
+	int		j;
+
+	for( i = -BENCH_WARMUP; i < BENCH_ITERATIONS; i++ )
+	{
+		if( i == 0 )
+			nStart = BenchNs();
+		for( j = 0; j < BENCH_Q_BULK - 1; j++ )
+		{
+			if( bPrio )
+				OSQPostPrio( pQ, &nMsg, OS_Q_PRIO_LEVELS - 1 );
+			else
+				OSQPost( pQ, &nMsg );
+		}
+		nT0 = BenchNs();
+		if( bPrio )
+			OSQPostPrio( pQ, &nCmd, 0 );
+		else
+			OSQPost( pQ, &nCmd );
+		while( OSQPend( pQ, 0, &err ) != &nCmd )
+			;
+		if( i >= 0 )
+			grnLatencyNs[ i ] = (INT32U)( BenchNs() - nT0 );
+		OSQFlush( pQ );
+	}
+	snprintf( szParams, sizeof( szParams ), "\"mode\":\"%s\",\"depth\":%d", pMode, BENCH_Q_BULK - 1 );
+	BenchReport( "q_urgent", szParams, grnLatencyNs, BENCH_ITERATIONS, BENCH_ITERATIONS, BenchNs() - nStart );
+}
+#endif
+
+#if (OS_TOPIC_EN > 0) && (OS_MAX_TOPICS > 0) && (OS_TOPIC_SUBS >= BENCH_TOPIC_SUBS)
+/*
+*********************************************************************************************************
+*                                               BenchTopic
+*
+* Description:	No task waits on the subscriber queues, the samples are the cost of the fan-out alone. The
+*				runner takes the messages back out with OSQAccept() outside of the samples.
+*********************************************************************************************************
+*/
+static void BenchTopic( const char* pMode )
+{
+	BOOLEAN	bTopic = ( pMode[ 0 ] == 't' );
+	INT64U	nStart = 0;
+	INT64U	nT0;
+	INT8U	err;
+	char	szParams[ 48 ];
+	int	i;
+	int	j;
+
+	for( i = -BENCH_WARMUP; i < BENCH_ITERATIONS; i++ )
+	{
+		if( i == 0 )
+			nStart = BenchNs();
+		nT0 = BenchNs();
+		if( bTopic )
+			OSTopicPublish( pTopic, &nMsg, OS_POST_OPT_NONE, &err );
+		else
+		{
+			for( j = 0; j < BENCH_TOPIC_SUBS; j++ )
+				OSQPost( grpQSub[ j ], &nMsg );
+		}
+		if( i >= 0 )
+			grnLatencyNs[ i ] = (INT32U)( BenchNs() - nT0 );
+		for( j = 0; j < BENCH_TOPIC_SUBS; j++ )
+			OSQAccept( grpQSub[ j ], &err );
+	}
+	snprintf( szParams, sizeof( szParams ), "\"mode\":\"%s\",\"subs\":%d", pMode, BENCH_TOPIC_SUBS );
+	BenchReport( "topic_fanout", szParams, grnLatencyNs, BENCH_ITERATIONS, BENCH_ITERATIONS, BenchNs() - nStart );
+}
+#endif
+
+#if (OS_RING_EN > 0) && (OS_MAX_RINGS > 0)
+/*
+*********************************************************************************************************
+*                                               BenchFrame
+*
+* Description:	The echo task has a higher priority than the runner and takes every frame as soon as it is
+*				sent, so the pool and the ring never run out. Both modes build and sum the same frames, mem_q
+*				writes each frame twice, ring once.
+*********************************************************************************************************
+*/
+static void FrameBatch( BOOLEAN bRing )
+{
+	INT32U*	pBlk;
+	INT8U*	pFrame;
+	INT32U	nLen;
+	INT8U	err;
+	int	j;
+
+	for( j = 0; j < BENCH_Q_BATCH; j++ )
+	{
+		nLen = FrameLen( j );
+		if( bRing )
+		{
+			pFrame = (INT8U*)OSRingReserve( pRing, nLen, 0, &err );
+			FrameFill( pFrame, nLen );
+			OSRingCommit( pRing, pFrame, nLen );
+		}
+		else
+		{
+			FrameFill( grbFrame, nLen );
+			pBlk      = (INT32U*)OSMemGet( pFrameMem, &err );
+			pBlk[ 0 ] = nLen;
+			memcpy( pBlk + 1, grbFrame, nLen );
+			OSQPost( pQReq, pBlk );
+		}
+	}
+	OSQPend( pQRep, 0, &err );
+}
+
+static void BenchFrame( const char* pMode )
+{
+	BOOLEAN	bRing = ( pMode[ 0 ] == 'r' );
+	INT64U	nStart = 0;
+	INT64U	nT0;
+	char	szParams[ 64 ];
+	int	i;
+
+	for( i = -BENCH_WARMUP; i < BENCH_ITERATIONS; i++ )
+	{
+		if( i == 0 )
+			nStart = BenchNs();
+		nT0 = BenchNs();
+		FrameBatch( bRing );
+		if( i >= 0 )
+			grnLatencyNs[ i ] = (INT32U)( ( BenchNs() - nT0 ) / BENCH_Q_BATCH );
+	}
+	snprintf( szParams, sizeof( szParams ), "\"mode\":\"%s\",\"batch\":%d,\"frame_max\":%d", pMode, BENCH_Q_BATCH,
+			  BENCH_FRAME_MAX );
+	BenchReport( "frame_pipe", szParams, grnLatencyNs, BENCH_ITERATIONS, (INT64U)BENCH_ITERATIONS * BENCH_Q_BATCH,
+				 BenchNs() - nStart );
+
+	if( !bRing )
+	{
+		nEchoMode = ECHO_FRAME_RING;
+		FrameBatch( OS_FALSE );
+	}
+}
+#endif
+
+/*
+*********************************************************************************************************
+*                                               BenchFlag
+*
+* Description:	The waiters have a higher priority than the runner, OSFlagPost() returns once all of them
+*				have run and are waiting again.
+*********************************************************************************************************
+*/
+static void BenchFlag( void )
+{
+	OS_FLAGS	flags = (OS_FLAGS)( ( 1 << BENCH_FLAG_WAITERS ) - 1 );
+	INT64U		nStart = 0;
+	INT64U		nT0;
+	INT8U		err;
+	char		szParams[ 32 ];
+	int		i;
+
+	for( i = -BENCH_WARMUP; i < BENCH_ITERATIONS; i++ )
+	{
+		if( i == 0 )
+			nStart = BenchNs();
+		nT0 = BenchNs();
+		OSFlagPost( pFlagGrp, flags, OS_FLAG_SET, &err );
+		if( i >= 0 )
+			grnLatencyNs[ i ] = (INT32U)( BenchNs() - nT0 );
+	}
+
+	snprintf( szParams, sizeof( szParams ), "\"waiters\":%d", BENCH_FLAG_WAITERS );
+	BenchReport( "flag_fanout", szParams, grnLatencyNs, BENCH_ITERATIONS, BENCH_ITERATIONS, BenchNs() - nStart );
+}
+
+/*
+*********************************************************************************************************
+*                                               BenchMem
+*
+* Description:	A get/put pair takes about as long as reading the clock, so a sample is the average of a batch.
+*********************************************************************************************************
+*/
+static void BenchMem( void )
+{
+	INT64U	nStart = 0;
+	INT64U	nT0;
+	void*	pBlk;
+	INT8U	err;
+	char	szParams[ 32 ];
+	int	i;
+	int	j;
+
+	for( i = -BENCH_WARMUP; i < BENCH_ITERATIONS; i++ )
+	{
+		if( i == 0 )
+			nStart = BenchNs();
+		nT0 = BenchNs();
+		for( j = 0; j < BENCH_MEM_BATCH; j++ )
+		{
+			pBlk = OSMemGet( pMem, &err );
+			OSMemPut( pMem, pBlk );
+		}
+		if( i >= 0 )
+			grnLatencyNs[ i ] = (INT32U)( ( BenchNs() - nT0 ) / BENCH_MEM_BATCH );
+	}
+
+	snprintf( szParams, sizeof( szParams ), "\"batch\":%d", BENCH_MEM_BATCH );
+	BenchReport( "mem_getput", szParams, grnLatencyNs, BENCH_ITERATIONS, (INT64U)BENCH_ITERATIONS * BENCH_MEM_BATCH,
+				 BenchNs() - nStart );
+}
+
+/*
+*********************************************************************************************************
+*                                               BenchDly
+*
+* Description:	Measures the wakeup interval of OSTimeDly(1). A sample is the absolute deviation from the tick
+*				period, the operation rate is the wakeup rate.
+*********************************************************************************************************
+*/
+static void BenchDly( void )
+{
+	INT64U	nPeriod = 1000000000ULL / OS_TICKS_PER_SEC;
+	INT64U	nStart;
+	INT64U	nLast;
+	INT64U	nNow;
+	INT64U	nInterval;
+	char	szParams[ 32 ];
+	int	i;
+
+	/* Start on a tick */
+	OSTimeDly( 1 );
+	nStart = nLast = BenchNs();
+
+	for( i = 0; i < BENCH_DLY_ITERATIONS; i++ )
+	{
+		OSTimeDly( 1 );
+		nNow = BenchNs();
+		nInterval = nNow - nLast;
+		nLast = nNow;
+		grnLatencyNs[ i ] = (INT32U)( ( nInterval > nPeriod ) ? nInterval - nPeriod : nPeriod - nInterval );
+	}
+
+	snprintf( szParams, sizeof( szParams ), "\"period_ns\":%u", (INT32U)nPeriod );
+	BenchReport( "dly_jitter", szParams, grnLatencyNs, BENCH_DLY_ITERATIONS, BENCH_DLY_ITERATIONS, nLast - nStart );
+}
+
+/*
+*********************************************************************************************************
+*                                               BenchTick
+*
+* Description:	Calls OSTimeTick() from the runner with a growing number of sleepers waiting on a delay. The
+*				call is made in a critical section so the real tick does not run in the middle of a sample.
+*********************************************************************************************************
+*/
+static void BenchTick( void )
+{
+	INT64U	nStart;
+	INT64U	nT0;
+	char	szParams[ 32 ];
+	int	nSleepers;
+	int	nStep;
+	int	i;
+#if OS_CRITICAL_METHOD == 3
+	OS_CPU_SR cpu_sr = 0;
+#endif
+
+	for( nStep = 0; nStep <= BENCH_TICK_STEPS; nStep++ )
+	{
+		nSleepers = ( BENCH_SLEEPERS * nStep ) / BENCH_TICK_STEPS;
+
+		/* The sleepers have a higher priority and start their delay at once */
+		for( i = 0; i < nSleepers; i++ )
+			OSTaskResume( BENCH_PRIO_SLEEPER + i );
+
+		nStart = BenchNs();
+		for( i = 0; i < BENCH_TICK_ITERATIONS; i++ )
+		{
+			OS_ENTER_CRITICAL();
+			nT0 = BenchNs();
+			OSTimeTick();
+			grnLatencyNs[ i ] = (INT32U)( BenchNs() - nT0 );
+			OS_EXIT_CRITICAL();
+		}
+
+		snprintf( szParams, sizeof( szParams ), "\"delayed_tasks\":%d", nSleepers );
+		BenchReport( "tick_cost", szParams, grnLatencyNs, BENCH_TICK_ITERATIONS, BENCH_TICK_ITERATIONS,
+					 BenchNs() - nStart );
+
+		for( i = 0; i < nSleepers; i++ )
+			OSTimeDlyResume( BENCH_PRIO_SLEEPER + i );
+	}
+}
+
+/*
+*********************************************************************************************************
+*                                               BenchTimeout
+*
+* Description:	Pends on a semaphore nobody posts. A sample is the time the pend took beyond BENCH_TIMEOUT_NS,
+*				a tick timeout is rounded up to the next tick.
+*********************************************************************************************************
+*/
+static void BenchTimeout( const char* pMode )
+{
+	INT64U	nStart;
+	INT64U	nT0;
+	INT64U	nElapsed;
+	INT8U	err;
+	char	szParams[ 48 ];
+	int	i;
+
+	nStart = BenchNs();
+	for( i = 0; i < BENCH_DLY_ITERATIONS; i++ )
+	{
+		nT0 = BenchNs();
+#if OS_TIME_NS_EN > 0
+		if( pMode[ 0 ] == 'n' )
+			OSSemPendNs( pSemNever, BENCH_TIMEOUT_NS, &err );
+		else
+#endif
+			OSSemPend( pSemNever, 1, &err );
+		nElapsed = BenchNs() - nT0;
+		grnLatencyNs[ i ] = (INT32U)( ( nElapsed > BENCH_TIMEOUT_NS ) ? nElapsed - BENCH_TIMEOUT_NS : 0 );
+	}
+
+	snprintf( szParams, sizeof( szParams ), "\"mode\":\"%s\",\"timeout_ns\":%d", pMode, BENCH_TIMEOUT_NS );
+	BenchReport( "pend_timeout", szParams, grnLatencyNs, BENCH_DLY_ITERATIONS, BENCH_DLY_ITERATIONS,
+				 BenchNs() - nStart );
+}
+
+#if (OS_CHAN_EN > 0) && (OS_MAX_CHANS > 0)
+/*
+*********************************************************************************************************
+*                                               ThreadChan
+*
+* Description:	Producer of the chan benchmark, a plain thread that makes no kernel call. It posts the index of
+*				each message, in the wake mode after storing the time of the post in grnChanTs[]. The check
+*				mode posts a single message BENCH_CHAN_CHECK_US after it was set, see CheckChan().
+*********************************************************************************************************
+*/
+static void* ThreadChan( void* pArg )
+{
+	INT32U	nMode;
+	long	i;
+
+	for(;;)
+	{
+		nMode = nChanMode;
+		if( nMode == CHAN_IDLE )
+		{
+			usleep( 1000 );
+			continue;
+		}
+		if( nMode == CHAN_CHECK )
+		{
+			usleep( BENCH_CHAN_CHECK_US );
+			OSChanPost( pChan, &nMsg );
+			nChanMode = CHAN_IDLE;
+			continue;
+		}
+
+		for( i = 0; i < BENCH_WARMUP + BENCH_ITERATIONS; i++ )
+		{
+			if( nMode == CHAN_WAKE )
+			{
+				usleep( BENCH_CHAN_GAP_US );
+				grnChanTs[ i ] = BenchNs();
+			}
+			while( OSChanPost( pChan, (void*)i ) == OS_ERR_CHAN_FULL )
+				sched_yield();
+		}
+		nChanMode = CHAN_IDLE;
+	}
+
+	return( NULL );
+}
+
+/*
+*********************************************************************************************************
+*                                               CheckChan
+*
+* Description:	Checks the channel: a pend on an empty channel times out, the message of ThreadChan() wakes
+*				the runner waiting on the channel through OSCPUIntRaise() and a full channel refuses the
+*				post. The runner fills the channel itself, ThreadChan() is idle and the channel has a single
+*				producer.
+*********************************************************************************************************
+*/
+static void CheckChan( void )
+{
+	INT8U	err;
+	long	i;
+
+	CHECK( "chan", OSChanAccept( pChan, &err ) == NULL && err == OS_ERR_CHAN_EMPTY );
+	CHECK( "chan", OSChanPend( pChan, 2, &err ) == NULL && err == OS_ERR_TIMEOUT );
+	CHECK( "chan", pChan->OSChanEvent.OSEventGrp == 0 );
+
+	nChanMode = CHAN_CHECK;
+	CHECK( "chan", OSChanPend( pChan, OS_TICKS_PER_SEC, &err ) == &nMsg && err == OS_ERR_NONE );
+	CHECK( "chan", pChan->OSChanWaiting == 0 && pChan->OSChanSig == 0 && OSChanSigList == NULL );
+	while( nChanMode != CHAN_IDLE )
+		OSTimeDly( 1 );
+
+	for( i = 0; i < BENCH_CHAN_SIZE - 1; i++ )
+		CHECK( "chan", OSChanPost( pChan, (void*)i ) == OS_ERR_NONE );
+	CHECK( "chan", OSChanPost( pChan, &nMsg ) == OS_ERR_CHAN_FULL );
+	for( i = 0; i < BENCH_CHAN_SIZE - 1; i++ )
+		CHECK( "chan", (long)OSChanPend( pChan, 0, &err ) == i && err == OS_ERR_NONE );
+	CHECK( "chan", OSChanAccept( pChan, &err ) == NULL && err == OS_ERR_CHAN_EMPTY );
+}
+
+/*
+*********************************************************************************************************
+*                                               BenchChan
+*
+* Description:	Takes the messages of ThreadChan() in the selected mode.
+*********************************************************************************************************
+*/
+static void BenchChan( const char* pMode )
+{
+	BOOLEAN	bWake = ( pMode[ 0 ] == 'w' );
+	INT64U	nStart = 0;
+	INT64U	nT0;
+	INT64U	nNow;
+	INT8U	err;
+	long	nIdx;
+	char	szParams[ 48 ];
+	int	i;
+
+	nChanMode = bWake ? CHAN_WAKE : CHAN_STREAM;
+	for( i = -BENCH_WARMUP; i < BENCH_ITERATIONS; i++ )
+	{
+		if( i == 0 )
+			nStart = BenchNs();
+		nT0  = BenchNs();
+		nIdx = (long)OSChanPend( pChan, 0, &err );
+		nNow = BenchNs();
+		if( i >= 0 )
+			grnLatencyNs[ i ] = (INT32U)( bWake ? nNow - grnChanTs[ nIdx ] : nNow - nT0 );
+	}
+	while( nChanMode != CHAN_IDLE )
+		OSTimeDly( 1 );
+
+	snprintf( szParams, sizeof( szParams ), "\"mode\":\"%s\",\"size\":%d", pMode, BENCH_CHAN_SIZE );
+	BenchReport( "chan", szParams, grnLatencyNs, BENCH_ITERATIONS, BENCH_ITERATIONS, BenchNs() - nStart );
+}
+#endif
+
+static void TaskRunner( void* p_arg )
+{
+#if OS_SLAB_EN > 0
+	CheckSlab();
+#endif
+	BenchSem();
+	BenchMbox();
+	BenchQ();
+#if (OS_Q_PEND_N_EN > 0) && (OS_Q_POST_N_EN > 0)
+	BenchQBatch( "single" );
+	BenchQBatch( "batch" );
+#endif
+#if OS_Q_PRIO_EN > 0
+	CheckQPrio();
+	BenchQUrgent( "fifo" );
+	BenchQUrgent( "prio" );
+#endif
+#if (OS_TOPIC_EN > 0) && (OS_MAX_TOPICS > 0) && (OS_TOPIC_SUBS >= BENCH_TOPIC_SUBS)
+#if OS_TOPIC_REF_EN > 0
+	CheckTopic();
+#endif
+	BenchTopic( "loop" );
+	BenchTopic( "topic" );
+#endif
+#if (OS_RING_EN > 0) && (OS_MAX_RINGS > 0)
+	CheckRing();
+	BenchFrame( "mem_q" );
+	BenchFrame( "ring" );
+#endif
+	BenchFlag();
+	BenchMem();
+	BenchDly();
+	BenchTick();
+	BenchTimeout( "ticks" );
+#if OS_TIME_NS_EN > 0
+	BenchTimeout( "ns" );
+#endif
+#if (OS_CHAN_EN > 0) && (OS_MAX_CHANS > 0)
+	CheckChan();
+	BenchChan( "wake" );
+	BenchChan( "stream" );
+#endif
+
+	exit( 0 );
+}
+
+int main (void)
+{
+	INT8U	err;
+	int	i;
+
+	OSInit();
+
+	pSemReq  = OSSemCreate( 0 );
+	pSemRep  = OSSemCreate( 0 );
+	pMboxReq = OSMboxCreate( NULL );
+	pMboxRep = OSMboxCreate( NULL );
+	pQReq    = OSQCreate( grpQReq, BENCH_Q_BATCH );
+	pQRep    = OSQCreate( grpQRep, 4 );
+	pFlagGrp = OSFlagCreate( 0, &err );
+	pMem     = OSMemCreate( grnMemBlk, 16, sizeof( grnMemBlk[ 0 ] ), &err );
+	pSemNever = OSSemCreate( 0 );
+#if (OS_RING_EN > 0) && (OS_MAX_RINGS > 0)
+	pFrameMem = OSMemCreate( grnFrameBlk, BENCH_Q_BATCH, sizeof( grnFrameBlk[ 0 ] ), &err );
+	pRing     = OSRingCreate( grbRing, BENCH_RING_SIZE, &err );
+	if( pFrameMem == NULL || pRing == NULL )
+	{
+		printf( "bench: kernel objects could not be created\n" );
+		return 1;
+	}
+#endif
+#if OS_Q_PRIO_EN > 0
+	pQBulkFifo = OSQCreate( grpQBulkFifo, BENCH_Q_BULK );
+	pQBulkPrio = OSQCreatePrio( grQBulkPrio, BENCH_Q_BULK );
+	if( pQBulkFifo == NULL || pQBulkPrio == NULL )
+	{
+		printf( "bench: kernel objects could not be created\n" );
+		return 1;
+	}
+#endif
+#if (OS_TOPIC_EN > 0) && (OS_MAX_TOPICS > 0) && (OS_TOPIC_SUBS >= BENCH_TOPIC_SUBS)
+	pTopic = OSTopicCreate( &err );
+	for( i = 0; i < BENCH_TOPIC_SUBS; i++ )
+	{
+		grpQSub[ i ] = OSQCreate( grpQSubMsg[ i ], 1 );
+		OSTopicSubscribe( pTopic, grpQSub[ i ], &err );
+		if( grpQSub[ i ] == NULL || err != OS_ERR_NONE )
+		{
+			printf( "bench: kernel objects could not be created\n" );
+			return 1;
+		}
+	}
+#endif
+#if (OS_CHAN_EN > 0) && (OS_MAX_CHANS > 0)
+	/* The thread inherits the blocked tick signal of this thread, see OSCPUIntRaise() */
+	pChan = OSChanCreate( grpChan, BENCH_CHAN_SIZE, &err );
+	if( pChan == NULL || pthread_create( &threadChan, NULL, ThreadChan, NULL ) != 0 )
+	{
+		printf( "bench: kernel objects could not be created\n" );
+		return 1;
+	}
+#endif
+
+	if( pQRep == NULL || pFlagGrp == NULL || pMem == NULL || pSemNever == NULL )
+	{
+		printf( "bench: kernel objects could not be created\n" );
+		return 1;
+	}
+
+	OSTaskCreate( TaskRunner, NULL, &StkRunner[ BENCH_STK_SIZE - 1 ], BENCH_PRIO_RUNNER );
+	OSTaskCreate( TaskEcho, NULL, &StkEcho[ BENCH_STK_SIZE - 1 ], BENCH_PRIO_ECHO );
+	for( i = 0; i < BENCH_Q_BATCH; i++ )
+		grpQBatch[ i ] = &nMsg;
+	for( i = 0; i < BENCH_FLAG_WAITERS; i++ )
+		OSTaskCreate( TaskWaiter, (void*)(long)i, &StkWaiter[ i ][ BENCH_STK_SIZE - 1 ], BENCH_PRIO_WAITER + i );
+	for( i = 0; i < BENCH_SLEEPERS; i++ )
+		OSTaskCreate( TaskSleeper, NULL, &StkSleeper[ i ][ BENCH_STK_SIZE - 1 ], BENCH_PRIO_SLEEPER + i );
+
+	OSStart();
+
+	return 0;
+}
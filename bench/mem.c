@@ -0,0 +1,216 @@
+/*
+*********************************************************************************************************
+*                                                 mem.c
+*
+* Description:	Benchmark of the memory clear and copy of the kernel. The Makefile builds the kernel, the port
+*				and this file once with the word loops of os_core.c and once with the SIMD functions of the
+*				port, see OS_CPU_MEM_SIMD_EN in os_cpu.h. The build with the word loops also measures the
+*				byte loops the kernel used before, as a reference. Before measuring, OS_MemCopy() is checked
+*				for every alignment of the source and the destination.
+*
+*				mem_clr			OS_MemClr() of BENCH_MEM_SIZES bytes.
+*				mem_copy		OS_MemCopy() of BENCH_MEM_SIZES bytes, the source aligned like the destination
+*								and the source one and three bytes off.
+*				task_create		OSTaskCreateExt() with OS_TASK_OPT_STK_CLR and OSTaskDel() of a task with
+*								a stack of BENCH_MEM_STK_SIZE elements, the task does not run.
+*
+*********************************************************************************************************
+*/
+
+#include <stdlib.h>
+#include <stdio.h>
+#include "bench.h"
+
+#define BENCH_ITERATIONS	2000
+#define BENCH_WARMUP		100
+
+#define BENCH_MEM_MAX		262144
+#define BENCH_MEM_STK_SIZE	16384
+
+#define BENCH_PRIO_RUNNER	10
+#define BENCH_PRIO_NEW		11
+
+#if defined(OS_CPU_MEM_CLR)
+#define BENCH_IMPL			"simd"
+#else
+#define BENCH_IMPL			"word"
+#endif
+
+static const INT32U grnSizes[] = { 64, 4096, 65536, BENCH_MEM_MAX };
+
+#define BENCH_MEM_SIZES		( sizeof( grnSizes ) / sizeof( grnSizes[ 0 ] ) )
+
+static OS_STK StkRunner[ BENCH_STK_SIZE ];
+static OS_STK StkNew[ BENCH_MEM_STK_SIZE ];
+
+/* One spare vector on top of the largest size for the misaligned source */
+static INT8U		grnDest[ BENCH_MEM_MAX + 16 ] __attribute__(( aligned( 16 ) ));
+static INT8U		grnSrc[ BENCH_MEM_MAX + 16 ] __attribute__(( aligned( 16 ) ));
+
+static INT32U		grnLatencyNs[ BENCH_ITERATIONS ];
+static char		szParams[ 128 ];
+
+#if !defined(OS_CPU_MEM_CLR)
+/* The byte loops of the kernel before the word loops, the reference of the word build */
+static void MemClrByte( INT8U* pDest, INT32U nSize, INT8U* pUnused )
+{
+	while( nSize > 0 )
+	{
+		*pDest++ = 0;
+		nSize--;
+	}
+}
+
+static void MemCopyByte( INT8U* pDest, INT32U nSize, INT8U* pSrc )
+{
+	while( nSize > 0 )
+	{
+		*pDest++ = *pSrc++;
+		nSize--;
+	}
+}
+#endif
+
+/*
+*********************************************************************************************************
+*                                             CheckMemCopy
+*
+* Description:	Checks OS_MemCopy() against a byte copy for every offset of the source and the destination
+*				within 16 bytes and the sizes up to BENCH_CHECK_SIZE, the bytes around the destination must
+*				stay untouched.
+*********************************************************************************************************
+*/
+#define BENCH_CHECK_SIZE	80
+
+static void CheckMemCopy( void )
+{
+	INT32U	nDestOff;
+	INT32U	nSrcOff;
+	INT32U	nSize;
+	INT32U	i;
+	INT8U	nExpect;
+
+	for( i = 0; i < 2 * BENCH_CHECK_SIZE; i++ )
+		grnSrc[ i ] = (INT8U)( i * 7 + 1 );
+	for( nDestOff = 0; nDestOff < 16; nDestOff++ )
+		for( nSrcOff = 0; nSrcOff < 16; nSrcOff++ )
+			for( nSize = 0; nSize <= BENCH_CHECK_SIZE; nSize++ )
+			{
+				for( i = 0; i < 2 * BENCH_CHECK_SIZE; i++ )
+					grnDest[ i ] = 0xAA;
+				OS_MemCopy( &grnDest[ nDestOff ], &grnSrc[ nSrcOff ], nSize );
+				for( i = 0; i < 2 * BENCH_CHECK_SIZE; i++ )
+				{
+					nExpect = 0xAA;
+					if( ( i >= nDestOff ) && ( i < nDestOff + nSize ) )
+						nExpect = grnSrc[ i - nDestOff + nSrcOff ];
+					if( grnDest[ i ] != nExpect )
+					{
+						printf( "mem_copy: %u bytes from offset %u to offset %u differ at byte %u\n",
+								nSize, nSrcOff, nDestOff, i );
+						exit( 1 );
+					}
+				}
+			}
+}
+
+static void MemClrKernel( INT8U* pDest, INT32U nSize, INT8U* pUnused )
+{
+	OS_MemClr( pDest, nSize );
+}
+
+static void MemCopyKernel( INT8U* pDest, INT32U nSize, INT8U* pSrc )
+{
+	OS_MemCopy( pDest, pSrc, nSize );
+}
+
+/*
+*********************************************************************************************************
+*                                               BenchMem
+*
+* Description:	Measures one clear or copy function for every size of grnSizes[].
+*
+* Arguments  :	pBench		name of the benchmark.
+*				pImpl		implementation measured, for the result line.
+*				pFunc		clear or copy function.
+*				nSrcOff		offset of the source from a 16 byte boundary, for the copy.
+*********************************************************************************************************
+*/
+static void BenchMem( const char* pBench, const char* pImpl, void (*pFunc)( INT8U*, INT32U, INT8U* ), INT32U nSrcOff )
+{
+	INT64U	nStart = 0;
+	INT64U	nT0;
+	INT32U	s;
+	int	i;
+
+	for( s = 0; s < BENCH_MEM_SIZES; s++ )
+	{
+		for( i = -BENCH_WARMUP; i < BENCH_ITERATIONS; i++ )
+		{
+			if( i == 0 )
+				nStart = BenchNs();
+			nT0 = BenchNs();
+			pFunc( grnDest, grnSizes[ s ], &grnSrc[ nSrcOff ] );
+			if( i >= 0 )
+				grnLatencyNs[ i ] = (INT32U)( BenchNs() - nT0 );
+		}
+		snprintf( szParams, sizeof( szParams ), "\"impl\":\"%s\",\"bytes\":%u,\"src_offset\":%u",
+				  pImpl, grnSizes[ s ], nSrcOff );
+		BenchReport( pBench, szParams, grnLatencyNs, BENCH_ITERATIONS, BENCH_ITERATIONS, BenchNs() - nStart );
+	}
+}
+
+static void TaskNew( void* p_arg )
+{
+	while(1)
+		OSTimeDly( 1 );
+}
+
+static void BenchTaskCreate( void )
+{
+	INT64U	nStart = 0;
+	INT64U	nT0;
+	int	i;
+
+	for( i = -BENCH_WARMUP; i < BENCH_ITERATIONS; i++ )
+	{
+		if( i == 0 )
+			nStart = BenchNs();
+		nT0 = BenchNs();
+		OSTaskCreateExt( TaskNew, NULL, &StkNew[ BENCH_MEM_STK_SIZE - 1 ], BENCH_PRIO_NEW, BENCH_PRIO_NEW,
+						 &StkNew[ 0 ], BENCH_MEM_STK_SIZE, NULL, OS_TASK_OPT_STK_CHK | OS_TASK_OPT_STK_CLR );
+		OSTaskDel( BENCH_PRIO_NEW );
+		if( i >= 0 )
+			grnLatencyNs[ i ] = (INT32U)( BenchNs() - nT0 );
+	}
+	snprintf( szParams, sizeof( szParams ), "\"impl\":\"%s\",\"stk_bytes\":%u", BENCH_IMPL,
+			  (INT32U)sizeof( StkNew ) );
+	BenchReport( "task_create", szParams, grnLatencyNs, BENCH_ITERATIONS, BENCH_ITERATIONS, BenchNs() - nStart );
+}
+
+static void TaskRunner( void* p_arg )
+{
+	CheckMemCopy();
+#if !defined(OS_CPU_MEM_CLR)
+	BenchMem( "mem_clr", "byte", MemClrByte, 0 );
+	BenchMem( "mem_copy", "byte", MemCopyByte, 0 );
+#endif
+	BenchMem( "mem_clr", BENCH_IMPL, MemClrKernel, 0 );
+	BenchMem( "mem_copy", BENCH_IMPL, MemCopyKernel, 0 );
+	BenchMem( "mem_copy", BENCH_IMPL, MemCopyKernel, 1 );
+	BenchMem( "mem_copy", BENCH_IMPL, MemCopyKernel, 3 );
+	BenchTaskCreate();
+
+	exit( 0 );
+}
+
+int main (void)
+{
+	OSInit();
+
+	OSTaskCreate( TaskRunner, NULL, &StkRunner[ BENCH_STK_SIZE - 1 ], BENCH_PRIO_RUNNER );
+
+	OSStart();
+
+	return 0;
+}
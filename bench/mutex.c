@@ -0,0 +1,201 @@
+/*
+*********************************************************************************************************
+*                                                mutex.c
+*
+* Description:	Benchmark of the mutex modes (OS_MUTEX_PROTOCOL_EN). The Makefile builds the kernel and this
+*				file with cfg/os_cfg.h and the single threaded port, like the scheduler benchmark, with
+*				OS_SCHED_RR_EN and OS_MUTEX_PROTOCOL_EN.
+*
+*				mutex_lock		OSMutexPend() and OSMutexPost() of a free mutex by one task, for a PIP
+*								("mode":"pip"), a ceiling and an inheritance mutex.
+*				mutex_chain		A high priority task waits for M1, held by a low priority task that waits
+*								for M2, held by a lower priority task that needs BENCH_MUTEX_WORK_NS to
+*								release it. A medium priority task becomes ready with the high priority
+*								task and runs for BENCH_MUTEX_SPIN_NS. The samples are the waits of the
+*								high priority task for M1. With PIP mutexes the owner of M2 only gets
+*								the PIP of M2 and the medium task delays it, with inheritance mutexes the
+*								priority of the high priority task goes down the chain.
+*
+*********************************************************************************************************
+*/
+
+#include <stdlib.h>
+#include <stdio.h>
+#include "bench.h"
+
+#define BENCH_ITERATIONS	20000
+#define BENCH_WARMUP		1000
+
+#define BENCH_CHAIN_ITERATIONS	2000
+#define BENCH_CHAIN_WARMUP		100
+
+#define BENCH_MUTEX_WORK_NS		20000
+#define BENCH_MUTEX_SPIN_NS		200000
+
+/* The PIP of M2 only has to be above the tasks that use M2, the medium task is above it */
+#define BENCH_PIP_LOCK		1
+#define BENCH_PIP_M1		2
+#define BENCH_CEILING		4
+#define BENCH_PRIO_HIGH		5
+#define BENCH_PRIO_MEDIUM	20
+#define BENCH_PIP_M2		25
+#define BENCH_PRIO_LOW		30
+#define BENCH_PRIO_LOWER	40
+
+static OS_STK StkHigh[ BENCH_STK_SIZE ];
+static OS_STK StkMedium[ BENCH_STK_SIZE ];
+static OS_STK StkLow[ BENCH_STK_SIZE ];
+static OS_STK StkLower[ BENCH_STK_SIZE ];
+
+static INT32U		grnLatencyNs[ BENCH_ITERATIONS ];
+static char		szParams[ 64 ];
+
+static OS_EVENT*	pM1;
+static OS_EVENT*	pM2;
+static OS_EVENT*	pSemAck;
+static OS_EVENT*	pSemMedium;
+static OS_EVENT*	pSemLow;
+static OS_EVENT*	pSemLower;
+
+static void Spin( INT64U nNs )
+{
+	INT64U	nEnd = BenchNs() + nNs;
+
+	while( BenchNs() < nEnd )
+		;
+}
+
+static void BenchLock( const char* pMode, OS_EVENT* pMutex )
+{
+	INT64U	nStart = 0;
+	INT64U	nT0;
+	INT8U	err;
+	int	i;
+
+	for( i = -BENCH_WARMUP; i < BENCH_ITERATIONS; i++ )
+	{
+		if( i == 0 )
+			nStart = BenchNs();
+		nT0 = BenchNs();
+		OSMutexPend( pMutex, 0, &err );
+		OSMutexPost( pMutex );
+		if( i >= 0 )
+			grnLatencyNs[ i ] = (INT32U)( BenchNs() - nT0 );
+	}
+	snprintf( szParams, sizeof( szParams ), "\"mode\":\"%s\"", pMode );
+	BenchReport( "mutex_lock", szParams, grnLatencyNs, BENCH_ITERATIONS, BENCH_ITERATIONS, BenchNs() - nStart );
+}
+
+/*
+*********************************************************************************************************
+*                                          TaskLower, TaskLow
+*
+* Description:	TaskLower takes M2, acknowledges, and acknowledges again once TaskLow waits for M2, then works
+*				and releases M2. TaskLow takes M1 and waits for M2 before it releases both.
+*********************************************************************************************************
+*/
+static void TaskLower( void* p_arg )
+{
+	INT8U	err;
+
+	while(1)
+	{
+		OSSemPend( pSemLower, 0, &err );
+		OSMutexPend( pM2, 0, &err );
+		OSSemPost( pSemAck );
+		OSSemPost( pSemAck );
+		Spin( BENCH_MUTEX_WORK_NS );
+		OSMutexPost( pM2 );
+	}
+}
+
+static void TaskLow( void* p_arg )
+{
+	INT8U	err;
+
+	while(1)
+	{
+		OSSemPend( pSemLow, 0, &err );
+		OSMutexPend( pM1, 0, &err );
+		OSMutexPend( pM2, 0, &err );
+		OSMutexPost( pM2 );
+		OSMutexPost( pM1 );
+	}
+}
+
+static void TaskMedium( void* p_arg )
+{
+	INT8U	err;
+
+	while(1)
+	{
+		OSSemPend( pSemMedium, 0, &err );
+		Spin( BENCH_MUTEX_SPIN_NS );
+		OSSemPost( pSemAck );
+	}
+}
+
+static void BenchChain( const char* pMode )
+{
+	INT64U	nStart = 0;
+	INT64U	nT0;
+	INT8U	err;
+	int	i;
+
+	for( i = -BENCH_CHAIN_WARMUP; i < BENCH_CHAIN_ITERATIONS; i++ )
+	{
+		if( i == 0 )
+			nStart = BenchNs();
+		OSSemPost( pSemLower );
+		OSSemPend( pSemAck, 0, &err );
+		OSSemPost( pSemLow );
+		OSSemPend( pSemAck, 0, &err );
+		OSSemPost( pSemMedium );
+		nT0 = BenchNs();
+		OSMutexPend( pM1, 0, &err );
+		if( i >= 0 )
+			grnLatencyNs[ i ] = (INT32U)( BenchNs() - nT0 );
+		OSMutexPost( pM1 );
+		OSSemPend( pSemAck, 0, &err );
+	}
+	snprintf( szParams, sizeof( szParams ), "\"mode\":\"%s\",\"spin_ns\":%d", pMode, BENCH_MUTEX_SPIN_NS );
+	BenchReport( "mutex_chain", szParams, grnLatencyNs, BENCH_CHAIN_ITERATIONS, BENCH_CHAIN_ITERATIONS,
+				 BenchNs() - nStart );
+}
+
+static void TaskHigh( void* p_arg )
+{
+	INT8U	err;
+
+	BenchLock( "pip", OSMutexCreate( BENCH_PIP_LOCK, &err ) );
+	BenchLock( "ceiling", OSMutexCreateExt( BENCH_CEILING, OS_MUTEX_OPT_CEILING, &err ) );
+	BenchLock( "inherit", OSMutexCreateExt( 0, OS_MUTEX_OPT_INHERIT, &err ) );
+
+	pSemAck    = OSSemCreate( 0 );
+	pSemMedium = OSSemCreate( 0 );
+	pSemLow    = OSSemCreate( 0 );
+	pSemLower  = OSSemCreate( 0 );
+	OSTaskCreate( TaskMedium, NULL, &StkMedium[ BENCH_STK_SIZE - 1 ], BENCH_PRIO_MEDIUM );
+	OSTaskCreate( TaskLow, NULL, &StkLow[ BENCH_STK_SIZE - 1 ], BENCH_PRIO_LOW );
+	OSTaskCreate( TaskLower, NULL, &StkLower[ BENCH_STK_SIZE - 1 ], BENCH_PRIO_LOWER );
+
+	pM1 = OSMutexCreate( BENCH_PIP_M1, &err );
+	pM2 = OSMutexCreate( BENCH_PIP_M2, &err );
+	BenchChain( "pip" );
+	pM1 = OSMutexCreateExt( 0, OS_MUTEX_OPT_INHERIT, &err );
+	pM2 = OSMutexCreateExt( 0, OS_MUTEX_OPT_INHERIT, &err );
+	BenchChain( "inherit" );
+
+	exit( 0 );
+}
+
+int main (void)
+{
+	OSInit();
+
+	OSTaskCreate( TaskHigh, NULL, &StkHigh[ BENCH_STK_SIZE - 1 ], BENCH_PRIO_HIGH );
+
+	OSStart();
+
+	return 0;
+}
@@ -0,0 +1,159 @@
+/*
+*********************************************************************************************************
+*                                                 rr.c
+*
+* Description:	Benchmark of the round-robin scheduling of tasks sharing a priority (OS_SCHED_RR_EN). The
+*				Makefile builds the kernel and this file with cfg/os_cfg.h and the single threaded port,
+*				like the scheduler benchmark.
+*
+*				rr_turn_wait	BENCH_RR_WORKERS CPU bound workers at one priority with a quantum of
+*								BENCH_RR_QUANTUM ticks, for BENCH_RR_TICKS ticks. The samples are the times
+*								a worker waited for its next turn, the operations are all the turns waited
+*								for, the first BENCH_ITERATIONS of them are sampled. The loops of all the
+*								workers and the share of the CPU of the slowest and the fastest worker are
+*								added to the result line.
+*				rr_yield		OSTimeDlyYield() between two tasks of the same priority, one switch.
+*
+*********************************************************************************************************
+*/
+
+#include <stdlib.h>
+#include <stdio.h>
+#include "bench.h"
+
+#define BENCH_ITERATIONS	20000
+#define BENCH_WARMUP		1000
+
+#define BENCH_RR_WORKERS	4
+#define BENCH_RR_QUANTUM	1
+#define BENCH_RR_TICKS		( OS_TICKS_PER_SEC * 2 )
+
+/* A gap in the loop of a worker longer than this is a turn of the other workers */
+#define BENCH_RR_GAP_NS		100000
+
+#define BENCH_PRIO_RUNNER	10
+#define BENCH_PRIO_WORKER	20
+
+static OS_STK StkRunner[ BENCH_STK_SIZE ];
+static OS_STK StkWorker[ BENCH_RR_WORKERS ][ BENCH_STK_SIZE ];
+
+static INT32U		grnLatencyNs[ BENCH_ITERATIONS ];
+static INT32U		nSamples;
+static INT64U		nTurns;
+static INT64U		grnLoops[ BENCH_RR_WORKERS ];
+static char		szParams[ 128 ];
+
+static INT64U		nYieldLast;
+static INT32S		nYieldCtr = -BENCH_WARMUP;
+static INT64U		nYieldStart;
+
+/*
+*********************************************************************************************************
+*                                               TaskWorker
+*
+* Description:	CPU bound worker of rr_turn_wait, counts its loops and records the time it waited for every
+*				turn. The workers never block, only the quantum makes them take turns.
+*********************************************************************************************************
+*/
+static void TaskWorker( void* p_arg )
+{
+	INT32U	nWorker = (INT32U)(long)p_arg;
+	INT64U	nLast = BenchNs();
+	INT64U	nNow;
+
+	while(1)
+	{
+		nNow = BenchNs();
+		if( nNow - nLast > BENCH_RR_GAP_NS )
+		{
+			if( nSamples < BENCH_ITERATIONS )
+				grnLatencyNs[ nSamples++ ] = (INT32U)( nNow - nLast );
+			nTurns++;
+		}
+		nLast = nNow;
+		grnLoops[ nWorker ]++;
+	}
+}
+
+/*
+*********************************************************************************************************
+*                                               TaskYield
+*
+* Description:	The two tasks of rr_yield, every return from OSTimeDlyYield() is one switch from the other
+*				task. The task that takes the last sample reports and ends the benchmarks.
+*********************************************************************************************************
+*/
+static void TaskYield( void* p_arg )
+{
+	INT64U	nNow;
+
+	while(1)
+	{
+		nNow = BenchNs();
+		if( nYieldCtr == 0 )
+			nYieldStart = nNow;
+		if( nYieldCtr >= 0 && nYieldCtr < BENCH_ITERATIONS )
+			grnLatencyNs[ nYieldCtr ] = (INT32U)( nNow - nYieldLast );
+		nYieldLast = nNow;
+		if( ++nYieldCtr == BENCH_ITERATIONS )
+		{
+			BenchReport( "rr_yield", "", grnLatencyNs, BENCH_ITERATIONS, BENCH_ITERATIONS, BenchNs() - nYieldStart );
+			exit( 0 );
+		}
+		OSTimeDlyYield();
+	}
+}
+
+static void BenchTurnWait( void )
+{
+	INT64U	nStart;
+	INT64U	nTotal = 0;
+	INT64U	nMin = ~0ULL;
+	INT64U	nMax = 0;
+	int	i;
+
+	for( i = 0; i < BENCH_RR_WORKERS; i++ )
+		OSTaskCreate( TaskWorker, (void*)(long)i, &StkWorker[ i ][ BENCH_STK_SIZE - 1 ], BENCH_PRIO_WORKER );
+	OSTaskQuantaSet( BENCH_PRIO_WORKER, BENCH_RR_QUANTUM );
+
+	nStart = BenchNs();
+	OSTimeDly( BENCH_RR_TICKS );
+	for( i = 0; i < BENCH_RR_WORKERS; i++ )
+		OSTaskDel( BENCH_PRIO_WORKER );
+
+	for( i = 0; i < BENCH_RR_WORKERS; i++ )
+	{
+		nTotal += grnLoops[ i ];
+		if( grnLoops[ i ] < nMin )
+			nMin = grnLoops[ i ];
+		if( grnLoops[ i ] > nMax )
+			nMax = grnLoops[ i ];
+	}
+	snprintf( szParams, sizeof( szParams ),
+			  "\"workers\":%d,\"quantum_ticks\":%d,\"loops\":%llu,\"min_share_pct\":%.1f,\"max_share_pct\":%.1f",
+			  BENCH_RR_WORKERS, BENCH_RR_QUANTUM, (unsigned long long)nTotal, ( nMin * 100.0 ) / nTotal,
+			  ( nMax * 100.0 ) / nTotal );
+	if( nSamples == 0 )
+		grnLatencyNs[ nSamples++ ] = 0;
+	BenchReport( "rr_turn_wait", szParams, grnLatencyNs, nSamples, nTurns, BenchNs() - nStart );
+}
+
+static void TaskRunner( void* p_arg )
+{
+	BenchTurnWait();
+
+	OSTaskCreate( TaskYield, NULL, &StkWorker[ 0 ][ BENCH_STK_SIZE - 1 ], BENCH_PRIO_WORKER );
+	OSTaskCreate( TaskYield, NULL, &StkWorker[ 1 ][ BENCH_STK_SIZE - 1 ], BENCH_PRIO_WORKER );
+	OSTaskSuspend( OS_PRIO_SELF );
+}
+
+int main (void)
+{
+	OSInit();
+
+	OSTaskCreate( TaskRunner, NULL, &StkRunner[ BENCH_STK_SIZE - 1 ], BENCH_PRIO_RUNNER );
+
+	OSStart();
+
+	return 0;
+}
@@ -0,0 +1,123 @@
+/*
+*********************************************************************************************************
+*                                               sched.c
+*
+* Description:	Benchmark of the ready list and wait list lookups. The Makefile builds the kernel and this file
+*				for every combination of OS_SCHED_CTZ_EN and OS_LOWEST_PRIO (64 or 255 priorities), see
+*				cfg/os_cfg.h, with the single threaded port so the lookups are not hidden behind the thread
+*				switch. The tasks run at the bottom of the priority range, where the OSUnMapTbl[] search of
+*				the 255 priority configuration has to look at the upper byte of the words.
+*
+*				sched_lookup	OSSchedLock() and OSSchedUnlock(), one OS_SchedNew() finding the runner,
+*								averaged over a batch of BENCH_BATCH.
+*				sem_pingpong	OSSemPost() to an echo task and OSSemPend() for its answer, two wait list
+*								lookups, two ready list lookups and two switches.
+*
+*********************************************************************************************************
+*/
+
+#include <stdlib.h>
+#include <stdio.h>
+#include "bench.h"
+
+#define BENCH_ITERATIONS	20000
+#define BENCH_WARMUP		1000
+#define BENCH_BATCH		100
+
+#define BENCH_PRIO_RUNNER	( OS_TASK_STAT_PRIO - 1 )
+#define BENCH_PRIO_ECHO		( OS_TASK_STAT_PRIO - 2 )
+
+#if OS_SCHED_CTZ_EN > 0
+#define BENCH_LOOKUP		"ctz"
+#else
+#define BENCH_LOOKUP		"unmap"
+#endif
+
+static OS_STK StkRunner[ BENCH_STK_SIZE ];
+static OS_STK StkEcho[ BENCH_STK_SIZE ];
+
+static INT32U		grnLatencyNs[ BENCH_ITERATIONS ];
+static char		szParams[ 64 ];
+
+static OS_EVENT*	pSemReq;
+static OS_EVENT*	pSemRep;
+
+static void TaskEcho( void* p_arg )
+{
+	INT8U	err;
+
+	while(1)
+	{
+		OSSemPend( pSemReq, 0, &err );
+		OSSemPost( pSemRep );
+	}
+}
+
+static void BenchLookup( void )
+{
+	INT64U	nStart = 0;
+	INT64U	nT0;
+	int	i;
+	int	j;
+
+	for( i = -BENCH_WARMUP; i < BENCH_ITERATIONS; i++ )
+	{
+		if( i == 0 )
+			nStart = BenchNs();
+		nT0 = BenchNs();
+		for( j = 0; j < BENCH_BATCH; j++ )
+		{
+			OSSchedLock();
+			OSSchedUnlock();
+		}
+		if( i >= 0 )
+			grnLatencyNs[ i ] = (INT32U)( ( BenchNs() - nT0 ) / BENCH_BATCH );
+	}
+	BenchReport( "sched_lookup", szParams, grnLatencyNs, BENCH_ITERATIONS, (INT64U)BENCH_ITERATIONS * BENCH_BATCH,
+				 BenchNs() - nStart );
+}
+
+static void BenchSem( void )
+{
+	INT64U	nStart = 0;
+	INT64U	nT0;
+	INT8U	err;
+	int	i;
+
+	for( i = -BENCH_WARMUP; i < BENCH_ITERATIONS; i++ )
+	{
+		if( i == 0 )
+			nStart = BenchNs();
+		nT0 = BenchNs();
+		OSSemPost( pSemReq );
+		OSSemPend( pSemRep, 0, &err );
+		if( i >= 0 )
+			grnLatencyNs[ i ] = (INT32U)( BenchNs() - nT0 );
+	}
+	BenchReport( "sem_pingpong", szParams, grnLatencyNs, BENCH_ITERATIONS, BENCH_ITERATIONS, BenchNs() - nStart );
+}
+
+static void TaskRunner( void* p_arg )
+{
+	snprintf( szParams, sizeof( szParams ), "\"lookup\":\"%s\",\"priorities\":%d", BENCH_LOOKUP, OS_LOWEST_PRIO + 1 );
+
+	BenchLookup();
+	BenchSem();
+
+	exit( 0 );
+}
+
+int main (void)
+{
+	OSInit();
+
+	pSemReq = OSSemCreate( 0 );
+	pSemRep = OSSemCreate( 0 );
+
+	OSTaskCreate( TaskRunner, NULL, &StkRunner[ BENCH_STK_SIZE - 1 ], BENCH_PRIO_RUNNER );
+	OSTaskCreate( TaskEcho, NULL, &StkEcho[ BENCH_STK_SIZE - 1 ], BENCH_PRIO_ECHO );
+
+	OSStart();
+
+	return 0;
+}
@@ -0,0 +1,31 @@
+/*
+*********************************************************************************************************
+*                                            sched_kernel.c
+*
+* Description:	The kernel in one translation unit, the way ucos/ucos_ii.c would build it, so every scheduler
+*				benchmark variant gets its own kernel object compiled with its own cfg/os_cfg.h settings.
+*
+*********************************************************************************************************
+*/
+
+#define  OS_GLOBALS
+#include <ucos_ii.h>
+
+#define  OS_MASTER_FILE
+#include <os_chan.c>
+#include <os_core.c>
+#include <os_flag.c>
+#include <os_intq.c>
+#include <os_mbox.c>
+#include <os_mem.c>
+#include <os_mutex.c>
+#include <os_q.c>
+#include <os_ring.c>
+#include <os_sem.c>
+#include <os_set.c>
+#include <os_slab.c>
+#include <os_stat.c>
+#include <os_task.c>
+#include <os_time.c>
+#include <os_tmr.c>
+#include <os_topic.c>
@@ -0,0 +1,201 @@
+/*
+*********************************************************************************************************
+*                                                 set.c
+*
+* Description:	Benchmark of the event sets (OS_SET_EN) against OSEventPendMulti(). The Makefile builds the
+*				kernel and this file with cfg/os_cfg.h and the single threaded port, like the scheduler
+*				benchmark, with enough event control blocks for BENCH_SET_EVENTS semaphores.
+*
+*				set_wake		A gateway task waits on BENCH_SET_EVENTS semaphores, a lower priority task
+*								posts one of them in turn. The samples are the OSSemPost() of the poster,
+*								the wakeup of the gateway, taking the count and the gateway waiting again.
+*								The gateway waits with OSEventPendMulti() ("wait":"multi") or with
+*								OSSetPend() and OSSemAccept() ("wait":"set").
+*
+*				Afterwards OSSetPend() is checked to wait again when a higher priority task took the
+*				count that readied it.
+*
+*********************************************************************************************************
+*/
+
+#include <stdlib.h>
+#include <stdio.h>
+#include "bench.h"
+
+#define BENCH_ITERATIONS	20000
+#define BENCH_WARMUP		1000
+
+#define BENCH_PRIO_RUNNER	10
+#define BENCH_PRIO_GATEWAY	9
+#define BENCH_PRIO_WAITER	11
+
+#define BENCH_SET_TIMEOUT	10
+
+static OS_STK StkRunner[ BENCH_STK_SIZE ];
+static OS_STK StkGateway[ BENCH_STK_SIZE ];
+static OS_STK StkWaiter[ BENCH_STK_SIZE ];
+
+static INT32U		grnLatencyNs[ BENCH_ITERATIONS ];
+static char		szParams[ 64 ];
+
+static OS_EVENT*	grpSem[ BENCH_SET_EVENTS + 1 ];
+static OS_EVENT*	pSet;
+static BOOLEAN		bUseSet;
+static INT32U		nWakeups;
+
+static OS_EVENT*	grpWaiterRdy[ BENCH_SET_EVENTS + 1 ];
+static INT8U		nWaiterRdy;
+static INT8U		errWaiter;
+static INT32U		nWaiterTicks;
+static INT32U		nWaiterDone;
+
+/*
+*********************************************************************************************************
+*                                               TaskGateway
+*
+* Description:	Waits on all the semaphores and takes the count of every one that is ready.
+*********************************************************************************************************
+*/
+static void TaskGateway( void* p_arg )
+{
+	OS_EVENT*	grpRdy[ BENCH_SET_EVENTS + 1 ];
+	void*		grpMsg[ BENCH_SET_EVENTS + 1 ];
+	INT8U		err;
+	INT16U		nRdy;
+	INT16U		i;
+
+	while(1)
+	{
+		if( bUseSet )
+		{
+			nRdy = OSSetPend( pSet, grpRdy, BENCH_SET_EVENTS, 0, &err );
+			for( i = 0; i < nRdy; i++ )
+				OSSemAccept( grpRdy[ i ] );
+		}
+		else
+			nRdy = OSEventPendMulti( grpSem, grpRdy, grpMsg, 0, &err );
+		nWakeups += nRdy;
+	}
+}
+
+static void BenchWake( const char* pWait )
+{
+	INT64U	nStart = 0;
+	INT64U	nT0;
+	int	i;
+
+	for( i = -BENCH_WARMUP; i < BENCH_ITERATIONS; i++ )
+	{
+		if( i == 0 )
+			nStart = BenchNs();
+		nT0 = BenchNs();
+		OSSemPost( grpSem[ (INT32U)( i + BENCH_WARMUP ) % BENCH_SET_EVENTS ] );
+		if( i >= 0 )
+			grnLatencyNs[ i ] = (INT32U)( BenchNs() - nT0 );
+	}
+	snprintf( szParams, sizeof( szParams ), "\"wait\":\"%s\",\"events\":%d", pWait, BENCH_SET_EVENTS );
+	BenchReport( "set_wake", szParams, grnLatencyNs, BENCH_ITERATIONS, BENCH_ITERATIONS, BenchNs() - nStart );
+}
+
+/*
+*********************************************************************************************************
+*                                             CheckRetake
+*
+* Description:	Checks that OSSetPend() of a lower priority task whose count was taken by the runner waits
+*				again for the rest of its timeout instead of returning no member with OS_ERR_NONE.
+*********************************************************************************************************
+*/
+#define CHECK( bOk )	Check( bOk, __LINE__ )
+
+static void Check( BOOLEAN bOk, int nLine )
+{
+	if( !bOk )
+	{
+		printf( "set_wake: check at line %d failed\n", nLine );
+		exit( 1 );
+	}
+}
+
+static void TaskWaiter( void* p_arg )
+{
+	INT32U	nStart;
+
+	while(1)
+	{
+		nStart = OSTimeGet();
+		nWaiterRdy = OSSetPend( pSet, grpWaiterRdy, BENCH_SET_EVENTS, BENCH_SET_TIMEOUT, &errWaiter );
+		nWaiterTicks = OSTimeGet() - nStart;
+		if( nWaiterRdy > 0 )
+			OSSemAccept( grpWaiterRdy[ 0 ] );
+		nWaiterDone++;
+		OSTaskSuspend( OS_PRIO_SELF );
+	}
+}
+
+static void CheckRetake( void )
+{
+	OSTaskCreate( TaskWaiter, NULL, &StkWaiter[ BENCH_STK_SIZE - 1 ], BENCH_PRIO_WAITER );
+	OSTimeDly( 1 );
+	OSSemPost( grpSem[ 0 ] );						/* Readies the waiter, the runner takes the count first */
+	OSSemAccept( grpSem[ 0 ] );
+	OSTimeDly( 1 );
+	CHECK( nWaiterDone == 0 );
+	OSSemPost( grpSem[ 1 ] );
+	OSTimeDly( 1 );
+	CHECK( nWaiterDone == 1 );
+	CHECK( ( nWaiterRdy == 1 ) && ( errWaiter == OS_ERR_NONE ) && ( grpWaiterRdy[ 0 ] == grpSem[ 1 ] ) );
+
+	OSTaskResume( BENCH_PRIO_WAITER );
+	OSTimeDly( BENCH_SET_TIMEOUT / 2 );
+	OSSemPost( grpSem[ 0 ] );
+	OSSemAccept( grpSem[ 0 ] );
+	OSTimeDly( BENCH_SET_TIMEOUT );					/* The waiter times out within the first timeout */
+	CHECK( nWaiterDone == 2 );
+	CHECK( ( nWaiterRdy == 0 ) && ( errWaiter == OS_ERR_TIMEOUT ) && ( grpWaiterRdy[ 0 ] == NULL ) );
+	CHECK( nWaiterTicks <= BENCH_SET_TIMEOUT + 1 );
+	OSTaskDel( BENCH_PRIO_WAITER );
+}
+
+static void TaskRunner( void* p_arg )
+{
+	INT8U	err;
+	int	i;
+
+	OSTaskCreate( TaskGateway, NULL, &StkGateway[ BENCH_STK_SIZE - 1 ], BENCH_PRIO_GATEWAY );
+	BenchWake( "multi" );
+	OSTaskDel( BENCH_PRIO_GATEWAY );
+
+	pSet = OSSetCreate();
+	for( i = 0; i < BENCH_SET_EVENTS; i++ )
+		OSSetAdd( pSet, grpSem[ i ], &err );
+	bUseSet = OS_TRUE;
+	OSTaskCreate( TaskGateway, NULL, &StkGateway[ BENCH_STK_SIZE - 1 ], BENCH_PRIO_GATEWAY );
+	BenchWake( "set" );
+
+	if( nWakeups != 2 * ( BENCH_ITERATIONS + BENCH_WARMUP ) )
+	{
+		printf( "set_wake: %u wakeups instead of %u\n", nWakeups, 2 * ( BENCH_ITERATIONS + BENCH_WARMUP ) );
+		exit( 1 );
+	}
+
+	OSTaskDel( BENCH_PRIO_GATEWAY );
+	CheckRetake();
+	exit( 0 );
+}
+
+int main (void)
+{
+	int	i;
+
+	OSInit();
+
+	for( i = 0; i < BENCH_SET_EVENTS; i++ )
+		grpSem[ i ] = OSSemCreate( 0 );
+	grpSem[ BENCH_SET_EVENTS ] = (OS_EVENT*)0;
+
+	OSTaskCreate( TaskRunner, NULL, &StkRunner[ BENCH_STK_SIZE - 1 ], BENCH_PRIO_RUNNER );
+
+	OSStart();
+
+	return 0;
+}
@@ -0,0 +1,185 @@
+/*
+*********************************************************************************************************
+*                                               stkchk.c
+*
+* Description:	Benchmark of the stack checking of the statistic task. The Makefile builds the kernel and this
+*				file with cfg/os_cfg.h and the single threaded port, like the scheduler benchmark, so the
+*				tasks really use their stacks. BENCH_STK_TASKS tasks with stacks of BENCH_STK_CHK_SIZE
+*				entries have used a few KiB of them. The kernel is built with OS_SCHED_RR_EN, before the
+*				benchmark the runner checks the incremental stack check with tasks sharing a priority, a
+*				failed check prints its line and exits with 1.
+*
+*				stk_chk			One period of the stack checking of the statistic task. "full" is
+*								OSTaskStkChk() of every task, what the statistic task did before,
+*								"incremental" is OS_TaskStatStkChk() once the high-water marks are known.
+*
+*********************************************************************************************************
+*/
+
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include "bench.h"
+
+#define BENCH_ITERATIONS	2000
+#define BENCH_WARMUP		100
+
+#define BENCH_STK_TASKS		16
+#define BENCH_STK_CHK_SIZE	16384
+
+#define BENCH_STK_CHK_TASKS	2
+
+#define BENCH_PRIO_RUNNER	10
+#define BENCH_PRIO_TASK		20
+#define BENCH_PRIO_CHK		50
+
+static OS_STK StkRunner[ BENCH_STK_SIZE ];
+static OS_STK StkTask[ BENCH_STK_TASKS ][ BENCH_STK_CHK_SIZE ];
+static OS_STK StkChk[ BENCH_STK_CHK_TASKS ][ BENCH_STK_CHK_SIZE ];
+
+static INT32U		grnLatencyNs[ BENCH_ITERATIONS ];
+static char		szParams[ 64 ];
+
+/* Leaves a few KiB of the stack used before the task waits for good */
+static int UseStack( int nDepth )
+{
+	volatile char	grBuf[ 256 ];
+
+	memset( (char*)grBuf, nDepth, sizeof( grBuf ) );
+	return ( nDepth > 0 ) ? UseStack( nDepth - 1 ) + grBuf[ 1 ] : grBuf[ 0 ];
+}
+
+static void TaskStk( void* p_arg )
+{
+	UseStack( 16 );
+	while(1)
+		OSTaskSuspend( OS_PRIO_SELF );
+}
+
+/*
+*********************************************************************************************************
+*                                               CheckStk
+*
+* Description:	Checks OS_TaskStatStkChk() with BENCH_STK_CHK_TASKS tasks at BENCH_PRIO_CHK: every task of
+*				the priority gets its high-water mark, a stack used down to its guard entries is not an
+*				overflow and the guard entries of a full stack are still checked. The overflow is reported
+*				once by OSTaskStkOvfHook() of the port.
+*********************************************************************************************************
+*/
+#define CHECK( bOk )	Check( bOk, __LINE__ )
+
+static void Check( BOOLEAN bOk, int nLine )
+{
+	if( !bOk )
+	{
+		printf( "stk_chk: check at line %d failed\n", nLine );
+		exit( 1 );
+	}
+}
+
+/* Enough periods of the statistic task to visit every task */
+static void CheckStkPeriods( void )
+{
+	INT16U	i;
+
+	for( i = 0; i < OSTaskCtr; i++ )
+		OS_TaskStatStkChk();
+}
+
+static void CheckStk( void )
+{
+	OS_TCB*	grpTCB[ BENCH_STK_CHK_TASKS ];
+	OS_STK*	pStk;
+	INT32U	nFree = BENCH_STK_CHK_SIZE - OS_TASK_STK_GUARD( BENCH_STK_CHK_SIZE );
+	INT32U	j;
+	int	i;
+
+	for( i = 0; i < BENCH_STK_CHK_TASKS; i++ )
+	{
+		OSTaskCreateExt( TaskStk, NULL, &StkChk[ i ][ BENCH_STK_CHK_SIZE - 1 ], BENCH_PRIO_CHK, BENCH_PRIO_CHK,
+						 &StkChk[ i ][ 0 ], BENCH_STK_CHK_SIZE, NULL, OS_TASK_OPT_STK_CHK | OS_TASK_OPT_STK_CLR );
+		grpTCB[ i ] = OSTCBList;
+	}
+	OSTimeDly( 1 );
+
+	CheckStkPeriods();
+	for( i = 0; i < BENCH_STK_CHK_TASKS; i++ )
+	{
+		CHECK( grpTCB[ i ]->OSTCBPrio == BENCH_PRIO_CHK );
+		CHECK( grpTCB[ i ]->OSTCBStkFree > 0 && grpTCB[ i ]->OSTCBStkFree < nFree );
+		CHECK( grpTCB[ i ]->OSTCBStkOvf == OS_FALSE );
+	}
+
+	/* The first task used every free entry, the stack is full but did not overflow */
+	pStk = &StkChk[ 0 ][ OS_TASK_STK_GUARD( BENCH_STK_CHK_SIZE ) ];
+	for( j = 0; j < grpTCB[ 0 ]->OSTCBStkFree; j++ )
+		pStk[ j ] = 1;
+	CheckStkPeriods();
+	CHECK( grpTCB[ 0 ]->OSTCBStkFree == 0 && grpTCB[ 0 ]->OSTCBStkOvf == OS_FALSE );
+
+	/* It then writes a guard entry */
+	StkChk[ 0 ][ 0 ] = 0;
+	CheckStkPeriods();
+	CHECK( grpTCB[ 0 ]->OSTCBStkOvf == OS_TRUE && grpTCB[ 1 ]->OSTCBStkOvf == OS_FALSE );
+
+	StkChk[ 0 ][ 0 ] = OS_TASK_STK_CANARY;
+	for( i = 0; i < BENCH_STK_CHK_TASKS; i++ )
+		OSTaskDel( BENCH_PRIO_CHK );
+}
+
+static void FullChk( void )
+{
+	OS_STK_DATA	stk_data;
+	INT8U		prio;
+
+	for( prio = 0; prio <= OS_TASK_IDLE_PRIO; prio++ )
+		OSTaskStkChk( prio, &stk_data );
+}
+
+static void BenchChk( const char* pImpl, void (*pFunc)( void ) )
+{
+	INT64U	nStart = 0;
+	INT64U	nT0;
+	int	i;
+
+	for( i = -BENCH_WARMUP; i < BENCH_ITERATIONS; i++ )
+	{
+		if( i == 0 )
+			nStart = BenchNs();
+		nT0 = BenchNs();
+		pFunc();
+		if( i >= 0 )
+			grnLatencyNs[ i ] = (INT32U)( BenchNs() - nT0 );
+	}
+	snprintf( szParams, sizeof( szParams ), "\"impl\":\"%s\",\"tasks\":%d,\"stk_bytes\":%u", pImpl,
+			  BENCH_STK_TASKS, (INT32U)sizeof( StkTask[ 0 ] ) );
+	BenchReport( "stk_chk", szParams, grnLatencyNs, BENCH_ITERATIONS, BENCH_ITERATIONS, BenchNs() - nStart );
+}
+
+static void TaskRunner( void* p_arg )
+{
+	int	i;
+
+	CheckStk();
+	for( i = 0; i < BENCH_STK_TASKS; i++ )
+		OSTaskCreateExt( TaskStk, NULL, &StkTask[ i ][ BENCH_STK_CHK_SIZE - 1 ], BENCH_PRIO_TASK + i,
+						 BENCH_PRIO_TASK + i, &StkTask[ i ][ 0 ], BENCH_STK_CHK_SIZE, NULL,
+						 OS_TASK_OPT_STK_CHK | OS_TASK_OPT_STK_CLR );
+	OSTimeDly( 1 );
+
+	BenchChk( "full", FullChk );
+	BenchChk( "incremental", OS_TaskStatStkChk );
+
+	exit( 0 );
+}
+
+int main (void)
+{
+	OSInit();
+
+	OSTaskCreate( TaskRunner, NULL, &StkRunner[ BENCH_STK_SIZE - 1 ], BENCH_PRIO_RUNNER );
+
+	OSStart();
+
+	return 0;
+}
@@ -35,6 +35,8 @@
 
 #define OS_EVENT_MULTI_EN         1    /* Include code for OSEventPendMulti()                          */
 #define OS_EVENT_NAME_SIZE       16    /* Determine the size of the name of a Sem, Mutex, Mbox or Q    */
+#define OS_EVENT_PROF_EN          1    /* Pend/post statistics of the Sems, Mutexes, Mboxes, Qs, Flags */
+#define OS_EVENT_PROF_BINS       32    /*     Number of log2 buckets of the blocked time histograms    */
 
 #define OS_LOWEST_PRIO           63    /* Defines the lowest priority that can be assigned ...         */
                                        /* ... MUST NEVER be higher than 254!                           */
@@ -45,16 +47,23 @@
 #define OS_MAX_QS                 4    /* Max. number of queue control blocks in your application      */
 #define OS_MAX_TASKS             20    /* Max. number of tasks in your application, MUST be >= 2       */
 
+#define OS_SLAB_EN                1    /* Grow the object tables beyond OS_MAX_xxx from slab pages     */
+#define OS_SLAB_PAGE_SIZE      4096    /*     Size of a slab page (bytes)                              */
+
 #define OS_SCHED_LOCK_EN          1    /* Include code for OSSchedLock() and OSSchedUnlock()           */
+#define OS_SCHED_CTZ_EN           1    /* Ready and wait lists in 64-bit words searched with CTZ       */
+#define OS_SCHED_RR_EN            0    /* Several tasks per priority, scheduled round-robin            */
+#define OS_SCHED_RR_QUANTUM      10    /*     Default time quantum of a task (# of ticks)              */
 
 #define OS_TICK_STEP_EN           1    /* Enable tick stepping feature for uC/OS-View                  */
 #define OS_TICKS_PER_SEC        100    /* Set the number of ticks in one second                        */
 
 
                                        /* --------------------- TASK STACK SIZE ---------------------- */
-#define OS_TASK_TMR_STK_SIZE    128    /* Timer      task stack size (# of OS_STK wide entries)        */
-#define OS_TASK_STAT_STK_SIZE   128    /* Statistics task stack size (# of OS_STK wide entries)        */
-#define OS_TASK_IDLE_STK_SIZE   128    /* Idle       task stack size (# of OS_STK wide entries)        */
+#define OS_TASK_TMR_STK_SIZE   4096    /* Timer      task stack size (# of OS_STK wide entries)        */
+#define OS_TASK_INT_Q_STK_SIZE 4096    /* Int. Q     task stack size (# of OS_STK wide entries)        */
+#define OS_TASK_STAT_STK_SIZE  4096    /* Statistics task stack size (# of OS_STK wide entries)        */
+#define OS_TASK_IDLE_STK_SIZE  4096    /* Idle       task stack size (# of OS_STK wide entries)        */
 
 
                                        /* --------------------- TASK MANAGEMENT ---------------------- */
@@ -64,9 +73,13 @@
 #define OS_TASK_DEL_EN            1    /*     Include code for OSTaskDel()                             */
 #define OS_TASK_NAME_SIZE        16    /*     Determine the size of a task name                        */
 #define OS_TASK_PROFILE_EN        1    /*     Include variables in OS_TCB for profiling                */
+#define OS_TASK_PROFILE_WIN      10    /*     Profiling window in statistic task periods (1/10 s)      */
+#define OS_STAT_EN                1    /*     Load statistics from the task profiles (os_stat.c)       */
 #define OS_TASK_QUERY_EN          1    /*     Include code for OSTaskQuery()                           */
 #define OS_TASK_STAT_EN           1    /*     Enable (1) or Disable(0) the statistics task             */
 #define OS_TASK_STAT_STK_CHK_EN   1    /*     Check task stacks from statistic task                    */
+#define OS_TASK_STAT_STK_CHK_NBR  4    /*     Max. # of task stacks scanned per statistic period       */
+#define OS_TASK_STK_CANARY_EN     1    /*     Guard words at the end of the task stacks                */
 #define OS_TASK_SUSPEND_EN        1    /*     Include code for OSTaskSuspend() and OSTaskResume()      */
 #define OS_TASK_SW_HOOK_EN        1    /*     Include code for OSTaskSwHook()                          */
 
@@ -81,6 +94,17 @@
 #define OS_FLAGS_NBITS           16    /* Size in #bits of OS_FLAGS data type (8, 16 or 32)            */
 
 
+                                       /* ------------------ ISR DEFERRED POSTS ---------------------- */
+#define OS_INT_Q_EN               0    /* Enable (1) or Disable (0) the deferred posts of the ISRs     */
+#define OS_MAX_INT_QS             4    /*     Max. number of interrupt queues (one per ISR source)     */
+#define OS_TASK_INT_Q_PRIO        0    /*     Priority of the task that does the deferred posts        */
+
+
+                                       /* ------------------ NATIVE THREAD CHANNELS ------------------ */
+#define OS_CHAN_EN                1    /* Enable (1) or Disable (0) the channels from native threads   */
+#define OS_MAX_CHANS              2    /*     Max. number of channels written by native threads        */
+
+
                                        /* -------------------- MESSAGE MAILBOXES --------------------- */
 #define OS_MBOX_EN                1    /* Enable (1) or Disable (0) code generation for MAILBOXES      */
 #define OS_MBOX_ACCEPT_EN         1    /*     Include code for OSMboxAccept()                          */
@@ -102,6 +126,8 @@
 #define OS_MUTEX_ACCEPT_EN        1    /*     Include code for OSMutexAccept()                         */
 #define OS_MUTEX_DEL_EN           1    /*     Include code for OSMutexDel()                            */
 #define OS_MUTEX_QUERY_EN         1    /*     Include code for OSMutexQuery()                          */
+#define OS_MUTEX_PROTOCOL_EN      0    /*     Ceiling and inheritance mutexes, need OS_SCHED_RR_EN     */
+#define OS_MUTEX_STAT_EN          1    /*     Lock hold time and contention counters                   */
 
 
                                        /* ---------------------- MESSAGE QUEUES ---------------------- */
@@ -110,12 +136,21 @@
 #define OS_Q_DEL_EN               1    /*     Include code for OSQDel()                                */
 #define OS_Q_FLUSH_EN             1    /*     Include code for OSQFlush()                              */
 #define OS_Q_PEND_ABORT_EN        1    /*     Include code for OSQPendAbort()                          */
+#define OS_Q_PEND_N_EN            1    /*     Include code for OSQPendN()                              */
 #define OS_Q_POST_EN              1    /*     Include code for OSQPost()                               */
 #define OS_Q_POST_FRONT_EN        1    /*     Include code for OSQPostFront()                          */
+#define OS_Q_POST_N_EN            1    /*     Include code for OSQPostN()                              */
 #define OS_Q_POST_OPT_EN          1    /*     Include code for OSQPostOpt()                            */
+#define OS_Q_PRIO_EN              1    /*     Include code for OSQCreatePrio() and OSQPostPrio()       */
+#define OS_Q_PRIO_LEVELS          8    /*     Number of message priorities of a priority queue (<= 8)  */
 #define OS_Q_QUERY_EN             1    /*     Include code for OSQQuery()                              */
 
 
+                                       /* ------------------------ BYTE RINGS ------------------------ */
+#define OS_RING_EN                1    /* Enable (1) or Disable (0) code generation for BYTE RINGS     */
+#define OS_MAX_RINGS              2    /*     Max. number of byte rings in your application            */
+
+
                                        /* ------------------------ SEMAPHORES ------------------------ */
 #define OS_SEM_EN                 1    /* Enable (1) or Disable (0) code generation for SEMAPHORES     */
 #define OS_SEM_ACCEPT_EN          1    /*    Include code for OSSemAccept()                            */
@@ -125,11 +160,26 @@
 #define OS_SEM_SET_EN             1    /*    Include code for OSSemSet()                               */
 
 
+                                       /* ------------------------ EVENT SETS ------------------------ */
+#define OS_SET_EN                 1    /* Enable (1) or Disable (0) code generation for EVENT SETS     */
+#define OS_MAX_SETS               2    /*     Max. number of event sets in your application            */
+#define OS_SET_SIZE              32    /*     Max. number of events in one event set (<= 64)           */
+
+
+                                       /* ------------------ PUBLISH/SUBSCRIBE TOPICS ---------------- */
+#define OS_TOPIC_EN               1    /* Enable (1) or Disable (0) code generation for TOPICS         */
+#define OS_MAX_TOPICS             2    /*     Max. number of topics in your application                */
+#define OS_TOPIC_SUBS             4    /*     Max. number of queues subscribed to one topic (<= 255)   */
+#define OS_TOPIC_REF_EN           1    /*     Reference counted messages, need OS_MEM_EN               */
+
+
                                        /* --------------------- TIME MANAGEMENT ---------------------- */
 #define OS_TIME_DLY_HMSM_EN       1    /*     Include code for OSTimeDlyHMSM()                         */
 #define OS_TIME_DLY_RESUME_EN     1    /*     Include code for OSTimeDlyResume()                       */
 #define OS_TIME_GET_SET_EN        1    /*     Include code for OSTimeGet() and OSTimeSet()             */
 #define OS_TIME_TICK_HOOK_EN      1    /*     Include code for OSTimeTickHook()                        */
+#define OS_TICKLESS_EN            1    /*     Stop the periodic tick while the idle task runs          */
+#define OS_TIME_NS_EN             1    /*     Include the pends and delays with nanosecond timeouts    */
 
 
                                        /* --------------------- TIMER MANAGEMENT --------------------- */
@@ -0,0 +1,470 @@
+/*
+*********************************************************************************************************
+*                                                uC/OS-II
+*                                          The Real-Time Kernel
+*                                     NATIVE THREAD CHANNEL MANAGEMENT
+*
+* File    : OS_CHAN.C
+* Version : V2.86
+*
+* A thread of the process that is not a task cannot post to a queue: it can neither disable the interrupts
+* of the kernel nor bracket the post with OSIntEnter() and OSIntExit().  A channel is a ring of messages
+* with one producer, the producer writes an entry and moves the index with atomic operations only.  The
+* tasks read the channel like a queue, a task that waits is readied through the tick interrupt of the
+* port when the producer writes the next message.
+*********************************************************************************************************
+*/
+
+#ifndef  OS_MASTER_FILE
+#include <ucos_ii.h>
+#endif
+
+#if (OS_CHAN_EN > 0) && (OS_MAX_CHANS > 0)
+/*
+*********************************************************************************************************
+*                                          LOCAL FUNCTION PROTOTYPES
+*********************************************************************************************************
+*/
+
+static  BOOLEAN  OS_ChanDeliver(OS_CHAN *pchan);
+static  BOOLEAN  OS_ChanGet(OS_CHAN *pchan, void **pmsg);
+
+/*$PAGE*/
+/*
+*********************************************************************************************************
+*                                     ACCEPT A MESSAGE FROM A CHANNEL
+*
+* Description: This function checks a channel for a message.  Unlike OSChanPend(), OSChanAccept() does not
+*              suspend the calling task if there is none.
+*
+* Arguments  : pchan         is a pointer to the channel.
+*
+*              perr          is a pointer to where an error message will be deposited.  Possible error
+*                            messages are:
+*
+*                            OS_ERR_NONE          The call was successful and you got a message.
+*                            OS_ERR_CHAN_EMPTY    The channel has no message.
+*                            OS_ERR_CHAN_INVALID  If 'pchan' is a NULL pointer.
+*
+* Returns    : The message, (void *)0 if there is none.  A NULL message can be told apart by '*perr'.
+*
+* Note(s)    : 1) This function can be called from an ISR.
+*********************************************************************************************************
+*/
+
+void  *OSChanAccept (OS_CHAN *pchan, INT8U *perr)
+{
+    void      *pmsg;
+#if OS_CRITICAL_METHOD == 3                           /* Allocate storage for CPU status register      */
+    OS_CPU_SR  cpu_sr = 0;
+#endif
+
+
+
+#if OS_ARG_CHK_EN > 0
+    if (perr == (INT8U *)0) {                         /* Validate 'perr'                               */
+        return ((void *)0);
+    }
+    if (pchan == (OS_CHAN *)0) {                      /* Validate 'pchan'                              */
+        *perr = OS_ERR_CHAN_INVALID;
+        return ((void *)0);
+    }
+#endif
+    OS_ENTER_CRITICAL();
+    if (OS_ChanGet(pchan, &pmsg) == OS_FALSE) {
+        OS_EXIT_CRITICAL();
+        *perr = OS_ERR_CHAN_EMPTY;
+        return ((void *)0);
+    }
+    OS_EXIT_CRITICAL();
+    *perr = OS_ERR_NONE;
+    return (pmsg);
+}
+
+/*$PAGE*/
+/*
+*********************************************************************************************************
+*                                           CREATE A CHANNEL
+*
+* Description: This function creates a channel from a thread that is not a task to the tasks.
+*
+* Arguments  : pstart        is a pointer to the storage area of the ring, an array of message pointers.
+*
+*              size          is the number of entries of the array.  One entry is always left empty, so
+*                            the ring holds up to 'size - 1' messages.
+*
+*              perr          is a pointer to an error code that will be set by this function
+*
+*                            OS_ERR_NONE              the call was successful
+*                            OS_ERR_CREATE_ISR        if you called this function from an ISR
+*                            OS_ERR_CHAN_DEPLETED     if OS_MAX_CHANS channels were created
+*                            OS_ERR_CHAN_SIZE         if 'size' is less than 2
+*                            OS_ERR_PDATA_NULL        if 'pstart' is a NULL pointer
+*
+* Returns    : != (OS_CHAN *)0  is a pointer to the channel
+*              == (OS_CHAN *)0  if the channel could not be created
+*
+* Note(s)    : 1) Only one thread may post to a channel, any number of tasks may read it.
+*              2) Channels cannot be deleted, the producer could still be about to signal the channel.
+*********************************************************************************************************
+*/
+
+OS_CHAN  *OSChanCreate (void **pstart, INT16U size, INT8U *perr)
+{
+    OS_CHAN    *pchan;
+#if OS_CRITICAL_METHOD == 3                           /* Allocate storage for CPU status register      */
+    OS_CPU_SR   cpu_sr = 0;
+#endif
+
+
+
+#if OS_ARG_CHK_EN > 0
+    if (perr == (INT8U *)0) {                         /* Validate 'perr'                               */
+        return ((OS_CHAN *)0);
+    }
+    if (pstart == (void **)0) {                       /* Validate 'pstart'                             */
+        *perr = OS_ERR_PDATA_NULL;
+        return ((OS_CHAN *)0);
+    }
+#endif
+    if (size < 2) {                                   /* One entry is always left empty                */
+        *perr = OS_ERR_CHAN_SIZE;
+        return ((OS_CHAN *)0);
+    }
+    if (OSIntNesting > 0) {                           /* See if called from ISR ...                    */
+        *perr = OS_ERR_CREATE_ISR;                    /* ... can't CREATE from an ISR                  */
+        return ((OS_CHAN *)0);
+    }
+    OS_ENTER_CRITICAL();
+    if (OSChanCtr >= OS_MAX_CHANS) {
+        OS_EXIT_CRITICAL();
+        *perr = OS_ERR_CHAN_DEPLETED;
+        return ((OS_CHAN *)0);
+    }
+    pchan                          = &OSChanTbl[OSChanCtr];
+    OSChanCtr++;
+    pchan->OSChanStart             = pstart;
+    pchan->OSChanSize              = size;
+    pchan->OSChanIn                = 0;
+    pchan->OSChanOut               = 0;
+    pchan->OSChanWaiting           = 0;
+    pchan->OSChanSig               = 0;
+    pchan->OSChanSigNext           = (OS_CHAN *)0;
+    pchan->OSChanEvent.OSEventType = OS_EVENT_TYPE_CHAN;
+    pchan->OSChanEvent.OSEventCnt  = 0;
+    pchan->OSChanEvent.OSEventPtr  = pchan;
+    OS_EventWaitListInit(&pchan->OSChanEvent);
+    OS_EXIT_CRITICAL();
+    *perr = OS_ERR_NONE;
+    return (pchan);
+}
+
+/*$PAGE*/
+/*
+*********************************************************************************************************
+*                                    PEND ON A CHANNEL FOR A MESSAGE
+*
+* Description: This function waits for a message of a channel.
+*
+* Arguments  : pchan         is a pointer to the channel.
+*
+*              timeout       is an optional timeout period (in clock ticks).  If non-zero, your task will
+*                            wait for a message up to the amount of time specified by this argument.  If you
+*                            specify 0, however, your task will wait forever.
+*
+*              perr          is a pointer to where an error message will be deposited.  Possible error
+*                            messages are:
+*
+*                            OS_ERR_NONE          The call was successful and you got a message.
+*                            OS_ERR_TIMEOUT       No message was posted within 'timeout'.
+*                            OS_ERR_CHAN_INVALID  If 'pchan' is a NULL pointer.
+*                            OS_ERR_PEND_ISR      If you called this function from an ISR.
+*                            OS_ERR_PEND_LOCKED   If you called this function when the scheduler is locked.
+*
+* Returns    : The message, (void *)0 upon error.  A NULL message can be told apart by '*perr'.
+*
+* Note(s)    : 1) A task waiting on a channel has OS_STAT_Q set in OSTCBStat.
+*              2) The task sets OSChanWaiting after it is in the wait list and checks the ring once more,
+*                 a message the producer wrote before it saw the flag is given to the task right away.
+*********************************************************************************************************
+*/
+
+void  *OSChanPend (OS_CHAN *pchan, INT16U timeout, INT8U *perr)
+{
+    void      *pmsg;
+#if OS_CRITICAL_METHOD == 3                           /* Allocate storage for CPU status register      */
+    OS_CPU_SR  cpu_sr = 0;
+#endif
+
+
+
+#if OS_ARG_CHK_EN > 0
+    if (perr == (INT8U *)0) {                         /* Validate 'perr'                               */
+        return ((void *)0);
+    }
+    if (pchan == (OS_CHAN *)0) {                      /* Validate 'pchan'                              */
+        *perr = OS_ERR_CHAN_INVALID;
+        return ((void *)0);
+    }
+#endif
+    if (OSIntNesting > 0) {                           /* See if called from ISR ...                    */
+        *perr = OS_ERR_PEND_ISR;                      /* ... can't PEND from an ISR                    */
+        return ((void *)0);
+    }
+    if (OSLockNesting > 0) {                          /* See if called with scheduler locked ...       */
+        *perr = OS_ERR_PEND_LOCKED;                   /* ... can't PEND when locked                    */
+        return ((void *)0);
+    }
+    OS_ENTER_CRITICAL();
+    if (OS_ChanGet(pchan, &pmsg) == OS_TRUE) {        /* See if a message is waiting already           */
+        OS_EXIT_CRITICAL();
+        *perr = OS_ERR_NONE;
+        return (pmsg);
+    }
+                                                      /* Otherwise, must wait until a post             */
+    OSTCBCur->OSTCBStat     |= OS_STAT_Q;
+    OSTCBCur->OSTCBStatPend  = OS_STAT_PEND_OK;
+    OS_TickListInsert(OSTCBCur, timeout);             /* Store pend timeout in TCB and tick list       */
+    OS_EventTaskWait(&pchan->OSChanEvent);            /* Suspend task until a post or timeout occurs   */
+    (void)OS_ChanDeliver(pchan);                      /* Ask the producer to signal (See Note #2)      */
+    OS_EXIT_CRITICAL();
+    OS_Sched();                                       /* Find next highest priority task ready         */
+    OS_ENTER_CRITICAL();
+    switch (OSTCBCur->OSTCBStatPend) {                /* See if we timed-out or aborted                */
+        case OS_STAT_PEND_OK:                         /* OS_ChanDeliver() handed us the message        */
+             pmsg  = OSTCBCur->OSTCBMsg;
+             *perr = OS_ERR_NONE;
+             break;
+
+        case OS_STAT_PEND_TO:
+        default:
+             OS_EventTaskRemove(OSTCBCur, &pchan->OSChanEvent);
+             pmsg  = (void *)0;
+             *perr = OS_ERR_TIMEOUT;                  /* Indicate that we didn't get event within TO   */
+             break;
+    }
+    OSTCBCur->OSTCBStat          =  OS_STAT_RDY;      /* Set   task  status to ready                   */
+    OSTCBCur->OSTCBStatPend      =  OS_STAT_PEND_OK;  /* Clear pend  status                            */
+    OSTCBCur->OSTCBEventPtr      = (OS_EVENT  *)0;    /* Clear event pointers                          */
+#if (OS_EVENT_MULTI_EN > 0)
+    OSTCBCur->OSTCBEventMultiPtr = (OS_EVENT **)0;
+#endif
+    OSTCBCur->OSTCBMsg           = (void      *)0;    /* Clear  received message                       */
+    OS_EXIT_CRITICAL();
+    return (pmsg);
+}
+
+/*$PAGE*/
+/*
+*********************************************************************************************************
+*                                       POST A MESSAGE TO A CHANNEL
+*
+* Description: This function is called by the producer of a channel, usually a thread of the process that
+*              is not a task, to append a message.  It makes no kernel call and takes no critical section.
+*
+* Arguments  : pchan         is a pointer to the channel.
+*
+*              pmsg          is the message to post.
+*
+* Returns    : OS_ERR_NONE           the message was posted
+*              OS_ERR_CHAN_FULL      the ring was full, the message was not posted
+*              OS_ERR_CHAN_INVALID   if 'pchan' is a NULL pointer
+*
+* Note(s)    : 1) Only one thread may post to a channel.  The thread must keep the tick interrupt of the port
+*                 blocked, see OSCPUIntRaise().
+*              2) The barrier between the index and OSChanWaiting pairs with the one of OS_ChanDeliver(): either
+*                 the task sees the message or the producer sees the flag.
+*              3) The tick interrupt is only raised when a task waits, a producer that stays ahead of the
+*                 tasks costs two barriers per message.
+*********************************************************************************************************
+*/
+
+INT8U  OSChanPost (OS_CHAN *pchan, void *pmsg)
+{
+    OS_CHAN  *pnext;
+    INT16U    in;
+    INT16U    next;
+
+
+#if OS_ARG_CHK_EN > 0
+    if (pchan == (OS_CHAN *)0) {                      /* Validate 'pchan'                              */
+        return (OS_ERR_CHAN_INVALID);
+    }
+#endif
+    in   = pchan->OSChanIn;
+    next = in + 1;
+    if (next == pchan->OSChanSize) {
+        next = 0;
+    }
+    if (next == pchan->OSChanOut) {                   /* See if the ring is full                       */
+        return (OS_ERR_CHAN_FULL);
+    }
+    OS_CPU_SMP_ACQUIRE();                             /* The tasks are done with the entry             */
+    pchan->OSChanStart[in] = pmsg;
+    OS_CPU_SMP_RELEASE();                             /* Write the entry before the index              */
+    pchan->OSChanIn        = next;
+    OS_CPU_SMP_BARRIER();                             /* See Note #2                                   */
+    if (pchan->OSChanWaiting == 0) {
+        return (OS_ERR_NONE);
+    }
+    if (OS_CPU_XCHG(&pchan->OSChanWaiting, 0) != 0) { /* Signal only once per wait                     */
+        if (OS_CPU_XCHG(&pchan->OSChanSig, 1) == 0) { /* Put the channel on the list once              */
+            pnext = OSChanSigList;
+            do {
+                pchan->OSChanSigNext = pnext;
+            } while (OS_CPU_CAS(&OSChanSigList, &pnext, pchan) == 0);
+        }
+        OSCPUIntRaise();                              /* The tick ISR calls OSChanSignal()             */
+    }
+    return (OS_ERR_NONE);
+}
+
+/*$PAGE*/
+/*
+*********************************************************************************************************
+*                                   READY THE TASKS OF SIGNALED CHANNELS
+*
+* Description: This function is called by the tick ISR of the port when OSCPUIntRaise() raised it.  It
+*              gives the messages of the channels on OSChanSigList to the tasks waiting on them.
+*
+* Arguments  : none
+*
+* Returns    : none
+*
+* Note(s)    : 1) The list is taken as a whole, producers only ever push on it, so the exchange needs no
+*                 protection against a channel that is taken off and pushed again.
+*              2) OSChanSig is cleared after the link is read, the producer may push the channel again right
+*                 away.
+*********************************************************************************************************
+*/
+
+void  OSChanSignal (void)
+{
+    OS_CHAN   *pchan;
+    OS_CHAN   *pnext;
+#if OS_CRITICAL_METHOD == 3                           /* Allocate storage for CPU status register      */
+    OS_CPU_SR  cpu_sr = 0;
+#endif
+
+
+
+    OS_ENTER_CRITICAL();
+    pchan = OS_CPU_XCHG(&OSChanSigList, (OS_CHAN *)0);/* See Note #1                                   */
+    while (pchan != (OS_CHAN *)0) {
+        pnext = pchan->OSChanSigNext;
+        OS_CPU_SMP_RELEASE();                         /* See Note #2                                   */
+        pchan->OSChanSig = 0;
+        (void)OS_ChanDeliver(pchan);
+        pchan = pnext;
+    }
+    OS_EXIT_CRITICAL();
+}
+
+/*$PAGE*/
+/*
+*********************************************************************************************************
+*                                  NATIVE THREAD CHANNEL INITIALIZATION
+*
+* Description : This function is called by uC/OS-II to initialize the channels.  Your application MUST NOT
+*               call this function.
+*
+* Arguments   : none
+*
+* Returns     : none
+*
+* Note(s)    : This function is INTERNAL to uC/OS-II and your application should not call it.
+*********************************************************************************************************
+*/
+
+void  OS_ChanInit (void)
+{
+    OS_MemClr((INT8U *)&OSChanTbl[0], sizeof(OSChanTbl)); /* Clear the channel table                  */
+    OSChanCtr     = 0;
+    OSChanSigList = (OS_CHAN *)0;
+}
+
+/*$PAGE*/
+/*
+*********************************************************************************************************
+*                              GIVE THE MESSAGES OF A CHANNEL TO WAITING TASKS
+*
+* Description: This function readies the tasks waiting on a channel in the order of their priority as long
+*              as the channel has messages.  If tasks are left waiting, it sets OSChanWaiting so the
+*              producer signals the next message.
+*
+* Arguments  : pchan       is a pointer to the channel.
+*
+* Returns    : OS_TRUE     if a task was readied, the caller has to reschedule.
+*              OS_FALSE    otherwise.
+*
+* Note(s)    : 1) This function is INTERNAL to uC/OS-II and your application should not call it.
+*              2) Interrupts are assumed to be disabled when this function is called.
+*              3) The ring is checked again after the flag is set, see OSChanPost().  A message posted in
+*                 between is delivered here and the producer may signal it once more, OSChanSignal() then
+*                 finds no message or no task and does nothing.
+*********************************************************************************************************
+*/
+
+static  BOOLEAN  OS_ChanDeliver (OS_CHAN *pchan)
+{
+    OS_EVENT  *pevent;
+    void      *pmsg;
+    BOOLEAN    sched;
+
+
+    sched  = OS_FALSE;
+    pevent = &pchan->OSChanEvent;
+    while (pevent->OSEventGrp != 0) {                      /* See if any task waiting for a message    */
+        if (OS_ChanGet(pchan, &pmsg) == OS_TRUE) {
+            (void)OS_EventTaskRdy(pevent, pmsg, OS_STAT_Q, OS_STAT_PEND_OK);
+            sched = OS_TRUE;
+            continue;
+        }
+        pchan->OSChanWaiting = 1;                          /* Ask the producer to signal ...           */
+        OS_CPU_SMP_BARRIER();
+        if (pchan->OSChanIn == pchan->OSChanOut) {         /* ... unless a message came in (Note #3)   */
+            break;
+        }
+    }
+    return (sched);
+}
+
+/*$PAGE*/
+/*
+*********************************************************************************************************
+*                                     TAKE A MESSAGE FROM A CHANNEL
+*
+* Description: This function removes the oldest message of a channel.
+*
+* Arguments  : pchan       is a pointer to the channel.
+*
+*              pmsg        is a pointer to where the message will be deposited.
+*
+* Returns    : OS_TRUE     if a message was taken.
+*              OS_FALSE    if the channel is empty.
+*
+* Note(s)    : 1) This function is INTERNAL to uC/OS-II and your application should not call it.
+*              2) Interrupts are assumed to be disabled when this function is called.
+*********************************************************************************************************
+*/
+
+static  BOOLEAN  OS_ChanGet (OS_CHAN *pchan, void **pmsg)
+{
+    INT16U  out;
+
+
+    out = pchan->OSChanOut;
+    if (out == pchan->OSChanIn) {
+        return (OS_FALSE);
+    }
+    OS_CPU_SMP_ACQUIRE();                                  /* Read the entry after the index           */
+    *pmsg = pchan->OSChanStart[out];
+    out++;
+    if (out == pchan->OSChanSize) {
+        out = 0;
+    }
+    OS_CPU_SMP_RELEASE();                                  /* Read the entry before it is handed back  */
+    pchan->OSChanOut = out;
+    return (OS_TRUE);
+}
+#endif                                                      /* OS_CHAN_EN                               */
@@ -76,8 +76,30 @@ static  void  OS_InitTaskStat(void);
 
 static  void  OS_InitTCBList(void);
 
+#if (OS_TASK_STAT_STK_CHK_EN > 0) && (OS_TASK_CREATE_EXT_EN > 0)
+static  INT32U  OS_TaskStkScan(OS_STK *pbos, INT32U size, INT32U nfree);
+#endif
+
 static  void  OS_SchedNew(void);
 
+#if OS_SCHED_RR_EN > 0
+static  void  OS_SchedRoundRobin(INT32U ticks);
+
+#if (OS_EVENT_EN)
+static  BOOLEAN  OS_EventTaskPending(OS_TCB *ptcb, OS_EVENT *pevent);
+
+static  BOOLEAN  OS_EventTaskPendingOther(OS_TCB *ptcb, OS_EVENT *pevent);
+#endif
+#endif
+
+static  void  OS_TickListAdvance(INT32U ticks);
+
+static  void  OS_TickListExpire(OS_TCB *ptcb);
+
+#if OS_TIME_NS_EN > 0
+static  void  OS_DlyNsListInsert(OS_TCB *ptcb);
+#endif
+
 /*$PAGE*/
 /*
 *********************************************************************************************************
@@ -138,6 +160,7 @@ INT8U  OSEventNameGet (OS_EVENT *pevent, INT8U *pname, INT8U *perr)
         case OS_EVENT_TYPE_MUTEX:
         case OS_EVENT_TYPE_MBOX:
         case OS_EVENT_TYPE_Q:
+        case OS_EVENT_TYPE_RING:
              break;
 
         default:
@@ -212,6 +235,7 @@ void  OSEventNameSet (OS_EVENT *pevent, INT8U *pname, INT8U *perr)
         case OS_EVENT_TYPE_MUTEX:
         case OS_EVENT_TYPE_MBOX:
         case OS_EVENT_TYPE_Q:
+        case OS_EVENT_TYPE_RING:
              break;
 
         default:
@@ -421,11 +445,18 @@ INT16U  OSEventPendMulti (OS_EVENT **pevents_pend, OS_EVENT **pevents_rdy, void
                  pq = (OS_Q *)pevent->OSEventPtr;
                  if (pq->OSQEntries > 0) {              /* If queue NOT empty;                     ... */
                                                         /* ... return available message,           ... */
-                    *pmsgs_rdy++ = (void *)*pq->OSQOut++;
-                     if (pq->OSQOut == pq->OSQEnd) {    /* If OUT ptr at queue end, ...                */
-                         pq->OSQOut  = pq->OSQStart;    /* ... wrap   to queue start                   */
+#if OS_Q_PRIO_EN > 0
+                     if (pq->OSQPrio == OS_TRUE) {      /* ... the most urgent of a priority queue     */
+                        *pmsgs_rdy++ = OS_QPrioGet(pq);
+                     } else
+#endif
+                     {
+                        *pmsgs_rdy++ = (void *)*pq->OSQOut++;
+                         if (pq->OSQOut == pq->OSQEnd) {/* If OUT ptr at queue end, ...                */
+                             pq->OSQOut  = pq->OSQStart;/* ... wrap   to queue start                   */
+                         }
+                         pq->OSQEntries--;              /* Update number of queue entries              */
                      }
-                     pq->OSQEntries--;                  /* Update number of queue entries              */
                     *pevents_rdy++ = pevent;            /* ... and return available queue event        */
                       events_rdy   = OS_TRUE;
                       events_rdy_nbr++;
@@ -459,7 +490,7 @@ INT16U  OSEventPendMulti (OS_EVENT **pevents_pend, OS_EVENT **pevents_rdy, void
     OSTCBCur->OSTCBStat     |= events_stat  |           /* Resource not available, ...                 */
                                OS_STAT_MULTI;           /* ... pend on multiple events                 */
     OSTCBCur->OSTCBStatPend  = OS_STAT_PEND_OK;
-    OSTCBCur->OSTCBDly       = timeout;                 /* Store pend timeout in TCB                   */
+    OS_TickListInsert(OSTCBCur, timeout);                /* Store pend timeout in TCB and tick list     */
     OS_EventTaskWaitMulti(pevents_pend);                /* Suspend task until events or timeout occurs */
 
     OS_EXIT_CRITICAL();
@@ -538,6 +569,71 @@ INT16U  OSEventPendMulti (OS_EVENT **pevents_pend, OS_EVENT **pevents_rdy, void
 }
 #endif
 
+/*$PAGE*/
+/*
+*********************************************************************************************************
+*                                   GET THE STATISTICS OF AN EVENT
+*
+* Description: This function copies the pend and post statistics of a semaphore, a mutex, a mailbox or a
+*              queue (see OS_EVENT_PROF).
+*
+* Arguments  : pevent    is a pointer to the event control block of the semaphore, mutex, mailbox or queue.
+*
+*              p_prof    is a pointer to where the statistics are copied.
+*
+*              opt       determines what is done with the statistics:
+*                        OS_PROF_OPT_NONE    They are only read.
+*                        OS_PROF_OPT_CLR     They are cleared after they are read, so the next call
+*                                            returns the statistics of the period between the calls.
+*
+* Returns    : OS_ERR_NONE          The statistics were copied.
+*              OS_ERR_PEVENT_NULL   If 'pevent' is a NULL pointer.
+*              OS_ERR_PDATA_NULL    If 'p_prof' is a NULL pointer.
+*              OS_ERR_EVENT_TYPE    If 'pevent' is not a semaphore, mutex, mailbox or queue.
+*              OS_ERR_INVALID_OPT   If you specified an invalid option.
+*********************************************************************************************************
+*/
+
+#if (OS_EVENT_EN) && (OS_EVENT_PROF_EN > 0)
+INT8U  OSEventProfGet (OS_EVENT *pevent, OS_EVENT_PROF *p_prof, INT8U opt)
+{
+#if OS_CRITICAL_METHOD == 3                                /* Allocate storage for CPU status register     */
+    OS_CPU_SR  cpu_sr = 0;
+#endif
+
+
+
+#if OS_ARG_CHK_EN > 0
+    if (pevent == (OS_EVENT *)0) {                         /* Validate 'pevent'                            */
+        return (OS_ERR_PEVENT_NULL);
+    }
+    if (p_prof == (OS_EVENT_PROF *)0) {                    /* Validate 'p_prof'                            */
+        return (OS_ERR_PDATA_NULL);
+    }
+#endif
+    switch (pevent->OSEventType) {
+        case OS_EVENT_TYPE_SEM:
+        case OS_EVENT_TYPE_MUTEX:
+        case OS_EVENT_TYPE_MBOX:
+        case OS_EVENT_TYPE_Q:
+             break;
+
+        default:
+             return (OS_ERR_EVENT_TYPE);
+    }
+    if (opt > OS_PROF_OPT_CLR) {
+        return (OS_ERR_INVALID_OPT);
+    }
+    OS_ENTER_CRITICAL();
+    OS_MemCopy((INT8U *)p_prof, (INT8U *)&pevent->OSEventProf, sizeof(OS_EVENT_PROF));
+    if (opt == OS_PROF_OPT_CLR) {
+        OS_MemClr((INT8U *)&pevent->OSEventProf, sizeof(OS_EVENT_PROF));
+    }
+    OS_EXIT_CRITICAL();
+    return (OS_ERR_NONE);
+}
+#endif
+
 /*$PAGE*/
 /*
 *********************************************************************************************************
@@ -566,6 +662,10 @@ void  OSInit (void)
 
     OS_InitEventList();                                          /* Initialize the free list of OS_EVENTs    */
 
+#if (OS_CHAN_EN > 0) && (OS_MAX_CHANS > 0)
+    OS_ChanInit();                                               /* Initialize the native thread channels    */
+#endif
+
 #if (OS_FLAG_EN > 0) && (OS_MAX_FLAGS > 0)
     OS_FlagInit();                                               /* Initialize the event flag structures     */
 #endif
@@ -578,6 +678,22 @@ void  OSInit (void)
     OS_QInit();                                                  /* Initialize the message queue structures  */
 #endif
 
+#if (OS_RING_EN > 0) && (OS_MAX_RINGS > 0)
+    OS_RingInit();                                               /* Initialize the byte ring structures      */
+#endif
+
+#if (OS_SET_EN > 0) && (OS_MAX_SETS > 0)
+    OS_SetInit();                                                /* Initialize the event set structures      */
+#endif
+
+#if (OS_TOPIC_EN > 0) && (OS_MAX_TOPICS > 0)
+    OS_TopicInit();                                              /* Initialize the topic structures          */
+#endif
+
+#if OS_STAT_EN > 0
+    OS_StatInit();                                               /* Initialize the load statistics           */
+#endif
+
     OS_InitTaskIdle();                                           /* Create the Idle Task                     */
 #if OS_TASK_STAT_EN > 0
     OS_InitTaskStat();                                           /* Create the Statistic Task                */
@@ -587,6 +703,10 @@ void  OSInit (void)
     OSTmr_Init();                                                /* Initialize the Timer Manager             */
 #endif
 
+#if (OS_INT_Q_EN > 0) && (OS_MAX_INT_QS > 0)
+    OS_IntQInit();                                               /* Initialize the ISR deferred posts        */
+#endif
+
     OSInitHookEnd();                                             /* Call port specific init. code            */
 
 #if OS_DEBUG_EN > 0
@@ -624,6 +744,11 @@ void  OSIntEnter (void)
     if (OSRunning == OS_TRUE) {
         if (OSIntNesting < 255u) {
             OSIntNesting++;                      /* Increment ISR nesting level                        */
+#if OS_STAT_EN > 0
+            if (OSIntNesting == 1) {
+                OSStatIntStart = OSCPUTsGet();   /* Stamp the start of the outermost ISR               */
+            }
+#endif
         }
     }
 }
@@ -659,12 +784,26 @@ void  OSIntExit (void)
         OS_ENTER_CRITICAL();
         if (OSIntNesting > 0) {                            /* Prevent OSIntNesting from wrapping       */
             OSIntNesting--;
+#if OS_STAT_EN > 0
+            if (OSIntNesting == 0) {
+                OS_StatIntExit();                          /* Account the time of the outermost ISR    */
+            }
+#endif
         }
         if (OSIntNesting == 0) {                           /* Reschedule only if all ISRs complete ... */
+#if (OS_INT_Q_EN > 0) && (OS_MAX_INT_QS > 0)
+            if (OSIntQPend == OS_TRUE) {                   /* Ready the task of the deferred posts     */
+                OS_IntQSignal();
+            }
+#endif
             if (OSLockNesting == 0) {                      /* ... and not locked.                      */
                 OS_SchedNew();
+                OSTCBHighRdy  = OSTCBPrioTbl[OSPrioHighRdy];
+#if OS_SCHED_RR_EN > 0
+                if (OSTCBHighRdy != OSTCBCur) {            /* No Ctx Sw if current task is highest rdy */
+#else                                                      /* ... (or its turn at the priority)        */
                 if (OSPrioHighRdy != OSPrioCur) {          /* No Ctx Sw if current task is highest rdy */
-                    OSTCBHighRdy  = OSTCBPrioTbl[OSPrioHighRdy];
+#endif
 #if OS_TASK_PROFILE_EN > 0
                     OSTCBHighRdy->OSTCBCtxSwCtr++;         /* Inc. # of context switches to this task  */
 #endif
@@ -809,6 +948,9 @@ void  OSStart (void)
 * Arguments  : none
 *
 * Returns    : none
+*
+* Notes      : 1) With OS_STAT_EN the load is computed from the run time of the tasks, the idle counter is
+*                 not calibrated and this function only releases the statistic task without delay.
 *********************************************************************************************************
 */
 
@@ -821,6 +963,12 @@ void  OSStatInit (void)
 
 
 
+#if OS_STAT_EN > 0
+    OS_ENTER_CRITICAL();
+    OSIdleCtrMax = 0L;                           /* The load comes from the run times, see OS_STAT.C   */
+    OSStatRdy    = OS_TRUE;
+    OS_EXIT_CRITICAL();
+#else
     OSTimeDly(2);                                /* Synchronize with clock tick                        */
     OS_ENTER_CRITICAL();
     OSIdleCtr    = 0L;                           /* Clear idle counter                                 */
@@ -830,6 +978,7 @@ void  OSStatInit (void)
     OSIdleCtrMax = OSIdleCtr;                    /* Store maximum idle counter count in 1/10 second    */
     OSStatRdy    = OS_TRUE;
     OS_EXIT_CRITICAL();
+#endif
 }
 #endif
 /*$PAGE*/
@@ -849,7 +998,6 @@ void  OSStatInit (void)
 
 void  OSTimeTick (void)
 {
-    OS_TCB    *ptcb;
 #if OS_TICK_STEP_EN > 0
     BOOLEAN    step;
 #endif
@@ -863,7 +1011,7 @@ void  OSTimeTick (void)
     OSTimeTickHook();                                      /* Call user definable hook                     */
 #endif
 #if OS_TIME_GET_SET_EN > 0
-    OS_ENTER_CRITICAL();                                   /* Update the 32-bit tick counter               */
+    OS_ENTER_CRITICAL();                                   /* Update the 64-bit tick counter               */
     OSTime++;
     OS_EXIT_CRITICAL();
 #endif
@@ -892,30 +1040,157 @@ void  OSTimeTick (void)
             return;
         }
 #endif
-        ptcb = OSTCBList;                                  /* Point at first TCB in TCB list               */
-        while (ptcb->OSTCBPrio != OS_TASK_IDLE_PRIO) {     /* Go through all TCBs in TCB list              */
-            OS_ENTER_CRITICAL();
-            if (ptcb->OSTCBDly != 0) {                     /* No, Delayed or waiting for event with TO     */
-                if (--ptcb->OSTCBDly == 0) {               /* Decrement nbr of ticks to end of delay       */
-                                                           /* Check for timeout                            */
-                    if ((ptcb->OSTCBStat & OS_STAT_PEND_ANY) != OS_STAT_RDY) {
-                        ptcb->OSTCBStat  &= ~(INT8U)OS_STAT_PEND_ANY;          /* Yes, Clear status flag   */
-                        ptcb->OSTCBStatPend = OS_STAT_PEND_TO;                 /* Indicate PEND timeout    */
-                    } else {
-                        ptcb->OSTCBStatPend = OS_STAT_PEND_OK;
-                    }
-
-                    if ((ptcb->OSTCBStat & OS_STAT_SUSPEND) == OS_STAT_RDY) {  /* Is task suspended?       */
-                        OSRdyGrp               |= ptcb->OSTCBBitY;             /* No,  Make ready          */
-                        OSRdyTbl[ptcb->OSTCBY] |= ptcb->OSTCBBitX;
-                    }
-                }
-            }
-            ptcb = ptcb->OSTCBNext;                        /* Point at next TCB in TCB list                */
-            OS_EXIT_CRITICAL();
+        OS_TickListAdvance(1);                             /* Ready the tasks whose delay ended            */
+#if OS_SCHED_RR_EN > 0
+        OS_SchedRoundRobin(1);                             /* Charge the tick to the running task's quantum*/
+#endif
+    }
+}
+
+/*$PAGE*/
+/*
+*********************************************************************************************************
+*                                     PROCESS SEVERAL SYSTEM TICKS
+*
+* Description: This function is used by a tickless port to signal that 'ticks' system ticks elapsed while
+*              the periodic tick was stopped.  It has the same effect as calling OSTimeTick() 'ticks' times
+*              but the tick list is only advanced once.
+*
+* Arguments  : ticks     is the number of ticks that elapsed.
+*
+* Returns    : none
+*********************************************************************************************************
+*/
+
+#if OS_TICKLESS_EN > 0
+void  OSTimeTickN (INT32U ticks)
+{
+#if OS_TIME_TICK_HOOK_EN > 0
+    INT32U     i;
+#endif
+#if OS_CRITICAL_METHOD == 3                                /* Allocate storage for CPU status register     */
+    OS_CPU_SR  cpu_sr = 0;
+#endif
+
+
+
+    if (ticks == 0) {
+        return;
+    }
+#if OS_TICK_STEP_EN > 0
+    if (OSTickStepState != OS_TICK_STEP_DIS) {             /* Let OSTimeTick() handle tick stepping        */
+        while (ticks-- > 0) {
+            OSTimeTick();
+        }
+        return;
+    }
+#endif
+#if OS_TIME_TICK_HOOK_EN > 0
+    for (i = 0; i < ticks; i++) {
+        OSTimeTickHook();                                  /* Call user definable hook for every tick      */
+    }
+#endif
+#if OS_TIME_GET_SET_EN > 0
+    OS_ENTER_CRITICAL();                                   /* Update the 64-bit tick counter               */
+    OSTime += ticks;
+    OS_EXIT_CRITICAL();
+#endif
+    if (OSRunning == OS_TRUE) {
+        OS_TickListAdvance(ticks);                         /* Ready the tasks whose delay ended            */
+#if OS_SCHED_RR_EN > 0
+        OS_SchedRoundRobin(ticks);                         /* Charge the ticks to the running task         */
+#endif
+    }
+}
+#endif
+
+/*$PAGE*/
+/*
+*********************************************************************************************************
+*                                  PROCESS THE NANOSECOND DELAYS
+*
+* Description: This function is called by the port when its one-shot timer, programmed with
+*              OSCPUTimerSet(), expires.  The tasks of OSDlyNsList whose delay or pend timeout ended are
+*              made ready and the timer is programmed for the next one.
+*
+* Arguments  : none
+*
+* Returns    : none
+*
+* Note(s)    : 1) The timer may expire for a task that is not in the list anymore (see
+*                 OS_TickListRemove()), it is then only programmed again.
+*********************************************************************************************************
+*/
+
+#if OS_TIME_NS_EN > 0
+void  OSTimeTickNs (void)
+{
+    OS_TCB    *ptcb;
+    INT64U     ts;
+#if OS_CRITICAL_METHOD == 3                                /* Allocate storage for CPU status register     */
+    OS_CPU_SR  cpu_sr = 0;
+#endif
+
+
+
+    if (OSRunning == OS_FALSE) {
+        return;
+    }
+    OS_ENTER_CRITICAL();
+    ts   = OSCPUTsGet();
+    ptcb = OSDlyNsList;
+    while (ptcb != (OS_TCB *)0) {                          /* The list is sorted, stop at the first ...    */
+        if (ptcb->OSTCBDlyNsMatch > ts) {                  /* ... TCB whose delay did not end yet          */
+            break;
         }
+        OS_TickListExpire(ptcb);
+        OS_EXIT_CRITICAL();                                /* Give interrupts a chance between tasks       */
+        OS_ENTER_CRITICAL();
+        ptcb = OSDlyNsList;
+    }
+    if (ptcb != (OS_TCB *)0) {                             /* Program the timer for the next one, or stop  */
+        OSCPUTimerSet(ptcb->OSTCBDlyNsMatch);
+    } else {
+        OSCPUTimerSet(0);
+    }
+    OS_EXIT_CRITICAL();
+}
+#endif
+
+/*$PAGE*/
+/*
+*********************************************************************************************************
+*                                   GET THE TICKS TO THE NEXT DEADLINE
+*
+* Description: This function is called by a tickless port, from the idle task, to find out how many ticks
+*              can pass before a delayed task or a pend timeout needs the tick.
+*
+* Arguments  : none
+*
+* Returns    : the number of ticks until the first delay or timeout ends, or 0 if no task is waiting for
+*              the tick.
+*
+* Note(s)    : 1) This function is INTERNAL to uC/OS-II and your application should not call it.
+*              2) Interrupts are assumed to be disabled when this function is called.
+*********************************************************************************************************
+*/
+
+#if OS_TICKLESS_EN > 0
+INT32U  OSTimeTickNextGet (void)
+{
+    INT32S  ticks;
+
+
+    if (OSTickList == (OS_TCB *)0) {                       /* No task is waiting for the tick              */
+        return (0);
+    }
+    ticks = (INT32S)(OSTickList->OSTCBTickMatch - OSTickCtr);  /* The head of the tick list ends first    */
+    if (ticks < 1) {
+        ticks = 1;
     }
+    return ((INT32U)ticks);
 }
+#endif
 
 /*$PAGE*/
 /*
@@ -959,44 +1234,195 @@ void  OS_Dummy (void)
 /*$PAGE*/
 /*
 *********************************************************************************************************
-*                             MAKE TASK READY TO RUN BASED ON EVENT OCCURING
+*                                 INSERT A TASK IN THE NANOSECOND LIST
 *
-* Description: This function is called by other uC/OS-II services and is used to ready a task that was
-*              waiting for an event to occur.
+* Description: This function is called by OS_TickListInsert() for a TCB whose delay or pend timeout was
+*              set with OS_DlyNsSet().  The TCB is inserted in OSDlyNsList after the TCBs whose delay ends at
+*              the same time or earlier, using the links of the tick list.  The one-shot timer of the port
+*              is programmed when the TCB becomes the head of the list.
 *
-* Arguments  : pevent      is a pointer to the event control block corresponding to the event.
+* Arguments  : ptcb      is a pointer to the TCB of the task, the task must not be in a delay list.
 *
-*              pmsg        is a pointer to a message.  This pointer is used by message oriented services
-*                          such as MAILBOXEs and QUEUEs.  The pointer is not used when called by other
-*                          service functions.
+* Returns    : none
 *
-*              msk         is a mask that is used to clear the status byte of the TCB.  For example,
-*                          OSSemPost() will pass OS_STAT_SEM, OSMboxPost() will pass OS_STAT_MBOX etc.
+* Note(s)    : 1) OSTCBDly is set to 1 so that the services that check for a delay (OSTimeDlyResume(),
+*                 OS_TickListRemove() ...) see the task as delayed.
+*              2) Interrupts are assumed to be disabled when this function is called.
+*********************************************************************************************************
+*/
+
+#if OS_TIME_NS_EN > 0
+static  void  OS_DlyNsListInsert (OS_TCB *ptcb)
+{
+    OS_TCB  *pprev;
+    OS_TCB  *pnext;
+    INT64U   match;
+
+
+    ptcb->OSTCBDly = 1;                                    /* See Note #1                                  */
+    match          = ptcb->OSTCBDlyNsMatch;
+    pprev          = (OS_TCB *)0;
+    pnext          = OSDlyNsList;
+    while (pnext != (OS_TCB *)0) {                         /* Find the first TCB whose delay ends later    */
+        if (pnext->OSTCBDlyNsMatch > match) {
+            break;
+        }
+        pprev = pnext;
+        pnext = pnext->OSTCBTickNext;
+    }
+    ptcb->OSTCBTickPrev = pprev;                           /* Link between 'pprev' and 'pnext'             */
+    ptcb->OSTCBTickNext = pnext;
+    if (pnext != (OS_TCB *)0) {
+        pnext->OSTCBTickPrev = ptcb;
+    }
+    if (pprev != (OS_TCB *)0) {
+        pprev->OSTCBTickNext = ptcb;
+    } else {
+        OSDlyNsList = ptcb;                                /* New head, ends first                         */
+        OSCPUTimerSet(match);
+    }
+}
+
+/*$PAGE*/
+/*
+*********************************************************************************************************
+*                                 SET THE NANOSECOND DELAY OF THE TASK
 *
-*              pend_stat   is used to indicate the readied task's pending status:
+* Description: This function is called by OSTimeDlyNs() and the pends with a nanosecond timeout (see
+*              OSSemPendNs()).  The next delay or pend timeout of the current task ends 'ns' nanoseconds
+*              from now, OS_TickListInsert() puts it in OSDlyNsList instead of the tick list whatever the
+*              number of ticks it is given.
 *
-*                          OS_STAT_PEND_OK      Task ready due to a post (or delete), not a timeout or
-*                                               an abort.
-*                          OS_STAT_PEND_ABORT   Task ready due to an abort.
+* Arguments  : ns        is the delay in nanoseconds.  0 ends the setting, the next delays of the task are
+*                        in ticks again.
+*
+* Returns    : none
+*
+* Note(s)    : This function is INTERNAL to uC/OS-II and your application should not call it.
+*********************************************************************************************************
+*/
+
+void  OS_DlyNsSet (INT64U ns)
+{
+#if OS_CRITICAL_METHOD == 3                                /* Allocate storage for CPU status register     */
+    OS_CPU_SR  cpu_sr = 0;
+#endif
+
+
+
+    OS_ENTER_CRITICAL();
+    if (ns == 0) {
+        OSTCBCur->OSTCBDlyNs      = OS_FALSE;
+    } else {
+        OSTCBCur->OSTCBDlyNsMatch = OSCPUTsGet() + OS_TIME_NS_TO_TS(ns);
+        OSTCBCur->OSTCBDlyNs      = OS_TRUE;
+    }
+    OS_EXIT_CRITICAL();
+}
+#endif
+
+/*$PAGE*/
+/*
+*********************************************************************************************************
+*                                  ACCOUNT A PEND THAT BLOCKED THE TASK
+*
+* Description: This function is called by the pends of the semaphores, mutexes, mailboxes, queues and event
+*              flag groups when the current task runs again after it blocked.  The blocked time and, when
+*              the task was made ready by a post, the time from the post until now are added to the
+*              statistics of the object.
+*
+* Arguments  : pprof     is a pointer to the statistics of the object.
 *
 * Returns    : none
 *
+* Note(s)    : 1) This function is INTERNAL to uC/OS-II and your application should not call it.
+*              2) Interrupts are assumed to be disabled when this function is called, before OSTCBStatPend
+*                 of the task is cleared.
+*********************************************************************************************************
+*/
+
+#if OS_EVENT_PROF_EN > 0
+static  INT8U  OS_EventProfBin (INT64U t)
+{
+    INT8U  bin;
+
+
+    bin = 0;
+    while ((t > 1) && (bin < (OS_EVENT_PROF_BINS - 1))) {  /* Bucket of 2^bin <= t < 2^(bin + 1)          */
+        t >>= 1;
+        bin++;
+    }
+    return (bin);
+}
+
+
+void  OS_EventProfWake (OS_EVENT_PROF *pprof)
+{
+    INT64U  ts;
+    INT64U  blocked;
+    INT64U  wake;
+
+
+    ts = OSCPUTsGet();
+    pprof->OSPendBlockCtr++;
+    if (OSTCBCur->OSTCBStatPend == OS_STAT_PEND_OK) {      /* Made ready by a post                         */
+        blocked = OSTCBCur->OSTCBRdyTs - OSTCBCur->OSTCBPendTs;
+        wake    = ts - OSTCBCur->OSTCBRdyTs;
+        pprof->OSWakeHist[OS_EventProfBin(wake)]++;
+        if (wake > 0xFFFFFFFFL) {                          /* Saturate the maximum                         */
+            wake = 0xFFFFFFFFL;
+        }
+        if ((INT32U)wake > pprof->OSWakeMax) {
+            pprof->OSWakeMax = (INT32U)wake;
+        }
+    } else {                                               /* Timeout or abort, blocked until now          */
+        blocked = ts - OSTCBCur->OSTCBPendTs;
+        if (OSTCBCur->OSTCBStatPend == OS_STAT_PEND_TO) {
+            pprof->OSPendTOCtr++;
+        }
+    }
+    pprof->OSBlockHist[OS_EventProfBin(blocked)]++;
+    if (blocked > 0xFFFFFFFFL) {                           /* Saturate the maximum                         */
+        blocked = 0xFFFFFFFFL;
+    }
+    if ((INT32U)blocked > pprof->OSBlockMax) {
+        pprof->OSBlockMax = (INT32U)blocked;
+    }
+}
+#endif
+
+/*$PAGE*/
+/*
+*********************************************************************************************************
+*                               FIND THE HIGHEST PRIORITY TASK WAITING ON AN EVENT
+*
+* Description: This function returns the task OS_EventTaskRdy() readies next.  It is used by services that
+*              have to look at the request of the task before they ready it.
+*
+* Arguments  : pevent      is a pointer to the event control block, at least one task must be waiting on it.
+*
+* Returns    : A pointer to the OS_TCB of the highest priority task waiting on the event.
+*
 * Note       : This function is INTERNAL to uC/OS-II and your application should not call it.
 *********************************************************************************************************
 */
 #if (OS_EVENT_EN)
-INT8U  OS_EventTaskRdy (OS_EVENT *pevent, void *pmsg, INT8U msk, INT8U pend_stat)
+OS_TCB  *OS_EventTaskHighest (OS_EVENT *pevent)
 {
     OS_TCB  *ptcb;
     INT8U    y;
     INT8U    x;
     INT8U    prio;
-#if OS_LOWEST_PRIO > 63
+#if (OS_SCHED_CTZ_EN == 0) && (OS_LOWEST_PRIO > 63)
     INT16U  *ptbl;
 #endif
 
 
-#if OS_LOWEST_PRIO <= 63
+#if OS_SCHED_CTZ_EN > 0
+    y    = (INT8U)OS_CPU_CTZ(pevent->OSEventGrp);       /* Find HPT waiting for message                */
+    x    = (INT8U)OS_CPU_CTZ(pevent->OSEventTbl[y]);
+    prio = (INT8U)((y << 6) + x);                       /* Find priority of task getting the msg       */
+#elif OS_LOWEST_PRIO <= 63
     y    = OSUnMapTbl[pevent->OSEventGrp];              /* Find HPT waiting for message                */
     x    = OSUnMapTbl[pevent->OSEventTbl[y]];
     prio = (INT8U)((y << 3) + x);                       /* Find priority of task getting the msg       */
@@ -1015,19 +1441,72 @@ INT8U  OS_EventTaskRdy (OS_EVENT *pevent, void *pmsg, INT8U msk, INT8U pend_stat
     prio = (INT8U)((y << 4) + x);                       /* Find priority of task getting the msg       */
 #endif
 
-    ptcb                  =  OSTCBPrioTbl[prio];        /* Point to this task's OS_TCB                 */
-    ptcb->OSTCBDly        =  0;                         /* Prevent OSTimeTick() from readying task     */
-#if ((OS_Q_EN > 0) && (OS_MAX_QS > 0)) || (OS_MBOX_EN > 0)
-    ptcb->OSTCBMsg        =  pmsg;                      /* Send message directly to waiting task       */
+    ptcb = OSTCBPrioTbl[prio];                          /* Point to this task's OS_TCB                 */
+#if OS_SCHED_RR_EN > 0
+    while (OS_EventTaskPending(ptcb, pevent) == OS_FALSE) {  /* Find the task of the priority waiting  */
+        ptcb = ptcb->OSTCBRRNext;
+    }
+#endif
+    return (ptcb);
+}
+#endif
+/*$PAGE*/
+/*
+*********************************************************************************************************
+*                             MAKE TASK READY TO RUN BASED ON EVENT OCCURING
+*
+* Description: This function is called by other uC/OS-II services and is used to ready a task that was
+*              waiting for an event to occur.
+*
+* Arguments  : pevent      is a pointer to the event control block corresponding to the event.
+*
+*              pmsg        is a pointer to a message.  This pointer is used by message oriented services
+*                          such as MAILBOXEs and QUEUEs.  The pointer is not used when called by other
+*                          service functions.
+*
+*              msk         is a mask that is used to clear the status byte of the TCB.  For example,
+*                          OSSemPost() will pass OS_STAT_SEM, OSMboxPost() will pass OS_STAT_MBOX etc.
+*
+*              pend_stat   is used to indicate the readied task's pending status:
+*
+*                          OS_STAT_PEND_OK      Task ready due to a post (or delete), not a timeout or
+*                                               an abort.
+*                          OS_STAT_PEND_ABORT   Task ready due to an abort.
+*
+* Returns    : none
+*
+* Note       : This function is INTERNAL to uC/OS-II and your application should not call it.
+*********************************************************************************************************
+*/
+#if (OS_EVENT_EN)
+INT8U  OS_EventTaskRdy (OS_EVENT *pevent, void *pmsg, INT8U msk, INT8U pend_stat)
+{
+    OS_TCB  *ptcb;
+    INT8U    prio;
+
+
+    ptcb                  =  OS_EventTaskHighest(pevent);  /* Find HPT waiting for message             */
+    prio                  =  ptcb->OSTCBPrio;           /* Find priority of task getting the msg       */
+    OS_TickListRemove(ptcb);                            /* Prevent OSTimeTick() from readying task     */
+#if ((OS_Q_EN > 0) && (OS_MAX_QS > 0)) || (OS_MBOX_EN > 0) || ((OS_RING_EN > 0) && (OS_MAX_RINGS > 0)) || \
+    ((OS_CHAN_EN > 0) && (OS_MAX_CHANS > 0))
+    ptcb->OSTCBMsg        =  pmsg;                      /* Send message directly to waiting task       */
 #else
     pmsg                  =  pmsg;                      /* Prevent compiler warning if not used        */
 #endif
     ptcb->OSTCBStat      &= ~msk;                       /* Clear bit associated with event type        */
+#if (OS_EVENT_MULTI_EN > 0)
+    if (ptcb->OSTCBEventMultiPtr != (OS_EVENT **)0) {   /* No longer pending on the other events       */
+        ptcb->OSTCBStat  &= ~(INT8U)(OS_STAT_PEND_ANY | OS_STAT_MULTI);
+    }
+#endif
     ptcb->OSTCBStatPend   =  pend_stat;                 /* Set pend status of post or abort            */
+#if OS_EVENT_PROF_EN > 0
+    ptcb->OSTCBRdyTs      =  OSCPUTsGet();              /* Start of the wakeup time                    */
+#endif
                                                         /* See if task is ready (could be susp'd)      */
     if ((ptcb->OSTCBStat &   OS_STAT_SUSPEND) == OS_STAT_RDY) {
-        OSRdyGrp         |=  ptcb->OSTCBBitY;           /* Put task in the ready to run list           */
-        OSRdyTbl[y]      |=  ptcb->OSTCBBitX;
+        OS_RdyListInsert(ptcb);                         /* Put task in the ready to run list           */
     }
 
     OS_EventTaskRemove(ptcb, pevent);                   /* Remove this task from event   wait list     */
@@ -1059,19 +1538,15 @@ INT8U  OS_EventTaskRdy (OS_EVENT *pevent, void *pmsg, INT8U msk, INT8U pend_stat
 #if (OS_EVENT_EN)
 void  OS_EventTaskWait (OS_EVENT *pevent)
 {
-    INT8U  y;
-
-
     OSTCBCur->OSTCBEventPtr               = pevent;                 /* Store ptr to ECB in TCB         */
+#if OS_EVENT_PROF_EN > 0
+    OSTCBCur->OSTCBPendTs                 = OSCPUTsGet();           /* Start of the blocked time       */
+#endif
 
     pevent->OSEventTbl[OSTCBCur->OSTCBY] |= OSTCBCur->OSTCBBitX;    /* Put task in waiting list        */
     pevent->OSEventGrp                   |= OSTCBCur->OSTCBBitY;
 
-    y             =  OSTCBCur->OSTCBY;            /* Task no longer ready                              */
-    OSRdyTbl[y]  &= ~OSTCBCur->OSTCBBitX;
-    if (OSRdyTbl[y] == 0) {
-        OSRdyGrp &= ~OSTCBCur->OSTCBBitY;         /* Clear event grp bit if this was only task pending */
-    }
+    OS_RdyListRemove(OSTCBCur);                                     /* Task no longer ready            */
 }
 #endif
 /*$PAGE*/
@@ -1095,7 +1570,6 @@ void  OS_EventTaskWaitMulti (OS_EVENT **pevents_wait)
 {
     OS_EVENT **pevents;
     OS_EVENT  *pevent;
-    INT8U      y;
 
 
     OSTCBCur->OSTCBEventPtr      = (OS_EVENT  *)0;
@@ -1110,11 +1584,7 @@ void  OS_EventTaskWaitMulti (OS_EVENT **pevents_wait)
         pevent = *pevents;
     }
 
-    y             =  OSTCBCur->OSTCBY;            /* Task no longer ready                              */
-    OSRdyTbl[y]  &= ~OSTCBCur->OSTCBBitX;
-    if (OSRdyTbl[y] == 0) {
-        OSRdyGrp &= ~OSTCBCur->OSTCBBitY;         /* Clear event grp bit if this was only task pending */
-    }
+    OS_RdyListRemove(OSTCBCur);                                     /* Task no longer ready            */
 }
 #endif
 /*$PAGE*/
@@ -1140,6 +1610,11 @@ void  OS_EventTaskRemove (OS_TCB   *ptcb,
     INT8U  y;
 
 
+#if OS_SCHED_RR_EN > 0
+    if (OS_EventTaskPendingOther(ptcb, pevent) == OS_TRUE) {  /* Bit still needed for another task ... */
+        return;                                         /* ... of the same priority                    */
+    }
+#endif
     y                       =  ptcb->OSTCBY;
     pevent->OSEventTbl[y]  &= ~ptcb->OSTCBBitX;         /* Remove task from wait list                  */
     if (pevent->OSEventTbl[y] == 0) {
@@ -1170,13 +1645,8 @@ void  OS_EventTaskRemoveMulti (OS_TCB    *ptcb,
     OS_EVENT **pevents;
     OS_EVENT  *pevent;
     INT8U      y;
-#if (OS_LOWEST_PRIO <= 63)
-    INT8U      bity;
-    INT8U      bitx;
-#else
-    INT16U     bity;
-    INT16U     bitx;
-#endif
+    OS_PRIO_GRP bity;
+    OS_PRIO_TBL bitx;
 
 
     y       =  ptcb->OSTCBY;
@@ -1185,10 +1655,16 @@ void  OS_EventTaskRemoveMulti (OS_TCB    *ptcb,
     pevents =  pevents_multi;
     pevent  = *pevents;
     while (pevent != (OS_EVENT *)0) {                   /* Remove task from all events' wait lists     */
-        pevent->OSEventTbl[y]  &= ~bitx;
-        if (pevent->OSEventTbl[y] == 0) {
-            pevent->OSEventGrp &= ~bity;
+#if OS_SCHED_RR_EN > 0
+        if (OS_EventTaskPendingOther(ptcb, pevent) == OS_FALSE) {
+#endif
+            pevent->OSEventTbl[y]  &= ~bitx;
+            if (pevent->OSEventTbl[y] == 0) {
+                pevent->OSEventGrp &= ~bity;
+            }
+#if OS_SCHED_RR_EN > 0
         }
+#endif
         pevents++;
         pevent = *pevents;
     }
@@ -1197,6 +1673,71 @@ void  OS_EventTaskRemoveMulti (OS_TCB    *ptcb,
 /*$PAGE*/
 /*
 *********************************************************************************************************
+*                             SEE IF A TASK IS PENDING ON AN EVENT (ROUND-ROBIN)
+*
+* Description: With OS_SCHED_RR_EN several tasks share the bit of a priority in the wait list of an event.
+*              These functions find out which task of the priority the bit stands for.
+*
+* Arguments  : ptcb     is a pointer to the task (OS_EventTaskPending()) or to the task to leave out
+*                       (OS_EventTaskPendingOther()).
+*
+*              pevent   is a pointer to the event control block.
+*
+* Returns    : OS_TRUE  if the task (or another task of its priority) is pending on the event.
+*              OS_FALSE otherwise.
+*
+* Note       : These functions are INTERNAL to uC/OS-II and your application should not call them.
+*********************************************************************************************************
+*/
+#if (OS_SCHED_RR_EN > 0) && (OS_EVENT_EN)
+static  BOOLEAN  OS_EventTaskPending (OS_TCB   *ptcb,
+                                      OS_EVENT *pevent)
+{
+#if (OS_EVENT_MULTI_EN > 0)
+    OS_EVENT **pevents;
+#endif
+
+
+    if ((ptcb->OSTCBStat & OS_STAT_PEND_ANY) == OS_STAT_RDY) {     /* Not pending at all              */
+        return (OS_FALSE);
+    }
+    if (ptcb->OSTCBEventPtr == pevent) {
+        return (OS_TRUE);
+    }
+#if (OS_EVENT_MULTI_EN > 0)
+    pevents = ptcb->OSTCBEventMultiPtr;
+    if ((ptcb->OSTCBEventPtr == (OS_EVENT *)0) && (pevents != (OS_EVENT **)0)) {
+        while (*pevents != (OS_EVENT *)0) {                         /* Look for event in the list      */
+            if (*pevents == pevent) {
+                return (OS_TRUE);
+            }
+            pevents++;
+        }
+    }
+#endif
+    return (OS_FALSE);
+}
+
+
+static  BOOLEAN  OS_EventTaskPendingOther (OS_TCB   *ptcb,
+                                           OS_EVENT *pevent)
+{
+    OS_TCB  *pother;
+
+
+    pother = ptcb->OSTCBRRNext;
+    while (pother != ptcb) {                                        /* Other tasks of the priority     */
+        if (OS_EventTaskPending(pother, pevent) == OS_TRUE) {
+            return (OS_TRUE);
+        }
+        pother = pother->OSTCBRRNext;
+    }
+    return (OS_FALSE);
+}
+#endif
+/*$PAGE*/
+/*
+*********************************************************************************************************
 *                                 INITIALIZE EVENT CONTROL BLOCK'S WAIT LIST
 *
 * Description: This function is called by other uC/OS-II services to initialize the event wait list.
@@ -1211,11 +1752,7 @@ void  OS_EventTaskRemoveMulti (OS_TCB    *ptcb,
 #if (OS_EVENT_EN)
 void  OS_EventWaitListInit (OS_EVENT *pevent)
 {
-#if OS_LOWEST_PRIO <= 63
-    INT8U  *ptbl;
-#else
-    INT16U *ptbl;
-#endif
+    OS_PRIO_TBL *ptbl;
     INT8U   i;
 
 
@@ -1298,7 +1835,7 @@ static  void  OS_InitEventList (void)
 static  void  OS_InitMisc (void)
 {
 #if OS_TIME_GET_SET_EN > 0
-    OSTime        = 0L;                                    /* Clear the 32-bit system clock            */
+    OSTime        = 0L;                                    /* Clear the 64-bit system clock            */
 #endif
 
     OSIntNesting  = 0;                                     /* Clear the interrupt nesting counter      */
@@ -1309,6 +1846,11 @@ static  void  OS_InitMisc (void)
     OSRunning     = OS_FALSE;                              /* Indicate that multitasking not started   */
 
     OSCtxSwCtr    = 0;                                     /* Clear the context switch counter         */
+    OSTickList    = (OS_TCB *)0;                           /* No task is delayed                       */
+    OSTickCtr     = 0L;
+#if OS_TIME_NS_EN > 0
+    OSDlyNsList   = (OS_TCB *)0;
+#endif
     OSIdleCtr     = 0L;                                    /* Clear the 32-bit idle counter            */
 
 #if OS_TASK_STAT_EN > 0
@@ -1316,6 +1858,15 @@ static  void  OS_InitMisc (void)
     OSIdleCtrMax  = 0L;
     OSStatRdy     = OS_FALSE;                              /* Statistic task is not ready              */
 #endif
+
+#if (OS_TASK_STAT_STK_CHK_EN > 0) && (OS_TASK_CREATE_EXT_EN > 0)
+    OSTaskStatStkTCB  = (OS_TCB *)0;                       /* Start the stack checks at OSTCBList      */
+#endif
+
+#if OS_SLAB_EN > 0
+    OSSlabPageCtr     = 0L;
+    OSSlabBytes       = 0L;
+#endif
 }
 /*$PAGE*/
 /*
@@ -1334,11 +1885,7 @@ static  void  OS_InitMisc (void)
 static  void  OS_InitRdyList (void)
 {
     INT8U    i;
-#if OS_LOWEST_PRIO <= 63
-    INT8U   *prdytbl;
-#else
-    INT16U  *prdytbl;
-#endif
+    OS_PRIO_TBL *prdytbl;
 
 
     OSRdyGrp      = 0;                                     /* Clear the ready list                     */
@@ -1542,21 +2089,53 @@ static  void  OS_InitTCBList (void)
 * Returns    : none
 *
 * Notes      : 1) This function is INTERNAL to uC/OS-II and your application should not call it.
-*              2) Note that we can only clear up to 64K bytes of RAM.  This is not an issue because none
-*                 of the uses of this function gets close to this limit.
-*              3) The clear is done one byte at a time since this will work on any processor irrespective
-*                 of the alignment of the destination.
+*              2) When the port defines OS_CPU_MEM_CLR() the clear is done by the port (e.g. with SIMD
+*                 instructions).  Otherwise the bytes up to a word boundary of the destination are cleared one
+*                 at a time, then whole OS_CPU_WORDs, four per loop, and the remaining bytes one at a time.
 *********************************************************************************************************
 */
 
-void  OS_MemClr (INT8U *pdest, INT16U size)
+void  OS_MemClr (INT8U *pdest, INT32U size)
 {
-    while (size > 0) {
+#ifdef OS_CPU_MEM_CLR
+    OS_CPU_MEM_CLR(pdest, size);
+#else
+    OS_CPU_WORD  *pword;
+
+
+    while ((size > 0) && (((OS_CPU_WORD)pdest & (sizeof(OS_CPU_WORD) - 1)) != 0)) {
+        *pdest++ = (INT8U)0;                               /* Clear up to a word boundary              */
+        size--;
+    }
+    pword = (OS_CPU_WORD *)pdest;
+    while (size >= 4 * sizeof(OS_CPU_WORD)) {              /* Clear four words at a time               */
+        pword[0] = (OS_CPU_WORD)0;
+        pword[1] = (OS_CPU_WORD)0;
+        pword[2] = (OS_CPU_WORD)0;
+        pword[3] = (OS_CPU_WORD)0;
+        pword   += 4;
+        size    -= 4 * sizeof(OS_CPU_WORD);
+    }
+    while (size >= sizeof(OS_CPU_WORD)) {
+        *pword++ = (OS_CPU_WORD)0;
+        size    -= sizeof(OS_CPU_WORD);
+    }
+    pdest = (INT8U *)pword;
+    while (size > 0) {                                     /* Clear the remaining bytes                */
         *pdest++ = (INT8U)0;
         size--;
     }
+#endif
 }
 /*$PAGE*/
+#ifndef OS_CPU_MEM_COPY                                    /* Word of a source misaligned by shift     */
+#if OS_CPU_BIG_ENDIAN > 0
+#define  OS_MEM_WORD_MERGE(lo, hi, shift, shift_next)  (((lo) << (shift)) | ((hi) >> (shift_next)))
+#else
+#define  OS_MEM_WORD_MERGE(lo, hi, shift, shift_next)  (((lo) >> (shift)) | ((hi) << (shift_next)))
+#endif
+#endif
+
 /*
 *********************************************************************************************************
 *                                        COPY A BLOCK OF MEMORY
@@ -1575,22 +2154,206 @@ void  OS_MemClr (INT8U *pdest, INT16U size)
 * Notes      : 1) This function is INTERNAL to uC/OS-II and your application should not call it.  There is
 *                 no provision to handle overlapping memory copy.  However, that's not a problem since this
 *                 is not a situation that will happen.
-*              2) Note that we can only copy up to 64K bytes of RAM
-*              3) The copy is done one byte at a time since this will work on any processor irrespective
-*                 of the alignment of the source and destination.
+*              2) When the port defines OS_CPU_MEM_COPY() the copy is done by the port.  Otherwise the bytes
+*                 up to a word boundary of the destination are copied one at a time, then whole OS_CPU_WORDs
+*                 and the remaining bytes one at a time.  A source aligned like the destination is copied
+*                 four words per loop.  Otherwise each word is built from the two aligned source words it
+*                 straddles, shifted by the misalignment in the byte order of OS_CPU_BIG_ENDIAN.  The aligned
+*                 loads may read the bytes next to the source in the same word, never across a word.
 *********************************************************************************************************
 */
 
-void  OS_MemCopy (INT8U *pdest, INT8U *psrc, INT16U size)
+void  OS_MemCopy (INT8U *pdest, INT8U *psrc, INT32U size)
 {
-    while (size > 0) {
+#ifdef OS_CPU_MEM_COPY
+    OS_CPU_MEM_COPY(pdest, psrc, size);
+#else
+    OS_CPU_WORD  *pword_dest;
+    OS_CPU_WORD  *pword_src;
+    OS_CPU_WORD   word_lo;
+    OS_CPU_WORD   word_hi;
+    INT32U        shift;
+    INT32U        shift_next;
+
+
+    while ((size > 0) && (((OS_CPU_WORD)pdest & (sizeof(OS_CPU_WORD) - 1)) != 0)) {
+        *pdest++ = *psrc++;                                /* Copy up to a word boundary               */
+        size--;
+    }
+    pword_dest = (OS_CPU_WORD *)pdest;
+    shift      = (INT32U)((OS_CPU_WORD)psrc & (sizeof(OS_CPU_WORD) - 1)) * 8;
+    if (shift == 0) {                                      /* Source is aligned as well                */
+        pword_src  = (OS_CPU_WORD *)psrc;
+        while (size >= 4 * sizeof(OS_CPU_WORD)) {          /* Copy four words at a time                */
+            pword_dest[0] = pword_src[0];
+            pword_dest[1] = pword_src[1];
+            pword_dest[2] = pword_src[2];
+            pword_dest[3] = pword_src[3];
+            pword_dest   += 4;
+            pword_src    += 4;
+            size         -= 4 * sizeof(OS_CPU_WORD);
+        }
+        while (size >= sizeof(OS_CPU_WORD)) {
+            *pword_dest++ = *pword_src++;
+            size         -= sizeof(OS_CPU_WORD);
+        }
+        pdest = (INT8U *)pword_dest;
+        psrc  = (INT8U *)pword_src;
+    } else if (size >= sizeof(OS_CPU_WORD)) {              /* Merge two aligned source words per word  */
+        shift_next = 8 * sizeof(OS_CPU_WORD) - shift;
+        pword_src  = (OS_CPU_WORD *)(psrc - shift / 8);
+        word_lo    = *pword_src++;
+        while (size >= 4 * sizeof(OS_CPU_WORD)) {          /* Merge four words at a time               */
+            word_hi       = pword_src[0];
+            pword_dest[0] = OS_MEM_WORD_MERGE(word_lo, word_hi, shift, shift_next);
+            word_lo       = pword_src[1];
+            pword_dest[1] = OS_MEM_WORD_MERGE(word_hi, word_lo, shift, shift_next);
+            word_hi       = pword_src[2];
+            pword_dest[2] = OS_MEM_WORD_MERGE(word_lo, word_hi, shift, shift_next);
+            word_lo       = pword_src[3];
+            pword_dest[3] = OS_MEM_WORD_MERGE(word_hi, word_lo, shift, shift_next);
+            pword_dest   += 4;
+            pword_src    += 4;
+            psrc         += 4 * sizeof(OS_CPU_WORD);
+            size         -= 4 * sizeof(OS_CPU_WORD);
+        }
+        while (size >= sizeof(OS_CPU_WORD)) {
+            word_hi       = *pword_src++;
+            *pword_dest++ = OS_MEM_WORD_MERGE(word_lo, word_hi, shift, shift_next);
+            word_lo       = word_hi;
+            psrc         += sizeof(OS_CPU_WORD);
+            size         -= sizeof(OS_CPU_WORD);
+        }
+        pdest = (INT8U *)pword_dest;
+    }
+    while (size > 0) {                                     /* Copy the remaining bytes                 */
         *pdest++ = *psrc++;
         size--;
     }
+#endif
 }
 /*$PAGE*/
 /*
 *********************************************************************************************************
+*                                 LINK A TASK TO THE TASKS OF ITS PRIORITY
+*
+* Description: With OS_SCHED_RR_EN the tasks sharing a priority are kept in a circular list.  The entry of
+*              the priority in OSTCBPrioTbl[] points to the 'current' task of the list, which is the task
+*              that runs when the priority is the highest ready.  OS_PrioRingInsert() links a task in front
+*              of the current task, so it gets its turn last, and OS_PrioRingRemove() unlinks it.
+*
+* Arguments  : ptcb      is a pointer to the TCB of the task, OSTCBPrio must be set.
+*
+* Returns    : none
+*
+* Note(s)    : 1) These functions are INTERNAL to uC/OS-II and your application should not call them.
+*              2) Interrupts are assumed to be disabled when these functions are called.
+*              3) The ready list is not changed.  A task is inserted before OS_RdyListInsert() and removed
+*                 after OS_RdyListRemove().
+*********************************************************************************************************
+*/
+
+#if OS_SCHED_RR_EN > 0
+void  OS_PrioRingInsert (OS_TCB *ptcb)
+{
+    OS_TCB  *pcur;
+
+
+    pcur = OSTCBPrioTbl[ptcb->OSTCBPrio];
+    if ((pcur == (OS_TCB *)0) || (pcur == OS_TCB_RESERVED)) {  /* First task of the priority           */
+        ptcb->OSTCBRRNext             = ptcb;
+        ptcb->OSTCBRRPrev             = ptcb;
+        OSTCBPrioTbl[ptcb->OSTCBPrio] = ptcb;
+    } else {                                               /* Link in front of the current task        */
+        ptcb->OSTCBRRNext             = pcur;
+        ptcb->OSTCBRRPrev             = pcur->OSTCBRRPrev;
+        pcur->OSTCBRRPrev->OSTCBRRNext = ptcb;
+        pcur->OSTCBRRPrev             = ptcb;
+    }
+}
+
+
+void  OS_PrioRingRemove (OS_TCB *ptcb)
+{
+    if (OSTCBPrioTbl[ptcb->OSTCBPrio] == ptcb) {           /* Current task leaves the priority         */
+        if (ptcb->OSTCBRRNext == ptcb) {
+            OSTCBPrioTbl[ptcb->OSTCBPrio] = (OS_TCB *)0;   /* ... it was the last one                  */
+        } else {
+            OSTCBPrioTbl[ptcb->OSTCBPrio] = ptcb->OSTCBRRNext;
+        }
+    }
+    ptcb->OSTCBRRPrev->OSTCBRRNext = ptcb->OSTCBRRNext;
+    ptcb->OSTCBRRNext->OSTCBRRPrev = ptcb->OSTCBRRPrev;
+    ptcb->OSTCBRRNext              = ptcb;
+    ptcb->OSTCBRRPrev              = ptcb;
+}
+#endif
+/*$PAGE*/
+/*
+*********************************************************************************************************
+*                                  MAKE A TASK READY OR NOT READY TO RUN
+*
+* Description: With OS_SCHED_RR_EN the bit of a priority in the ready list is set as long as one task of
+*              the priority is ready, and the current task of the priority (see OS_PrioRingInsert()) is then
+*              always a ready one.  When the current task stops being ready the next ready task of the
+*              priority takes its turn with a full time quantum.
+*
+*              Without OS_SCHED_RR_EN these functions are macros that set or clear the bit of the task.
+*
+* Arguments  : ptcb      is a pointer to the TCB of the task.
+*
+* Returns    : none
+*
+* Note(s)    : 1) These functions are INTERNAL to uC/OS-II and your application should not call them.
+*              2) Interrupts are assumed to be disabled when these functions are called.
+*********************************************************************************************************
+*/
+
+#if OS_SCHED_RR_EN > 0
+void  OS_RdyListInsert (OS_TCB *ptcb)
+{
+    OS_TCB  *pcur;
+
+
+    ptcb->OSTCBRRRdy = OS_TRUE;
+    pcur             = OSTCBPrioTbl[ptcb->OSTCBPrio];
+    if ((pcur != ptcb) && (pcur->OSTCBRRRdy == OS_FALSE)) {    /* No other task of the prio. is ready  */
+        OSTCBPrioTbl[ptcb->OSTCBPrio] = ptcb;              /* ... so this one has the turn             */
+        ptcb->OSTCBRRCtr              = ptcb->OSTCBRRQuanta;
+    }
+    OSRdyGrp               |= ptcb->OSTCBBitY;
+    OSRdyTbl[ptcb->OSTCBY] |= ptcb->OSTCBBitX;
+}
+
+
+void  OS_RdyListRemove (OS_TCB *ptcb)
+{
+    OS_TCB  *pnext;
+
+
+    ptcb->OSTCBRRRdy = OS_FALSE;
+    pnext            = OSTCBPrioTbl[ptcb->OSTCBPrio];
+    if (pnext == ptcb) {                                   /* Task had the turn, pass it on to ...     */
+        pnext = ptcb->OSTCBRRNext;
+        while ((pnext != ptcb) && (pnext->OSTCBRRRdy == OS_FALSE)) {
+            pnext = pnext->OSTCBRRNext;                    /* ... the next ready task of the priority  */
+        }
+        if (pnext != ptcb) {
+            OSTCBPrioTbl[ptcb->OSTCBPrio] = pnext;
+            pnext->OSTCBRRCtr             = pnext->OSTCBRRQuanta;
+            return;
+        }
+    } else if (pnext->OSTCBRRRdy == OS_TRUE) {             /* Task with the turn is still ready        */
+        return;
+    }
+    if ((OSRdyTbl[ptcb->OSTCBY] &= ~ptcb->OSTCBBitX) == 0) {   /* No task of the priority is ready     */
+        OSRdyGrp &= ~ptcb->OSTCBBitY;
+    }
+}
+#endif
+/*$PAGE*/
+/*
+*********************************************************************************************************
 *                                              SCHEDULER
 *
 * Description: This function is called by other uC/OS-II services to determine whether a new, high
@@ -1618,8 +2381,12 @@ void  OS_Sched (void)
     if (OSIntNesting == 0) {                           /* Schedule only if all ISRs done and ...       */
         if (OSLockNesting == 0) {                      /* ... scheduler is not locked                  */
             OS_SchedNew();
+            OSTCBHighRdy = OSTCBPrioTbl[OSPrioHighRdy];
+#if OS_SCHED_RR_EN > 0
+            if (OSTCBHighRdy != OSTCBCur) {            /* No Ctx Sw if current task is highest rdy     */
+#else                                                  /* ... (or its turn at the priority)            */
             if (OSPrioHighRdy != OSPrioCur) {          /* No Ctx Sw if current task is highest rdy     */
-                OSTCBHighRdy = OSTCBPrioTbl[OSPrioHighRdy];
+#endif
 #if OS_TASK_PROFILE_EN > 0
                 OSTCBHighRdy->OSTCBCtxSwCtr++;         /* Inc. # of context switches to this task      */
 #endif
@@ -1650,7 +2417,13 @@ void  OS_Sched (void)
 
 static  void  OS_SchedNew (void)
 {
-#if OS_LOWEST_PRIO <= 63                         /* See if we support up to 64 tasks                   */
+#if OS_SCHED_CTZ_EN > 0                          /* Ready list in 64-bit words, up to 256 tasks        */
+    INT8U   y;
+
+
+    y             = (INT8U)OS_CPU_CTZ(OSRdyGrp);
+    OSPrioHighRdy = (INT8U)((y << 6) + OS_CPU_CTZ(OSRdyTbl[y]));
+#elif OS_LOWEST_PRIO <= 63                       /* See if we support up to 64 tasks                   */
     INT8U   y;
 
 
@@ -1675,6 +2448,64 @@ static  void  OS_SchedNew (void)
 #endif
 }
 
+/*$PAGE*/
+/*
+*********************************************************************************************************
+*                                     ROUND-ROBIN TIME SLICING
+*
+* Description: This function is called by OSTimeTick() and OSTimeTickN() to charge the elapsed ticks to the
+*              time quantum of the running task.  When the quantum is used up the turn passes to the next
+*              ready task of the same priority and the switch happens in OSIntExit().  While the scheduler
+*              is locked the turn is not passed on, so the running task is always the one OSTCBPrioTbl[]
+*              points to.
+*
+* Arguments  : ticks     is the number of ticks that elapsed.
+*
+* Returns    : none
+*********************************************************************************************************
+*/
+
+#if OS_SCHED_RR_EN > 0
+static  void  OS_SchedRoundRobin (INT32U ticks)
+{
+    OS_TCB    *ptcb;
+    OS_TCB    *pnext;
+#if OS_CRITICAL_METHOD == 3                                /* Allocate storage for CPU status register     */
+    OS_CPU_SR  cpu_sr = 0;
+#endif
+
+
+
+    OS_ENTER_CRITICAL();
+    ptcb = OSTCBCur;
+    if ((ptcb->OSTCBRRNext == ptcb) ||                     /* Alone at its priority, or ...                */
+        (ptcb->OSTCBRRRdy  == OS_FALSE)) {                 /* ... about to give up the CPU anyway          */
+        OS_EXIT_CRITICAL();
+        return;
+    }
+    if (ptcb->OSTCBRRCtr > ticks) {
+        ptcb->OSTCBRRCtr -= (INT16U)ticks;
+        OS_EXIT_CRITICAL();
+        return;
+    }
+    ptcb->OSTCBRRCtr = 0;
+    if (OSLockNesting > 0) {                               /* Keep the turn until the first tick after ... */
+        OS_EXIT_CRITICAL();                                /* ... OSSchedUnlock(), the running task stays  */
+        return;                                            /* ... the current one of its priority          */
+    }
+    ptcb->OSTCBRRCtr = ptcb->OSTCBRRQuanta;                /* Quantum used up, full one for next turn      */
+    pnext            = ptcb->OSTCBRRNext;
+    while ((pnext != ptcb) && (pnext->OSTCBRRRdy == OS_FALSE)) {
+        pnext = pnext->OSTCBRRNext;                        /* Find the next ready task of the priority     */
+    }
+    if (pnext != ptcb) {
+        OSTCBPrioTbl[ptcb->OSTCBPrio] = pnext;             /* Give it the turn                             */
+        pnext->OSTCBRRCtr             = pnext->OSTCBRRQuanta;
+    }
+    OS_EXIT_CRITICAL();
+}
+#endif
+
 /*$PAGE*/
 /*
 *********************************************************************************************************
@@ -1801,6 +2632,8 @@ void  OS_TaskIdle (void *p_arg)
 *              2) You can disable this task by setting the configuration #define OS_TASK_STAT_EN to 0.
 *              3) You MUST have at least a delay of 2/10 seconds to allow for the system to establish the
 *                 maximum value for the idle counter.
+*              4) When the idle counter can not be calibrated because OSTaskIdleHook() sleeps, OSCPUUsage
+*                 is computed from the run time of the idle task if OS_TASK_PROFILE_EN is set.
 *********************************************************************************************************
 */
 
@@ -1818,19 +2651,32 @@ void  OS_TaskStat (void *p_arg)
         OSTimeDly(2 * OS_TICKS_PER_SEC / 10);    /* Wait until statistic task is ready                 */
     }
     OSIdleCtrMax /= 100L;
+#if OS_TASK_PROFILE_EN == 0
     if (OSIdleCtrMax == 0L) {
         OSCPUUsage = 0;
         (void)OSTaskSuspend(OS_PRIO_SELF);
     }
+#endif
     for (;;) {
         OS_ENTER_CRITICAL();
         OSIdleCtrRun = OSIdleCtr;                /* Obtain the of the idle counter for the past second */
         OSIdleCtr    = 0L;                       /* Reset the idle counter for the next second         */
         OS_EXIT_CRITICAL();
-        OSCPUUsage   = (INT8U)(100L - OSIdleCtrRun / OSIdleCtrMax);
+        if (OSIdleCtrMax > 0L) {
+            OSCPUUsage = (INT8U)(100L - OSIdleCtrRun / OSIdleCtrMax);
+        }
         OSTaskStatHook();                        /* Invoke user definable hook                         */
 #if (OS_TASK_STAT_STK_CHK_EN > 0) && (OS_TASK_CREATE_EXT_EN > 0)
         OS_TaskStatStkChk();                     /* Check the stacks for each task                     */
+#endif
+#if OS_STAT_EN > 0
+        OS_StatUpdate();                         /* Compute the load over the period                   */
+#endif
+#if OS_TASK_PROFILE_EN > 0
+        OS_TaskStatProf();                       /* Compute the task profiles over the window          */
+        if (OSIdleCtrMax == 0L) {                /* Idle hook sleeps, use the run time of the idle task*/
+            OSCPUUsage = (INT8U)(100 - OSTCBPrioTbl[OS_TASK_IDLE_PRIO]->OSTCBCPUUsage / 100);
+        }
 #endif
         OSTimeDly(OS_TICKS_PER_SEC / 10);        /* Accumulate OSIdleCtr for the next 1/10 second      */
     }
@@ -1841,46 +2687,279 @@ void  OS_TaskStat (void *p_arg)
 *********************************************************************************************************
 *                                      CHECK ALL TASK STACKS
 *
-* Description: This function is called by OS_TaskStat() to check the stacks of each active task.
+* Description: This function is called by OS_TaskStat() to check the stacks of the tasks.  The guard
+*              entries of all the stacks are checked every period.  The stacks themselves are scanned
+*              incrementally, see OS_TaskStkScan(), and at most OS_TASK_STAT_STK_CHK_NBR of them per period
+*              so the time the statistic task runs does not grow with the number and the size of the stacks.
 *
 * Arguments  : none
 *
 * Returns    : none
+*
+* Note(s)    : 1) The tasks are visited in the order of OSTCBList from OSTaskStatStkTCB, which OSTaskDel()
+*                 moves past a deleted task.  The tasks sharing a priority with OS_SCHED_RR_EN are all
+*                 visited, not only the one whose turn it is.
+*              2) OSTaskStkOvfHook() is called once for a task whose guard entries were overwritten,
+*                 OSTCBStkOvf remembers it.  A stack used down to the guard entries has no free entry left,
+*                 its guard entries are still checked every period.
 *********************************************************************************************************
 */
 
 #if (OS_TASK_STAT_STK_CHK_EN > 0) && (OS_TASK_CREATE_EXT_EN > 0)
 void  OS_TaskStatStkChk (void)
 {
-    OS_TCB      *ptcb;
-    OS_STK_DATA  stk_data;
-    INT8U        err;
-    INT8U        prio;
-
-
-    for (prio = 0; prio <= OS_TASK_IDLE_PRIO; prio++) {
-        err = OSTaskStkChk(prio, &stk_data);
-        if (err == OS_ERR_NONE) {
-            ptcb = OSTCBPrioTbl[prio];
-            if (ptcb != (OS_TCB *)0) {                               /* Make sure task 'ptcb' is ...   */
-                if (ptcb != OS_TCB_RESERVED) {                       /* ... still valid.               */
-#if OS_TASK_PROFILE_EN > 0
-                    #if OS_STK_GROWTH == 1
-                    ptcb->OSTCBStkBase = ptcb->OSTCBStkBottom + ptcb->OSTCBStkSize;
-                    #else
-                    ptcb->OSTCBStkBase = ptcb->OSTCBStkBottom - ptcb->OSTCBStkSize;
-                    #endif
-                    ptcb->OSTCBStkUsed = stk_data.OSUsed;            /* Store the number of bytes used */
+    OS_TCB    *ptcb;
+    OS_STK    *pbos;
+    INT32U     size;
+    INT32U     nfree;
+    INT8U      nbr;
+    INT16U     i;
+#if OS_TASK_STK_CANARY_EN > 0
+    INT32U     j;
 #endif
+#if OS_CRITICAL_METHOD == 3                      /* Allocate storage for CPU status register           */
+    OS_CPU_SR  cpu_sr = 0;
+#endif
+
+
+
+#if OS_TASK_STK_CANARY_EN > 0
+    OS_ENTER_CRITICAL();
+    ptcb = OSTCBList;
+    while (ptcb != (OS_TCB *)0) {                /* Check the guard entries of every stack             */
+        if (((ptcb->OSTCBOpt & OS_TASK_OPT_STK_CHK) != 0) && (ptcb->OSTCBStkOvf == OS_FALSE)) {
+            for (j = 0; j < OS_TASK_STK_GUARD(ptcb->OSTCBStkSize); j++) {
+#if OS_STK_GROWTH == 1
+                if (ptcb->OSTCBStkBottom[j] != OS_TASK_STK_CANARY) {
+#else
+                if (*(ptcb->OSTCBStkBottom - j) != OS_TASK_STK_CANARY) {
+#endif
+                    ptcb->OSTCBStkOvf  = OS_TRUE;/* The stack overflowed, report it only once          */
+                    OSTaskStkOvfHook(ptcb);
+                    break;
                 }
             }
         }
+        ptcb = ptcb->OSTCBNext;
+    }
+    OS_EXIT_CRITICAL();
+#endif
+    nbr = 0;
+    for (i = 0; (i < OSTaskCtr) && (nbr < OS_TASK_STAT_STK_CHK_NBR); i++) {
+        OS_ENTER_CRITICAL();
+        ptcb = OSTaskStatStkTCB;
+        if (ptcb == (OS_TCB *)0) {               /* Past the idle task, start over at the list head    */
+            ptcb             = OSTCBList;
+            OSTaskStatStkTCB = ptcb;
+        }
+        if ((ptcb->OSTCBOpt & OS_TASK_OPT_STK_CHK) != 0) {
+            pbos  = ptcb->OSTCBStkBottom;
+            size  = ptcb->OSTCBStkSize;
+            nfree = ptcb->OSTCBStkFree;
+            OS_EXIT_CRITICAL();
+            nfree = OS_TaskStkScan(pbos, size, nfree);   /* Scan from the high-water mark          */
+            OS_ENTER_CRITICAL();
+            if (OSTaskStatStkTCB == ptcb) {              /* Task was not deleted during the scan   */
+                if (nfree < ptcb->OSTCBStkFree) {
+                    ptcb->OSTCBStkFree = nfree;
+                }
+#if OS_TASK_PROFILE_EN > 0
+                #if OS_STK_GROWTH == 1
+                ptcb->OSTCBStkBase = ptcb->OSTCBStkBottom + ptcb->OSTCBStkSize;
+                #else
+                ptcb->OSTCBStkBase = ptcb->OSTCBStkBottom - ptcb->OSTCBStkSize;
+                #endif
+                ptcb->OSTCBStkUsed = (size - ptcb->OSTCBStkFree) * sizeof(OS_STK);  /* Bytes used */
+#endif
+            }
+            nbr++;
+        }
+        if (OSTaskStatStkTCB == ptcb) {          /* Otherwise OSTaskDel() already moved the cursor     */
+            OSTaskStatStkTCB = ptcb->OSTCBNext;
+        }
+        OS_EXIT_CRITICAL();
     }
 }
 #endif
 /*$PAGE*/
 /*
 *********************************************************************************************************
+*                                     SCAN A TASK STACK INCREMENTALLY
+*
+* Description: This function is called by OS_TaskStatStkChk() to find the high-water mark of a stack.  The
+*              stack only grows into the free (zero) entries, so instead of counting them from the end of
+*              the stack like OSTaskStkChk() does, the scan starts at the last high-water mark and walks
+*              towards the end of the stack until it finds OS_TASK_STK_CHK_RUN free entries in a row.
+*
+* Arguments  : pbos        is a pointer to the bottom of the stack (the end it grows towards).
+*
+*              size        is the number of entries of the stack.
+*
+*              nfree       is the number of free entries found by the last scan.
+*
+* Returns    : The number of free entries, not counting the guard entries.
+*
+* Note(s)    : 1) The time of a scan depends on how much the stack grew since the last one, not on its size.
+*              2) A block of OS_TASK_STK_CHK_RUN or more zero entries that the task never overwrote ends the
+*                 scan early.  OSTaskStkChk() still counts all the free entries exactly.
+*********************************************************************************************************
+*/
+
+#if (OS_TASK_STAT_STK_CHK_EN > 0) && (OS_TASK_CREATE_EXT_EN > 0)
+static  INT32U  OS_TaskStkScan (OS_STK *pbos, INT32U size, INT32U nfree)
+{
+    INT32U  guard;
+    INT32U  low;
+    INT32U  ix;
+    INT32U  run;
+
+
+    guard = OS_TASK_STK_GUARD(size);
+    low   = guard + nfree;                       /* Lowest entry known to be used                      */
+    ix    = low;
+    run   = 0;
+    while ((ix > guard) && (run < OS_TASK_STK_CHK_RUN)) {
+        ix--;
+#if OS_STK_GROWTH == 1
+        if (pbos[ix] != (OS_STK)0) {
+#else
+        if (*(pbos - ix) != (OS_STK)0) {
+#endif
+            low = ix;
+            run = 0;
+        } else {
+            run++;
+        }
+    }
+    return (low - guard);
+}
+#endif
+/*$PAGE*/
+/*
+*********************************************************************************************************
+*                                        COMPUTE TASK PROFILES
+*
+* Description: This function is called by OS_TaskStat() to compute the CPU share, the context switch rate
+*              and the longest run of each task over the last OS_TASK_PROFILE_WIN statistic task periods.
+*              The run time of the tasks is accumulated by OSTaskSwHook() at every context switch.
+*
+* Arguments  : none
+*
+* Returns    : none
+*
+* Note(s)    : 1) Every TCB keeps the values it had at the window boundaries in a ring indexed by
+*                 OSTaskProfIx, which points to the oldest boundary.  The oldest boundary is replaced by
+*                 the current values, so the window slides by one period every call.
+*********************************************************************************************************
+*/
+
+#if (OS_TASK_STAT_EN > 0) && (OS_TASK_PROFILE_EN > 0)
+void  OS_TaskStatProf (void)
+{
+    OS_TCB    *ptcb;
+    INT64U     ts;
+    INT64U     ts_win;
+    INT64U     cycles;
+    INT32U     ctx_sw;
+    INT32U     run_max;
+    BOOLEAN    first;
+    INT8U      ix;
+    INT8U      i;
+#if OS_CRITICAL_METHOD == 3                      /* Allocate storage for CPU status register           */
+    OS_CPU_SR  cpu_sr = 0;
+#endif
+
+
+
+    OS_ENTER_CRITICAL();
+    ts     = OSCPUTsGet();
+    ix     = OSTaskProfIx;
+    first  = (OSTaskProfTs[ix] == 0L) ? OS_TRUE : OS_FALSE;
+    if (first == OS_TRUE) {                      /* First call, the window starts now                  */
+        for (i = 0; i < OS_TASK_PROFILE_WIN; i++) {
+            OSTaskProfTs[i] = ts;
+        }
+    }
+    ts_win = ts - OSTaskProfTs[ix];
+    ptcb   = OSTCBList;
+    while (ptcb != (OS_TCB *)0) {
+        if (first == OS_TRUE) {
+            for (i = 0; i < OS_TASK_PROFILE_WIN; i++) {
+                ptcb->OSTCBWinCycles[i] = ptcb->OSTCBCyclesTot;
+                ptcb->OSTCBWinCtxSw[i]  = ptcb->OSTCBCtxSwCtr;
+            }
+        }
+        cycles                    = ptcb->OSTCBCyclesTot - ptcb->OSTCBWinCycles[ix];
+        ctx_sw                    = ptcb->OSTCBCtxSwCtr  - ptcb->OSTCBWinCtxSw[ix];
+        ptcb->OSTCBWinCycles[ix]  = ptcb->OSTCBCyclesTot;
+        ptcb->OSTCBWinCtxSw[ix]   = ptcb->OSTCBCtxSwCtr;
+        ptcb->OSTCBWinRunMax[ix]  = ptcb->OSTCBRunMax;     /* Close the current period                 */
+        ptcb->OSTCBRunMax         = 0L;
+        run_max                   = 0L;
+        for (i = 0; i < OS_TASK_PROFILE_WIN; i++) {
+            if (ptcb->OSTCBWinRunMax[i] > run_max) {
+                run_max = ptcb->OSTCBWinRunMax[i];
+            }
+        }
+        ptcb->OSTCBRunMaxWin      = run_max;
+        if (ts_win > 0L) {
+            if (cycles > ts_win) {                         /* Clamp rounding at the window edges       */
+                cycles = ts_win;
+            }
+            ptcb->OSTCBCPUUsage   = (INT16U)((cycles * 10000L) / ts_win);
+            ptcb->OSTCBCtxSwRate  = (INT32U)(((INT64U)ctx_sw * OS_CPU_TS_FREQ) / ts_win);
+        }
+        ptcb = ptcb->OSTCBNext;
+    }
+    OSTaskProfTs[ix] = ts;
+    OSTaskProfIx     = (INT8U)((ix + 1) % OS_TASK_PROFILE_WIN);
+    OS_EXIT_CRITICAL();
+}
+#endif
+/*$PAGE*/
+/*
+*********************************************************************************************************
+*                                          SET THE PRIORITY OF A TCB
+*
+* Description: This function is called when a task is created or changes its priority.  It stores the
+*              priority in the TCB and pre-computes the X, Y, BitX and BitY fields used to find the task in
+*              the ready list and the wait lists.
+*
+* Arguments  : ptcb          is a pointer to the TCB of the task.
+*
+*              prio          is the new priority of the task.
+*
+* Returns    : none
+*
+* Note(s)    : 1) This function is INTERNAL to uC/OS-II and your application should not call it.
+*              2) The caller takes the task off the ready list and the wait lists before and puts it back
+*                 after, the fields locate its bits.
+*********************************************************************************************************
+*/
+
+void  OS_TCBPrioSet (OS_TCB *ptcb, INT8U prio)
+{
+    ptcb->OSTCBPrio = prio;
+#if OS_SCHED_CTZ_EN > 0
+    ptcb->OSTCBY    = (INT8U)(prio >> 6);                  /* 64 priorities per group, see OS_SchedNew */
+    ptcb->OSTCBX    = (INT8U)(prio & 0x3F);
+    ptcb->OSTCBBitY = (OS_PRIO_GRP)(1 << ptcb->OSTCBY);
+    ptcb->OSTCBBitX = (OS_PRIO_TBL)1 << ptcb->OSTCBX;
+#elif OS_LOWEST_PRIO <= 63
+    ptcb->OSTCBY    = (INT8U)(prio >> 3);
+    ptcb->OSTCBX    = (INT8U)(prio & 0x07);
+    ptcb->OSTCBBitY = (INT8U)(1 << ptcb->OSTCBY);
+    ptcb->OSTCBBitX = (INT8U)(1 << ptcb->OSTCBX);
+#else
+    ptcb->OSTCBY    = (INT8U)((prio >> 4) & 0x0F);
+    ptcb->OSTCBX    = (INT8U) (prio & 0x0F);
+    ptcb->OSTCBBitY = (INT16U)(1 << ptcb->OSTCBY);
+    ptcb->OSTCBBitX = (INT16U)(1 << ptcb->OSTCBX);
+#endif
+}
+/*$PAGE*/
+/*
+*********************************************************************************************************
 *                                            INITIALIZE TCB
 *
 * Description: This function is internal to uC/OS-II and is used to initialize a Task Control Block when
@@ -1931,22 +3010,32 @@ INT8U  OS_TCBInit (INT8U prio, OS_STK *ptos, OS_STK *pbos, INT16U id, INT32U stk
 
 
 
+#if OS_SLAB_EN > 0
+    OS_SlabTCBRefill();                                    /* Grow the free list if it is empty        */
+#endif
     OS_ENTER_CRITICAL();
     ptcb = OSTCBFreeList;                                  /* Get a free TCB from the free TCB list    */
     if (ptcb != (OS_TCB *)0) {
         OSTCBFreeList            = ptcb->OSTCBNext;        /* Update pointer to free TCB list          */
         OS_EXIT_CRITICAL();
         ptcb->OSTCBStkPtr        = ptos;                   /* Load Stack pointer in TCB                */
-        ptcb->OSTCBPrio          = prio;                   /* Load task priority into TCB              */
+        OS_TCBPrioSet(ptcb, prio);                         /* Load task priority, X, Y, BitX and BitY  */
         ptcb->OSTCBStat          = OS_STAT_RDY;            /* Task is ready to run                     */
         ptcb->OSTCBStatPend      = OS_STAT_PEND_OK;        /* Clear pend status                        */
         ptcb->OSTCBDly           = 0;                      /* Task is not delayed                      */
+        ptcb->OSTCBTickNext      = (OS_TCB *)0;            /* Task is not in the tick list             */
+        ptcb->OSTCBTickPrev      = (OS_TCB *)0;
+#if OS_TIME_NS_EN > 0
+        ptcb->OSTCBDlyNs         = OS_FALSE;               /* Next timeout is in ticks                 */
+#endif
 
 #if OS_TASK_CREATE_EXT_EN > 0
         ptcb->OSTCBExtPtr        = pext;                   /* Store pointer to TCB extension           */
         ptcb->OSTCBStkSize       = stk_size;               /* Store stack size                         */
         ptcb->OSTCBStkBottom     = pbos;                   /* Store pointer to bottom of stack         */
         ptcb->OSTCBOpt           = opt;                    /* Store task options                       */
+        ptcb->OSTCBStkFree       = stk_size - OS_TASK_STK_GUARD(stk_size);   /* Whole stack is free    */
+        ptcb->OSTCBStkOvf        = OS_FALSE;               /* No stack overflow reported               */
         ptcb->OSTCBId            = id;                     /* Store task ID                            */
 #else
         pext                     = pext;                   /* Prevent compiler warning if not used     */
@@ -1960,16 +3049,17 @@ INT8U  OS_TCBInit (INT8U prio, OS_STK *ptos, OS_STK *pbos, INT16U id, INT32U stk
         ptcb->OSTCBDelReq        = OS_ERR_NONE;
 #endif
 
-#if OS_LOWEST_PRIO <= 63
-        ptcb->OSTCBY             = (INT8U)(prio >> 3);          /* Pre-compute X, Y, BitX and BitY     */
-        ptcb->OSTCBX             = (INT8U)(prio & 0x07);
-        ptcb->OSTCBBitY          = (INT8U)(1 << ptcb->OSTCBY);
-        ptcb->OSTCBBitX          = (INT8U)(1 << ptcb->OSTCBX);
-#else
-        ptcb->OSTCBY             = (INT8U)((prio >> 4) & 0xFF); /* Pre-compute X, Y, BitX and BitY     */
-        ptcb->OSTCBX             = (INT8U) (prio & 0x0F);
-        ptcb->OSTCBBitY          = (INT16U)(1 << ptcb->OSTCBY);
-        ptcb->OSTCBBitX          = (INT16U)(1 << ptcb->OSTCBX);
+#if OS_SCHED_RR_EN > 0
+        ptcb->OSTCBRRNext        = ptcb;                   /* Not linked to the priority's tasks yet   */
+        ptcb->OSTCBRRPrev        = ptcb;
+        ptcb->OSTCBRRRdy         = OS_FALSE;
+        ptcb->OSTCBRRQuanta      = OS_SCHED_RR_QUANTUM;    /* Default time quantum                     */
+        ptcb->OSTCBRRCtr         = OS_SCHED_RR_QUANTUM;
+#endif
+
+#if (OS_MUTEX_EN > 0) && (OS_MUTEX_PROTOCOL_EN > 0)
+        ptcb->OSTCBBasePrio      = prio;                   /* Holds no ceiling or inheritance mutex    */
+        ptcb->OSTCBMutexList     = (OS_EVENT *)0;
 #endif
 
 #if (OS_EVENT_EN)
@@ -1983,7 +3073,8 @@ INT8U  OS_TCBInit (INT8U prio, OS_STK *ptos, OS_STK *pbos, INT16U id, INT32U stk
         ptcb->OSTCBFlagNode  = (OS_FLAG_NODE *)0;          /* Task is not pending on an event flag     */
 #endif
 
-#if (OS_MBOX_EN > 0) || ((OS_Q_EN > 0) && (OS_MAX_QS > 0))
+#if (OS_MBOX_EN > 0) || ((OS_Q_EN > 0) && (OS_MAX_QS > 0)) || ((OS_RING_EN > 0) && (OS_MAX_RINGS > 0)) || \
+    ((OS_CHAN_EN > 0) && (OS_MAX_CHANS > 0))
         ptcb->OSTCBMsg       = (void *)0;                  /* No message received                      */
 #endif
 
@@ -1991,8 +3082,18 @@ INT8U  OS_TCBInit (INT8U prio, OS_STK *ptos, OS_STK *pbos, INT16U id, INT32U stk
         ptcb->OSTCBCtxSwCtr    = 0L;                       /* Initialize profiling variables           */
         ptcb->OSTCBCyclesStart = 0L;
         ptcb->OSTCBCyclesTot   = 0L;
+        ptcb->OSTCBRunMax      = 0L;
         ptcb->OSTCBStkBase     = (OS_STK *)0;
         ptcb->OSTCBStkUsed     = 0L;
+        OS_MemClr((INT8U *)&ptcb->OSTCBWinCycles[0], sizeof(ptcb->OSTCBWinCycles));
+        OS_MemClr((INT8U *)&ptcb->OSTCBWinCtxSw[0],  sizeof(ptcb->OSTCBWinCtxSw));
+        OS_MemClr((INT8U *)&ptcb->OSTCBWinRunMax[0], sizeof(ptcb->OSTCBWinRunMax));
+        ptcb->OSTCBCPUUsage    = 0;
+        ptcb->OSTCBCtxSwRate   = 0L;
+        ptcb->OSTCBRunMaxWin   = 0L;
+#if OS_STAT_EN > 0
+        OS_MemClr((INT8U *)&ptcb->OSTCBLoadAvg[0],   sizeof(ptcb->OSTCBLoadAvg));
+#endif
 #endif
 
 #if OS_TASK_NAME_SIZE > 1
@@ -2005,15 +3106,18 @@ INT8U  OS_TCBInit (INT8U prio, OS_STK *ptos, OS_STK *pbos, INT16U id, INT32U stk
         OSTaskCreateHook(ptcb);                            /* Call user defined hook                   */
 
         OS_ENTER_CRITICAL();
+#if OS_SCHED_RR_EN > 0
+        OS_PrioRingInsert(ptcb);                           /* Join the tasks of the same priority      */
+#else
         OSTCBPrioTbl[prio] = ptcb;
+#endif
         ptcb->OSTCBNext    = OSTCBList;                    /* Link into TCB chain                      */
         ptcb->OSTCBPrev    = (OS_TCB *)0;
         if (OSTCBList != (OS_TCB *)0) {
             OSTCBList->OSTCBPrev = ptcb;
         }
         OSTCBList               = ptcb;
-        OSRdyGrp               |= ptcb->OSTCBBitY;         /* Make task ready to run                   */
-        OSRdyTbl[ptcb->OSTCBY] |= ptcb->OSTCBBitX;
+        OS_RdyListInsert(ptcb);                            /* Make task ready to run                   */
         OSTaskCtr++;                                       /* Increment the #tasks counter             */
         OS_EXIT_CRITICAL();
         return (OS_ERR_NONE);
@@ -2021,3 +3125,187 @@ INT8U  OS_TCBInit (INT8U prio, OS_STK *ptos, OS_STK *pbos, INT16U id, INT32U stk
     OS_EXIT_CRITICAL();
     return (OS_ERR_TASK_NO_MORE_TCB);
 }
+/*$PAGE*/
+/*
+*********************************************************************************************************
+*                                        ADVANCE THE TICK LIST
+*
+* Description: This function is called by OSTimeTick() and OSTimeTickN() to advance the tick counter and
+*              to ready the tasks whose delay or pend timeout ended.  The tick list is sorted by the tick
+*              at which the delays end so, only the head of the list needs to be looked at and the cost
+*              of a tick no longer depends on the number of tasks.
+*
+* Arguments  : ticks     is the number of ticks that elapsed.
+*
+* Returns    : none
+*********************************************************************************************************
+*/
+
+static  void  OS_TickListAdvance (INT32U ticks)
+{
+    OS_TCB    *ptcb;
+#if OS_CRITICAL_METHOD == 3                                /* Allocate storage for CPU status register     */
+    OS_CPU_SR  cpu_sr = 0;
+#endif
+
+
+
+    OS_ENTER_CRITICAL();
+    OSTickCtr += ticks;
+    ptcb       = OSTickList;
+    while (ptcb != (OS_TCB *)0) {
+        if ((INT32S)(ptcb->OSTCBTickMatch - OSTickCtr) > 0) {  /* Delays after this one end later         */
+            break;
+        }
+        OS_TickListExpire(ptcb);                           /* Delay ended, check for timeout               */
+        OS_EXIT_CRITICAL();                                /* Give interrupts a chance between tasks       */
+        OS_ENTER_CRITICAL();
+        ptcb = OSTickList;
+    }
+    OS_EXIT_CRITICAL();
+}
+
+/*$PAGE*/
+/*
+*********************************************************************************************************
+*                                       END THE DELAY OF A TASK
+*
+* Description: This function is called by OS_TickListAdvance() and OSTimeTickNs() when the delay or the
+*              pend timeout of a task ends.  The task is removed from its list and made ready to run
+*              unless it is suspended.
+*
+* Arguments  : ptcb      is a pointer to the TCB of the task.
+*
+* Returns    : none
+*
+* Note(s)    : Interrupts are assumed to be disabled when this function is called.
+*********************************************************************************************************
+*/
+
+static  void  OS_TickListExpire (OS_TCB *ptcb)
+{
+    OS_TickListRemove(ptcb);
+    if ((ptcb->OSTCBStat & OS_STAT_PEND_ANY) != OS_STAT_RDY) {
+        ptcb->OSTCBStat  &= ~(INT8U)OS_STAT_PEND_ANY;      /* Yes, Clear status flag                       */
+        ptcb->OSTCBStatPend = OS_STAT_PEND_TO;             /* Indicate PEND timeout                        */
+#if (OS_SCHED_RR_EN > 0) && (OS_EVENT_EN)
+        if (ptcb->OSTCBEventPtr != (OS_EVENT *)0) {        /* Leave the wait list now, a task of the same  */
+            OS_EventTaskRemove(ptcb, ptcb->OSTCBEventPtr); /* ... priority may still be waiting           */
+        }
+#if (OS_EVENT_MULTI_EN > 0)
+        if (ptcb->OSTCBEventMultiPtr != (OS_EVENT **)0) {
+            OS_EventTaskRemoveMulti(ptcb, ptcb->OSTCBEventMultiPtr);
+        }
+#endif
+#endif
+    } else {
+        ptcb->OSTCBStatPend = OS_STAT_PEND_OK;
+    }
+
+    if ((ptcb->OSTCBStat & OS_STAT_SUSPEND) == OS_STAT_RDY) {  /* Is task suspended?                       */
+        OS_RdyListInsert(ptcb);                            /* No,  Make ready                              */
+    }
+}
+
+/*$PAGE*/
+/*
+*********************************************************************************************************
+*                                    INSERT A TASK IN THE TICK LIST
+*
+* Description: This function is called to delay a task or to start the timeout of a pend.  The TCB is
+*              inserted in the tick list after the TCBs whose delay ends at the same tick or earlier.
+*
+* Arguments  : ptcb      is a pointer to the TCB of the task, the task must not be in the tick list.
+*
+*              ticks     is the number of ticks to delay the task.  0 means that the task is not delayed
+*                        (i.e. it waits forever for the event) and the TCB is not inserted.
+*
+* Returns    : none
+*
+* Note(s)    : 1) This function is INTERNAL to uC/OS-II and your application should not call it.
+*              2) Interrupts are assumed to be disabled when this function is called.
+*              3) After OS_DlyNsSet() the TCB is inserted in OSDlyNsList instead and 'ticks' is ignored.
+*********************************************************************************************************
+*/
+
+void  OS_TickListInsert (OS_TCB *ptcb, INT16U ticks)
+{
+    OS_TCB  *pprev;
+    OS_TCB  *pnext;
+    INT32U   match;
+
+
+#if OS_TIME_NS_EN > 0
+    if (ptcb->OSTCBDlyNs == OS_TRUE) {                     /* See Note #3                                  */
+        OS_DlyNsListInsert(ptcb);
+        return;
+    }
+#endif
+    ptcb->OSTCBDly = ticks;
+    if (ticks == 0) {                                      /* Not delayed, leave out of the tick list      */
+        return;
+    }
+    match                = OSTickCtr + ticks;
+    ptcb->OSTCBTickMatch = match;
+    pprev                = (OS_TCB *)0;
+    pnext                = OSTickList;
+    while (pnext != (OS_TCB *)0) {                         /* Find the first TCB whose delay ends later    */
+        if ((INT32S)(pnext->OSTCBTickMatch - match) > 0) {
+            break;
+        }
+        pprev = pnext;
+        pnext = pnext->OSTCBTickNext;
+    }
+    ptcb->OSTCBTickPrev = pprev;                           /* Link between 'pprev' and 'pnext'             */
+    ptcb->OSTCBTickNext = pnext;
+    if (pnext != (OS_TCB *)0) {
+        pnext->OSTCBTickPrev = ptcb;
+    }
+    if (pprev != (OS_TCB *)0) {
+        pprev->OSTCBTickNext = ptcb;
+    } else {
+        OSTickList = ptcb;                                 /* New head, ends first                         */
+    }
+}
+
+/*$PAGE*/
+/*
+*********************************************************************************************************
+*                                    REMOVE A TASK FROM THE TICK LIST
+*
+* Description: This function is called when the delay or the pend timeout of a task ends early (the event
+*              occurred, the delay was resumed or the task is deleted) and when it expires.
+*
+* Arguments  : ptcb      is a pointer to the TCB of the task.  Nothing is done if the task is not in the
+*                        tick list.
+*
+* Returns    : none
+*
+* Note(s)    : 1) This function is INTERNAL to uC/OS-II and your application should not call it.
+*              2) Interrupts are assumed to be disabled when this function is called.
+*              3) A TCB in OSDlyNsList is removed from it the same way.  The one-shot timer of the port is
+*                 left as it is, OSTimeTickNs() programs it again when it expires.
+*********************************************************************************************************
+*/
+
+void  OS_TickListRemove (OS_TCB *ptcb)
+{
+    if (ptcb->OSTCBDly == 0) {                             /* Task is not in the tick list                 */
+        return;
+    }
+    if (ptcb->OSTCBTickPrev != (OS_TCB *)0) {
+        ptcb->OSTCBTickPrev->OSTCBTickNext = ptcb->OSTCBTickNext;
+#if OS_TIME_NS_EN > 0
+    } else if (ptcb->OSTCBDlyNs == OS_TRUE) {              /* See Note #3                                  */
+        OSDlyNsList = ptcb->OSTCBTickNext;
+#endif
+    } else {
+        OSTickList = ptcb->OSTCBTickNext;
+    }
+    if (ptcb->OSTCBTickNext != (OS_TCB *)0) {
+        ptcb->OSTCBTickNext->OSTCBTickPrev = ptcb->OSTCBTickPrev;
+    }
+    ptcb->OSTCBTickNext = (OS_TCB *)0;
+    ptcb->OSTCBTickPrev = (OS_TCB *)0;
+    ptcb->OSTCBDly      = 0;
+}
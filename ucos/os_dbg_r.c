@@ -35,6 +35,14 @@ INT16U  const  OSDebugEn           = OS_DEBUG_EN;               /* Debug constan
 
 INT32U  const  OSEndiannessTest    = 0x12345678L;               /* Variable to test CPU endianness     */
 
+INT16U  const  OSChanEn            = OS_CHAN_EN;
+INT16U  const  OSChanMax           = OS_MAX_CHANS;              /* Number of native thread channels    */
+#if (OS_CHAN_EN > 0) && (OS_MAX_CHANS > 0)
+INT16U  const  OSChanSize          = sizeof(OS_CHAN);           /* Size in bytes of OS_CHAN structure  */
+#else
+INT16U  const  OSChanSize          = 0;
+#endif
+
 INT16U  const  OSEventEn           = OS_EVENT_EN;
 INT16U  const  OSEventMax          = OS_MAX_EVENTS;             /* Number of event control blocks      */
 INT16U  const  OSEventNameSize     = OS_EVENT_NAME_SIZE;        /* Size (in bytes) of event names      */
@@ -46,6 +54,7 @@ INT16U  const  OSEventSize         = 0;
 INT16U  const  OSEventTblSize      = 0;
 #endif
 INT16U  const  OSEventMultiEn      = OS_EVENT_MULTI_EN;
+INT16U  const  OSEventProfEn       = OS_EVENT_PROF_EN;
 
 
 INT16U  const  OSFlagEn            = OS_FLAG_EN;
@@ -61,6 +70,14 @@ INT16U  const  OSFlagWidth         = 0;
 INT16U  const  OSFlagMax           = OS_MAX_FLAGS;
 INT16U  const  OSFlagNameSize      = OS_FLAG_NAME_SIZE;         /* Size (in bytes) of flag names       */
 
+INT16U  const  OSIntQEn            = OS_INT_Q_EN;
+INT16U  const  OSIntQMax           = OS_MAX_INT_QS;             /* Number of interrupt queues          */
+#if (OS_INT_Q_EN > 0) && (OS_MAX_INT_QS > 0)
+INT16U  const  OSIntQSize          = sizeof(OS_INT_Q);          /* Size in bytes of OS_INT_Q structure */
+#else
+INT16U  const  OSIntQSize          = 0;
+#endif
+
 INT16U  const  OSLowestPrio        = OS_LOWEST_PRIO;
 
 INT16U  const  OSMboxEn            = OS_MBOX_EN;
@@ -76,11 +93,18 @@ INT16U  const  OSMemSize           = 0;
 INT16U  const  OSMemTblSize        = 0;
 #endif
 INT16U  const  OSMutexEn           = OS_MUTEX_EN;
+INT16U  const  OSMutexProtocolEn   = OS_MUTEX_PROTOCOL_EN;      /* Ceiling and inheritance mutexes     */
+INT16U  const  OSMutexStatEn       = OS_MUTEX_STAT_EN;          /* Lock and hold time statistics       */
 
 INT16U  const  OSPtrSize           = sizeof(void *);            /* Size in Bytes of a pointer          */
 
 INT16U  const  OSQEn               = OS_Q_EN;
 INT16U  const  OSQMax              = OS_MAX_QS;                 /* Number of queues                    */
+#if OS_Q_PRIO_EN > 0
+INT16U  const  OSQPrioLevels       = OS_Q_PRIO_LEVELS;          /* Message priorities of a prio. queue */
+#else
+INT16U  const  OSQPrioLevels       = 0;
+#endif
 #if (OS_Q_EN > 0) && (OS_MAX_QS > 0)
 INT16U  const  OSQSize             = sizeof(OS_Q);              /* Size in bytes of OS_Q structure     */
 #else
@@ -89,8 +113,46 @@ INT16U  const  OSQSize             = 0;
 
 INT16U  const  OSRdyTblSize        = OS_RDY_TBL_SIZE;           /* Number of bytes in the ready table  */
 
+INT16U  const  OSRingEn            = OS_RING_EN;
+INT16U  const  OSRingMax           = OS_MAX_RINGS;              /* Number of byte rings                */
+#if (OS_RING_EN > 0) && (OS_MAX_RINGS > 0)
+INT16U  const  OSRingSize          = sizeof(OS_RING);           /* Size in bytes of OS_RING structure  */
+#else
+INT16U  const  OSRingSize          = 0;
+#endif
+
 INT16U  const  OSSemEn             = OS_SEM_EN;
 
+INT16U  const  OSSetEn             = OS_SET_EN;
+INT16U  const  OSSetMax            = OS_MAX_SETS;               /* Number of event sets                */
+#if (OS_SET_EN > 0) && (OS_MAX_SETS > 0)
+INT16U  const  OSSetSize           = sizeof(OS_SET);            /* Size in bytes of OS_SET structure   */
+#else
+INT16U  const  OSSetSize           = 0;
+#endif
+
+INT16U  const  OSTopicEn           = OS_TOPIC_EN;
+INT16U  const  OSTopicMax          = OS_MAX_TOPICS;             /* Number of publish/subscribe topics  */
+#if (OS_TOPIC_EN > 0) && (OS_MAX_TOPICS > 0)
+INT16U  const  OSTopicSize         = sizeof(OS_TOPIC);          /* Size in bytes of OS_TOPIC structure */
+#else
+INT16U  const  OSTopicSize         = 0;
+#endif
+
+INT16U  const  OSSlabEn            = OS_SLAB_EN;
+#if OS_SLAB_EN > 0
+INT16U  const  OSSlabPageSize      = OS_SLAB_PAGE_SIZE;         /* Size in bytes of a slab page        */
+#else
+INT16U  const  OSSlabPageSize      = 0;
+#endif
+
+INT16U  const  OSStatEn            = OS_STAT_EN;
+#if OS_STAT_EN > 0
+INT16U  const  OSStatDataSize      = sizeof(OS_STAT_DATA);      /* Size in bytes of OS_STAT_DATA       */
+#else
+INT16U  const  OSStatDataSize      = 0;
+#endif
+
 INT16U  const  OSStkWidth          = sizeof(OS_STK);            /* Size in Bytes of a stack entry      */
 
 INT16U  const  OSTaskCreateEn      = OS_TASK_CREATE_EN;
@@ -103,6 +165,7 @@ INT16U  const  OSTaskNameSize      = OS_TASK_NAME_SIZE;             /* Size (in
 INT16U  const  OSTaskStatEn        = OS_TASK_STAT_EN;
 INT16U  const  OSTaskStatStkSize   = OS_TASK_STAT_STK_SIZE;
 INT16U  const  OSTaskStatStkChkEn  = OS_TASK_STAT_STK_CHK_EN;
+INT16U  const  OSTaskStkCanaryEn   = OS_TASK_STK_CANARY_EN;
 INT16U  const  OSTaskSwHookEn      = OS_TASK_SW_HOOK_EN;
 
 INT16U  const  OSTCBPrioTblMax     = OS_LOWEST_PRIO + 1;        /* Number of entries in OSTCBPrioTbl[] */
@@ -141,6 +204,11 @@ INT16U  const  OSTmrWheelTblSize   = 0;
 #if OS_DEBUG_EN > 0
 
 INT16U  const  OSDataSize = sizeof(OSCtxSwCtr)
+#if (OS_CHAN_EN > 0) && (OS_MAX_CHANS > 0)
+                          + sizeof(OSChanTbl)
+                          + sizeof(OSChanCtr)
+                          + sizeof(OSChanSigList)
+#endif
 #if (OS_EVENT_EN) && (OS_MAX_EVENTS > 0)
                           + sizeof(OSEventFreeList)
                           + sizeof(OSEventTbl)
@@ -156,9 +224,19 @@ INT16U  const  OSDataSize = sizeof(OSCtxSwCtr)
                           + sizeof(OSStatRdy)
                           + sizeof(OSTaskStatStk)
 #endif
+#if (OS_TASK_STAT_STK_CHK_EN > 0) && (OS_TASK_CREATE_EXT_EN > 0)
+                          + sizeof(OSTaskStatStkTCB)
+#endif
 #if OS_TICK_STEP_EN > 0
                           + sizeof(OSTickStepState)
 #endif
+#if (OS_INT_Q_EN > 0) && (OS_MAX_INT_QS > 0)
+                          + sizeof(OSIntQTbl)
+                          + sizeof(OSIntQCtr)
+                          + sizeof(OSIntQPend)
+                          + sizeof(OSIntQTCB)
+                          + sizeof(OSTaskIntQStk)
+#endif
 #if (OS_MEM_EN > 0) && (OS_MAX_MEM_PART > 0)
                           + sizeof(OSMemFreeList)
                           + sizeof(OSMemTbl)
@@ -167,6 +245,33 @@ INT16U  const  OSDataSize = sizeof(OSCtxSwCtr)
                           + sizeof(OSQFreeList)
                           + sizeof(OSQTbl)
 #endif
+#if (OS_RING_EN > 0) && (OS_MAX_RINGS > 0)
+                          + sizeof(OSRingFreeList)
+                          + sizeof(OSRingTbl)
+#endif
+#if (OS_SET_EN > 0) && (OS_MAX_SETS > 0)
+                          + sizeof(OSSetFreeList)
+                          + sizeof(OSSetTbl)
+#endif
+#if (OS_TOPIC_EN > 0) && (OS_MAX_TOPICS > 0)
+                          + sizeof(OSTopicFreeList)
+                          + sizeof(OSTopicTbl)
+#endif
+#if OS_SLAB_EN > 0
+                          + sizeof(OSSlabPageCtr)
+                          + sizeof(OSSlabBytes)
+#endif
+#if OS_STAT_EN > 0
+                          + sizeof(OSStatIntStart)
+                          + sizeof(OSStatIntTimeTot)
+                          + sizeof(OSStatIntCtr)
+                          + sizeof(OSStatData)
+                          + sizeof(OSStatCPULoadAvg)
+                          + sizeof(OSStatIntLoadAvg)
+                          + sizeof(OSStatIntTimeLast)
+                          + sizeof(OSStatIntCtrLast)
+                          + sizeof(OSStatCtxSwCtrLast)
+#endif
 #if OS_TIME_GET_SET_EN > 0   
                           + sizeof(OSTime)
 #endif
@@ -231,12 +336,17 @@ void  OSDebugInit (void)
 
     ptemp = (void *)&OSEndiannessTest;
 
+    ptemp = (void *)&OSChanEn;
+    ptemp = (void *)&OSChanMax;
+    ptemp = (void *)&OSChanSize;
+
     ptemp = (void *)&OSEventMax;
     ptemp = (void *)&OSEventNameSize;
     ptemp = (void *)&OSEventEn;
     ptemp = (void *)&OSEventSize;
     ptemp = (void *)&OSEventTblSize;
     ptemp = (void *)&OSEventMultiEn;
+    ptemp = (void *)&OSEventProfEn;
 
     ptemp = (void *)&OSFlagEn;
     ptemp = (void *)&OSFlagGrpSize;
@@ -245,6 +355,10 @@ void  OSDebugInit (void)
     ptemp = (void *)&OSFlagMax;
     ptemp = (void *)&OSFlagNameSize;
 
+    ptemp = (void *)&OSIntQEn;
+    ptemp = (void *)&OSIntQMax;
+    ptemp = (void *)&OSIntQSize;
+
     ptemp = (void *)&OSLowestPrio;
 
     ptemp = (void *)&OSMboxEn;
@@ -256,17 +370,38 @@ void  OSDebugInit (void)
     ptemp = (void *)&OSMemTblSize;
 
     ptemp = (void *)&OSMutexEn;
+    ptemp = (void *)&OSMutexProtocolEn;
+    ptemp = (void *)&OSMutexStatEn;
 
     ptemp = (void *)&OSPtrSize;
 
     ptemp = (void *)&OSQEn;
     ptemp = (void *)&OSQMax;
+    ptemp = (void *)&OSQPrioLevels;
     ptemp = (void *)&OSQSize;
 
     ptemp = (void *)&OSRdyTblSize;
 
+    ptemp = (void *)&OSRingEn;
+    ptemp = (void *)&OSRingMax;
+    ptemp = (void *)&OSRingSize;
+
     ptemp = (void *)&OSSemEn;
 
+    ptemp = (void *)&OSSetEn;
+    ptemp = (void *)&OSSetMax;
+    ptemp = (void *)&OSSetSize;
+
+    ptemp = (void *)&OSTopicEn;
+    ptemp = (void *)&OSTopicMax;
+    ptemp = (void *)&OSTopicSize;
+
+    ptemp = (void *)&OSSlabEn;
+    ptemp = (void *)&OSSlabPageSize;
+
+    ptemp = (void *)&OSStatEn;
+    ptemp = (void *)&OSStatDataSize;
+
     ptemp = (void *)&OSStkWidth;
 
     ptemp = (void *)&OSTaskCreateEn;
@@ -279,6 +414,7 @@ void  OSDebugInit (void)
     ptemp = (void *)&OSTaskStatEn;
     ptemp = (void *)&OSTaskStatStkSize;
     ptemp = (void *)&OSTaskStatStkChkEn;
+    ptemp = (void *)&OSTaskStkCanaryEn;
     ptemp = (void *)&OSTaskSwHookEn;
 
     ptemp = (void *)&OSTCBPrioTblMax;
@@ -223,6 +223,9 @@ OS_FLAG_GRP  *OSFlagCreate (OS_FLAGS flags, INT8U *perr)
         *perr = OS_ERR_CREATE_ISR;                  /* ... can't CREATE from an ISR                    */
         return ((OS_FLAG_GRP *)0);
     }
+#if OS_SLAB_EN > 0
+    OS_SlabFlagRefill();                            /* Grow the free list if it is empty               */
+#endif
     OS_ENTER_CRITICAL();
     pgrp = OSFlagFreeList;                          /* Get next free event flag                        */
     if (pgrp != (OS_FLAG_GRP *)0) {                 /* See if we have event flag groups available      */
@@ -234,6 +237,9 @@ OS_FLAG_GRP  *OSFlagCreate (OS_FLAGS flags, INT8U *perr)
 #if OS_FLAG_NAME_SIZE > 1
         pgrp->OSFlagName[0]  = '?';
         pgrp->OSFlagName[1]  = OS_ASCII_NUL;
+#endif
+#if OS_EVENT_PROF_EN > 0
+        OS_MemClr((INT8U *)&pgrp->OSFlagProf, sizeof(OS_EVENT_PROF));
 #endif
         OS_EXIT_CRITICAL();
         *perr                = OS_ERR_NONE;
@@ -600,6 +606,9 @@ OS_FLAGS  OSFlagPend (OS_FLAG_GRP *pgrp, OS_FLAGS flags, INT8U wait_type, INT16U
     }
 /*$PAGE*/
     OS_ENTER_CRITICAL();
+#if OS_EVENT_PROF_EN > 0
+    pgrp->OSFlagProf.OSPendCtr++;
+#endif
     switch (wait_type) {
         case OS_FLAG_WAIT_SET_ALL:                         /* See if all required flags are set        */
              flags_rdy = (OS_FLAGS)(pgrp->OSFlagFlags & flags);   /* Extract only the bits we want     */
@@ -676,6 +685,9 @@ OS_FLAGS  OSFlagPend (OS_FLAG_GRP *pgrp, OS_FLAGS flags, INT8U wait_type, INT16U
 /*$PAGE*/
     OS_Sched();                                            /* Find next HPT ready to run               */
     OS_ENTER_CRITICAL();
+#if OS_EVENT_PROF_EN > 0
+    OS_EventProfWake(&pgrp->OSFlagProf);                   /* Account the blocked and the wakeup time  */
+#endif
     if (OSTCBCur->OSTCBStatPend != OS_STAT_PEND_OK) {      /* Have we timed-out or aborted?            */
         pend_stat                = OSTCBCur->OSTCBStatPend;
         OSTCBCur->OSTCBStatPend  = OS_STAT_PEND_OK;
@@ -719,6 +731,47 @@ OS_FLAGS  OSFlagPend (OS_FLAG_GRP *pgrp, OS_FLAGS flags, INT8U wait_type, INT16U
     *perr = OS_ERR_NONE;                                   /* Event(s) must have occurred              */
     return (flags_rdy);
 }
+
+/*$PAGE*/
+/*
+*********************************************************************************************************
+*                               EVENT FLAG GROUP WAIT, NANOSECOND TIMEOUT
+*
+* Description: This function is OSFlagPend() with a timeout in nanoseconds.  The timeout is not
+*              rounded up to clock ticks, it ends at the time stamp of the port (OSCPUTsGet()) it is due.
+*
+* Arguments  : pgrp          is a pointer to the desired event flag group.
+*
+*              flags         is a bit pattern indicating which bit(s) (i.e. flags) you wish to wait for.
+*
+*              wait_type     specifies whether you want all bits to be set or any bit, as for
+*                            OSFlagPend().
+*
+*              timeout_ns    is an optional timeout period in nanoseconds.  If you specify 0, your task
+*                            will wait forever like with OSFlagPend().
+*
+*              perr          is a pointer to where an error message will be deposited, the same as for
+*                            OSFlagPend().
+*
+* Returns    : the flags in the event flag group that made the task ready, or 0 on a timeout or error.
+*********************************************************************************************************
+*/
+
+#if OS_TIME_NS_EN > 0
+OS_FLAGS  OSFlagPendNs (OS_FLAG_GRP *pgrp, OS_FLAGS flags, INT8U wait_type, INT64U timeout_ns, INT8U *perr)
+{
+    OS_FLAGS  flags_rdy;
+
+
+    if ((timeout_ns == 0) || (OSIntNesting > 0)) {         /* Wait forever, or let OSFlagPend() fail   */
+        return (OSFlagPend(pgrp, flags, wait_type, 0, perr));
+    }
+    OS_DlyNsSet(timeout_ns);
+    flags_rdy = OSFlagPend(pgrp, flags, wait_type, 0, perr);
+    OS_DlyNsSet(0);
+    return (flags_rdy);
+}
+#endif
 /*$PAGE*/
 /*
 *********************************************************************************************************
@@ -820,6 +873,9 @@ OS_FLAGS  OSFlagPost (OS_FLAG_GRP *pgrp, OS_FLAGS flags, INT8U opt, INT8U *perr)
     }
 /*$PAGE*/
     OS_ENTER_CRITICAL();
+#if OS_EVENT_PROF_EN > 0
+    pgrp->OSFlagProf.OSPostCtr++;
+#endif
     switch (opt) {
         case OS_FLAG_CLR:
              pgrp->OSFlagFlags &= ~flags;            /* Clear the flags specified in the group         */
@@ -896,6 +952,65 @@ OS_FLAGS  OSFlagPost (OS_FLAG_GRP *pgrp, OS_FLAGS flags, INT8U opt, INT8U *perr)
     *perr     = OS_ERR_NONE;
     return (flags_cur);
 }
+/*$PAGE*/
+/*
+*********************************************************************************************************
+*                                   GET THE STATISTICS OF AN EVENT FLAG GROUP
+*
+* Description: This function copies the pend and post statistics of an event flag group (see
+*              OS_EVENT_PROF).
+*
+* Arguments  : pgrp         is a pointer to the desired event flag group.
+*
+*              p_prof       is a pointer to where the statistics are copied.
+*
+*              opt          determines what is done with the statistics:
+*                           OS_PROF_OPT_NONE    They are only read.
+*                           OS_PROF_OPT_CLR     They are cleared after they are read.
+*
+* Returns    : OS_ERR_NONE                The statistics were copied
+*              OS_ERR_FLAG_INVALID_PGRP   You passed a NULL pointer for 'pgrp'
+*              OS_ERR_PDATA_NULL          You passed a NULL pointer for 'p_prof'
+*              OS_ERR_EVENT_TYPE          You are not pointing to an event flag group
+*              OS_ERR_INVALID_OPT         You specified an invalid option
+*
+* Called From: Task or ISR
+*********************************************************************************************************
+*/
+
+#if OS_EVENT_PROF_EN > 0
+INT8U  OSFlagProfGet (OS_FLAG_GRP *pgrp, OS_EVENT_PROF *p_prof, INT8U opt)
+{
+#if OS_CRITICAL_METHOD == 3                       /* Allocate storage for CPU status register          */
+    OS_CPU_SR  cpu_sr = 0;
+#endif
+
+
+
+#if OS_ARG_CHK_EN > 0
+    if (pgrp == (OS_FLAG_GRP *)0) {               /* Validate 'pgrp'                                   */
+        return (OS_ERR_FLAG_INVALID_PGRP);
+    }
+    if (p_prof == (OS_EVENT_PROF *)0) {           /* Validate 'p_prof'                                 */
+        return (OS_ERR_PDATA_NULL);
+    }
+#endif
+    if (pgrp->OSFlagType != OS_EVENT_TYPE_FLAG) { /* Validate event block type                         */
+        return (OS_ERR_EVENT_TYPE);
+    }
+    if (opt > OS_PROF_OPT_CLR) {
+        return (OS_ERR_INVALID_OPT);
+    }
+    OS_ENTER_CRITICAL();
+    OS_MemCopy((INT8U *)p_prof, (INT8U *)&pgrp->OSFlagProf, sizeof(OS_EVENT_PROF));
+    if (opt == OS_PROF_OPT_CLR) {
+        OS_MemClr((INT8U *)&pgrp->OSFlagProf, sizeof(OS_EVENT_PROF));
+    }
+    OS_EXIT_CRITICAL();
+    return (OS_ERR_NONE);
+}
+#endif
+
 /*$PAGE*/
 /*
 *********************************************************************************************************
@@ -988,12 +1103,14 @@ OS_FLAGS  OSFlagQuery (OS_FLAG_GRP *pgrp, INT8U *perr)
 static  void  OS_FlagBlock (OS_FLAG_GRP *pgrp, OS_FLAG_NODE *pnode, OS_FLAGS flags, INT8U wait_type, INT16U timeout)
 {
     OS_FLAG_NODE  *pnode_next;
-    INT8U          y;
 
 
     OSTCBCur->OSTCBStat      |= OS_STAT_FLAG;
     OSTCBCur->OSTCBStatPend   = OS_STAT_PEND_OK;
-    OSTCBCur->OSTCBDly        = timeout;              /* Store timeout in task's TCB                   */
+#if OS_EVENT_PROF_EN > 0
+    OSTCBCur->OSTCBPendTs     = OSCPUTsGet();         /* Start of the blocked time                    */
+#endif
+    OS_TickListInsert(OSTCBCur, timeout);             /* Store timeout in task's TCB and tick list    */
 #if OS_TASK_DEL_EN > 0
     OSTCBCur->OSTCBFlagNode   = pnode;                /* TCB to link to node                           */
 #endif
@@ -1009,11 +1126,7 @@ static  void  OS_FlagBlock (OS_FLAG_GRP *pgrp, OS_FLAG_NODE *pnode, OS_FLAGS fla
     }
     pgrp->OSFlagWaitList = (void *)pnode;
 
-    y            =  OSTCBCur->OSTCBY;                 /* Suspend current task until flag(s) received   */
-    OSRdyTbl[y] &= ~OSTCBCur->OSTCBBitX;
-    if (OSRdyTbl[y] == 0x00) {
-        OSRdyGrp &= ~OSTCBCur->OSTCBBitY;
-    }
+    OS_RdyListRemove(OSTCBCur);                       /* Suspend current task until flag(s) received   */
 }
 
 /*$PAGE*/
@@ -1105,13 +1218,15 @@ static  BOOLEAN  OS_FlagTaskRdy (OS_FLAG_NODE *pnode, OS_FLAGS flags_rdy)
 
 
     ptcb                 = (OS_TCB *)pnode->OSFlagNodeTCB; /* Point to TCB of waiting task             */
-    ptcb->OSTCBDly       = 0;
+    OS_TickListRemove(ptcb);
     ptcb->OSTCBFlagsRdy  = flags_rdy;
     ptcb->OSTCBStat     &= ~(INT8U)OS_STAT_FLAG;
     ptcb->OSTCBStatPend  = OS_STAT_PEND_OK;
+#if OS_EVENT_PROF_EN > 0
+    ptcb->OSTCBRdyTs     = OSCPUTsGet();                   /* Start of the wakeup time                 */
+#endif
     if (ptcb->OSTCBStat == OS_STAT_RDY) {                  /* Task now ready?                          */
-        OSRdyGrp               |= ptcb->OSTCBBitY;         /* Put task into ready list                 */
-        OSRdyTbl[ptcb->OSTCBY] |= ptcb->OSTCBBitX;
+        OS_RdyListInsert(ptcb);                            /* Put task into ready list                 */
         sched                   = OS_TRUE;
     } else {
         sched                   = OS_FALSE;
@@ -0,0 +1,534 @@
+/*
+*********************************************************************************************************
+*                                                uC/OS-II
+*                                          The Real-Time Kernel
+*                                      ISR DEFERRED POST MANAGEMENT
+*
+* File    : OS_INTQ.C
+* Version : V2.86
+*
+* An ISR that posts to a semaphore, a mailbox, a queue or an event flag group directly walks the wait
+* list of the object with interrupts disabled, and the time that takes grows with the number of waiting
+* tasks.  With an interrupt queue the ISR only appends the post to a ring of its own, which needs no
+* critical section, and OSIntExit() readies OS_TaskIntQ() in constant time.  The task then does the
+* posts at task level, with interrupts enabled except for the short critical sections of each post.
+*********************************************************************************************************
+*/
+
+#ifndef  OS_MASTER_FILE
+#include <ucos_ii.h>
+#endif
+
+#if (OS_INT_Q_EN > 0) && (OS_MAX_INT_QS > 0)
+/*
+*********************************************************************************************************
+*                                          LOCAL FUNCTION PROTOTYPES
+*********************************************************************************************************
+*/
+
+static  void             OS_IntQDrain(OS_INT_Q *pq);
+static  OS_INT_Q_ENTRY  *OS_IntQEntryGet(OS_INT_Q *pq);
+static  INT8U            OS_IntQEntryPost(OS_INT_Q_ENTRY *pentry);
+static  void             OS_IntQEntryPut(OS_INT_Q *pq);
+
+/*$PAGE*/
+/*
+*********************************************************************************************************
+*                                       CREATE AN INTERRUPT QUEUE
+*
+* Description: This function creates the ring in which one ISR defers its posts.
+*
+* Arguments  : pstart        is a pointer to the storage area of the ring, an array of OS_INT_Q_ENTRY.
+*
+*              size          is the number of entries of the array.  One entry is always left empty, so
+*                            the ring holds up to 'size - 1' posts.
+*
+*              perr          is a pointer to an error code that will be set by this function
+*
+*                            OS_ERR_NONE              the call was successful
+*                            OS_ERR_CREATE_ISR        if you called this function from an ISR
+*                            OS_ERR_INT_Q_DEPLETED    if OS_MAX_INT_QS interrupt queues were created
+*                            OS_ERR_INT_Q_SIZE        if 'size' is less than 2
+*                            OS_ERR_PDATA_NULL        if 'pstart' is a NULL pointer
+*
+* Returns    : != (OS_INT_Q *)0  is a pointer to the interrupt queue
+*              == (OS_INT_Q *)0  if the interrupt queue could not be created
+*
+* Note(s)    : 1) Only one ISR may post to an interrupt queue and it must not nest with itself, create one
+*                 interrupt queue for every interrupt source.
+*              2) Interrupt queues cannot be deleted.
+*********************************************************************************************************
+*/
+
+OS_INT_Q  *OSIntQCreate (OS_INT_Q_ENTRY *pstart, INT16U size, INT8U *perr)
+{
+    OS_INT_Q   *pq;
+#if OS_CRITICAL_METHOD == 3                           /* Allocate storage for CPU status register      */
+    OS_CPU_SR   cpu_sr = 0;
+#endif
+
+
+
+#if OS_ARG_CHK_EN > 0
+    if (perr == (INT8U *)0) {                         /* Validate 'perr'                               */
+        return ((OS_INT_Q *)0);
+    }
+    if (pstart == (OS_INT_Q_ENTRY *)0) {              /* Validate 'pstart'                             */
+        *perr = OS_ERR_PDATA_NULL;
+        return ((OS_INT_Q *)0);
+    }
+#endif
+    if (size < 2) {                                   /* One entry is always left empty                */
+        *perr = OS_ERR_INT_Q_SIZE;
+        return ((OS_INT_Q *)0);
+    }
+    if (OSIntNesting > 0) {                           /* See if called from ISR ...                    */
+        *perr = OS_ERR_CREATE_ISR;                    /* ... can't CREATE from an ISR                  */
+        return ((OS_INT_Q *)0);
+    }
+    OS_ENTER_CRITICAL();
+    if (OSIntQCtr >= OS_MAX_INT_QS) {
+        OS_EXIT_CRITICAL();
+        *perr = OS_ERR_INT_Q_DEPLETED;
+        return ((OS_INT_Q *)0);
+    }
+    pq               = &OSIntQTbl[OSIntQCtr];
+    pq->OSIntQStart  = pstart;
+    pq->OSIntQSize   = size;
+    pq->OSIntQIn     = 0;
+    pq->OSIntQOut    = 0;
+    pq->OSIntQMax    = 0;
+    pq->OSIntQOvfCtr = 0L;
+    pq->OSIntQErrCtr = 0L;
+    OSIntQCtr++;                                      /* OS_TaskIntQ() drains it from now on           */
+    OS_EXIT_CRITICAL();
+    *perr = OS_ERR_NONE;
+    return (pq);
+}
+
+/*$PAGE*/
+/*
+*********************************************************************************************************
+*                                 DEFER A POST TO AN EVENT FLAG GROUP
+*
+* Description: This function is called by an ISR to set or clear flags of an event flag group from
+*              OS_TaskIntQ() instead of calling OSFlagPost() directly.
+*
+* Arguments  : pq            is a pointer to the interrupt queue of the ISR.
+*
+*              pgrp          is a pointer to the event flag group.
+*
+*              flags         the flags to set or clear, see OSFlagPost().
+*
+*              opt           OS_FLAG_SET or OS_FLAG_CLR, see OSFlagPost().
+*
+* Returns    : OS_ERR_NONE              the post was deferred
+*              OS_ERR_INT_Q_FULL        if the ring is full, the post is lost and OSIntQOvfCtr counts it
+*              OS_ERR_INT_Q_INVALID     if 'pq' is a NULL pointer
+*              OS_ERR_FLAG_INVALID_PGRP if 'pgrp' is a NULL pointer
+*
+* Note(s)    : 1) This function MUST be called from an ISR, between OSIntEnter() and OSIntExit(), which
+*                 readies OS_TaskIntQ().
+*              2) The error OSFlagPost() returns later is only counted in OSIntQErrCtr.
+*********************************************************************************************************
+*/
+
+#if (OS_FLAG_EN > 0) && (OS_MAX_FLAGS > 0)
+INT8U  OSIntQFlagPost (OS_INT_Q *pq, OS_FLAG_GRP *pgrp, OS_FLAGS flags, INT8U opt)
+{
+    OS_INT_Q_ENTRY  *pentry;
+
+
+#if OS_ARG_CHK_EN > 0
+    if (pq == (OS_INT_Q *)0) {                        /* Validate 'pq'                                 */
+        return (OS_ERR_INT_Q_INVALID);
+    }
+    if (pgrp == (OS_FLAG_GRP *)0) {                   /* Validate 'pgrp'                               */
+        return (OS_ERR_FLAG_INVALID_PGRP);
+    }
+#endif
+    pentry = OS_IntQEntryGet(pq);
+    if (pentry == (OS_INT_Q_ENTRY *)0) {
+        return (OS_ERR_INT_Q_FULL);
+    }
+    pentry->OSIntQObj   = (void *)pgrp;
+    pentry->OSIntQFlags = flags;
+    pentry->OSIntQOpt   = opt;
+    pentry->OSIntQType  = OS_EVENT_TYPE_FLAG;
+    OS_IntQEntryPut(pq);
+    return (OS_ERR_NONE);
+}
+#endif
+
+/*$PAGE*/
+/*
+*********************************************************************************************************
+*                          DEFER A POST TO A SEMAPHORE, A MAILBOX OR A QUEUE
+*
+* Description: This function is called by an ISR to post to a semaphore, a mailbox or a message queue from
+*              OS_TaskIntQ() instead of calling OSSemPost(), OSMboxPostOpt() or OSQPostOpt() directly.
+*
+* Arguments  : pq            is a pointer to the interrupt queue of the ISR.
+*
+*              pevent        is a pointer to the event control block of the semaphore, mailbox or queue.
+*
+*              pmsg          is the message to post to a mailbox or a queue, it is ignored for a semaphore.
+*
+*              opt           determines the type of POST performed on a mailbox or a queue, see
+*                            OSMboxPostOpt() and OSQPostOpt().  It is ignored for a semaphore.
+*
+* Returns    : OS_ERR_NONE              the post was deferred
+*              OS_ERR_INT_Q_FULL        if the ring is full, the post is lost and OSIntQOvfCtr counts it
+*              OS_ERR_INT_Q_INVALID     if 'pq' is a NULL pointer
+*              OS_ERR_PEVENT_NULL       if 'pevent' is a NULL pointer
+*              OS_ERR_EVENT_TYPE        if 'pevent' is not a semaphore, a mailbox or a queue
+*
+* Note(s)    : 1) This function MUST be called from an ISR, between OSIntEnter() and OSIntExit(), which
+*                 readies OS_TaskIntQ().
+*              2) The error the post returns later, OS_ERR_Q_FULL for instance, is only counted in
+*                 OSIntQErrCtr.
+*********************************************************************************************************
+*/
+
+INT8U  OSIntQPost (OS_INT_Q *pq, OS_EVENT *pevent, void *pmsg, INT8U opt)
+{
+    OS_INT_Q_ENTRY  *pentry;
+
+
+#if OS_ARG_CHK_EN > 0
+    if (pq == (OS_INT_Q *)0) {                        /* Validate 'pq'                                 */
+        return (OS_ERR_INT_Q_INVALID);
+    }
+    if (pevent == (OS_EVENT *)0) {                    /* Validate 'pevent'                             */
+        return (OS_ERR_PEVENT_NULL);
+    }
+#endif
+    switch (pevent->OSEventType) {
+        case OS_EVENT_TYPE_SEM:
+        case OS_EVENT_TYPE_MBOX:
+        case OS_EVENT_TYPE_Q:
+             break;
+
+        default:                                      /* A mutex can't be posted by an ISR             */
+             return (OS_ERR_EVENT_TYPE);
+    }
+    pentry = OS_IntQEntryGet(pq);
+    if (pentry == (OS_INT_Q_ENTRY *)0) {
+        return (OS_ERR_INT_Q_FULL);
+    }
+    pentry->OSIntQObj  = (void *)pevent;
+    pentry->OSIntQMsg  = pmsg;
+    pentry->OSIntQOpt  = opt;
+    pentry->OSIntQType = pevent->OSEventType;
+    OS_IntQEntryPut(pq);
+    return (OS_ERR_NONE);
+}
+
+/*$PAGE*/
+/*
+*********************************************************************************************************
+*                                 INITIALIZE THE ISR DEFERRED POSTS
+*
+* Description: This function is called by OSInit() to clear the table of interrupt queues and to create
+*              OS_TaskIntQ().
+*
+* Arguments  : none
+*
+* Returns    : none
+*
+* Note(s)    : This function is INTERNAL to uC/OS-II and your application should not call it.
+*********************************************************************************************************
+*/
+
+void  OS_IntQInit (void)
+{
+#if OS_TASK_NAME_SIZE > 8
+    INT8U  err;
+#endif
+
+
+    OS_MemClr((INT8U *)&OSIntQTbl[0], sizeof(OSIntQTbl));
+    OSIntQCtr  = 0;
+    OSIntQPend = OS_FALSE;
+
+#if OS_TASK_CREATE_EXT_EN > 0
+    #if OS_STK_GROWTH == 1
+    (void)OSTaskCreateExt(OS_TaskIntQ,
+                          (void *)0,                                 /* No args passed to OS_TaskIntQ()*/
+                          &OSTaskIntQStk[OS_TASK_INT_Q_STK_SIZE - 1],/* Set Top-Of-Stack               */
+                          OS_TASK_INT_Q_PRIO,
+                          OS_TASK_INT_Q_ID,
+                          &OSTaskIntQStk[0],                         /* Set Bottom-Of-Stack            */
+                          OS_TASK_INT_Q_STK_SIZE,
+                          (void *)0,                                 /* No TCB extension               */
+                          OS_TASK_OPT_STK_CHK | OS_TASK_OPT_STK_CLR);/* Enable stack checking + clear  */
+    #else
+    (void)OSTaskCreateExt(OS_TaskIntQ,
+                          (void *)0,                                 /* No args passed to OS_TaskIntQ()*/
+                          &OSTaskIntQStk[0],                         /* Set Top-Of-Stack               */
+                          OS_TASK_INT_Q_PRIO,
+                          OS_TASK_INT_Q_ID,
+                          &OSTaskIntQStk[OS_TASK_INT_Q_STK_SIZE - 1],/* Set Bottom-Of-Stack            */
+                          OS_TASK_INT_Q_STK_SIZE,
+                          (void *)0,                                 /* No TCB extension               */
+                          OS_TASK_OPT_STK_CHK | OS_TASK_OPT_STK_CLR);/* Enable stack checking + clear  */
+    #endif
+#else
+    #if OS_STK_GROWTH == 1
+    (void)OSTaskCreate(OS_TaskIntQ,
+                       (void *)0,
+                       &OSTaskIntQStk[OS_TASK_INT_Q_STK_SIZE - 1],
+                       OS_TASK_INT_Q_PRIO);
+    #else
+    (void)OSTaskCreate(OS_TaskIntQ,
+                       (void *)0,
+                       &OSTaskIntQStk[0],
+                       OS_TASK_INT_Q_PRIO);
+    #endif
+#endif
+    OSIntQTCB = OSTCBPrioTbl[OS_TASK_INT_Q_PRIO];
+
+#if OS_TASK_NAME_SIZE > 15
+    OSTaskNameSet(OS_TASK_INT_Q_PRIO, (INT8U *)"uC/OS-II Int. Q", &err);
+#else
+#if OS_TASK_NAME_SIZE > 8
+    OSTaskNameSet(OS_TASK_INT_Q_PRIO, (INT8U *)"OS-Int.Q", &err);
+#endif
+#endif
+}
+
+/*$PAGE*/
+/*
+*********************************************************************************************************
+*                                   READY THE TASK OF THE DEFERRED POSTS
+*
+* Description: This function is called by OSIntExit() when the outermost ISR completes and an ISR deferred
+*              a post.  If OS_TaskIntQ() waits, it is made ready to run again.
+*
+* Arguments  : none
+*
+* Returns    : none
+*
+* Note(s)    : 1) This function is INTERNAL to uC/OS-II and your application should not call it.
+*              2) Interrupts are assumed to be disabled when this function is called.
+*********************************************************************************************************
+*/
+
+void  OS_IntQSignal (void)
+{
+    OS_TCB  *ptcb;
+
+
+    ptcb = OSIntQTCB;
+    if ((ptcb->OSTCBStat & OS_STAT_SUSPEND) != OS_STAT_RDY) { /* See if the task waits                */
+        ptcb->OSTCBStat &= ~(INT8U)OS_STAT_SUSPEND;
+        OS_RdyListInsert(ptcb);
+    }
+}
+
+/*$PAGE*/
+/*
+*********************************************************************************************************
+*                                      TASK OF THE DEFERRED POSTS
+*
+* Description: This task does the posts the ISRs deferred to their interrupt queues.  When every queue is
+*              empty it removes itself from the ready list until OSIntExit() readies it again.
+*
+* Arguments  : p_arg     this pointer is not used at this time.
+*
+* Returns    : none
+*
+* Note(s)    : 1) This task is INTERNAL to uC/OS-II and your application should not call it.
+*              2) OSIntQPend is cleared before the queues are drained, a post deferred meanwhile sets it
+*                 again and the task makes one more pass instead of waiting.
+*              3) The task should have the highest priority of the tasks the ISRs post to, or the posts
+*                 are delayed by the tasks in between.
+*********************************************************************************************************
+*/
+
+void  OS_TaskIntQ (void *p_arg)
+{
+    INT8U      i;
+#if OS_CRITICAL_METHOD == 3                           /* Allocate storage for CPU status register      */
+    OS_CPU_SR  cpu_sr = 0;
+#endif
+
+
+
+    p_arg = p_arg;                                    /* Prevent compiler warning for not using 'p_arg'*/
+    for (;;) {
+        OSIntQPend = OS_FALSE;                        /* See Note #2                                   */
+        OS_CPU_BARRIER();
+        for (i = 0; i < OSIntQCtr; i++) {
+            OS_IntQDrain(&OSIntQTbl[i]);
+        }
+        OS_ENTER_CRITICAL();
+        if (OSIntQPend == OS_FALSE) {                 /* Wait for OSIntExit() if nothing was deferred  */
+            OS_RdyListRemove(OSTCBCur);
+            OSTCBCur->OSTCBStat |= OS_STAT_SUSPEND;
+            OS_EXIT_CRITICAL();
+            OS_Sched();
+        } else {
+            OS_EXIT_CRITICAL();
+        }
+    }
+}
+
+/*$PAGE*/
+/*
+*********************************************************************************************************
+*                                     DRAIN AN INTERRUPT QUEUE
+*
+* Description: This function does the posts that were in an interrupt queue when it was called.  Each
+*              entry is copied before its slot is handed back to the ISR.
+*
+* Arguments  : pq            is a pointer to the interrupt queue.
+*
+* Returns    : none
+*********************************************************************************************************
+*/
+
+static  void  OS_IntQDrain (OS_INT_Q *pq)
+{
+    OS_INT_Q_ENTRY  entry;
+    INT16U          in;
+    INT16U          out;
+
+
+    out = pq->OSIntQOut;
+    in  = pq->OSIntQIn;
+    OS_CPU_BARRIER();                                 /* Read the entries after the index              */
+    while (out != in) {
+        entry = pq->OSIntQStart[out];
+        out++;
+        if (out == pq->OSIntQSize) {
+            out = 0;
+        }
+        OS_CPU_BARRIER();                             /* Copy the entry before the slot is handed back */
+        pq->OSIntQOut = out;
+        if (OS_IntQEntryPost(&entry) != OS_ERR_NONE) {
+            pq->OSIntQErrCtr++;
+        }
+    }
+}
+
+/*$PAGE*/
+/*
+*********************************************************************************************************
+*                                   GET THE FREE ENTRY OF AN INTERRUPT QUEUE
+*
+* Description: This function is called by the ISR to find the entry it writes the post to.
+*
+* Arguments  : pq            is a pointer to the interrupt queue.
+*
+* Returns    : != (OS_INT_Q_ENTRY *)0  is a pointer to the entry at OSIntQIn
+*              == (OS_INT_Q_ENTRY *)0  if the ring is full
+*********************************************************************************************************
+*/
+
+static  OS_INT_Q_ENTRY  *OS_IntQEntryGet (OS_INT_Q *pq)
+{
+    INT16U  next;
+
+
+    next = pq->OSIntQIn + 1;
+    if (next == pq->OSIntQSize) {
+        next = 0;
+    }
+    if (next == pq->OSIntQOut) {                      /* Leave one entry empty                         */
+        pq->OSIntQOvfCtr++;
+        return ((OS_INT_Q_ENTRY *)0);
+    }
+    return (&pq->OSIntQStart[pq->OSIntQIn]);
+}
+
+/*$PAGE*/
+/*
+*********************************************************************************************************
+*                                  PUBLISH THE ENTRY OF AN INTERRUPT QUEUE
+*
+* Description: This function is called by the ISR once it wrote the entry OS_IntQEntryGet() returned.  It
+*              advances OSIntQIn and tells OSIntExit() that a post was deferred.
+*
+* Arguments  : pq            is a pointer to the interrupt queue.
+*
+* Returns    : none
+*********************************************************************************************************
+*/
+
+static  void  OS_IntQEntryPut (OS_INT_Q *pq)
+{
+    INT16U  in;
+    INT16U  out;
+    INT16U  nbr;
+
+
+    in  = pq->OSIntQIn + 1;
+    if (in == pq->OSIntQSize) {
+        in = 0;
+    }
+    OS_CPU_BARRIER();                                 /* Write the entry before the index              */
+    pq->OSIntQIn = in;
+    out = pq->OSIntQOut;
+    nbr = (in >= out) ? (in - out) : (in + pq->OSIntQSize - out);
+    if (nbr > pq->OSIntQMax) {                        /* Keep track of the high-water mark             */
+        pq->OSIntQMax = nbr;
+    }
+    OSIntQPend = OS_TRUE;
+}
+
+/*$PAGE*/
+/*
+*********************************************************************************************************
+*                                     DO A DEFERRED POST
+*
+* Description: This function is called by OS_IntQDrain() to do the post an ISR deferred.
+*
+* Arguments  : pentry        is a pointer to a copy of the entry.
+*
+* Returns    : The error code of the post.
+*********************************************************************************************************
+*/
+
+static  INT8U  OS_IntQEntryPost (OS_INT_Q_ENTRY *pentry)
+{
+#if (OS_FLAG_EN > 0) && (OS_MAX_FLAGS > 0)
+    INT8U  err;
+#endif
+
+
+    switch (pentry->OSIntQType) {
+#if OS_SEM_EN > 0
+        case OS_EVENT_TYPE_SEM:
+             return (OSSemPost((OS_EVENT *)pentry->OSIntQObj));
+#endif
+
+#if OS_MBOX_EN > 0
+        case OS_EVENT_TYPE_MBOX:
+#if OS_MBOX_POST_OPT_EN > 0
+             return (OSMboxPostOpt((OS_EVENT *)pentry->OSIntQObj, pentry->OSIntQMsg, pentry->OSIntQOpt));
+#else
+             return (OSMboxPost((OS_EVENT *)pentry->OSIntQObj, pentry->OSIntQMsg));
+#endif
+#endif
+
+#if (OS_Q_EN > 0) && (OS_MAX_QS > 0)
+        case OS_EVENT_TYPE_Q:
+#if OS_Q_POST_OPT_EN > 0
+             return (OSQPostOpt((OS_EVENT *)pentry->OSIntQObj, pentry->OSIntQMsg, pentry->OSIntQOpt));
+#else
+             return (OSQPost((OS_EVENT *)pentry->OSIntQObj, pentry->OSIntQMsg));
+#endif
+#endif
+
+#if (OS_FLAG_EN > 0) && (OS_MAX_FLAGS > 0)
+        case OS_EVENT_TYPE_FLAG:
+             (void)OSFlagPost((OS_FLAG_GRP *)pentry->OSIntQObj, pentry->OSIntQFlags, pentry->OSIntQOpt, &err);
+             return (err);
+#endif
+
+        default:
+             return (OS_ERR_EVENT_TYPE);
+    }
+}
+#endif                                                      /* OS_INT_Q_EN                              */
@@ -97,6 +97,9 @@ OS_EVENT  *OSMboxCreate (void *pmsg)
     if (OSIntNesting > 0) {                      /* See if called from ISR ...                         */
         return ((OS_EVENT *)0);                  /* ... can't CREATE from an ISR                       */
     }
+#if OS_SLAB_EN > 0
+    OS_SlabEventRefill();                        /* Grow the free list if it is empty                  */
+#endif
     OS_ENTER_CRITICAL();
     pevent = OSEventFreeList;                    /* Get next free event control block                  */
     if (OSEventFreeList != (OS_EVENT *)0) {      /* See if pool of free ECB pool was empty             */
@@ -110,6 +113,9 @@ OS_EVENT  *OSMboxCreate (void *pmsg)
 #if OS_EVENT_NAME_SIZE > 1
         pevent->OSEventName[0] = '?';
         pevent->OSEventName[1] = OS_ASCII_NUL;
+#endif
+#if OS_EVENT_PROF_EN > 0
+        OS_MemClr((INT8U *)&pevent->OSEventProf, sizeof(OS_EVENT_PROF));
 #endif
         OS_EventWaitListInit(pevent);
     }
@@ -192,6 +198,9 @@ OS_EVENT  *OSMboxDel (OS_EVENT *pevent, INT8U opt, INT8U *perr)
 #if OS_EVENT_NAME_SIZE > 1
                  pevent->OSEventName[0] = '?';             /* Unknown name                             */
                  pevent->OSEventName[1] = OS_ASCII_NUL;
+#endif
+#if (OS_SET_EN > 0) && (OS_MAX_SETS > 0)
+                 OS_SetUnlink(pevent);
 #endif
                  pevent->OSEventType = OS_EVENT_TYPE_UNUSED;
                  pevent->OSEventPtr  = OSEventFreeList;    /* Return Event Control Block to free list  */
@@ -214,6 +223,9 @@ OS_EVENT  *OSMboxDel (OS_EVENT *pevent, INT8U opt, INT8U *perr)
 #if OS_EVENT_NAME_SIZE > 1
              pevent->OSEventName[0] = '?';                 /* Unknown name                             */
              pevent->OSEventName[1] = OS_ASCII_NUL;
+#endif
+#if (OS_SET_EN > 0) && (OS_MAX_SETS > 0)
+             OS_SetUnlink(pevent);
 #endif
              pevent->OSEventType    = OS_EVENT_TYPE_UNUSED;
              pevent->OSEventPtr     = OSEventFreeList;     /* Return Event Control Block to free list  */
@@ -302,6 +314,9 @@ void  *OSMboxPend (OS_EVENT *pevent, INT16U timeout, INT8U *perr)
         return ((void *)0);
     }
     OS_ENTER_CRITICAL();
+#if OS_EVENT_PROF_EN > 0
+    pevent->OSEventProf.OSPendCtr++;
+#endif
     pmsg = pevent->OSEventPtr;
     if (pmsg != (void *)0) {                          /* See if there is already a message             */
         pevent->OSEventPtr = (void *)0;               /* Clear the mailbox                             */
@@ -311,11 +326,14 @@ void  *OSMboxPend (OS_EVENT *pevent, INT16U timeout, INT8U *perr)
     }
     OSTCBCur->OSTCBStat     |= OS_STAT_MBOX;          /* Message not available, task will pend         */
     OSTCBCur->OSTCBStatPend  = OS_STAT_PEND_OK;
-    OSTCBCur->OSTCBDly       = timeout;               /* Load timeout in TCB                           */
+    OS_TickListInsert(OSTCBCur, timeout);            /* Load timeout in TCB and tick list             */
     OS_EventTaskWait(pevent);                         /* Suspend task until event or timeout occurs    */
     OS_EXIT_CRITICAL();
     OS_Sched();                                       /* Find next highest priority task ready to run  */
     OS_ENTER_CRITICAL();
+#if OS_EVENT_PROF_EN > 0
+    OS_EventProfWake(&pevent->OSEventProf);           /* Account the blocked and the wakeup time       */
+#endif
     switch (OSTCBCur->OSTCBStatPend) {                /* See if we timed-out or aborted                */
         case OS_STAT_PEND_OK:
              pmsg =  OSTCBCur->OSTCBMsg;
@@ -344,6 +362,43 @@ void  *OSMboxPend (OS_EVENT *pevent, INT16U timeout, INT8U *perr)
     OS_EXIT_CRITICAL();
     return (pmsg);                                    /* Return received message                       */
 }
+
+/*$PAGE*/
+/*
+*********************************************************************************************************
+*                                  PEND ON MAILBOX, NANOSECOND TIMEOUT
+*
+* Description: This function is OSMboxPend() with a timeout in nanoseconds.  The timeout is not
+*              rounded up to clock ticks, it ends at the time stamp of the port (OSCPUTsGet()) it is due.
+*
+* Arguments  : pevent        is a pointer to the event control block associated with the desired
+*                            mailbox.
+*
+*              timeout_ns    is an optional timeout period in nanoseconds.  If you specify 0, your task
+*                            will wait forever like with OSMboxPend().
+*
+*              perr          is a pointer to where an error message will be deposited, the same as for
+*                            OSMboxPend().
+*
+* Returns    : the message received, or a NULL pointer on a timeout or error.
+*********************************************************************************************************
+*/
+
+#if OS_TIME_NS_EN > 0
+void  *OSMboxPendNs (OS_EVENT *pevent, INT64U timeout_ns, INT8U *perr)
+{
+    void  *pmsg;
+
+
+    if ((timeout_ns == 0) || (OSIntNesting > 0)) {   /* Wait forever, or let OSMboxPend() fail        */
+        return (OSMboxPend(pevent, 0, perr));
+    }
+    OS_DlyNsSet(timeout_ns);
+    pmsg = OSMboxPend(pevent, 0, perr);
+    OS_DlyNsSet(0);
+    return (pmsg);
+}
+#endif
 /*$PAGE*/
 /*
 *********************************************************************************************************
@@ -472,6 +527,9 @@ INT8U  OSMboxPost (OS_EVENT *pevent, void *pmsg)
         return (OS_ERR_EVENT_TYPE);
     }
     OS_ENTER_CRITICAL();
+#if OS_EVENT_PROF_EN > 0
+    pevent->OSEventProf.OSPostCtr++;
+#endif
     if (pevent->OSEventGrp != 0) {                    /* See if any task pending on mailbox            */
                                                       /* Ready HPT waiting on event                    */
         (void)OS_EventTaskRdy(pevent, pmsg, OS_STAT_MBOX, OS_STAT_PEND_OK);
@@ -484,6 +542,16 @@ INT8U  OSMboxPost (OS_EVENT *pevent, void *pmsg)
         return (OS_ERR_MBOX_FULL);
     }
     pevent->OSEventPtr = pmsg;                        /* Place message in mailbox                      */
+#if OS_EVENT_PROF_EN > 0
+    pevent->OSEventProf.OSDepthMax = 1;
+#endif
+#if (OS_SET_EN > 0) && (OS_MAX_SETS > 0)
+    if (OS_SetSignal(pevent) == OS_TRUE) {            /* Ready the task pending on the event set       */
+        OS_EXIT_CRITICAL();
+        OS_Sched();
+        return (OS_ERR_NONE);
+    }
+#endif
     OS_EXIT_CRITICAL();
     return (OS_ERR_NONE);
 }
@@ -543,6 +611,9 @@ INT8U  OSMboxPostOpt (OS_EVENT *pevent, void *pmsg, INT8U opt)
         return (OS_ERR_EVENT_TYPE);
     }
     OS_ENTER_CRITICAL();
+#if OS_EVENT_PROF_EN > 0
+    pevent->OSEventProf.OSPostCtr++;
+#endif
     if (pevent->OSEventGrp != 0) {                    /* See if any task pending on mailbox            */
         if ((opt & OS_POST_OPT_BROADCAST) != 0x00) {  /* Do we need to post msg to ALL waiting tasks ? */
             while (pevent->OSEventGrp != 0) {         /* Yes, Post to ALL tasks waiting on mailbox     */
@@ -562,6 +633,18 @@ INT8U  OSMboxPostOpt (OS_EVENT *pevent, void *pmsg, INT8U opt)
         return (OS_ERR_MBOX_FULL);
     }
     pevent->OSEventPtr = pmsg;                        /* Place message in mailbox                      */
+#if OS_EVENT_PROF_EN > 0
+    pevent->OSEventProf.OSDepthMax = 1;
+#endif
+#if (OS_SET_EN > 0) && (OS_MAX_SETS > 0)
+    if (OS_SetSignal(pevent) == OS_TRUE) {            /* Ready the task pending on the event set       */
+        OS_EXIT_CRITICAL();
+        if ((opt & OS_POST_OPT_NO_SCHED) == 0) {
+            OS_Sched();
+        }
+        return (OS_ERR_NONE);
+    }
+#endif
     OS_EXIT_CRITICAL();
     return (OS_ERR_NONE);
 }
@@ -590,13 +673,8 @@ INT8U  OSMboxPostOpt (OS_EVENT *pevent, void *pmsg, INT8U opt)
 INT8U  OSMboxQuery (OS_EVENT *pevent, OS_MBOX_DATA *p_mbox_data)
 {
     INT8U      i;
-#if OS_LOWEST_PRIO <= 63
-    INT8U     *psrc;
-    INT8U     *pdest;
-#else
-    INT16U    *psrc;
-    INT16U    *pdest;
-#endif
+    OS_PRIO_TBL *psrc;
+    OS_PRIO_TBL *pdest;
 #if OS_CRITICAL_METHOD == 3                                /* Allocate storage for CPU status register */
     OS_CPU_SR  cpu_sr = 0;
 #endif
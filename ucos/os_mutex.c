@@ -46,6 +46,18 @@
 
 static  void  OSMutex_RdyAtPrio(OS_TCB *ptcb, INT8U prio);
 
+#if OS_MUTEX_PROTOCOL_EN > 0
+static  INT8U  OSMutex_Own(OS_EVENT *pevent, OS_TCB *ptcb);
+static  void   OSMutex_Unlink(OS_EVENT *pevent, OS_TCB *ptcb);
+static  INT8U  OSMutex_WaitPrio(OS_EVENT *pevent);
+static  void   OSMutex_PrioSet(OS_TCB *ptcb, INT8U prio);
+#endif
+
+#if OS_MUTEX_STAT_EN > 0
+static  void   OSMutex_StatLock(OS_EVENT *pevent);
+static  void   OSMutex_StatUnlock(OS_EVENT *pevent);
+#endif
+
 /*$PAGE*/
 /*
 *********************************************************************************************************
@@ -110,6 +122,16 @@ BOOLEAN  OSMutexAccept (OS_EVENT *pevent, INT8U *perr)
     OS_ENTER_CRITICAL();                               /* Get value (0 or 1) of Mutex                  */
     pip = (INT8U)(pevent->OSEventCnt >> 8);            /* Get PIP from mutex                           */
     if ((pevent->OSEventCnt & OS_MUTEX_KEEP_LOWER_8) == OS_MUTEX_AVAILABLE) {
+#if OS_MUTEX_STAT_EN > 0
+        OSMutex_StatLock(pevent);
+#endif
+#if OS_MUTEX_PROTOCOL_EN > 0
+        if (pevent->OSEventMutexOpt != OS_MUTEX_OPT_PIP) {  /* Ceiling or inheritance mutex            */
+            *perr = OSMutex_Own(pevent, OSTCBCur);
+            OS_EXIT_CRITICAL();
+            return (OS_TRUE);
+        }
+#endif
         pevent->OSEventCnt &= OS_MUTEX_KEEP_UPPER_8;   /*      Mask off LSByte (Acquire Mutex)         */
         pevent->OSEventCnt |= OSTCBCur->OSTCBPrio;     /*      Save current task priority in LSByte    */
         pevent->OSEventPtr  = (void *)OSTCBCur;        /*      Link TCB of task owning Mutex           */
@@ -122,6 +144,9 @@ BOOLEAN  OSMutexAccept (OS_EVENT *pevent, INT8U *perr)
         }
         return (OS_TRUE);
     }
+#if OS_MUTEX_STAT_EN > 0
+    pevent->OSEventMutexContCtr++;
+#endif
     OS_EXIT_CRITICAL();
     *perr = OS_ERR_NONE;
     return (OS_FALSE);
@@ -185,6 +210,9 @@ OS_EVENT  *OSMutexCreate (INT8U prio, INT8U *perr)
         *perr = OS_ERR_CREATE_ISR;                         /* ... can't CREATE mutex from an ISR       */
         return ((OS_EVENT *)0);
     }
+#if OS_SLAB_EN > 0
+    OS_SlabEventRefill();                                  /* Grow the free list if it is empty        */
+#endif
     OS_ENTER_CRITICAL();
     if (OSTCBPrioTbl[prio] != (OS_TCB *)0) {               /* Mutex priority must not already exist    */
         OS_EXIT_CRITICAL();                                /* Task already exist at priority ...       */
@@ -204,15 +232,162 @@ OS_EVENT  *OSMutexCreate (INT8U prio, INT8U *perr)
     pevent->OSEventType    = OS_EVENT_TYPE_MUTEX;
     pevent->OSEventCnt     = (INT16U)((INT16U)prio << 8) | OS_MUTEX_AVAILABLE; /* Resource is avail.   */
     pevent->OSEventPtr     = (void *)0;                                 /* No task owning the mutex    */
+#if OS_MUTEX_PROTOCOL_EN > 0
+    pevent->OSEventMutexOpt  = OS_MUTEX_OPT_PIP;
+    pevent->OSEventMutexNext = (OS_EVENT *)0;
+#endif
+#if OS_MUTEX_STAT_EN > 0
+    pevent->OSEventMutexHoldTot = 0L;
+    pevent->OSEventMutexHoldMax = 0L;
+    pevent->OSEventMutexLockCtr = 0L;
+    pevent->OSEventMutexContCtr = 0L;
+#endif
 #if OS_EVENT_NAME_SIZE > 1
     pevent->OSEventName[0] = '?';
     pevent->OSEventName[1] = OS_ASCII_NUL;
+#endif
+#if OS_EVENT_PROF_EN > 0
+    OS_MemClr((INT8U *)&pevent->OSEventProf, sizeof(OS_EVENT_PROF));
 #endif
     OS_EventWaitListInit(pevent);
     *perr                  = OS_ERR_NONE;
     return (pevent);
 }
 
+/*$PAGE*/
+/*
+*********************************************************************************************************
+*                        CREATE A MUTUAL EXCLUSION SEMAPHORE WITH A PROTOCOL
+*
+* Description: This function creates a mutual exclusion semaphore that avoids priority inversion with
+*              one of the following protocols:
+*
+*              OS_MUTEX_OPT_PIP      The owner is raised to the priority 'prio', which is reserved for the
+*                                    mutex, when a higher priority task waits (see OSMutexCreate()).
+*
+*              OS_MUTEX_OPT_CEILING  Immediate priority ceiling.  The owner runs at the priority 'prio' as
+*                                    long as it holds the mutex, no task that could lock the mutex can
+*                                    preempt it.  'prio' is the priority of the highest priority task
+*                                    using the mutex and is not reserved, any number of mutexes may
+*                                    share a ceiling.
+*
+*              OS_MUTEX_OPT_INHERIT  Priority inheritance.  The owner runs at the priority of the highest
+*                                    priority task waiting for the mutex.  If the owner itself waits for
+*                                    a ceiling or inheritance mutex the priority is passed on to the owner
+*                                    of that mutex and so on.  'prio' is not used.
+*
+* Arguments  : prio          is the priority inheritance priority or the ceiling of the mutex.
+*
+*              opt           is the protocol of the mutex (see above).
+*
+*              perr          is a pointer to an error code which will be returned to your application:
+*                               OS_ERR_NONE         if the call was successful.
+*                               OS_ERR_CREATE_ISR   if you attempted to create a MUTEX from an ISR
+*                               OS_ERR_PRIO_EXIST   if a task at the priority inheritance priority
+*                                                   already exist, or the ceiling is the PIP of another
+*                                                   mutex.
+*                               OS_ERR_PEVENT_NULL  No more event control blocks available.
+*                               OS_ERR_PRIO_INVALID if the priority you specify is higher that the
+*                                                   maximum allowed (i.e. > OS_LOWEST_PRIO)
+*                               OS_ERR_INVALID_OPT  if 'opt' is not one of the protocols above.
+*
+* Returns    : != (void *)0  is a pointer to the event control clock (OS_EVENT) associated with the
+*                            created mutex.
+*              == (void *)0  if an error is detected.
+*
+* Note(s)    : 1) The ceiling and inheritance mutexes share the priority of a task with OS_SCHED_RR_EN.
+*                 A task that is raised to a priority takes the turn of the priority.
+*
+*              2) The priority of a task holding ceiling or inheritance mutexes is the highest of its own
+*                 priority (see OSTaskChangePrio()), the ceilings of the mutexes and the priorities of the
+*                 tasks waiting for them.  It is recomputed whenever one of these changes, so mutexes may
+*                 be nested and released in any order.  A ceiling mutex only has waiting tasks if its
+*                 ceiling is too low or its owner waits while holding it.
+*
+*              3) A task must not hold a PIP mutex while it locks a ceiling or inheritance mutex.
+*********************************************************************************************************
+*/
+
+#if OS_MUTEX_PROTOCOL_EN > 0
+OS_EVENT  *OSMutexCreateExt (INT8U prio, INT8U opt, INT8U *perr)
+{
+    OS_EVENT  *pevent;
+#if OS_CRITICAL_METHOD == 3                                /* Allocate storage for CPU status register */
+    OS_CPU_SR  cpu_sr = 0;
+#endif
+
+
+
+#if OS_ARG_CHK_EN > 0
+    if (perr == (INT8U *)0) {                              /* Validate 'perr'                          */
+        return ((OS_EVENT *)0);
+    }
+#endif
+    switch (opt) {
+        case OS_MUTEX_OPT_PIP:
+             return (OSMutexCreate(prio, perr));
+
+        case OS_MUTEX_OPT_CEILING:
+             if (prio >= OS_LOWEST_PRIO) {                 /* Validate ceiling                         */
+                 *perr = OS_ERR_PRIO_INVALID;
+                 return ((OS_EVENT *)0);
+             }
+             break;
+
+        case OS_MUTEX_OPT_INHERIT:
+             prio = OS_PRIO_SELF;                          /* No ceiling                               */
+             break;
+
+        default:
+             *perr = OS_ERR_INVALID_OPT;
+             return ((OS_EVENT *)0);
+    }
+    if (OSIntNesting > 0) {                                /* See if called from ISR ...               */
+        *perr = OS_ERR_CREATE_ISR;                         /* ... can't CREATE mutex from an ISR       */
+        return ((OS_EVENT *)0);
+    }
+#if OS_SLAB_EN > 0
+    OS_SlabEventRefill();                                  /* Grow the free list if it is empty        */
+#endif
+    OS_ENTER_CRITICAL();
+    if ((opt == OS_MUTEX_OPT_CEILING) &&                   /* Ceiling must not be reserved by a PIP    */
+        (OSTCBPrioTbl[prio] == OS_TCB_RESERVED)) {
+        OS_EXIT_CRITICAL();
+        *perr = OS_ERR_PRIO_EXIST;
+        return ((OS_EVENT *)0);
+    }
+    pevent = OSEventFreeList;                              /* Get next free event control block        */
+    if (pevent == (OS_EVENT *)0) {                         /* See if an ECB was available              */
+        OS_EXIT_CRITICAL();
+        *perr = OS_ERR_PEVENT_NULL;                        /* No more event control blocks             */
+        return (pevent);
+    }
+    OSEventFreeList          = (OS_EVENT *)OSEventFreeList->OSEventPtr;  /* Adjust the free list       */
+    OS_EXIT_CRITICAL();
+    pevent->OSEventType      = OS_EVENT_TYPE_MUTEX;
+    pevent->OSEventCnt       = (INT16U)((INT16U)prio << 8) | OS_MUTEX_AVAILABLE; /* Resource is avail. */
+    pevent->OSEventPtr       = (void *)0;                                /* No task owning the mutex   */
+    pevent->OSEventMutexOpt  = opt;
+    pevent->OSEventMutexNext = (OS_EVENT *)0;
+#if OS_MUTEX_STAT_EN > 0
+    pevent->OSEventMutexHoldTot = 0L;
+    pevent->OSEventMutexHoldMax = 0L;
+    pevent->OSEventMutexLockCtr = 0L;
+    pevent->OSEventMutexContCtr = 0L;
+#endif
+#if OS_EVENT_NAME_SIZE > 1
+    pevent->OSEventName[0]   = '?';
+    pevent->OSEventName[1]   = OS_ASCII_NUL;
+#endif
+#if OS_EVENT_PROF_EN > 0
+    OS_MemClr((INT8U *)&pevent->OSEventProf, sizeof(OS_EVENT_PROF));
+#endif
+    OS_EventWaitListInit(pevent);
+    *perr                    = OS_ERR_NONE;
+    return (pevent);
+}
+#endif
+
 /*$PAGE*/
 /*
 *********************************************************************************************************
@@ -298,8 +473,19 @@ OS_EVENT  *OSMutexDel (OS_EVENT *pevent, INT8U opt, INT8U *perr)
                  pevent->OSEventName[0] = '?';             /* Unknown name                             */
                  pevent->OSEventName[1] = OS_ASCII_NUL;
 #endif
-                 pip                 = (INT8U)(pevent->OSEventCnt >> 8);
-                 OSTCBPrioTbl[pip]   = (OS_TCB *)0;        /* Free up the PIP                          */
+#if OS_MUTEX_PROTOCOL_EN > 0
+                 if (pevent->OSEventMutexOpt != OS_MUTEX_OPT_PIP) {
+                     ptcb = (OS_TCB *)pevent->OSEventPtr;
+                     if (ptcb != (OS_TCB *)0) {            /* Owner loses the ceiling of the mutex     */
+                         OSMutex_Unlink(pevent, ptcb);
+                         OS_MutexPrioUpdate(ptcb);
+                     }
+                 } else
+#endif
+                 {
+                     pip               = (INT8U)(pevent->OSEventCnt >> 8);
+                     OSTCBPrioTbl[pip] = (OS_TCB *)0;      /* Free up the PIP                          */
+                 }
                  pevent->OSEventType = OS_EVENT_TYPE_UNUSED;
                  pevent->OSEventPtr  = OSEventFreeList;    /* Return Event Control Block to free list  */
                  pevent->OSEventCnt  = 0;
@@ -318,10 +504,21 @@ OS_EVENT  *OSMutexDel (OS_EVENT *pevent, INT8U opt, INT8U *perr)
              pip  = (INT8U)(pevent->OSEventCnt >> 8);                     /* Get PIP of mutex          */
              prio = (INT8U)(pevent->OSEventCnt & OS_MUTEX_KEEP_LOWER_8);  /* Get owner's original prio */
              ptcb = (OS_TCB *)pevent->OSEventPtr;
-             if (ptcb != (OS_TCB *)0) {                    /* See if any task owns the mutex           */
-                 if (ptcb->OSTCBPrio == pip) {             /* See if original prio was changed         */
-                     OSMutex_RdyAtPrio(ptcb, prio);        /* Yes, Restore the task's original prio    */
+#if OS_MUTEX_PROTOCOL_EN > 0
+             if (pevent->OSEventMutexOpt != OS_MUTEX_OPT_PIP) {
+                 if (ptcb != (OS_TCB *)0) {                /* Owner loses the boost of the mutex       */
+                     OSMutex_Unlink(pevent, ptcb);
+                     OS_MutexPrioUpdate(ptcb);
+                 }
+             } else
+#endif
+             {
+                 if (ptcb != (OS_TCB *)0) {                /* See if any task owns the mutex           */
+                     if (ptcb->OSTCBPrio == pip) {         /* See if original prio was changed         */
+                         OSMutex_RdyAtPrio(ptcb, prio);    /* Yes, Restore the task's original prio    */
+                     }
                  }
+                 OSTCBPrioTbl[pip] = (OS_TCB *)0;          /* Free up the PIP                          */
              }
              while (pevent->OSEventGrp != 0) {             /* Ready ALL tasks waiting for mutex        */
                  (void)OS_EventTaskRdy(pevent, (void *)0, OS_STAT_MUTEX, OS_STAT_PEND_OK);
@@ -330,14 +527,13 @@ OS_EVENT  *OSMutexDel (OS_EVENT *pevent, INT8U opt, INT8U *perr)
              pevent->OSEventName[0] = '?';                 /* Unknown name                             */
              pevent->OSEventName[1] = OS_ASCII_NUL;
 #endif
-             pip                 = (INT8U)(pevent->OSEventCnt >> 8);
-             OSTCBPrioTbl[pip]   = (OS_TCB *)0;            /* Free up the PIP                          */
              pevent->OSEventType = OS_EVENT_TYPE_UNUSED;
              pevent->OSEventPtr  = OSEventFreeList;        /* Return Event Control Block to free list  */
              pevent->OSEventCnt  = 0;
              OSEventFreeList     = pevent;                 /* Get next free event control block        */
              OS_EXIT_CRITICAL();
-             if (tasks_waiting == OS_TRUE) {               /* Reschedule only if task(s) were waiting  */
+             if ((tasks_waiting == OS_TRUE) ||             /* Reschedule only if task(s) were waiting  */
+                 (ptcb != (OS_TCB *)0)) {                  /* ... or the owner may have lost a boost   */
                  OS_Sched();                               /* Find highest priority task ready to run  */
              }
              *perr         = OS_ERR_NONE;
@@ -390,8 +586,14 @@ OS_EVENT  *OSMutexDel (OS_EVENT *pevent, INT8U opt, INT8U *perr)
 * Returns    : none
 *
 * Note(s)    : 1) The task that owns the Mutex MUST NOT pend on any other event while it owns the mutex.
+*                 A task that owns a ceiling or inheritance mutex may pend on another mutex of these
+*                 kinds, the owner of that mutex then inherits the priority transitively.
+*
+*              2) You MUST NOT change the priority of the task that owns a PIP mutex.
 *
-*              2) You MUST NOT change the priority of the task that owns the mutex
+*              3) The owner of an inheritance mutex runs at the priority of its highest priority waiter
+*                 while it has one, it gets its priority back when the waiter got the mutex, timed out
+*                 or was deleted.
 *********************************************************************************************************
 */
 
@@ -402,7 +604,9 @@ void  OSMutexPend (OS_EVENT *pevent, INT16U timeout, INT8U *perr)
     BOOLEAN    rdy;                                        /* Flag indicating task was ready           */
     OS_TCB    *ptcb;
     OS_EVENT  *pevent2;
+#if OS_SCHED_RR_EN == 0
     INT8U      y;
+#endif
 #if OS_CRITICAL_METHOD == 3                                /* Allocate storage for CPU status register */
     OS_CPU_SR  cpu_sr = 0;
 #endif
@@ -432,9 +636,22 @@ void  OSMutexPend (OS_EVENT *pevent, INT16U timeout, INT8U *perr)
     }
 /*$PAGE*/
     OS_ENTER_CRITICAL();
+#if OS_EVENT_PROF_EN > 0
+    pevent->OSEventProf.OSPendCtr++;
+#endif
     pip = (INT8U)(pevent->OSEventCnt >> 8);                /* Get PIP from mutex                       */
                                                            /* Is Mutex available?                      */
     if ((INT8U)(pevent->OSEventCnt & OS_MUTEX_KEEP_LOWER_8) == OS_MUTEX_AVAILABLE) {
+#if OS_MUTEX_STAT_EN > 0
+        OSMutex_StatLock(pevent);
+#endif
+#if OS_MUTEX_PROTOCOL_EN > 0
+        if (pevent->OSEventMutexOpt != OS_MUTEX_OPT_PIP) { /* Ceiling or inheritance mutex             */
+            *perr = OSMutex_Own(pevent, OSTCBCur);
+            OS_EXIT_CRITICAL();
+            return;
+        }
+#endif
         pevent->OSEventCnt &= OS_MUTEX_KEEP_UPPER_8;       /* Yes, Acquire the resource                */
         pevent->OSEventCnt |= OSTCBCur->OSTCBPrio;         /*      Save priority of owning task        */
         pevent->OSEventPtr  = (void *)OSTCBCur;            /*      Point to owning task's OS_TCB       */
@@ -449,8 +666,25 @@ void  OSMutexPend (OS_EVENT *pevent, INT16U timeout, INT8U *perr)
     }
     mprio = (INT8U)(pevent->OSEventCnt & OS_MUTEX_KEEP_LOWER_8);  /* No, Get priority of mutex owner   */
     ptcb  = (OS_TCB *)(pevent->OSEventPtr);                       /*     Point to TCB of mutex owner   */
+#if OS_MUTEX_STAT_EN > 0
+    pevent->OSEventMutexContCtr++;
+#endif
+#if OS_MUTEX_PROTOCOL_EN > 0
+    if (pevent->OSEventMutexOpt != OS_MUTEX_OPT_PIP) {            /*     Owner inherits after the wait */
+        pip = OS_PRIO_SELF;
+    }
+#endif
     if (ptcb->OSTCBPrio > pip) {                                  /*     Need to promote prio of owner?*/
         if (mprio > OSTCBCur->OSTCBPrio) {
+#if OS_SCHED_RR_EN > 0
+            rdy = ptcb->OSTCBRRRdy;                               /*     See if mutex owner is ready   */
+            OS_RdyListRemove(ptcb);                               /*     Remove owner from Rdy list ...*/
+            pevent2 = ptcb->OSTCBEventPtr;                        /*     ... and wait list at its prio */
+            if ((rdy == OS_FALSE) && (pevent2 != (OS_EVENT *)0)) {
+                OS_EventTaskRemove(ptcb, pevent2);
+            }
+            OS_PrioRingRemove(ptcb);                              /*     Owner alone at the PIP        */
+#else
             y = ptcb->OSTCBY;
             if ((OSRdyTbl[y] & ptcb->OSTCBBitX) != 0) {           /*     See if mutex owner is ready   */
                 OSRdyTbl[y] &= ~ptcb->OSTCBBitX;                  /*     Yes, Remove owner from Rdy ...*/
@@ -467,21 +701,13 @@ void  OSMutexPend (OS_EVENT *pevent, INT16U timeout, INT8U *perr)
                 }
                 rdy = OS_FALSE;                            /* No                                       */
             }
-            ptcb->OSTCBPrio = pip;                         /* Change owner task prio to PIP            */
-#if OS_LOWEST_PRIO <= 63
-            ptcb->OSTCBY    = (INT8U)( ptcb->OSTCBPrio >> 3);
-            ptcb->OSTCBX    = (INT8U)( ptcb->OSTCBPrio & 0x07);
-            ptcb->OSTCBBitY = (INT8U)(1 << ptcb->OSTCBY);
-            ptcb->OSTCBBitX = (INT8U)(1 << ptcb->OSTCBX);
-#else
-            ptcb->OSTCBY    = (INT8U)((ptcb->OSTCBPrio >> 4) & 0xFF);
-            ptcb->OSTCBX    = (INT8U)( ptcb->OSTCBPrio & 0x0F);
-            ptcb->OSTCBBitY = (INT16U)(1 << ptcb->OSTCBY);
-            ptcb->OSTCBBitX = (INT16U)(1 << ptcb->OSTCBX);
+#endif
+            OS_TCBPrioSet(ptcb, pip);                      /* Change owner task prio to PIP            */
+#if OS_SCHED_RR_EN > 0
+            OS_PrioRingInsert(ptcb);                       /* Takes OSTCBPrioTbl[pip] over             */
 #endif
             if (rdy == OS_TRUE) {                          /* If task was ready at owner's priority ...*/
-                OSRdyGrp               |= ptcb->OSTCBBitY; /* ... make it ready at new priority.       */
-                OSRdyTbl[ptcb->OSTCBY] |= ptcb->OSTCBBitX;
+                OS_RdyListInsert(ptcb);                    /* ... make it ready at new priority.       */
             } else {
                 pevent2 = ptcb->OSTCBEventPtr;
                 if (pevent2 != (OS_EVENT *)0) {            /* Add to event wait list                   */
@@ -494,14 +720,29 @@ void  OSMutexPend (OS_EVENT *pevent, INT16U timeout, INT8U *perr)
     }
     OSTCBCur->OSTCBStat     |= OS_STAT_MUTEX;         /* Mutex not available, pend current task        */
     OSTCBCur->OSTCBStatPend  = OS_STAT_PEND_OK;
-    OSTCBCur->OSTCBDly       = timeout;               /* Store timeout in current task's TCB           */
+    OS_TickListInsert(OSTCBCur, timeout);            /* Store timeout in current task's TCB           */
     OS_EventTaskWait(pevent);                         /* Suspend task until event or timeout occurs    */
+#if OS_MUTEX_PROTOCOL_EN > 0
+    if (pevent->OSEventMutexOpt != OS_MUTEX_OPT_PIP) {
+        OS_MutexPrioUpdate(ptcb);                     /* Owner (and its owners) inherit our priority   */
+    }
+#endif
     OS_EXIT_CRITICAL();
     OS_Sched();                                       /* Find next highest priority task ready         */
     OS_ENTER_CRITICAL();
+#if OS_EVENT_PROF_EN > 0
+    OS_EventProfWake(&pevent->OSEventProf);           /* Account the blocked and the wakeup time       */
+#endif
     switch (OSTCBCur->OSTCBStatPend) {                /* See if we timed-out or aborted                */
         case OS_STAT_PEND_OK:
              *perr = OS_ERR_NONE;
+#if OS_MUTEX_PROTOCOL_EN > 0
+             if (pevent->OSEventMutexOpt == OS_MUTEX_OPT_CEILING) {    /* Ceiling must be higher       */
+                 if (OSTCBCur->OSTCBBasePrio < (INT8U)(pevent->OSEventCnt >> 8)) {
+                     *perr = OS_ERR_PIP_LOWER;
+                 }
+             }
+#endif
              break;
 
         case OS_STAT_PEND_ABORT:
@@ -514,6 +755,14 @@ void  OSMutexPend (OS_EVENT *pevent, INT16U timeout, INT8U *perr)
              *perr = OS_ERR_TIMEOUT;                  /* Indicate that we didn't get mutex within TO   */
              break;
     }
+#if OS_MUTEX_PROTOCOL_EN > 0
+    if ((*perr != OS_ERR_NONE) && (*perr != OS_ERR_PIP_LOWER)) {
+        ptcb = (OS_TCB *)pevent->OSEventPtr;
+        if ((pevent->OSEventMutexOpt != OS_MUTEX_OPT_PIP) && (ptcb != (OS_TCB *)0)) {
+            OS_MutexPrioUpdate(ptcb);                 /* Owner no longer inherits our priority         */
+        }
+    }
+#endif
     OSTCBCur->OSTCBStat          =  OS_STAT_RDY;      /* Set   task  status to ready                   */
     OSTCBCur->OSTCBStatPend      =  OS_STAT_PEND_OK;  /* Clear pend  status                            */
     OSTCBCur->OSTCBEventPtr      = (OS_EVENT  *)0;    /* Clear event pointers                          */
@@ -522,6 +771,40 @@ void  OSMutexPend (OS_EVENT *pevent, INT16U timeout, INT8U *perr)
 #endif
     OS_EXIT_CRITICAL();
 }
+
+/*$PAGE*/
+/*
+*********************************************************************************************************
+*                        PEND ON MUTUAL EXCLUSION SEMAPHORE, NANOSECOND TIMEOUT
+*
+* Description: This function is OSMutexPend() with a timeout in nanoseconds.  The timeout is not
+*              rounded up to clock ticks, it ends at the time stamp of the port (OSCPUTsGet()) it is due.
+*
+* Arguments  : pevent        is a pointer to the event control block associated with the desired
+*                            mutex.
+*
+*              timeout_ns    is an optional timeout period in nanoseconds.  If you specify 0, your task
+*                            will wait forever like with OSMutexPend().
+*
+*              perr          is a pointer to where an error message will be deposited, the same as for
+*                            OSMutexPend().
+*
+* Returns    : none
+*********************************************************************************************************
+*/
+
+#if OS_TIME_NS_EN > 0
+void  OSMutexPendNs (OS_EVENT *pevent, INT64U timeout_ns, INT8U *perr)
+{
+    if ((timeout_ns == 0) || (OSIntNesting > 0)) {   /* Wait forever, or let OSMutexPend() fail       */
+        OSMutexPend(pevent, 0, perr);
+        return;
+    }
+    OS_DlyNsSet(timeout_ns);
+    OSMutexPend(pevent, 0, perr);
+    OS_DlyNsSet(0);
+}
+#endif
 /*$PAGE*/
 /*
 *********************************************************************************************************
@@ -551,6 +834,9 @@ INT8U  OSMutexPost (OS_EVENT *pevent)
 {
     INT8U      pip;                                   /* Priority inheritance priority                 */
     INT8U      prio;
+#if OS_SCHED_RR_EN > 0
+    OS_TCB    *ptcb;
+#endif
 #if OS_CRITICAL_METHOD == 3                           /* Allocate storage for CPU status register      */
     OS_CPU_SR  cpu_sr = 0;
 #endif
@@ -575,6 +861,39 @@ INT8U  OSMutexPost (OS_EVENT *pevent)
         OS_EXIT_CRITICAL();
         return (OS_ERR_NOT_MUTEX_OWNER);
     }
+#if OS_EVENT_PROF_EN > 0
+    pevent->OSEventProf.OSPostCtr++;
+#endif
+#if OS_MUTEX_STAT_EN > 0
+    OSMutex_StatUnlock(pevent);                       /* Account the time the mutex was held           */
+#endif
+#if OS_MUTEX_PROTOCOL_EN > 0
+    if (pevent->OSEventMutexOpt != OS_MUTEX_OPT_PIP) {/* Ceiling or inheritance mutex                  */
+        OSMutex_Unlink(pevent, OSTCBCur);
+        OS_MutexPrioUpdate(OSTCBCur);                 /* Drop what we had because of this mutex        */
+        if (pevent->OSEventGrp != 0) {                /* Any task waiting for the mutex?               */
+            prio = OS_EventTaskRdy(pevent, (void *)0, OS_STAT_MUTEX, OS_STAT_PEND_OK);
+            ptcb = OSTCBPrioTbl[prio];                /* Find the new owner among the tasks of ...     */
+            while ((ptcb->OSTCBEventPtr != pevent) || /* ... its priority                              */
+                   ((ptcb->OSTCBStat & OS_STAT_MUTEX) != OS_STAT_RDY) ||
+                   (ptcb->OSTCBStatPend != OS_STAT_PEND_OK)) {
+                ptcb = ptcb->OSTCBRRNext;
+            }
+#if OS_MUTEX_STAT_EN > 0
+            OSMutex_StatLock(pevent);
+#endif
+            (void)OSMutex_Own(pevent, ptcb);          /* Hand the mutex over, it inherits the waiters  */
+            OS_EXIT_CRITICAL();
+            OS_Sched();                               /* Find highest priority task ready to run       */
+            return (OS_ERR_NONE);
+        }
+        pevent->OSEventCnt |= OS_MUTEX_AVAILABLE;     /* No,  Mutex is now available                   */
+        pevent->OSEventPtr  = (void *)0;
+        OS_EXIT_CRITICAL();
+        OS_Sched();                                   /* We may have lost a boost                      */
+        return (OS_ERR_NONE);
+    }
+#endif
     if (OSTCBCur->OSTCBPrio == pip) {                 /* Did we have to raise current task's priority? */
         OSMutex_RdyAtPrio(OSTCBCur, prio);            /* Restore the task's original priority          */
     }
@@ -584,7 +903,20 @@ INT8U  OSMutexPost (OS_EVENT *pevent)
         prio                = OS_EventTaskRdy(pevent, (void *)0, OS_STAT_MUTEX, OS_STAT_PEND_OK);
         pevent->OSEventCnt &= OS_MUTEX_KEEP_UPPER_8;  /*      Save priority of mutex's new owner       */
         pevent->OSEventCnt |= prio;
+#if OS_MUTEX_STAT_EN > 0
+        OSMutex_StatLock(pevent);
+#endif
+#if OS_SCHED_RR_EN > 0
+        ptcb                = OSTCBPrioTbl[prio];     /*      Find the new owner among the tasks of ...*/
+        while ((ptcb->OSTCBEventPtr != pevent) ||     /*      ... its priority                         */
+               ((ptcb->OSTCBStat & OS_STAT_MUTEX) != OS_STAT_RDY) ||
+               (ptcb->OSTCBStatPend != OS_STAT_PEND_OK)) {
+            ptcb            = ptcb->OSTCBRRNext;
+        }
+        pevent->OSEventPtr  = ptcb;                   /*      Link to new mutex owner's OS_TCB         */
+#else
         pevent->OSEventPtr  = OSTCBPrioTbl[prio];     /*      Link to new mutex owner's OS_TCB         */
+#endif
         if (prio <= pip) {                            /*      PIP 'must' have a SMALLER prio ...       */
             OS_EXIT_CRITICAL();                       /*      ... than current task!                   */
             OS_Sched();                               /*      Find highest priority task ready to run  */
@@ -623,13 +955,8 @@ INT8U  OSMutexPost (OS_EVENT *pevent)
 INT8U  OSMutexQuery (OS_EVENT *pevent, OS_MUTEX_DATA *p_mutex_data)
 {
     INT8U      i;
-#if OS_LOWEST_PRIO <= 63
-    INT8U     *psrc;
-    INT8U     *pdest;
-#else
-    INT16U    *psrc;
-    INT16U    *pdest;
-#endif
+    OS_PRIO_TBL *psrc;
+    OS_PRIO_TBL *pdest;
 #if OS_CRITICAL_METHOD == 3                      /* Allocate storage for CPU status register           */
     OS_CPU_SR  cpu_sr = 0;
 #endif
@@ -664,6 +991,15 @@ INT8U  OSMutexQuery (OS_EVENT *pevent, OS_MUTEX_DATA *p_mutex_data)
     for (i = 0; i < OS_EVENT_TBL_SIZE; i++) {
         *pdest++ = *psrc++;
     }
+#if OS_MUTEX_PROTOCOL_EN > 0
+    p_mutex_data->OSMutexOpt    = pevent->OSEventMutexOpt;
+#endif
+#if OS_MUTEX_STAT_EN > 0
+    p_mutex_data->OSLockCtr     = pevent->OSEventMutexLockCtr;
+    p_mutex_data->OSContCtr     = pevent->OSEventMutexContCtr;
+    p_mutex_data->OSHoldTimeTot = pevent->OSEventMutexHoldTot;
+    p_mutex_data->OSHoldTimeMax = pevent->OSEventMutexHoldMax;
+#endif
     OS_EXIT_CRITICAL();
     return (OS_ERR_NONE);
 }
@@ -686,30 +1022,346 @@ INT8U  OSMutexQuery (OS_EVENT *pevent, OS_MUTEX_DATA *p_mutex_data)
 
 static  void  OSMutex_RdyAtPrio (OS_TCB *ptcb, INT8U prio)
 {
-    INT8U   y;
+    OS_RdyListRemove(ptcb);                                /* Remove owner from ready list at 'pip'    */
+#if OS_SCHED_RR_EN > 0
+    OS_PrioRingRemove(ptcb);
+#endif
+    OS_TCBPrioSet(ptcb, prio);
+#if OS_SCHED_RR_EN > 0
+    OS_PrioRingInsert(ptcb);                               /* Back with the tasks of its priority      */
+    OS_RdyListInsert(ptcb);                                /* Make task ready at original priority     */
+    if (ptcb == OSTCBCur) {                                /* Running task keeps the turn              */
+        OSTCBPrioTbl[prio]  = ptcb;
+    }
+#else
+    OS_RdyListInsert(ptcb);                                /* Make task ready at original priority     */
+    OSTCBPrioTbl[prio]      = ptcb;
+#endif
+}
+
+
+/*$PAGE*/
+/*
+*********************************************************************************************************
+*                                  GIVE A CEILING OR INHERITANCE MUTEX TO A TASK
+*
+* Description: This function makes a task the owner of a ceiling or inheritance mutex.  The mutex is linked
+*              to the list of mutexes the task holds and the priority of the task is raised to what the
+*              mutex asks for.
+*
+* Arguments  : pevent          is a pointer to the mutex
+*
+*              ptcb            is a pointer to OS_TCB of the new owner
+*
+* Returns    : OS_ERR_NONE         if the task got the mutex
+*              OS_ERR_PIP_LOWER    if the task got the mutex but its priority is higher than the ceiling
+*
+* Note(s)    : 1) Interrupts are assumed to be disabled when this function is called.
+*              2) The lower 8 bits of OSEventCnt hold the base priority of the owner, for OSMutexQuery().
+*********************************************************************************************************
+*/
+
+#if OS_MUTEX_PROTOCOL_EN > 0
+static  INT8U  OSMutex_Own (OS_EVENT *pevent, OS_TCB *ptcb)
+{
+    pevent->OSEventCnt      &= OS_MUTEX_KEEP_UPPER_8;
+    pevent->OSEventCnt      |= ptcb->OSTCBBasePrio;
+    pevent->OSEventPtr       = (void *)ptcb;
+    pevent->OSEventMutexNext = ptcb->OSTCBMutexList;       /* Link to the mutexes the task holds       */
+    ptcb->OSTCBMutexList     = pevent;
+    OS_MutexPrioUpdate(ptcb);
+    if (pevent->OSEventMutexOpt == OS_MUTEX_OPT_CEILING) {
+        if (ptcb->OSTCBBasePrio < (INT8U)(pevent->OSEventCnt >> 8)) {
+            return (OS_ERR_PIP_LOWER);                     /* Ceiling 'must' have a SMALLER prio       */
+        }
+    }
+    return (OS_ERR_NONE);
+}
+
+/*$PAGE*/
+/*
+*********************************************************************************************************
+*                                UNLINK A MUTEX FROM THE MUTEXES OF ITS OWNER
+*
+* Description: This function removes a mutex from the list of mutexes its owner holds.  The mutexes can be
+*              released in any order.
+*
+* Arguments  : pevent          is a pointer to the mutex
+*
+*              ptcb            is a pointer to OS_TCB of the owner
+*
+* Returns    : none
+*
+* Note(s)    : 1) Interrupts are assumed to be disabled when this function is called.
+*              2) The priority of the owner is not changed, call OS_MutexPrioUpdate() for that.
+*********************************************************************************************************
+*/
+
+static  void  OSMutex_Unlink (OS_EVENT *pevent, OS_TCB *ptcb)
+{
+    OS_EVENT  **ppevent;
+
+
+    ppevent = &ptcb->OSTCBMutexList;
+    while (*ppevent != (OS_EVENT *)0) {
+        if (*ppevent == pevent) {
+            *ppevent = pevent->OSEventMutexNext;
+            break;
+        }
+        ppevent = &(*ppevent)->OSEventMutexNext;
+    }
+    pevent->OSEventMutexNext = (OS_EVENT *)0;
+}
+
+/*$PAGE*/
+/*
+*********************************************************************************************************
+*                              FIND THE HIGHEST PRIORITY WAITING FOR A MUTEX
+*
+* Description: This function finds the priority of the highest priority task waiting for a mutex.
+*
+* Arguments  : pevent          is a pointer to the mutex
+*
+* Returns    : The priority of the highest priority waiter, OS_PRIO_SELF if no task waits.
+*********************************************************************************************************
+*/
+
+static  INT8U  OSMutex_WaitPrio (OS_EVENT *pevent)
+{
+    INT8U    y;
+    INT8U    x;
+#if (OS_SCHED_CTZ_EN == 0) && (OS_LOWEST_PRIO > 63)
+    OS_PRIO_TBL  *ptbl;
+#endif
 
 
-    y            =  ptcb->OSTCBY;                          /* Remove owner from ready list at 'pip'    */
-    OSRdyTbl[y] &= ~ptcb->OSTCBBitX;
-    if (OSRdyTbl[y] == 0) {
-        OSRdyGrp &= ~ptcb->OSTCBBitY;
+    if (pevent->OSEventGrp == 0) {
+        return (OS_PRIO_SELF);
     }
-    ptcb->OSTCBPrio         = prio;
-#if OS_LOWEST_PRIO <= 63
-    ptcb->OSTCBY            = (INT8U)((prio >> (INT8U)3) & (INT8U)0x07);
-    ptcb->OSTCBX            = (INT8U) (prio & (INT8U)0x07);
-    ptcb->OSTCBBitY         = (INT8U)(1 << ptcb->OSTCBY);
-    ptcb->OSTCBBitX         = (INT8U)(1 << ptcb->OSTCBX);
+#if OS_SCHED_CTZ_EN > 0
+    y = (INT8U)OS_CPU_CTZ(pevent->OSEventGrp);
+    x = (INT8U)OS_CPU_CTZ(pevent->OSEventTbl[y]);
+    return ((INT8U)((y << 6) + x));
+#elif OS_LOWEST_PRIO <= 63
+    y = OSUnMapTbl[pevent->OSEventGrp];
+    x = OSUnMapTbl[pevent->OSEventTbl[y]];
+    return ((INT8U)((y << 3) + x));
 #else
-    ptcb->OSTCBY            = (INT8U)((prio >> (INT8U)4) & (INT8U)0x0F);
-    ptcb->OSTCBX            = (INT8U) (prio & (INT8U)0x0F);
-    ptcb->OSTCBBitY         = (INT16U)(1 << ptcb->OSTCBY);
-    ptcb->OSTCBBitX         = (INT16U)(1 << ptcb->OSTCBX);
+    if ((pevent->OSEventGrp & 0xFF) != 0) {
+        y = OSUnMapTbl[ pevent->OSEventGrp & 0xFF];
+    } else {
+        y = OSUnMapTbl[(pevent->OSEventGrp >> 8) & 0xFF] + 8;
+    }
+    ptbl = &pevent->OSEventTbl[y];
+    if ((*ptbl & 0xFF) != 0) {
+        x = OSUnMapTbl[*ptbl & 0xFF];
+    } else {
+        x = OSUnMapTbl[(*ptbl >> 8) & 0xFF] + 8;
+    }
+    return ((INT8U)((y << 4) + x));
 #endif
-    OSRdyGrp               |= ptcb->OSTCBBitY;             /* Make task ready at original priority     */
-    OSRdyTbl[ptcb->OSTCBY] |= ptcb->OSTCBBitX;
-    OSTCBPrioTbl[prio]      = ptcb;
 }
 
+/*$PAGE*/
+/*
+*********************************************************************************************************
+*                                 PRIORITY A TASK IS ENTITLED TO BY ITS MUTEXES
+*
+* Description: This function computes the priority a task must run at: its base priority, raised to the
+*              ceiling of every ceiling mutex it holds and to the priority of the highest priority task
+*              waiting for any mutex it holds.
+*
+* Arguments  : ptcb            is a pointer to OS_TCB of the task
+*
+* Returns    : The effective priority of the task.
+*
+* Note(s)    : 1) This function is INTERNAL to uC/OS-II and your application should not call it.
+*              2) Interrupts are assumed to be disabled when this function is called.
+*              3) The waiters have their own effective priority, so the inheritance is transitive.
+*********************************************************************************************************
+*/
+
+INT8U  OS_MutexPrioGet (OS_TCB *ptcb)
+{
+    OS_EVENT  *pevent;
+    INT8U      prio;
+    INT8U      prio_mutex;
+
+
+    prio   = ptcb->OSTCBBasePrio;
+    pevent = ptcb->OSTCBMutexList;
+    while (pevent != (OS_EVENT *)0) {
+        if (pevent->OSEventMutexOpt == OS_MUTEX_OPT_CEILING) {
+            prio_mutex = (INT8U)(pevent->OSEventCnt >> 8); /* Ceiling of the mutex                     */
+            if (prio_mutex < prio) {
+                prio = prio_mutex;
+            }
+        }
+        prio_mutex = OSMutex_WaitPrio(pevent);             /* Highest priority waiter                  */
+        if (prio_mutex < prio) {
+            prio = prio_mutex;
+        }
+        pevent = pevent->OSEventMutexNext;
+    }
+    return (prio);
+}
+
+/*$PAGE*/
+/*
+*********************************************************************************************************
+*                                  UPDATE THE PRIORITY OF A MUTEX OWNER
+*
+* Description: This function moves a task to the priority it is entitled to by its mutexes.  If the task
+*              itself waits for a ceiling or inheritance mutex the owner of that mutex is updated next, and
+*              so on along the chain of owners.
+*
+* Arguments  : ptcb            is a pointer to OS_TCB of the task
+*
+* Returns    : none
+*
+* Note(s)    : 1) This function is INTERNAL to uC/OS-II and your application should not call it.
+*              2) Interrupts are assumed to be disabled when this function is called.
+*              3) The walk stops at the first task whose priority does not change, so it also ends for a
+*                 deadlocked cycle of owners.
+*********************************************************************************************************
+*/
+
+void  OS_MutexPrioUpdate (OS_TCB *ptcb)
+{
+    OS_EVENT  *pevent;
+    INT8U      prio;
+
+
+    while (ptcb != (OS_TCB *)0) {
+        prio = OS_MutexPrioGet(ptcb);
+        if (prio == ptcb->OSTCBPrio) {
+            return;
+        }
+        OSMutex_PrioSet(ptcb, prio);
+        if ((ptcb->OSTCBStat & OS_STAT_MUTEX) == OS_STAT_RDY) {
+            return;                                        /* Task doesn't wait for a mutex            */
+        }
+        pevent = ptcb->OSTCBEventPtr;
+        if ((pevent == (OS_EVENT *)0) || (pevent->OSEventMutexOpt == OS_MUTEX_OPT_PIP)) {
+            return;
+        }
+        ptcb = (OS_TCB *)pevent->OSEventPtr;               /* Owner of the mutex the task waits for    */
+    }
+}
+
+/*$PAGE*/
+/*
+*********************************************************************************************************
+*                                    MOVE A TASK TO ANOTHER PRIORITY
+*
+* Description: This function moves a ready or waiting task to another priority, like OSTaskChangePrio()
+*              does with OS_SCHED_RR_EN.  The task shares the new priority with the tasks already there.
+*
+* Arguments  : ptcb            is a pointer to OS_TCB of the task
+*
+*              prio            is the new priority
+*
+* Returns    : none
+*
+* Note(s)    : 1) Interrupts are assumed to be disabled when this function is called.
+*              2) A task that is raised or that is running takes the turn at its new priority.
+*********************************************************************************************************
+*/
+
+static  void  OSMutex_PrioSet (OS_TCB *ptcb, INT8U prio)
+{
+    OS_EVENT  *pevent;
+#if (OS_EVENT_MULTI_EN > 0)
+    OS_EVENT **pevents;
+#endif
+    BOOLEAN    rdy;
+    BOOLEAN    pend;
+    BOOLEAN    turn;
+
+
+    rdy  = ptcb->OSTCBRRRdy;
+    pend = (BOOLEAN)((ptcb->OSTCBStat & OS_STAT_PEND_ANY) != OS_STAT_RDY);
+    turn = (BOOLEAN)((ptcb == OSTCBCur) || (prio < ptcb->OSTCBPrio));
+    OS_RdyListRemove(ptcb);                                /* Leave the old priority ...               */
+    if (pend == OS_TRUE) {                                 /* ... and its wait list bits               */
+        if (ptcb->OSTCBEventPtr != (OS_EVENT *)0) {
+            OS_EventTaskRemove(ptcb, ptcb->OSTCBEventPtr);
+        }
+#if (OS_EVENT_MULTI_EN > 0)
+        if (ptcb->OSTCBEventMultiPtr != (OS_EVENT **)0) {
+            OS_EventTaskRemoveMulti(ptcb, ptcb->OSTCBEventMultiPtr);
+        }
+#endif
+    }
+    OS_PrioRingRemove(ptcb);
+    OS_TCBPrioSet(ptcb, prio);
+    OS_PrioRingInsert(ptcb);                               /* Join the tasks of the new priority       */
+    if (pend == OS_TRUE) {                                 /* Wait at the new priority                 */
+        pevent = ptcb->OSTCBEventPtr;
+        if (pevent != (OS_EVENT *)0) {
+            pevent->OSEventGrp                |= ptcb->OSTCBBitY;
+            pevent->OSEventTbl[ptcb->OSTCBY]  |= ptcb->OSTCBBitX;
+        }
+#if (OS_EVENT_MULTI_EN > 0)
+        if (ptcb->OSTCBEventMultiPtr != (OS_EVENT **)0) {
+            pevents =  ptcb->OSTCBEventMultiPtr;
+            pevent  = *pevents;
+            while (pevent != (OS_EVENT *)0) {
+                pevent->OSEventGrp               |= ptcb->OSTCBBitY;
+                pevent->OSEventTbl[ptcb->OSTCBY] |= ptcb->OSTCBBitX;
+                pevents++;
+                pevent                            = *pevents;
+            }
+        }
+#endif
+    }
+    if (rdy == OS_TRUE) {                                  /* Make new priority ready to run           */
+        OS_RdyListInsert(ptcb);
+        if (turn == OS_TRUE) {
+            OSTCBPrioTbl[prio] = ptcb;
+        }
+    }
+}
+#endif
+
+/*$PAGE*/
+/*
+*********************************************************************************************************
+*                                       ACCOUNT THE LOCKS OF A MUTEX
+*
+* Description: OSMutex_StatLock() stamps the time a task got the mutex and counts the lock,
+*              OSMutex_StatUnlock() adds the time the mutex was held to its hold time statistics.
+*
+* Arguments  : pevent          is a pointer to the mutex
+*
+* Returns    : none
+*
+* Note(s)    : 1) Interrupts are assumed to be disabled when these functions are called.
+*********************************************************************************************************
+*/
+
+#if OS_MUTEX_STAT_EN > 0
+static  void  OSMutex_StatLock (OS_EVENT *pevent)
+{
+    pevent->OSEventMutexTs = OSCPUTsGet();
+    pevent->OSEventMutexLockCtr++;
+}
+
+
+static  void  OSMutex_StatUnlock (OS_EVENT *pevent)
+{
+    INT64U  hold;
+
+
+    hold                         = OSCPUTsGet() - pevent->OSEventMutexTs;
+    pevent->OSEventMutexHoldTot += hold;
+    if (hold > 0xFFFFFFFFL) {                              /* Saturate the maximum                     */
+        hold = 0xFFFFFFFFL;
+    }
+    if ((INT32U)hold > pevent->OSEventMutexHoldMax) {
+        pevent->OSEventMutexHoldMax = (INT32U)hold;
+    }
+}
+#endif
 
 #endif                                                     /* OS_MUTEX_EN                              */
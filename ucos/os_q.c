@@ -28,6 +28,21 @@
 #if (OS_Q_EN > 0) && (OS_MAX_QS > 0)
 /*
 *********************************************************************************************************
+*                                            LOCAL PROTOTYPES
+*********************************************************************************************************
+*/
+
+#if OS_Q_PEND_N_EN > 0
+static  INT16U  OS_QDrain(OS_Q *pq, void **pmsgs, INT16U nmsgs);
+#endif
+
+#if OS_Q_PRIO_EN > 0
+static  void    OS_QPrioPut(OS_Q *pq, void *pmsg, INT8U prio, BOOLEAN front);
+#endif
+
+/*$PAGE*/
+/*
+*********************************************************************************************************
 *                                      ACCEPT MESSAGE FROM QUEUE
 *
 * Description: This function checks the queue to see if a message is available.  Unlike OSQPend(),
@@ -84,10 +99,17 @@ void  *OSQAccept (OS_EVENT *pevent, INT8U *perr)
     OS_ENTER_CRITICAL();
     pq = (OS_Q *)pevent->OSEventPtr;             /* Point at queue control block                       */
     if (pq->OSQEntries > 0) {                    /* See if any messages in the queue                   */
-        pmsg = *pq->OSQOut++;                    /* Yes, extract oldest message from the queue         */
-        pq->OSQEntries--;                        /* Update the number of entries in the queue          */
-        if (pq->OSQOut == pq->OSQEnd) {          /* Wrap OUT pointer if we are at the end of the queue */
-            pq->OSQOut = pq->OSQStart;
+#if OS_Q_PRIO_EN > 0
+        if (pq->OSQPrio == OS_TRUE) {            /* Yes, take the most urgent one of a priority queue  */
+            pmsg = OS_QPrioGet(pq);
+        } else
+#endif
+        {
+            pmsg = *pq->OSQOut++;                /* Yes, extract oldest message from the queue         */
+            pq->OSQEntries--;                    /* Update the number of entries in the queue          */
+            if (pq->OSQOut == pq->OSQEnd) {      /* Wrap OUT pointer if we are at the end of the queue */
+                pq->OSQOut = pq->OSQStart;
+            }
         }
         *perr = OS_ERR_NONE;
     } else {
@@ -131,6 +153,10 @@ OS_EVENT  *OSQCreate (void **start, INT16U size)
     if (OSIntNesting > 0) {                      /* See if called from ISR ...                         */
         return ((OS_EVENT *)0);                  /* ... can't CREATE from an ISR                       */
     }
+#if OS_SLAB_EN > 0
+    OS_SlabEventRefill();                        /* Grow the free lists if they are empty              */
+    OS_SlabQRefill();
+#endif
     OS_ENTER_CRITICAL();
     pevent = OSEventFreeList;                    /* Get next free event control block                  */
     if (OSEventFreeList != (OS_EVENT *)0) {      /* See if pool of free ECB pool was empty             */
@@ -149,12 +175,18 @@ OS_EVENT  *OSQCreate (void **start, INT16U size)
             pq->OSQOut             = start;
             pq->OSQSize            = size;
             pq->OSQEntries         = 0;
+#if OS_Q_PRIO_EN > 0
+            pq->OSQPrio            = OS_FALSE;            /*      Messages in the order they are posted*/
+#endif
             pevent->OSEventType    = OS_EVENT_TYPE_Q;
             pevent->OSEventCnt     = 0;
             pevent->OSEventPtr     = pq;
 #if OS_EVENT_NAME_SIZE > 1
             pevent->OSEventName[0] = '?';                  /* Unknown name                             */
             pevent->OSEventName[1] = OS_ASCII_NUL;
+#endif
+#if OS_EVENT_PROF_EN > 0
+            OS_MemClr((INT8U *)&pevent->OSEventProf, sizeof(OS_EVENT_PROF));
 #endif
             OS_EventWaitListInit(pevent);                 /*      Initalize the wait list              */
         } else {
@@ -169,6 +201,61 @@ OS_EVENT  *OSQCreate (void **start, INT16U size)
 /*$PAGE*/
 /*
 *********************************************************************************************************
+*                                   CREATE A PRIORITY ORDERED MESSAGE QUEUE
+*
+* Description: This function creates a message queue where each message carries a priority.  OSQPend(),
+*              OSQAccept() and OSQPendN() always return the oldest message of the most urgent priority
+*              that has messages, so an urgent message does not wait behind the messages of a lower
+*              priority posted before it.
+*
+* Arguments  : start         is a pointer to the base address of the message queue storage area.  The
+*                            storage area MUST be declared as an array of OS_Q_MSG as follows
+*
+*                            OS_Q_MSG MessageStorage[size]
+*
+*              size          is the number of elements in the storage area, shared by all priorities
+*
+* Returns    : != (OS_EVENT *)0  is a pointer to the event control block (OS_EVENT) associated with the
+*                                created queue
+*              == (OS_EVENT *)0  if no event control blocks were available or an error was detected
+*
+* Note(s)    : 1) Messages are posted with OSQPostPrio(), priority 0 is the most urgent and
+*                 OS_Q_PRIO_LEVELS - 1 the least.  OSQPost() and OSQPostN() post at the least urgent
+*                 priority, OSQPostFront() ahead of the messages of priority 0.
+*              2) Each priority is a list of the messages in the order they were posted.  A post and a
+*                 pend take the same time whatever the number of messages in the queue.
+*********************************************************************************************************
+*/
+
+#if OS_Q_PRIO_EN > 0
+OS_EVENT  *OSQCreatePrio (OS_Q_MSG *start, INT16U size)
+{
+    OS_EVENT  *pevent;
+    OS_Q      *pq;
+    INT16U     i;
+
+
+    pevent = OSQCreate((void **)0, 0);           /* Get a queue, not visible to other tasks yet ...    */
+    if (pevent != (OS_EVENT *)0) {               /* ... until it is returned                           */
+        pq              = (OS_Q *)pevent->OSEventPtr;
+        pq->OSQSize     = size;
+        pq->OSQPrio     = OS_TRUE;
+        pq->OSQPrioGrp  = 0;
+        for (i = 0; i < OS_Q_PRIO_LEVELS; i++) { /* All priorities are empty                           */
+            pq->OSQPrioEntries[i] = 0;
+        }
+        pq->OSQPrioFree = (OS_Q_MSG *)0;
+        for (i = size; i > 0; i--) {             /* All the storage is on the free list                */
+            start[i - 1].OSQMsgNext = pq->OSQPrioFree;
+            pq->OSQPrioFree         = &start[i - 1];
+        }
+    }
+    return (pevent);
+}
+#endif
+/*$PAGE*/
+/*
+*********************************************************************************************************
 *                                        DELETE A MESSAGE QUEUE
 *
 * Description: This function deletes a message queue and readies all tasks pending on the queue.
@@ -253,6 +340,9 @@ OS_EVENT  *OSQDel (OS_EVENT *pevent, INT8U opt, INT8U *perr)
                  pq                     = (OS_Q *)pevent->OSEventPtr;  /* Return OS_Q to free list     */
                  pq->OSQPtr             = OSQFreeList;
                  OSQFreeList            = pq;
+#if (OS_SET_EN > 0) && (OS_MAX_SETS > 0)
+                 OS_SetUnlink(pevent);
+#endif
                  pevent->OSEventType    = OS_EVENT_TYPE_UNUSED;
                  pevent->OSEventPtr     = OSEventFreeList; /* Return Event Control Block to free list  */
                  pevent->OSEventCnt     = 0;
@@ -278,6 +368,9 @@ OS_EVENT  *OSQDel (OS_EVENT *pevent, INT8U opt, INT8U *perr)
              pq                     = (OS_Q *)pevent->OSEventPtr;   /* Return OS_Q to free list        */
              pq->OSQPtr             = OSQFreeList;
              OSQFreeList            = pq;
+#if (OS_SET_EN > 0) && (OS_MAX_SETS > 0)
+             OS_SetUnlink(pevent);
+#endif
              pevent->OSEventType    = OS_EVENT_TYPE_UNUSED;
              pevent->OSEventPtr     = OSEventFreeList;     /* Return Event Control Block to free list  */
              pevent->OSEventCnt     = 0;
@@ -324,6 +417,9 @@ OS_EVENT  *OSQDel (OS_EVENT *pevent, INT8U opt, INT8U *perr)
 INT8U  OSQFlush (OS_EVENT *pevent)
 {
     OS_Q      *pq;
+#if OS_Q_PRIO_EN > 0
+    INT8U      prio;
+#endif
 #if OS_CRITICAL_METHOD == 3                           /* Allocate storage for CPU status register      */
     OS_CPU_SR  cpu_sr = 0;
 #endif
@@ -340,6 +436,15 @@ INT8U  OSQFlush (OS_EVENT *pevent)
 #endif
     OS_ENTER_CRITICAL();
     pq             = (OS_Q *)pevent->OSEventPtr;      /* Point to queue storage structure              */
+#if OS_Q_PRIO_EN > 0
+    while (pq->OSQPrioGrp != 0) {                     /* Return the messages of each priority ...      */
+        prio                    = OSUnMapTbl[pq->OSQPrioGrp];
+        pq->OSQPrioTail[prio]->OSQMsgNext = pq->OSQPrioFree;   /* ... to the free list at once         */
+        pq->OSQPrioFree         = pq->OSQPrioHead[prio];
+        pq->OSQPrioEntries[prio] = 0;
+        pq->OSQPrioGrp         &= (INT8U)~(1u << prio);
+    }
+#endif
     pq->OSQIn      = pq->OSQStart;
     pq->OSQOut     = pq->OSQStart;
     pq->OSQEntries = 0;
@@ -417,12 +522,22 @@ void  *OSQPend (OS_EVENT *pevent, INT16U timeout, INT8U *perr)
         return ((void *)0);
     }
     OS_ENTER_CRITICAL();
+#if OS_EVENT_PROF_EN > 0
+    pevent->OSEventProf.OSPendCtr++;
+#endif
     pq = (OS_Q *)pevent->OSEventPtr;             /* Point at queue control block                       */
     if (pq->OSQEntries > 0) {                    /* See if any messages in the queue                   */
-        pmsg = *pq->OSQOut++;                    /* Yes, extract oldest message from the queue         */
-        pq->OSQEntries--;                        /* Update the number of entries in the queue          */
-        if (pq->OSQOut == pq->OSQEnd) {          /* Wrap OUT pointer if we are at the end of the queue */
-            pq->OSQOut = pq->OSQStart;
+#if OS_Q_PRIO_EN > 0
+        if (pq->OSQPrio == OS_TRUE) {            /* Yes, take the most urgent one of a priority queue  */
+            pmsg = OS_QPrioGet(pq);
+        } else
+#endif
+        {
+            pmsg = *pq->OSQOut++;                /* Yes, extract oldest message from the queue         */
+            pq->OSQEntries--;                    /* Update the number of entries in the queue          */
+            if (pq->OSQOut == pq->OSQEnd) {      /* Wrap OUT pointer if we are at the end of the queue */
+                pq->OSQOut = pq->OSQStart;
+            }
         }
         OS_EXIT_CRITICAL();
         *perr = OS_ERR_NONE;
@@ -430,11 +545,14 @@ void  *OSQPend (OS_EVENT *pevent, INT16U timeout, INT8U *perr)
     }
     OSTCBCur->OSTCBStat     |= OS_STAT_Q;        /* Task will have to pend for a message to be posted  */
     OSTCBCur->OSTCBStatPend  = OS_STAT_PEND_OK;
-    OSTCBCur->OSTCBDly       = timeout;          /* Load timeout into TCB                              */
+    OS_TickListInsert(OSTCBCur, timeout);       /* Load timeout into TCB and tick list                */
     OS_EventTaskWait(pevent);                    /* Suspend task until event or timeout occurs         */
     OS_EXIT_CRITICAL();
     OS_Sched();                                  /* Find next highest priority task ready to run       */
     OS_ENTER_CRITICAL();
+#if OS_EVENT_PROF_EN > 0
+    OS_EventProfWake(&pevent->OSEventProf);           /* Account the blocked and the wakeup time       */
+#endif
     switch (OSTCBCur->OSTCBStatPend) {                /* See if we timed-out or aborted                */
         case OS_STAT_PEND_OK:                         /* Extract message from TCB (Put there by QPost) */
              pmsg =  OSTCBCur->OSTCBMsg;
@@ -463,6 +581,179 @@ void  *OSQPend (OS_EVENT *pevent, INT16U timeout, INT8U *perr)
     OS_EXIT_CRITICAL();
     return (pmsg);                                    /* Return received message                       */
 }
+
+/*$PAGE*/
+/*
+*********************************************************************************************************
+*                           PEND ON A QUEUE FOR A MESSAGE, NANOSECOND TIMEOUT
+*
+* Description: This function is OSQPend() with a timeout in nanoseconds.  The timeout is not
+*              rounded up to clock ticks, it ends at the time stamp of the port (OSCPUTsGet()) it is due.
+*
+* Arguments  : pevent        is a pointer to the event control block associated with the desired
+*                            queue.
+*
+*              timeout_ns    is an optional timeout period in nanoseconds.  If you specify 0, your task
+*                            will wait forever like with OSQPend().
+*
+*              perr          is a pointer to where an error message will be deposited, the same as for
+*                            OSQPend().
+*
+* Returns    : the message received, or a NULL pointer on a timeout or error.
+*********************************************************************************************************
+*/
+
+#if OS_TIME_NS_EN > 0
+void  *OSQPendNs (OS_EVENT *pevent, INT64U timeout_ns, INT8U *perr)
+{
+    void  *pmsg;
+
+
+    if ((timeout_ns == 0) || (OSIntNesting > 0)) {   /* Wait forever, or let OSQPend() fail           */
+        return (OSQPend(pevent, 0, perr));
+    }
+    OS_DlyNsSet(timeout_ns);
+    pmsg = OSQPend(pevent, 0, perr);
+    OS_DlyNsSet(0);
+    return (pmsg);
+}
+#endif
+/*$PAGE*/
+/*
+*********************************************************************************************************
+*                                   PEND ON A QUEUE FOR SEVERAL MESSAGES
+*
+* Description: This function waits for a message to be sent to a queue like OSQPend(), and then takes up
+*              to 'nmsgs' messages from the queue in the same call.  A task that processes messages in
+*              batches only blocks and switches once per batch instead of once per message.
+*
+* Arguments  : pevent        is a pointer to the event control block associated with the desired queue
+*
+*              pmsgs         is a pointer to an array where the messages received are stored, oldest
+*                            first.
+*
+*              nmsgs         is the number of entries of 'pmsgs', the most messages that are taken.
+*
+*              timeout       is an optional timeout period (in clock ticks).  If non-zero, your task will
+*                            wait for the first message up to the amount of time specified by this
+*                            argument.  If you specify 0, your task will wait forever.
+*
+*              perr          is a pointer to where an error message will be deposited.  Possible error
+*                            messages are:
+*
+*                            OS_ERR_NONE         The call was successful and your task received at least
+*                                                one message.
+*                            OS_ERR_TIMEOUT      A message was not received within the specified 'timeout'.
+*                            OS_ERR_PEND_ABORT   The wait on the queue was aborted.
+*                            OS_ERR_EVENT_TYPE   You didn't pass a pointer to a queue
+*                            OS_ERR_PEVENT_NULL  If 'pevent' is a NULL pointer
+*                            OS_ERR_PDATA_NULL   If 'pmsgs' is a NULL pointer
+*                            OS_ERR_PEND_ISR     If you called this function from an ISR and the result
+*                                                would lead to a suspension.
+*                            OS_ERR_PEND_LOCKED  If you called this function with the scheduler is locked
+*
+* Returns    : The number of messages stored in 'pmsgs', 0 on a timeout, an abort or an error.
+*
+* Note(s)    : 1) The task only blocks when the queue is empty.  The first message it then receives is
+*                 the one a post hands to it, the others are the ones posted to the queue until it runs
+*                 again, see OSQPostN().
+*              2) If 'nmsgs' is 0 the function returns 0 with OS_ERR_NONE and does not wait.
+*********************************************************************************************************
+*/
+
+#if OS_Q_PEND_N_EN > 0
+INT16U  OSQPendN (OS_EVENT *pevent, void **pmsgs, INT16U nmsgs, INT16U timeout, INT8U *perr)
+{
+    INT16U     nbr;
+    OS_Q      *pq;
+#if OS_CRITICAL_METHOD == 3                      /* Allocate storage for CPU status register           */
+    OS_CPU_SR  cpu_sr = 0;
+#endif
+
+
+
+#if OS_ARG_CHK_EN > 0
+    if (perr == (INT8U *)0) {                    /* Validate 'perr'                                    */
+        return (0);
+    }
+    if (pevent == (OS_EVENT *)0) {               /* Validate 'pevent'                                  */
+        *perr = OS_ERR_PEVENT_NULL;
+        return (0);
+    }
+    if (pmsgs == (void **)0) {                   /* Validate 'pmsgs'                                   */
+        *perr = OS_ERR_PDATA_NULL;
+        return (0);
+    }
+#endif
+    if (pevent->OSEventType != OS_EVENT_TYPE_Q) {/* Validate event block type                          */
+        *perr = OS_ERR_EVENT_TYPE;
+        return (0);
+    }
+    if (nmsgs == 0) {                            /* Nothing to receive                                 */
+        *perr = OS_ERR_NONE;
+        return (0);
+    }
+    if (OSIntNesting > 0) {                      /* See if called from ISR ...                         */
+        *perr = OS_ERR_PEND_ISR;                 /* ... can't PEND from an ISR                         */
+        return (0);
+    }
+    if (OSLockNesting > 0) {                     /* See if called with scheduler locked ...            */
+        *perr = OS_ERR_PEND_LOCKED;              /* ... can't PEND when locked                         */
+        return (0);
+    }
+    OS_ENTER_CRITICAL();
+#if OS_EVENT_PROF_EN > 0
+    pevent->OSEventProf.OSPendCtr++;
+#endif
+    pq = (OS_Q *)pevent->OSEventPtr;             /* Point at queue control block                       */
+    if (pq->OSQEntries > 0) {                    /* See if any messages in the queue                   */
+        nbr = OS_QDrain(pq, pmsgs, nmsgs);       /* Yes, take as many as we can                        */
+        OS_EXIT_CRITICAL();
+        *perr = OS_ERR_NONE;
+        return (nbr);
+    }
+    OSTCBCur->OSTCBStat     |= OS_STAT_Q;        /* Task will have to pend for a message to be posted  */
+    OSTCBCur->OSTCBStatPend  = OS_STAT_PEND_OK;
+    OS_TickListInsert(OSTCBCur, timeout);       /* Load timeout into TCB and tick list                */
+    OS_EventTaskWait(pevent);                    /* Suspend task until event or timeout occurs         */
+    OS_EXIT_CRITICAL();
+    OS_Sched();                                  /* Find next highest priority task ready to run       */
+    OS_ENTER_CRITICAL();
+#if OS_EVENT_PROF_EN > 0
+    OS_EventProfWake(&pevent->OSEventProf);           /* Account the blocked and the wakeup time       */
+#endif
+    switch (OSTCBCur->OSTCBStatPend) {                /* See if we timed-out or aborted                */
+        case OS_STAT_PEND_OK:                         /* First message from TCB (Put there by a post)  */
+             pmsgs[0] =  OSTCBCur->OSTCBMsg;
+             nbr      =  1;                           /* ... the rest posted since from the queue      */
+             nbr     +=  OS_QDrain(pq, &pmsgs[1], nmsgs - 1);
+            *perr     =  OS_ERR_NONE;
+             break;
+
+        case OS_STAT_PEND_ABORT:
+             nbr      =  0;
+            *perr     =  OS_ERR_PEND_ABORT;           /* Indicate that we aborted                      */
+             break;
+
+        case OS_STAT_PEND_TO:
+        default:
+             OS_EventTaskRemove(OSTCBCur, pevent);
+             nbr      =  0;
+            *perr     =  OS_ERR_TIMEOUT;              /* Indicate that we didn't get event within TO   */
+             break;
+    }
+    OSTCBCur->OSTCBStat          =  OS_STAT_RDY;      /* Set   task  status to ready                   */
+    OSTCBCur->OSTCBStatPend      =  OS_STAT_PEND_OK;  /* Clear pend  status                            */
+    OSTCBCur->OSTCBEventPtr      = (OS_EVENT  *)0;    /* Clear event pointers                          */
+#if (OS_EVENT_MULTI_EN > 0)
+    OSTCBCur->OSTCBEventMultiPtr = (OS_EVENT **)0;
+#endif
+    OSTCBCur->OSTCBMsg           = (void      *)0;    /* Clear  received message                       */
+    OS_EXIT_CRITICAL();
+    return (nbr);                                     /* Return the number of messages received        */
+}
+#endif
+
 /*$PAGE*/
 /*
 *********************************************************************************************************
@@ -586,6 +877,9 @@ INT8U  OSQPost (OS_EVENT *pevent, void *pmsg)
         return (OS_ERR_EVENT_TYPE);
     }
     OS_ENTER_CRITICAL();
+#if OS_EVENT_PROF_EN > 0
+    pevent->OSEventProf.OSPostCtr++;
+#endif
     if (pevent->OSEventGrp != 0) {                     /* See if any task pending on queue             */
                                                        /* Ready highest priority task waiting on event */
         (void)OS_EventTaskRdy(pevent, pmsg, OS_STAT_Q, OS_STAT_PEND_OK);
@@ -598,11 +892,30 @@ INT8U  OSQPost (OS_EVENT *pevent, void *pmsg)
         OS_EXIT_CRITICAL();
         return (OS_ERR_Q_FULL);
     }
-    *pq->OSQIn++ = pmsg;                               /* Insert message into queue                    */
-    pq->OSQEntries++;                                  /* Update the nbr of entries in the queue       */
-    if (pq->OSQIn == pq->OSQEnd) {                     /* Wrap IN ptr if we are at end of queue        */
-        pq->OSQIn = pq->OSQStart;
+#if OS_Q_PRIO_EN > 0
+    if (pq->OSQPrio == OS_TRUE) {                      /* Priority queue, post at the lowest priority  */
+        OS_QPrioPut(pq, pmsg, OS_Q_PRIO_LEVELS - 1, OS_FALSE);
+    } else
+#endif
+    {
+        *pq->OSQIn++ = pmsg;                           /* Insert message into queue                    */
+        pq->OSQEntries++;                              /* Update the nbr of entries in the queue       */
+        if (pq->OSQIn == pq->OSQEnd) {                 /* Wrap IN ptr if we are at end of queue        */
+            pq->OSQIn = pq->OSQStart;
+        }
+    }
+#if OS_EVENT_PROF_EN > 0
+    if (pq->OSQEntries > pevent->OSEventProf.OSDepthMax) {
+        pevent->OSEventProf.OSDepthMax = pq->OSQEntries;
+    }
+#endif
+#if (OS_SET_EN > 0) && (OS_MAX_SETS > 0)
+    if (OS_SetSignal(pevent) == OS_TRUE) {            /* Ready the task pending on the event set       */
+        OS_EXIT_CRITICAL();
+        OS_Sched();
+        return (OS_ERR_NONE);
     }
+#endif
     OS_EXIT_CRITICAL();
     return (OS_ERR_NONE);
 }
@@ -648,6 +961,9 @@ INT8U  OSQPostFront (OS_EVENT *pevent, void *pmsg)
         return (OS_ERR_EVENT_TYPE);
     }
     OS_ENTER_CRITICAL();
+#if OS_EVENT_PROF_EN > 0
+    pevent->OSEventProf.OSPostCtr++;
+#endif
     if (pevent->OSEventGrp != 0) {                    /* See if any task pending on queue              */
                                                       /* Ready highest priority task waiting on event  */
         (void)OS_EventTaskRdy(pevent, pmsg, OS_STAT_Q, OS_STAT_PEND_OK);
@@ -660,12 +976,31 @@ INT8U  OSQPostFront (OS_EVENT *pevent, void *pmsg)
         OS_EXIT_CRITICAL();
         return (OS_ERR_Q_FULL);
     }
-    if (pq->OSQOut == pq->OSQStart) {                 /* Wrap OUT ptr if we are at the 1st queue entry */
-        pq->OSQOut = pq->OSQEnd;
+#if OS_Q_PRIO_EN > 0
+    if (pq->OSQPrio == OS_TRUE) {                     /* Priority queue, post ahead of priority 0      */
+        OS_QPrioPut(pq, pmsg, 0, OS_TRUE);
+    } else
+#endif
+    {
+        if (pq->OSQOut == pq->OSQStart) {             /* Wrap OUT ptr if we are at the 1st queue entry */
+            pq->OSQOut = pq->OSQEnd;
+        }
+        pq->OSQOut--;
+        *pq->OSQOut = pmsg;                           /* Insert message into queue                     */
+        pq->OSQEntries++;                             /* Update the nbr of entries in the queue        */
+    }
+#if OS_EVENT_PROF_EN > 0
+    if (pq->OSQEntries > pevent->OSEventProf.OSDepthMax) {
+        pevent->OSEventProf.OSDepthMax = pq->OSQEntries;
     }
-    pq->OSQOut--;
-    *pq->OSQOut = pmsg;                               /* Insert message into queue                     */
-    pq->OSQEntries++;                                 /* Update the nbr of entries in the queue        */
+#endif
+#if (OS_SET_EN > 0) && (OS_MAX_SETS > 0)
+    if (OS_SetSignal(pevent) == OS_TRUE) {            /* Ready the task pending on the event set       */
+        OS_EXIT_CRITICAL();
+        OS_Sched();
+        return (OS_ERR_NONE);
+    }
+#endif
     OS_EXIT_CRITICAL();
     return (OS_ERR_NONE);
 }
@@ -673,6 +1008,127 @@ INT8U  OSQPostFront (OS_EVENT *pevent, void *pmsg)
 /*$PAGE*/
 /*
 *********************************************************************************************************
+*                                     POST SEVERAL MESSAGES TO A QUEUE
+*
+* Description: This function sends the messages of an array to a queue, in the order of the array, like
+*              as many calls to OSQPost() would.  The messages are posted in one critical section and the
+*              scheduler is called at most once, after the last message.
+*
+* Arguments  : pevent        is a pointer to the event control block associated with the desired queue
+*
+*              pmsgs         is a pointer to the array of messages to send.
+*
+*              nmsgs         is the number of messages in 'pmsgs'.
+*
+*              perr          is a pointer to where an error message will be deposited.  Possible error
+*                            messages are:
+*
+*                            OS_ERR_NONE         All the messages were sent.
+*                            OS_ERR_Q_FULL       The queue became full, only the number of messages
+*                                                returned were sent.
+*                            OS_ERR_EVENT_TYPE   You didn't pass a pointer to a queue
+*                            OS_ERR_PEVENT_NULL  If 'pevent' is a NULL pointer
+*                            OS_ERR_PDATA_NULL   If 'pmsgs' is a NULL pointer
+*
+* Returns    : The number of messages sent, the first ones of 'pmsgs'.
+*
+* Note(s)    : 1) The waiting tasks get the first messages, one each and highest priority first, the other
+*                 messages are put in the queue.  A task waiting in OSQPendN() takes these from the queue
+*                 when it runs.
+*              2) The time interrupts are disabled grows with the number of tasks readied and messages
+*                 queued, keep 'nmsgs' within what your interrupt latency allows.
+*********************************************************************************************************
+*/
+
+#if OS_Q_POST_N_EN > 0
+INT16U  OSQPostN (OS_EVENT *pevent, void **pmsgs, INT16U nmsgs, INT8U *perr)
+{
+    OS_Q      *pq;
+    INT16U     nbr;
+    INT16U     nbr_q;
+    BOOLEAN    sched;
+#if OS_CRITICAL_METHOD == 3                            /* Allocate storage for CPU status register     */
+    OS_CPU_SR  cpu_sr = 0;
+#endif
+
+
+
+#if OS_ARG_CHK_EN > 0
+    if (perr == (INT8U *)0) {                          /* Validate 'perr'                              */
+        return (0);
+    }
+    if (pevent == (OS_EVENT *)0) {                     /* Validate 'pevent'                            */
+        *perr = OS_ERR_PEVENT_NULL;
+        return (0);
+    }
+    if (pmsgs == (void **)0) {                         /* Validate 'pmsgs'                             */
+        *perr = OS_ERR_PDATA_NULL;
+        return (0);
+    }
+#endif
+    if (pevent->OSEventType != OS_EVENT_TYPE_Q) {      /* Validate event block type                    */
+        *perr = OS_ERR_EVENT_TYPE;
+        return (0);
+    }
+    sched = OS_FALSE;
+    nbr   = 0;
+    OS_ENTER_CRITICAL();
+    while ((nbr < nmsgs) && (pevent->OSEventGrp != 0)) {   /* One message to each waiting task         */
+        (void)OS_EventTaskRdy(pevent, pmsgs[nbr], OS_STAT_Q, OS_STAT_PEND_OK);
+        nbr++;
+        sched = OS_TRUE;
+    }
+    pq    = (OS_Q *)pevent->OSEventPtr;                /* Point to queue control block                 */
+    nbr_q = pq->OSQSize - pq->OSQEntries;              /* Queue the others, as many as fit             */
+    if (nbr_q > (nmsgs - nbr)) {
+        nbr_q = nmsgs - nbr;
+    }
+#if OS_Q_PRIO_EN > 0
+    if (pq->OSQPrio == OS_TRUE) {                      /* Priority queue, post at the lowest priority  */
+        while (nbr_q > 0) {
+            OS_QPrioPut(pq, pmsgs[nbr], OS_Q_PRIO_LEVELS - 1, OS_FALSE);
+            nbr++;
+            nbr_q--;
+        }
+    }
+#endif
+    pq->OSQEntries += nbr_q;
+    while (nbr_q > 0) {
+        *pq->OSQIn++ = pmsgs[nbr];                     /* Insert message into queue                    */
+        if (pq->OSQIn == pq->OSQEnd) {                 /* Wrap IN ptr if we are at end of queue        */
+            pq->OSQIn = pq->OSQStart;
+        }
+        nbr++;
+        nbr_q--;
+    }
+#if OS_EVENT_PROF_EN > 0
+    pevent->OSEventProf.OSPostCtr += nbr;
+    if (pq->OSQEntries > pevent->OSEventProf.OSDepthMax) {
+        pevent->OSEventProf.OSDepthMax = pq->OSQEntries;
+    }
+#endif
+#if (OS_SET_EN > 0) && (OS_MAX_SETS > 0)
+    if (pq->OSQEntries > 0) {
+        if (OS_SetSignal(pevent) == OS_TRUE) {         /* Ready the task pending on the event set      */
+            sched = OS_TRUE;
+        }
+    }
+#endif
+    OS_EXIT_CRITICAL();
+    if (sched == OS_TRUE) {
+        OS_Sched();                                    /* Find highest priority task ready to run      */
+    }
+    if (nbr < nmsgs) {
+        *perr = OS_ERR_Q_FULL;
+    } else {
+        *perr = OS_ERR_NONE;
+    }
+    return (nbr);
+}
+#endif
+/*$PAGE*/
+/*
+*********************************************************************************************************
 *                                        POST MESSAGE TO A QUEUE
 *
 * Description: This function sends a message to a queue.  This call has been added to reduce code size
@@ -719,6 +1175,9 @@ INT8U  OSQPostOpt (OS_EVENT *pevent, void *pmsg, INT8U opt)
         return (OS_ERR_EVENT_TYPE);
     }
     OS_ENTER_CRITICAL();
+#if OS_EVENT_PROF_EN > 0
+    pevent->OSEventProf.OSPostCtr++;
+#endif
     if (pevent->OSEventGrp != 0x00) {                 /* See if any task pending on queue              */
         if ((opt & OS_POST_OPT_BROADCAST) != 0x00) {  /* Do we need to post msg to ALL waiting tasks ? */
             while (pevent->OSEventGrp != 0) {         /* Yes, Post to ALL tasks waiting on queue       */
@@ -738,19 +1197,136 @@ INT8U  OSQPostOpt (OS_EVENT *pevent, void *pmsg, INT8U opt)
         OS_EXIT_CRITICAL();
         return (OS_ERR_Q_FULL);
     }
-    if ((opt & OS_POST_OPT_FRONT) != 0x00) {          /* Do we post to the FRONT of the queue?         */
-        if (pq->OSQOut == pq->OSQStart) {             /* Yes, Post as LIFO, Wrap OUT pointer if we ... */
-            pq->OSQOut = pq->OSQEnd;                  /*      ... are at the 1st queue entry           */
+#if OS_Q_PRIO_EN > 0
+    if (pq->OSQPrio == OS_TRUE) {                     /* Priority queue, FRONT is ahead of priority 0  */
+        if ((opt & OS_POST_OPT_FRONT) != 0x00) {
+            OS_QPrioPut(pq, pmsg, 0, OS_TRUE);
+        } else {                                      /* ... otherwise post at the lowest priority     */
+            OS_QPrioPut(pq, pmsg, OS_Q_PRIO_LEVELS - 1, OS_FALSE);
         }
-        pq->OSQOut--;
-        *pq->OSQOut = pmsg;                           /*      Insert message into queue                */
-    } else {                                          /* No,  Post as FIFO                             */
-        *pq->OSQIn++ = pmsg;                          /*      Insert message into queue                */
-        if (pq->OSQIn == pq->OSQEnd) {                /*      Wrap IN ptr if we are at end of queue    */
+    } else
+#endif
+    {
+        if ((opt & OS_POST_OPT_FRONT) != 0x00) {      /* Do we post to the FRONT of the queue?         */
+            if (pq->OSQOut == pq->OSQStart) {         /* Yes, Post as LIFO, Wrap OUT pointer if we ... */
+                pq->OSQOut = pq->OSQEnd;              /*      ... are at the 1st queue entry           */
+            }
+            pq->OSQOut--;
+            *pq->OSQOut = pmsg;                       /*      Insert message into queue                */
+        } else {                                      /* No,  Post as FIFO                             */
+            *pq->OSQIn++ = pmsg;                      /*      Insert message into queue                */
+            if (pq->OSQIn == pq->OSQEnd) {            /*      Wrap IN ptr if we are at end of queue    */
+                pq->OSQIn = pq->OSQStart;
+            }
+        }
+        pq->OSQEntries++;                             /* Update the nbr of entries in the queue        */
+    }
+#if OS_EVENT_PROF_EN > 0
+    if (pq->OSQEntries > pevent->OSEventProf.OSDepthMax) {
+        pevent->OSEventProf.OSDepthMax = pq->OSQEntries;
+    }
+#endif
+#if (OS_SET_EN > 0) && (OS_MAX_SETS > 0)
+    if (OS_SetSignal(pevent) == OS_TRUE) {            /* Ready the task pending on the event set       */
+        OS_EXIT_CRITICAL();
+        if ((opt & OS_POST_OPT_NO_SCHED) == 0) {
+            OS_Sched();
+        }
+        return (OS_ERR_NONE);
+    }
+#endif
+    OS_EXIT_CRITICAL();
+    return (OS_ERR_NONE);
+}
+#endif
+/*$PAGE*/
+/*
+*********************************************************************************************************
+*                                  POST MESSAGE TO A QUEUE WITH A PRIORITY
+*
+* Description: This function sends a message to a queue of OSQCreatePrio().  The message is returned
+*              after the messages of the same priority posted before it and before all the messages of
+*              the less urgent priorities.
+*
+* Arguments  : pevent        is a pointer to the event control block associated with the desired queue
+*
+*              pmsg          is a pointer to the message to send.
+*
+*              prio          is the priority of the message, 0 (most urgent) to OS_Q_PRIO_LEVELS - 1.
+*
+* Returns    : OS_ERR_NONE           The call was successful and the message was sent
+*              OS_ERR_Q_FULL         If the queue cannot accept any more messages because it is full.
+*              OS_ERR_Q_PRIO_INVALID If 'prio' is not lower than OS_Q_PRIO_LEVELS.
+*              OS_ERR_EVENT_TYPE     If you didn't pass a pointer to a queue.
+*              OS_ERR_PEVENT_NULL    If 'pevent' is a NULL pointer
+*
+* Note(s)    : 1) A task waiting on the queue receives the message at once, whatever its priority, the
+*                 queue is empty when a task waits.
+*              2) On a queue of OSQCreate() the priority is ignored and the message is posted like with
+*                 OSQPost().
+*              3) The queue is shared by all priorities.  If messages of a low priority may fill it, the
+*                 tasks that post them should check the depth of the queue with OSQQuery() first.
+*********************************************************************************************************
+*/
+
+#if OS_Q_PRIO_EN > 0
+INT8U  OSQPostPrio (OS_EVENT *pevent, void *pmsg, INT8U prio)
+{
+    OS_Q      *pq;
+#if OS_CRITICAL_METHOD == 3                            /* Allocate storage for CPU status register     */
+    OS_CPU_SR  cpu_sr = 0;
+#endif
+
+
+
+#if OS_ARG_CHK_EN > 0
+    if (pevent == (OS_EVENT *)0) {                     /* Validate 'pevent'                            */
+        return (OS_ERR_PEVENT_NULL);
+    }
+    if (prio >= OS_Q_PRIO_LEVELS) {                    /* Validate 'prio'                              */
+        return (OS_ERR_Q_PRIO_INVALID);
+    }
+#endif
+    if (pevent->OSEventType != OS_EVENT_TYPE_Q) {      /* Validate event block type                    */
+        return (OS_ERR_EVENT_TYPE);
+    }
+    OS_ENTER_CRITICAL();
+#if OS_EVENT_PROF_EN > 0
+    pevent->OSEventProf.OSPostCtr++;
+#endif
+    if (pevent->OSEventGrp != 0) {                     /* See if any task pending on queue             */
+                                                       /* Ready highest priority task waiting on event */
+        (void)OS_EventTaskRdy(pevent, pmsg, OS_STAT_Q, OS_STAT_PEND_OK);
+        OS_EXIT_CRITICAL();
+        OS_Sched();                                    /* Find highest priority task ready to run      */
+        return (OS_ERR_NONE);
+    }
+    pq = (OS_Q *)pevent->OSEventPtr;                   /* Point to queue control block                 */
+    if (pq->OSQEntries >= pq->OSQSize) {               /* Make sure queue is not full                  */
+        OS_EXIT_CRITICAL();
+        return (OS_ERR_Q_FULL);
+    }
+    if (pq->OSQPrio == OS_TRUE) {
+        OS_QPrioPut(pq, pmsg, prio, OS_FALSE);         /* Append to the messages of the same priority  */
+    } else {
+        *pq->OSQIn++ = pmsg;                           /* FIFO queue, insert message into queue        */
+        pq->OSQEntries++;
+        if (pq->OSQIn == pq->OSQEnd) {                 /* Wrap IN ptr if we are at end of queue        */
             pq->OSQIn = pq->OSQStart;
         }
     }
-    pq->OSQEntries++;                                 /* Update the nbr of entries in the queue        */
+#if OS_EVENT_PROF_EN > 0
+    if (pq->OSQEntries > pevent->OSEventProf.OSDepthMax) {
+        pevent->OSEventProf.OSDepthMax = pq->OSQEntries;
+    }
+#endif
+#if (OS_SET_EN > 0) && (OS_MAX_SETS > 0)
+    if (OS_SetSignal(pevent) == OS_TRUE) {            /* Ready the task pending on the event set       */
+        OS_EXIT_CRITICAL();
+        OS_Sched();
+        return (OS_ERR_NONE);
+    }
+#endif
     OS_EXIT_CRITICAL();
     return (OS_ERR_NONE);
 }
@@ -779,13 +1355,8 @@ INT8U  OSQQuery (OS_EVENT *pevent, OS_Q_DATA *p_q_data)
 {
     OS_Q      *pq;
     INT8U      i;
-#if OS_LOWEST_PRIO <= 63
-    INT8U     *psrc;
-    INT8U     *pdest;
-#else
-    INT16U    *psrc;
-    INT16U    *pdest;
-#endif
+    OS_PRIO_TBL *psrc;
+    OS_PRIO_TBL *pdest;
 #if OS_CRITICAL_METHOD == 3                            /* Allocate storage for CPU status register     */
     OS_CPU_SR  cpu_sr = 0;
 #endif
@@ -811,6 +1382,22 @@ INT8U  OSQQuery (OS_EVENT *pevent, OS_Q_DATA *p_q_data)
         *pdest++ = *psrc++;
     }
     pq = (OS_Q *)pevent->OSEventPtr;
+#if OS_Q_PRIO_EN > 0
+    for (i = 0; i < OS_Q_PRIO_LEVELS; i++) {           /* Depth of each priority, 0 for a FIFO queue   */
+        if (pq->OSQPrio == OS_TRUE) {
+            p_q_data->OSNMsgsPrio[i] = pq->OSQPrioEntries[i];
+        } else {
+            p_q_data->OSNMsgsPrio[i] = 0;
+        }
+    }
+    if (pq->OSQPrio == OS_TRUE) {
+        if (pq->OSQEntries > 0) {                      /* Most urgent message is the next one          */
+            p_q_data->OSMsg = pq->OSQPrioHead[OSUnMapTbl[pq->OSQPrioGrp]]->OSQMsgPtr;
+        } else {
+            p_q_data->OSMsg = (void *)0;
+        }
+    } else
+#endif
     if (pq->OSQEntries > 0) {
         p_q_data->OSMsg = *pq->OSQOut;                 /* Get next message to return if available      */
     } else {
@@ -823,6 +1410,223 @@ INT8U  OSQQuery (OS_EVENT *pevent, OS_Q_DATA *p_q_data)
 }
 #endif                                                 /* OS_Q_QUERY_EN                                */
 
+/*$PAGE*/
+/*
+*********************************************************************************************************
+*                                  TAKE SEVERAL MESSAGES FROM A QUEUE
+*
+* Description: This function takes up to 'nmsgs' messages from a queue, oldest first.
+*
+* Arguments  : pq            is a pointer to the queue control block.
+*
+*              pmsgs         is a pointer to the array where the messages are stored.
+*
+*              nmsgs         is the number of entries of 'pmsgs'.
+*
+* Returns    : The number of messages taken.
+*
+* Note(s)    : 1) This function is INTERNAL to uC/OS-II and your application should not call it.
+*              2) Interrupts are assumed to be disabled when this function is called.
+*********************************************************************************************************
+*/
+
+#if OS_Q_PEND_N_EN > 0
+static  INT16U  OS_QDrain (OS_Q *pq, void **pmsgs, INT16U nmsgs)
+{
+    INT16U  nbr;
+
+
+    if (nmsgs > pq->OSQEntries) {                    /* Not more than there are in the queue           */
+        nmsgs = pq->OSQEntries;
+    }
+#if OS_Q_PRIO_EN > 0
+    if (pq->OSQPrio == OS_TRUE) {                    /* Most urgent first from a priority queue        */
+        for (nbr = 0; nbr < nmsgs; nbr++) {
+            pmsgs[nbr] = OS_QPrioGet(pq);
+        }
+        return (nmsgs);
+    }
+#endif
+    pq->OSQEntries -= nmsgs;
+    for (nbr = 0; nbr < nmsgs; nbr++) {
+        pmsgs[nbr] = *pq->OSQOut++;                  /* Extract oldest message from the queue          */
+        if (pq->OSQOut == pq->OSQEnd) {              /* Wrap OUT pointer if we are at the end          */
+            pq->OSQOut = pq->OSQStart;
+        }
+    }
+    return (nmsgs);
+}
+#endif
+
+/*$PAGE*/
+/*
+*********************************************************************************************************
+*                              TAKE THE MOST URGENT MESSAGE FROM A PRIORITY QUEUE
+*
+* Description: This function takes the oldest message of the most urgent priority that has messages from
+*              a queue of OSQCreatePrio().  The priority is found with OSUnMapTbl[] like the scheduler
+*              finds the highest priority task ready to run.
+*
+* Arguments  : pq            is a pointer to the queue control block, the queue must not be empty.
+*
+* Returns    : The message.
+*
+* Note(s)    : 1) This function is INTERNAL to uC/OS-II and your application should not call it.
+*              2) Interrupts are assumed to be disabled when this function is called.
+*********************************************************************************************************
+*/
+
+#if OS_Q_PRIO_EN > 0
+void  *OS_QPrioGet (OS_Q *pq)
+{
+    OS_Q_MSG  *pentry;
+    INT8U      prio;
+
+
+    prio                = OSUnMapTbl[pq->OSQPrioGrp];       /* Most urgent priority with messages      */
+    pentry              = pq->OSQPrioHead[prio];            /* Its oldest message                      */
+    pq->OSQPrioHead[prio] = pentry->OSQMsgNext;
+    pq->OSQPrioEntries[prio]--;
+    if (pq->OSQPrioEntries[prio] == 0) {                    /* Priority has no more messages           */
+        pq->OSQPrioGrp &= (INT8U)~(1u << prio);
+    }
+    pq->OSQEntries--;
+    pentry->OSQMsgNext  = pq->OSQPrioFree;                  /* Return the entry to the free list       */
+    pq->OSQPrioFree     = pentry;
+    return (pentry->OSQMsgPtr);
+}
+
+/*$PAGE*/
+/*
+*********************************************************************************************************
+*                                  PUT A MESSAGE IN A PRIORITY QUEUE
+*
+* Description: This function puts a message in a queue of OSQCreatePrio(), after the messages of the same
+*              priority or, with 'front', before them.
+*
+* Arguments  : pq            is a pointer to the queue control block, the queue must not be full.
+*
+*              pmsg          is a pointer to the message.
+*
+*              prio          is the priority of the message.
+*
+*              front         is OS_TRUE to put the message before the messages of 'prio'.
+*
+* Returns    : none
+*
+* Note(s)    : 1) This function is INTERNAL to uC/OS-II and your application should not call it.
+*              2) Interrupts are assumed to be disabled when this function is called.
+*********************************************************************************************************
+*/
+
+static  void  OS_QPrioPut (OS_Q *pq, void *pmsg, INT8U prio, BOOLEAN front)
+{
+    OS_Q_MSG  *pentry;
+
+
+    pentry              = pq->OSQPrioFree;                  /* Get a free entry                        */
+    pq->OSQPrioFree     = pentry->OSQMsgNext;
+    pentry->OSQMsgPtr   = pmsg;
+    if (pq->OSQPrioEntries[prio] == 0) {                    /* First message of this priority          */
+        pentry->OSQMsgNext    = (OS_Q_MSG *)0;
+        pq->OSQPrioHead[prio] = pentry;
+        pq->OSQPrioTail[prio] = pentry;
+        pq->OSQPrioGrp       |= (INT8U)(1u << prio);
+    } else if (front == OS_TRUE) {                          /* Before the oldest message               */
+        pentry->OSQMsgNext    = pq->OSQPrioHead[prio];
+        pq->OSQPrioHead[prio] = pentry;
+    } else {                                                /* After the newest message                */
+        pentry->OSQMsgNext    = (OS_Q_MSG *)0;
+        pq->OSQPrioTail[prio]->OSQMsgNext = pentry;
+        pq->OSQPrioTail[prio] = pentry;
+    }
+    pq->OSQPrioEntries[prio]++;
+    pq->OSQEntries++;
+}
+#endif
+
+/*$PAGE*/
+/*
+*********************************************************************************************************
+*                                    POST MESSAGE TO A QUEUE OF A TOPIC
+*
+* Description: This function is called by OSTopicPublish() to post a message to one of the queues
+*              subscribed to a topic.  It does what OSQPostOpt() does for a single waiting task but leaves
+*              the critical section and the call to the scheduler to the caller.
+*
+* Arguments  : pevent        is a pointer to the event control block of the queue.
+*
+*              pmsg          is a pointer to the message to send.
+*
+*              opt           is OS_POST_OPT_FRONT to post as LIFO, the other options are ignored.
+*
+*              psched        is a pointer to a flag that is set to OS_TRUE if a task was readied.  It is not
+*                            changed otherwise.
+*
+* Returns    : OS_ERR_NONE           The message was sent.
+*              OS_ERR_Q_FULL         If the queue is full.
+*
+* Note(s)    : 1) This function is INTERNAL to uC/OS-II and your application should not call it.
+*              2) Interrupts are assumed to be disabled when this function is called.
+*********************************************************************************************************
+*/
+
+#if (OS_TOPIC_EN > 0) && (OS_MAX_TOPICS > 0)
+INT8U  OS_QPost (OS_EVENT *pevent, void *pmsg, INT8U opt, BOOLEAN *psched)
+{
+    OS_Q  *pq;
+
+
+#if OS_EVENT_PROF_EN > 0
+    pevent->OSEventProf.OSPostCtr++;
+#endif
+    if (pevent->OSEventGrp != 0x00) {                 /* See if any task pending on queue              */
+        (void)OS_EventTaskRdy(pevent, pmsg, OS_STAT_Q, OS_STAT_PEND_OK);
+        *psched = OS_TRUE;
+        return (OS_ERR_NONE);
+    }
+    pq = (OS_Q *)pevent->OSEventPtr;                  /* Point to queue control block                  */
+    if (pq->OSQEntries >= pq->OSQSize) {              /* Make sure queue is not full                   */
+        return (OS_ERR_Q_FULL);
+    }
+#if OS_Q_PRIO_EN > 0
+    if (pq->OSQPrio == OS_TRUE) {                     /* Priority queue, FRONT is ahead of priority 0  */
+        if ((opt & OS_POST_OPT_FRONT) != 0x00) {
+            OS_QPrioPut(pq, pmsg, 0, OS_TRUE);
+        } else {                                      /* ... otherwise post at the lowest priority     */
+            OS_QPrioPut(pq, pmsg, OS_Q_PRIO_LEVELS - 1, OS_FALSE);
+        }
+    } else
+#endif
+    {
+        if ((opt & OS_POST_OPT_FRONT) != 0x00) {      /* Do we post to the FRONT of the queue?         */
+            if (pq->OSQOut == pq->OSQStart) {         /* Yes, Post as LIFO, Wrap OUT pointer if we ... */
+                pq->OSQOut = pq->OSQEnd;              /*      ... are at the 1st queue entry           */
+            }
+            pq->OSQOut--;
+            *pq->OSQOut = pmsg;                       /*      Insert message into queue                */
+        } else {                                      /* No,  Post as FIFO                             */
+            *pq->OSQIn++ = pmsg;                      /*      Insert message into queue                */
+            if (pq->OSQIn == pq->OSQEnd) {            /*      Wrap IN ptr if we are at end of queue    */
+                pq->OSQIn = pq->OSQStart;
+            }
+        }
+        pq->OSQEntries++;                             /* Update the nbr of entries in the queue        */
+    }
+#if OS_EVENT_PROF_EN > 0
+    if (pq->OSQEntries > pevent->OSEventProf.OSDepthMax) {
+        pevent->OSEventProf.OSDepthMax = pq->OSQEntries;
+    }
+#endif
+#if (OS_SET_EN > 0) && (OS_MAX_SETS > 0)
+    if (OS_SetSignal(pevent) == OS_TRUE) {            /* Ready the task pending on the event set       */
+        *psched = OS_TRUE;
+    }
+#endif
+    return (OS_ERR_NONE);
+}
+#endif
+
 /*$PAGE*/
 /*
 *********************************************************************************************************
@@ -0,0 +1,985 @@
+/*
+*********************************************************************************************************
+*                                                uC/OS-II
+*                                          The Real-Time Kernel
+*                                          BYTE RING MANAGEMENT
+*
+* File    : OS_RING.C
+* Version : V2.86
+*
+* A byte ring carries variable length messages in a buffer of the application without copying them.  A
+* producer reserves the bytes of a message in the ring, writes the message in place and commits it.  A
+* consumer gets a pointer to the message and its length, reads it in place and releases it.  Producers
+* wait for space and consumers wait for messages in the wait lists of the ring like the tasks waiting on a
+* queue.
+*********************************************************************************************************
+*/
+
+#ifndef  OS_MASTER_FILE
+#include <ucos_ii.h>
+#endif
+
+#if (OS_RING_EN > 0) && (OS_MAX_RINGS > 0)
+/*
+*********************************************************************************************************
+*                                            LOCAL DEFINES
+*********************************************************************************************************
+*/
+
+#define  OS_RING_HDR_SIZE      ((INT32U)sizeof(OS_RING_HDR))
+
+#define  OS_RING_HDR_AT(pring, offset)  ((OS_RING_HDR *)((pring)->OSRingStart + (offset)))
+
+/*
+*********************************************************************************************************
+*                                          LOCAL FUNCTION PROTOTYPES
+*********************************************************************************************************
+*/
+
+static  void          *OS_RingAlloc(OS_RING *pring, INT32U len);
+static  BOOLEAN        OS_RingDeliver(OS_EVENT *pevent);
+static  void           OS_RingFree(OS_RING *pring);
+static  void          *OS_RingGet(OS_RING *pring);
+static  BOOLEAN        OS_RingGrant(OS_RING *pring);
+static  OS_RING_HDR   *OS_RingHdr(OS_RING *pring, void *pdata);
+
+/*$PAGE*/
+/*
+*********************************************************************************************************
+*                                    ACCEPT A MESSAGE FROM A BYTE RING
+*
+* Description: This function gets the oldest committed message of a byte ring.  Unlike OSRingPend(),
+*              OSRingAccept() does not suspend the calling task if there is none.
+*
+* Arguments  : pevent        is a pointer to the event control block of the byte ring.
+*
+*              plen          is a pointer to where the length of the message will be deposited.
+*
+*              perr          is a pointer to where an error message will be deposited.  Possible error
+*                            messages are:
+*
+*                            OS_ERR_NONE         The call was successful and you got a message.
+*                            OS_ERR_RING_EMPTY   The ring has no committed message.
+*                            OS_ERR_EVENT_TYPE   If you didn't pass a pointer to a byte ring.
+*                            OS_ERR_PEVENT_NULL  If 'pevent' is a NULL pointer.
+*                            OS_ERR_PDATA_NULL   If 'plen' is a NULL pointer.
+*
+* Returns    : != (void *)0  is a pointer to the message in the ring, release it with OSRingRelease().
+*              == (void *)0  if the ring has no committed message.
+*
+* Note(s)    : 1) This function can be called from an ISR.
+*********************************************************************************************************
+*/
+
+void  *OSRingAccept (OS_EVENT *pevent, INT32U *plen, INT8U *perr)
+{
+    void      *pdata;
+#if OS_CRITICAL_METHOD == 3                           /* Allocate storage for CPU status register      */
+    OS_CPU_SR  cpu_sr = 0;
+#endif
+
+
+
+#if OS_ARG_CHK_EN > 0
+    if (perr == (INT8U *)0) {                         /* Validate 'perr'                               */
+        return ((void *)0);
+    }
+    if (pevent == (OS_EVENT *)0) {                    /* Validate 'pevent'                             */
+        *perr = OS_ERR_PEVENT_NULL;
+        return ((void *)0);
+    }
+    if (plen == (INT32U *)0) {                        /* Validate 'plen'                               */
+        *perr = OS_ERR_PDATA_NULL;
+        return ((void *)0);
+    }
+#endif
+    if (pevent->OSEventType != OS_EVENT_TYPE_RING) {  /* Validate event block type                     */
+        *perr = OS_ERR_EVENT_TYPE;
+        return ((void *)0);
+    }
+    OS_ENTER_CRITICAL();
+    pdata = OS_RingGet((OS_RING *)pevent->OSEventPtr);
+    OS_EXIT_CRITICAL();
+    if (pdata == (void *)0) {
+        *plen = 0;
+        *perr = OS_ERR_RING_EMPTY;
+        return ((void *)0);
+    }
+    *plen = ((OS_RING_HDR *)pdata - 1)->OSRingHdrLen;
+    *perr = OS_ERR_NONE;
+    return (pdata);
+}
+
+/*$PAGE*/
+/*
+*********************************************************************************************************
+*                                      COMMIT A MESSAGE TO A BYTE RING
+*
+* Description: This function makes a message written in the space reserved by OSRingReserve() available
+*              to the consumers.  The highest priority task waiting for a message gets it.
+*
+* Arguments  : pevent        is a pointer to the event control block of the byte ring.
+*
+*              pdata         is the pointer returned by OSRingReserve().
+*
+*              len           is the length of the message, it can be shorter than the reserved length.
+*
+* Returns    : OS_ERR_NONE           The call was successful and the message was committed.
+*              OS_ERR_RING_SIZE      If 'len' is larger than the reserved length.
+*              OS_ERR_RING_INVALID   If 'pdata' is not a reservation of the ring that is not committed.
+*              OS_ERR_EVENT_TYPE     If you didn't pass a pointer to a byte ring.
+*              OS_ERR_PEVENT_NULL    If 'pevent' is a NULL pointer.
+*
+* Note(s)    : 1) Messages are given to the consumers in the order they were reserved.  A message that is
+*                 reserved but not committed yet holds back the messages reserved after it.
+*              2) This function can be called from an ISR.
+*********************************************************************************************************
+*/
+
+INT8U  OSRingCommit (OS_EVENT *pevent, void *pdata, INT32U len)
+{
+    OS_RING_HDR  *phdr;
+    BOOLEAN       sched;
+#if OS_CRITICAL_METHOD == 3                           /* Allocate storage for CPU status register      */
+    OS_CPU_SR     cpu_sr = 0;
+#endif
+
+
+
+#if OS_ARG_CHK_EN > 0
+    if (pevent == (OS_EVENT *)0) {                    /* Validate 'pevent'                             */
+        return (OS_ERR_PEVENT_NULL);
+    }
+#endif
+    if (pevent->OSEventType != OS_EVENT_TYPE_RING) {  /* Validate event block type                     */
+        return (OS_ERR_EVENT_TYPE);
+    }
+    phdr = OS_RingHdr((OS_RING *)pevent->OSEventPtr, pdata);
+    if (phdr == (OS_RING_HDR *)0) {
+        return (OS_ERR_RING_INVALID);
+    }
+    OS_ENTER_CRITICAL();
+    if ((phdr->OSRingHdrSize & OS_RING_REC_MSK) != OS_RING_REC_RESERVED) {
+        OS_EXIT_CRITICAL();
+        return (OS_ERR_RING_INVALID);
+    }
+    if (len > phdr->OSRingHdrLen) {                   /* The header holds the reserved length          */
+        OS_EXIT_CRITICAL();
+        return (OS_ERR_RING_SIZE);
+    }
+    phdr->OSRingHdrLen  = len;
+    phdr->OSRingHdrSize = (phdr->OSRingHdrSize & ~OS_RING_REC_MSK) | OS_RING_REC_COMMITTED;
+    sched               = OS_RingDeliver(pevent);     /* Give the message to a waiting consumer        */
+    OS_EXIT_CRITICAL();
+    if (sched == OS_TRUE) {
+        OS_Sched();                                   /* Find highest priority task ready to run       */
+    }
+    return (OS_ERR_NONE);
+}
+
+/*$PAGE*/
+/*
+*********************************************************************************************************
+*                                           CREATE A BYTE RING
+*
+* Description: This function creates a byte ring in a buffer of the application.
+*
+* Arguments  : pstart        is a pointer to the storage of the ring.  The start is rounded up to a multiple
+*                            of OS_RING_ALIGN.
+*
+*              size          is the number of bytes of the storage.  The size of the ring is rounded down
+*                            to a multiple of OS_RING_ALIGN.
+*
+*              perr          is a pointer to where an error message will be deposited.  Possible error
+*                            messages are:
+*
+*                            OS_ERR_NONE            The call was successful.
+*                            OS_ERR_RING_DEPLETED   No event control block or byte ring control block was
+*                                                   available.
+*                            OS_ERR_RING_SIZE       The storage cannot hold a message of one byte.
+*                            OS_ERR_CREATE_ISR      If you called this function from an ISR.
+*                            OS_ERR_PDATA_NULL      If 'pstart' is a NULL pointer.
+*
+* Returns    : != (OS_EVENT *)0  is a pointer to the event control block (OS_EVENT) associated with the
+*                                created byte ring
+*              == (OS_EVENT *)0  upon error
+*
+* Note(s)    : 1) Every message takes a header of OS_RING_ALIGN bytes and is padded to a multiple of
+*                 OS_RING_ALIGN bytes.  A message is contiguous, the space left at the end of the storage
+*                 when a message does not fit there is skipped.
+*********************************************************************************************************
+*/
+
+OS_EVENT  *OSRingCreate (void *pstart, INT32U size, INT8U *perr)
+{
+    OS_EVENT  *pevent;
+    OS_RING   *pring;
+    INT32U     skip;
+#if OS_CRITICAL_METHOD == 3                      /* Allocate storage for CPU status register           */
+    OS_CPU_SR  cpu_sr = 0;
+#endif
+
+
+
+#if OS_ARG_CHK_EN > 0
+    if (perr == (INT8U *)0) {                    /* Validate 'perr'                                    */
+        return ((OS_EVENT *)0);
+    }
+    if (pstart == (void *)0) {                   /* Validate 'pstart'                                  */
+        *perr = OS_ERR_PDATA_NULL;
+        return ((OS_EVENT *)0);
+    }
+#endif
+    if (OSIntNesting > 0) {                      /* See if called from ISR ...                         */
+        *perr = OS_ERR_CREATE_ISR;               /* ... can't CREATE from an ISR                       */
+        return ((OS_EVENT *)0);
+    }
+    skip = (INT32U)(-(unsigned long)pstart & (OS_RING_ALIGN - 1));   /* Bytes up to the alignment     */
+    if (size < skip + 2 * OS_RING_HDR_SIZE) {    /* Room for a header and one byte                     */
+        *perr = OS_ERR_RING_SIZE;
+        return ((OS_EVENT *)0);
+    }
+#if OS_SLAB_EN > 0
+    OS_SlabEventRefill();                        /* Grow the free lists if they are empty              */
+    OS_SlabRingRefill();
+#endif
+    OS_ENTER_CRITICAL();
+    pevent = OSEventFreeList;                    /* Get next free event control block                  */
+    if (OSEventFreeList != (OS_EVENT *)0) {      /* See if pool of free ECB pool was empty             */
+        OSEventFreeList = (OS_EVENT *)OSEventFreeList->OSEventPtr;
+    }
+    OS_EXIT_CRITICAL();
+    if (pevent == (OS_EVENT *)0) {
+        *perr = OS_ERR_RING_DEPLETED;
+        return ((OS_EVENT *)0);
+    }
+    OS_ENTER_CRITICAL();
+    pring = OSRingFreeList;                      /* Get a free byte ring control block                 */
+    if (pring == (OS_RING *)0) {
+        pevent->OSEventPtr = (void *)OSEventFreeList;      /* No,  Return event control block on error */
+        OSEventFreeList    = pevent;
+        OS_EXIT_CRITICAL();
+        *perr = OS_ERR_RING_DEPLETED;
+        return ((OS_EVENT *)0);
+    }
+    OSRingFreeList                 = OSRingFreeList->OSRingPtr;
+    OS_EXIT_CRITICAL();
+    pring->OSRingStart             = (INT8U *)pstart + skip;
+    pring->OSRingSize              = (size - skip) & ~(OS_RING_ALIGN - 1);
+    pring->OSRingUsed              = 0;
+    pring->OSRingIn                = 0;
+    pring->OSRingRd                = 0;
+    pring->OSRingOut               = 0;
+    pring->OSRingRdCnt             = 0;
+    pring->OSRingSpace.OSEventType = OS_EVENT_TYPE_RING;
+    pring->OSRingSpace.OSEventCnt  = 0;
+    pring->OSRingSpace.OSEventPtr  = pring;
+    OS_EventWaitListInit(&pring->OSRingSpace);   /*      Initalize the wait list of the producers      */
+    pevent->OSEventType            = OS_EVENT_TYPE_RING;
+    pevent->OSEventCnt             = 0;
+    pevent->OSEventPtr             = pring;
+#if OS_EVENT_NAME_SIZE > 1
+    pevent->OSEventName[0]         = '?';        /* Unknown name                                       */
+    pevent->OSEventName[1]         = OS_ASCII_NUL;
+#endif
+    OS_EventWaitListInit(pevent);                /*      Initalize the wait list of the consumers      */
+    *perr = OS_ERR_NONE;
+    return (pevent);
+}
+
+/*$PAGE*/
+/*
+*********************************************************************************************************
+*                                           DELETE A BYTE RING
+*
+* Description: This function deletes a byte ring and readies all tasks waiting for space or messages.
+*
+* Arguments  : pevent        is a pointer to the event control block of the byte ring.
+*
+*              opt           determines delete options as follows:
+*                            opt == OS_DEL_NO_PEND   Delete the byte ring ONLY if no task pending
+*                            opt == OS_DEL_ALWAYS    Deletes the byte ring even if tasks are waiting.
+*                                                    In this case, all the tasks pending will be readied
+*                                                    and get OS_ERR_PEND_ABORT.
+*
+*              perr          is a pointer to an error code that can contain one of the following values:
+*                            OS_ERR_NONE             The call was successful and the byte ring was deleted
+*                            OS_ERR_DEL_ISR          If you tried to delete the byte ring from an ISR
+*                            OS_ERR_INVALID_OPT      An invalid option was specified
+*                            OS_ERR_TASK_WAITING     One or more tasks were waiting on the byte ring
+*                            OS_ERR_EVENT_TYPE       If you didn't pass a pointer to a byte ring
+*                            OS_ERR_PEVENT_NULL      If 'pevent' is a NULL pointer.
+*
+* Returns    : pevent        upon error
+*              (OS_EVENT *)0 if the byte ring was successfully deleted.
+*
+* Note(s)    : 1) The messages still in the ring are dropped, the pointers to them the tasks hold are no
+*                 longer valid.
+*********************************************************************************************************
+*/
+
+OS_EVENT  *OSRingDel (OS_EVENT *pevent, INT8U opt, INT8U *perr)
+{
+    BOOLEAN    tasks_waiting;
+    OS_RING   *pring;
+#if OS_CRITICAL_METHOD == 3                                /* Allocate storage for CPU status register */
+    OS_CPU_SR  cpu_sr = 0;
+#endif
+
+
+
+#if OS_ARG_CHK_EN > 0
+    if (perr == (INT8U *)0) {                              /* Validate 'perr'                          */
+        return (pevent);
+    }
+    if (pevent == (OS_EVENT *)0) {                         /* Validate 'pevent'                        */
+        *perr = OS_ERR_PEVENT_NULL;
+        return (pevent);
+    }
+#endif
+    if (pevent->OSEventType != OS_EVENT_TYPE_RING) {       /* Validate event block type                */
+        *perr = OS_ERR_EVENT_TYPE;
+        return (pevent);
+    }
+    if (OSIntNesting > 0) {                                /* See if called from ISR ...               */
+        *perr = OS_ERR_DEL_ISR;                            /* ... can't DELETE from an ISR             */
+        return (pevent);
+    }
+    OS_ENTER_CRITICAL();
+    pring = (OS_RING *)pevent->OSEventPtr;
+    if ((pevent->OSEventGrp != 0) || (pring->OSRingSpace.OSEventGrp != 0)) {
+        tasks_waiting = OS_TRUE;                           /* Yes, tasks wait for messages or space    */
+    } else {
+        tasks_waiting = OS_FALSE;
+    }
+    if ((opt != OS_DEL_NO_PEND) && (opt != OS_DEL_ALWAYS)) {
+        OS_EXIT_CRITICAL();
+        *perr = OS_ERR_INVALID_OPT;
+        return (pevent);
+    }
+    if ((opt == OS_DEL_NO_PEND) && (tasks_waiting == OS_TRUE)) {
+        OS_EXIT_CRITICAL();
+        *perr = OS_ERR_TASK_WAITING;
+        return (pevent);
+    }
+    while (pevent->OSEventGrp != 0) {                      /* Ready ALL tasks waiting for messages     */
+        (void)OS_EventTaskRdy(pevent, (void *)0, OS_STAT_Q, OS_STAT_PEND_ABORT);
+    }
+    while (pring->OSRingSpace.OSEventGrp != 0) {           /* Ready ALL tasks waiting for space        */
+        (void)OS_EventTaskRdy(&pring->OSRingSpace, (void *)0, OS_STAT_Q, OS_STAT_PEND_ABORT);
+    }
+    pring->OSRingSpace.OSEventType = OS_EVENT_TYPE_UNUSED;
+    pring->OSRingPtr       = OSRingFreeList;               /* Return OS_RING to free list              */
+    OSRingFreeList         = pring;
+#if OS_EVENT_NAME_SIZE > 1
+    pevent->OSEventName[0] = '?';                          /* Unknown name                             */
+    pevent->OSEventName[1] = OS_ASCII_NUL;
+#endif
+    pevent->OSEventType    = OS_EVENT_TYPE_UNUSED;
+    pevent->OSEventPtr     = OSEventFreeList;              /* Return Event Control Block to free list  */
+    pevent->OSEventCnt     = 0;
+    OSEventFreeList        = pevent;
+    OS_EXIT_CRITICAL();
+    if (tasks_waiting == OS_TRUE) {                        /* Reschedule only if task(s) were waiting  */
+        OS_Sched();
+    }
+    *perr = OS_ERR_NONE;
+    return ((OS_EVENT *)0);
+}
+
+/*$PAGE*/
+/*
+*********************************************************************************************************
+*                                    PEND ON A BYTE RING FOR A MESSAGE
+*
+* Description: This function waits for a committed message in a byte ring.
+*
+* Arguments  : pevent        is a pointer to the event control block of the byte ring.
+*
+*              plen          is a pointer to where the length of the message will be deposited.
+*
+*              timeout       is an optional timeout period (in clock ticks).  If non-zero, your task will
+*                            wait for a message up to the amount of time specified by this argument.  If you
+*                            specify 0, however, your task will wait forever.
+*
+*              perr          is a pointer to where an error message will be deposited.  Possible error
+*                            messages are:
+*
+*                            OS_ERR_NONE         The call was successful and you got a message.
+*                            OS_ERR_TIMEOUT      No message was committed within 'timeout'.
+*                            OS_ERR_PEND_ABORT   The wait on the byte ring was aborted by deleting it.
+*                            OS_ERR_EVENT_TYPE   If you didn't pass a pointer to a byte ring.
+*                            OS_ERR_PEND_ISR     If you called this function from an ISR and the result
+*                                                would lead to a suspension.
+*                            OS_ERR_PEVENT_NULL  If 'pevent' is a NULL pointer.
+*                            OS_ERR_PDATA_NULL   If 'plen' is a NULL pointer.
+*                            OS_ERR_PEND_LOCKED  If you called this function when the scheduler is locked
+*
+* Returns    : != (void *)0  is a pointer to the message in the ring, release it with OSRingRelease().
+*              == (void *)0  upon error
+*
+* Note(s)    : 1) The message stays in the ring until it is released, a consumer can hold several messages
+*                 and release them in any order.  The space of a message is reused once it and all the
+*                 messages before it are released.
+*              2) A task waiting on a byte ring has OS_STAT_Q set in OSTCBStat.
+*********************************************************************************************************
+*/
+
+void  *OSRingPend (OS_EVENT *pevent, INT32U *plen, INT16U timeout, INT8U *perr)
+{
+    void      *pdata;
+#if OS_CRITICAL_METHOD == 3                           /* Allocate storage for CPU status register      */
+    OS_CPU_SR  cpu_sr = 0;
+#endif
+
+
+
+#if OS_ARG_CHK_EN > 0
+    if (perr == (INT8U *)0) {                         /* Validate 'perr'                               */
+        return ((void *)0);
+    }
+    if (pevent == (OS_EVENT *)0) {                    /* Validate 'pevent'                             */
+        *perr = OS_ERR_PEVENT_NULL;
+        return ((void *)0);
+    }
+    if (plen == (INT32U *)0) {                        /* Validate 'plen'                               */
+        *perr = OS_ERR_PDATA_NULL;
+        return ((void *)0);
+    }
+#endif
+    if (pevent->OSEventType != OS_EVENT_TYPE_RING) {  /* Validate event block type                     */
+        *perr = OS_ERR_EVENT_TYPE;
+        return ((void *)0);
+    }
+    if (OSIntNesting > 0) {                           /* See if called from ISR ...                    */
+        *perr = OS_ERR_PEND_ISR;                      /* ... can't PEND from an ISR                    */
+        return ((void *)0);
+    }
+    if (OSLockNesting > 0) {                          /* See if called with scheduler locked ...       */
+        *perr = OS_ERR_PEND_LOCKED;                   /* ... can't PEND when locked                    */
+        return ((void *)0);
+    }
+    *plen = 0;
+    OS_ENTER_CRITICAL();
+    pdata = OS_RingGet((OS_RING *)pevent->OSEventPtr);
+    if (pdata != (void *)0) {                         /* See if a message is committed already         */
+        OS_EXIT_CRITICAL();
+        *plen = ((OS_RING_HDR *)pdata - 1)->OSRingHdrLen;
+        *perr = OS_ERR_NONE;
+        return (pdata);
+    }
+                                                      /* Otherwise, must wait until a commit           */
+    OSTCBCur->OSTCBStat     |= OS_STAT_Q;
+    OSTCBCur->OSTCBStatPend  = OS_STAT_PEND_OK;
+    OS_TickListInsert(OSTCBCur, timeout);             /* Store pend timeout in TCB and tick list       */
+    OS_EventTaskWait(pevent);                         /* Suspend task until a commit or timeout occurs */
+    OS_EXIT_CRITICAL();
+    OS_Sched();                                       /* Find next highest priority task ready         */
+    OS_ENTER_CRITICAL();
+    switch (OSTCBCur->OSTCBStatPend) {                /* See if we timed-out or aborted                */
+        case OS_STAT_PEND_OK:                         /* The committer handed us the message           */
+             pdata = OSTCBCur->OSTCBMsg;
+             *plen = ((OS_RING_HDR *)pdata - 1)->OSRingHdrLen;
+             *perr = OS_ERR_NONE;
+             break;
+
+        case OS_STAT_PEND_ABORT:                      /* The byte ring was deleted                     */
+             pdata = (void *)0;
+             *perr = OS_ERR_PEND_ABORT;               /* Indicate that we aborted                      */
+             break;
+
+        case OS_STAT_PEND_TO:
+        default:
+             OS_EventTaskRemove(OSTCBCur, pevent);
+             pdata = (void *)0;
+             *perr = OS_ERR_TIMEOUT;                  /* Indicate that we didn't get event within TO   */
+             break;
+    }
+    OSTCBCur->OSTCBStat          =  OS_STAT_RDY;      /* Set   task  status to ready                   */
+    OSTCBCur->OSTCBStatPend      =  OS_STAT_PEND_OK;  /* Clear pend  status                            */
+    OSTCBCur->OSTCBEventPtr      = (OS_EVENT  *)0;    /* Clear event pointers                          */
+#if (OS_EVENT_MULTI_EN > 0)
+    OSTCBCur->OSTCBEventMultiPtr = (OS_EVENT **)0;
+#endif
+    OSTCBCur->OSTCBMsg           = (void      *)0;    /* Clear  received message                       */
+    OS_EXIT_CRITICAL();
+    return (pdata);
+}
+
+/*$PAGE*/
+/*
+*********************************************************************************************************
+*                                    RELEASE A MESSAGE OF A BYTE RING
+*
+* Description: This function gives back the space of a message got from OSRingPend() or OSRingAccept().
+*              The highest priority tasks waiting for space get it as long as their reservation fits.
+*
+* Arguments  : pevent        is a pointer to the event control block of the byte ring.
+*
+*              pdata         is the pointer returned by OSRingPend() or OSRingAccept().
+*
+* Returns    : OS_ERR_NONE           The call was successful and the message was released.
+*              OS_ERR_RING_INVALID   If 'pdata' is not a message of the ring that is being read.
+*              OS_ERR_EVENT_TYPE     If you didn't pass a pointer to a byte ring.
+*              OS_ERR_PEVENT_NULL    If 'pevent' is a NULL pointer.
+*
+* Note(s)    : 1) This function can be called from an ISR.
+*********************************************************************************************************
+*/
+
+INT8U  OSRingRelease (OS_EVENT *pevent, void *pdata)
+{
+    OS_RING      *pring;
+    OS_RING_HDR  *phdr;
+    BOOLEAN       sched;
+#if OS_CRITICAL_METHOD == 3                           /* Allocate storage for CPU status register      */
+    OS_CPU_SR     cpu_sr = 0;
+#endif
+
+
+
+#if OS_ARG_CHK_EN > 0
+    if (pevent == (OS_EVENT *)0) {                    /* Validate 'pevent'                             */
+        return (OS_ERR_PEVENT_NULL);
+    }
+#endif
+    if (pevent->OSEventType != OS_EVENT_TYPE_RING) {  /* Validate event block type                     */
+        return (OS_ERR_EVENT_TYPE);
+    }
+    pring = (OS_RING *)pevent->OSEventPtr;
+    phdr  = OS_RingHdr(pring, pdata);
+    if (phdr == (OS_RING_HDR *)0) {
+        return (OS_ERR_RING_INVALID);
+    }
+    OS_ENTER_CRITICAL();
+    if ((phdr->OSRingHdrSize & OS_RING_REC_MSK) != OS_RING_REC_READING) {
+        OS_EXIT_CRITICAL();
+        return (OS_ERR_RING_INVALID);
+    }
+    phdr->OSRingHdrSize = (phdr->OSRingHdrSize & ~OS_RING_REC_MSK) | OS_RING_REC_FREE;
+    OS_RingFree(pring);                               /* Reclaim the released messages at the tail     */
+    sched = OS_RingGrant(pring);                      /* Give the space to the waiting producers       */
+    OS_EXIT_CRITICAL();
+    if (sched == OS_TRUE) {
+        OS_Sched();                                   /* Find highest priority task ready to run       */
+    }
+    return (OS_ERR_NONE);
+}
+
+/*$PAGE*/
+/*
+*********************************************************************************************************
+*                                  RESERVE SPACE FOR A MESSAGE IN A BYTE RING
+*
+* Description: This function reserves contiguous space for a message in a byte ring.  The caller writes
+*              the message in place and makes it available with OSRingCommit().
+*
+* Arguments  : pevent        is a pointer to the event control block of the byte ring.
+*
+*              len           is the number of bytes to reserve.
+*
+*              timeout       is an optional timeout period (in clock ticks).  If non-zero, your task will
+*                            wait for space up to the amount of time specified by this argument.  If you
+*                            specify 0, however, your task will wait forever.
+*
+*              perr          is a pointer to where an error message will be deposited.  Possible error
+*                            messages are:
+*
+*                            OS_ERR_NONE         The call was successful and the space is reserved.
+*                            OS_ERR_TIMEOUT      The space was not released within 'timeout'.
+*                            OS_ERR_RING_FULL    If you called this function from an ISR and the ring does
+*                                                not have the space.
+*                            OS_ERR_RING_SIZE    If 'len' never fits in the ring.
+*                            OS_ERR_PEND_ABORT   The wait on the byte ring was aborted by deleting it.
+*                            OS_ERR_EVENT_TYPE   If you didn't pass a pointer to a byte ring.
+*                            OS_ERR_PEVENT_NULL  If 'pevent' is a NULL pointer.
+*                            OS_ERR_PEND_LOCKED  If you called this function when the scheduler is locked
+*                                                and the ring does not have the space.
+*
+* Returns    : != (void *)0  is a pointer to the reserved space, aligned on OS_RING_ALIGN.
+*              == (void *)0  upon error
+*
+* Note(s)    : 1) A reservation that fits is made at once, even if tasks wait for space for longer
+*                 messages.  Releases give the space to the waiting tasks in the order of their priority,
+*                 a task waits as long as the reservation of a higher priority waiting task does not fit.
+*              2) A task waiting on a byte ring has OS_STAT_Q set in OSTCBStat.
+*********************************************************************************************************
+*/
+
+void  *OSRingReserve (OS_EVENT *pevent, INT32U len, INT16U timeout, INT8U *perr)
+{
+    OS_RING   *pring;
+    void      *pdata;
+#if OS_CRITICAL_METHOD == 3                           /* Allocate storage for CPU status register      */
+    OS_CPU_SR  cpu_sr = 0;
+#endif
+
+
+
+#if OS_ARG_CHK_EN > 0
+    if (perr == (INT8U *)0) {                         /* Validate 'perr'                               */
+        return ((void *)0);
+    }
+    if (pevent == (OS_EVENT *)0) {                    /* Validate 'pevent'                             */
+        *perr = OS_ERR_PEVENT_NULL;
+        return ((void *)0);
+    }
+#endif
+    if (pevent->OSEventType != OS_EVENT_TYPE_RING) {  /* Validate event block type                     */
+        *perr = OS_ERR_EVENT_TYPE;
+        return ((void *)0);
+    }
+    pring = (OS_RING *)pevent->OSEventPtr;
+    if (len > pring->OSRingSize - OS_RING_HDR_SIZE) { /* See if the message fits in the empty ring     */
+        *perr = OS_ERR_RING_SIZE;
+        return ((void *)0);
+    }
+    OS_ENTER_CRITICAL();
+    pdata = OS_RingAlloc(pring, len);
+    if (pdata != (void *)0) {                         /* See if the space is free already              */
+        OS_EXIT_CRITICAL();
+        *perr = OS_ERR_NONE;
+        return (pdata);
+    }
+    if (OSIntNesting > 0) {                           /* See if called from ISR ...                    */
+        OS_EXIT_CRITICAL();
+        *perr = OS_ERR_RING_FULL;                     /* ... can't wait for space from an ISR          */
+        return ((void *)0);
+    }
+    if (OSLockNesting > 0) {                          /* See if called with scheduler locked ...       */
+        OS_EXIT_CRITICAL();
+        *perr = OS_ERR_PEND_LOCKED;                   /* ... can't PEND when locked                    */
+        return ((void *)0);
+    }
+                                                      /* Otherwise, must wait until a release          */
+    OSTCBCur->OSTCBRingLen   = len;                   /* Length OS_RingGrant() reserves for us         */
+    OSTCBCur->OSTCBStat     |= OS_STAT_Q;
+    OSTCBCur->OSTCBStatPend  = OS_STAT_PEND_OK;
+    OS_TickListInsert(OSTCBCur, timeout);             /* Store pend timeout in TCB and tick list       */
+    OS_EventTaskWait(&pring->OSRingSpace);            /* Suspend task until a release or timeout       */
+    OS_EXIT_CRITICAL();
+    OS_Sched();                                       /* Find next highest priority task ready         */
+    OS_ENTER_CRITICAL();
+    switch (OSTCBCur->OSTCBStatPend) {                /* See if we timed-out or aborted                */
+        case OS_STAT_PEND_OK:                         /* The releaser reserved the space for us        */
+             pdata = OSTCBCur->OSTCBMsg;
+             *perr = OS_ERR_NONE;
+             break;
+
+        case OS_STAT_PEND_ABORT:                      /* The byte ring was deleted                     */
+             pdata = (void *)0;
+             *perr = OS_ERR_PEND_ABORT;               /* Indicate that we aborted                      */
+             break;
+
+        case OS_STAT_PEND_TO:
+        default:
+             OS_EventTaskRemove(OSTCBCur, &pring->OSRingSpace);
+             pdata = (void *)0;
+             *perr = OS_ERR_TIMEOUT;                  /* Indicate that we didn't get space within TO   */
+             break;
+    }
+    OSTCBCur->OSTCBStat          =  OS_STAT_RDY;      /* Set   task  status to ready                   */
+    OSTCBCur->OSTCBStatPend      =  OS_STAT_PEND_OK;  /* Clear pend  status                            */
+    OSTCBCur->OSTCBEventPtr      = (OS_EVENT  *)0;    /* Clear event pointers                          */
+#if (OS_EVENT_MULTI_EN > 0)
+    OSTCBCur->OSTCBEventMultiPtr = (OS_EVENT **)0;
+#endif
+    OSTCBCur->OSTCBMsg           = (void      *)0;    /* Clear  received message                       */
+    OS_EXIT_CRITICAL();
+    return (pdata);
+}
+
+/*$PAGE*/
+/*
+*********************************************************************************************************
+*                                      BYTE RING MODULE INITIALIZATION
+*
+* Description : This function is called by uC/OS-II to initialize the byte ring module.  Your
+*               application MUST NOT call this function.
+*
+* Arguments   : none
+*
+* Returns     : none
+*
+* Note(s)    : This function is INTERNAL to uC/OS-II and your application should not call it.
+*********************************************************************************************************
+*/
+
+void  OS_RingInit (void)
+{
+    INT16U  i;
+
+
+
+    OS_MemClr((INT8U *)&OSRingTbl[0], sizeof(OSRingTbl));  /* Clear the byte ring table                */
+    for (i = 0; i < (OS_MAX_RINGS - 1); i++) {             /* Init. list of free BYTE RING ctrl blocks */
+        OSRingTbl[i].OSRingPtr = &OSRingTbl[i + 1];
+    }
+    OSRingTbl[OS_MAX_RINGS - 1].OSRingPtr = (OS_RING *)0;
+    OSRingFreeList                        = &OSRingTbl[0];
+}
+
+/*$PAGE*/
+/*
+*********************************************************************************************************
+*                                   ALLOCATE A MESSAGE IN A BYTE RING
+*
+* Description: This function takes the space of a message at the head of a byte ring.  When the message
+*              does not fit between the head and the end of the storage, the rest of the storage is marked
+*              with a wrap record and the message is placed at the start.
+*
+* Arguments  : pring       is a pointer to the byte ring control block.
+*
+*              len         is the length of the message, at most OSRingSize - OS_RING_ALIGN.
+*
+* Returns    : != (void *)0  is a pointer to the space of the message.
+*              == (void *)0  if the message does not fit.
+*
+* Note(s)    : 1) This function is INTERNAL to uC/OS-II and your application should not call it.
+*              2) Interrupts are assumed to be disabled when this function is called.
+*********************************************************************************************************
+*/
+
+static  void  *OS_RingAlloc (OS_RING *pring, INT32U len)
+{
+    OS_RING_HDR  *phdr;
+    INT32U        need;
+    INT32U        size;
+
+
+    need = OS_RING_HDR_SIZE + ((len + (OS_RING_ALIGN - 1)) & ~(OS_RING_ALIGN - 1));
+    size = pring->OSRingSize;
+    if (need > size - pring->OSRingUsed) {                 /* See if the ring has the space at all     */
+        return ((void *)0);
+    }
+    if (pring->OSRingIn >= pring->OSRingOut) {             /* Free space at the end and at the start   */
+        if (need > size - pring->OSRingIn) {               /* See if the message fits at the end       */
+            if (need > pring->OSRingOut) {                 /* No,  see if it fits at the start         */
+                return ((void *)0);
+            }
+            phdr                = OS_RING_HDR_AT(pring, pring->OSRingIn);
+            phdr->OSRingHdrSize = (size - pring->OSRingIn) | OS_RING_REC_WRAP;
+            pring->OSRingUsed  += size - pring->OSRingIn;  /* Skip the end of the storage              */
+            pring->OSRingIn     = 0;
+            if (pring->OSRingRdCnt == 0) {                 /* The next message to read is at the start */
+                pring->OSRingRd = 0;
+            }
+        }
+    } else if (need > pring->OSRingOut - pring->OSRingIn) {/* Free space between the head and the tail */
+        return ((void *)0);
+    }
+    phdr                = OS_RING_HDR_AT(pring, pring->OSRingIn);
+    phdr->OSRingHdrSize = need | OS_RING_REC_RESERVED;
+    phdr->OSRingHdrLen  = len;                             /* Reserved length until the commit         */
+    pring->OSRingIn    += need;
+    if (pring->OSRingIn == size) {
+        pring->OSRingIn = 0;
+    }
+    pring->OSRingUsed  += need;
+    pring->OSRingRdCnt++;
+    return ((void *)(phdr + 1));
+}
+
+/*$PAGE*/
+/*
+*********************************************************************************************************
+*                               GIVE COMMITTED MESSAGES TO WAITING CONSUMERS
+*
+* Description: This function readies the tasks waiting for a message in the order of their priority as
+*              long as the next message of the ring is committed.
+*
+* Arguments  : pevent      is a pointer to the event control block of the byte ring.
+*
+* Returns    : OS_TRUE     if a task was readied, the caller has to reschedule.
+*              OS_FALSE    otherwise.
+*
+* Note(s)    : 1) This function is INTERNAL to uC/OS-II and your application should not call it.
+*              2) Interrupts are assumed to be disabled when this function is called.
+*********************************************************************************************************
+*/
+
+static  BOOLEAN  OS_RingDeliver (OS_EVENT *pevent)
+{
+    void     *pdata;
+    BOOLEAN   sched;
+
+
+    sched = OS_FALSE;
+    while (pevent->OSEventGrp != 0) {                      /* See if any task waiting for a message    */
+        pdata = OS_RingGet((OS_RING *)pevent->OSEventPtr);
+        if (pdata == (void *)0) {
+            break;
+        }
+        (void)OS_EventTaskRdy(pevent, pdata, OS_STAT_Q, OS_STAT_PEND_OK);
+        sched = OS_TRUE;
+    }
+    return (sched);
+}
+
+/*$PAGE*/
+/*
+*********************************************************************************************************
+*                                  RECLAIM RELEASED MESSAGES OF A BYTE RING
+*
+* Description: This function moves the tail of a byte ring over the released messages and wrap records.
+*              The empty ring starts over at the start of the storage.
+*
+* Arguments  : pring       is a pointer to the byte ring control block.
+*
+* Returns    : none
+*
+* Note(s)    : 1) This function is INTERNAL to uC/OS-II and your application should not call it.
+*              2) Interrupts are assumed to be disabled when this function is called.
+*********************************************************************************************************
+*/
+
+static  void  OS_RingFree (OS_RING *pring)
+{
+    OS_RING_HDR  *phdr;
+    INT32U        size;
+
+
+    while (pring->OSRingUsed > 0) {
+        phdr = OS_RING_HDR_AT(pring, pring->OSRingOut);
+        size = phdr->OSRingHdrSize & ~OS_RING_REC_MSK;
+        switch (phdr->OSRingHdrSize & OS_RING_REC_MSK) {
+            case OS_RING_REC_FREE:
+            case OS_RING_REC_WRAP:
+                 pring->OSRingUsed -= size;
+                 pring->OSRingOut  += size;
+                 if (pring->OSRingOut == pring->OSRingSize) {
+                     pring->OSRingOut = 0;
+                 }
+                 break;
+
+            default:                                       /* Oldest message still in use              */
+                 return;
+        }
+    }
+    pring->OSRingIn  = 0;                                  /* Empty, start over                        */
+    pring->OSRingRd  = 0;
+    pring->OSRingOut = 0;
+}
+
+/*$PAGE*/
+/*
+*********************************************************************************************************
+*                                 GET THE NEXT MESSAGE FOR A CONSUMER
+*
+* Description: This function hands out the oldest message of a byte ring not handed out yet if it is
+*              committed.
+*
+* Arguments  : pring       is a pointer to the byte ring control block.
+*
+* Returns    : != (void *)0  is a pointer to the message, its header is marked as being read.
+*              == (void *)0  if there is no message or the next one is not committed yet.
+*
+* Note(s)    : 1) This function is INTERNAL to uC/OS-II and your application should not call it.
+*              2) Interrupts are assumed to be disabled when this function is called.
+*              3) OSRingRd moves past a wrap record as soon as it reaches it, OS_RingAlloc() moves it when
+*                 it writes the wrap record at OSRingRd.  OS_RingFree() reclaims wrap records, a wrap
+*                 record at OSRingRd could be overwritten before the next message is read.
+*********************************************************************************************************
+*/
+
+static  void  *OS_RingGet (OS_RING *pring)
+{
+    OS_RING_HDR  *phdr;
+
+
+    if (pring->OSRingRdCnt == 0) {                         /* See if a message was reserved            */
+        return ((void *)0);
+    }
+    phdr = OS_RING_HDR_AT(pring, pring->OSRingRd);
+    if ((phdr->OSRingHdrSize & OS_RING_REC_MSK) != OS_RING_REC_COMMITTED) {
+        return ((void *)0);
+    }
+    phdr->OSRingHdrSize = (phdr->OSRingHdrSize & ~OS_RING_REC_MSK) | OS_RING_REC_READING;
+    pring->OSRingRd    += phdr->OSRingHdrSize & ~OS_RING_REC_MSK;
+    pring->OSRingRdCnt--;
+    if (pring->OSRingRd == pring->OSRingSize) {
+        pring->OSRingRd = 0;
+    } else if (pring->OSRingRdCnt > 0) {                   /* Never rest on a wrap record (Note #3)    */
+        if ((OS_RING_HDR_AT(pring, pring->OSRingRd)->OSRingHdrSize & OS_RING_REC_MSK) == OS_RING_REC_WRAP) {
+            pring->OSRingRd = 0;
+        }
+    }
+    return ((void *)(phdr + 1));
+}
+
+/*$PAGE*/
+/*
+*********************************************************************************************************
+*                                  GIVE FREE SPACE TO WAITING PRODUCERS
+*
+* Description: This function reserves space for the tasks waiting for space in the order of their
+*              priority and readies them, until the reservation of the highest priority task left does
+*              not fit.
+*
+* Arguments  : pring       is a pointer to the byte ring control block.
+*
+* Returns    : OS_TRUE     if a task was readied, the caller has to reschedule.
+*              OS_FALSE    otherwise.
+*
+* Note(s)    : 1) This function is INTERNAL to uC/OS-II and your application should not call it.
+*              2) Interrupts are assumed to be disabled when this function is called.
+*********************************************************************************************************
+*/
+
+static  BOOLEAN  OS_RingGrant (OS_RING *pring)
+{
+    OS_EVENT  *pspace;
+    void      *pdata;
+    BOOLEAN    sched;
+
+
+    sched  = OS_FALSE;
+    pspace = &pring->OSRingSpace;
+    while (pspace->OSEventGrp != 0) {                      /* See if any task waiting for space        */
+        pdata = OS_RingAlloc(pring, OS_EventTaskHighest(pspace)->OSTCBRingLen);
+        if (pdata == (void *)0) {
+            break;
+        }
+        (void)OS_EventTaskRdy(pspace, pdata, OS_STAT_Q, OS_STAT_PEND_OK);
+        sched = OS_TRUE;
+    }
+    return (sched);
+}
+
+/*$PAGE*/
+/*
+*********************************************************************************************************
+*                                  FIND THE HEADER OF A MESSAGE
+*
+* Description: This function checks that a pointer given by the application can be the start of a message
+*              of a byte ring and returns the header of the message.
+*
+* Arguments  : pring       is a pointer to the byte ring control block.
+*
+*              pdata       is a pointer to the message.
+*
+* Returns    : != (OS_RING_HDR *)0  is a pointer to the header of the message.
+*              == (OS_RING_HDR *)0  if 'pdata' is outside of the storage or not aligned.
+*
+* Note(s)    : 1) This function is INTERNAL to uC/OS-II and your application should not call it.
+*********************************************************************************************************
+*/
+
+static  OS_RING_HDR  *OS_RingHdr (OS_RING *pring, void *pdata)
+{
+    INT8U   *p;
+    INT32U   offset;
+
+
+    p = (INT8U *)pdata;
+    if ((p < pring->OSRingStart + OS_RING_HDR_SIZE) ||     /* See if in the storage, an empty message  */
+        (p > pring->OSRingStart + pring->OSRingSize)) {    /* ... can end the storage                  */
+        return ((OS_RING_HDR *)0);
+    }
+    offset = (INT32U)(p - pring->OSRingStart);
+    if ((offset & (OS_RING_ALIGN - 1)) != 0) {             /* Messages are aligned                     */
+        return ((OS_RING_HDR *)0);
+    }
+    return ((OS_RING_HDR *)pdata - 1);
+}
+#endif                                                      /* OS_RING_EN                               */
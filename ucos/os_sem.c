@@ -103,6 +103,9 @@ OS_EVENT  *OSSemCreate (INT16U cnt)
     if (OSIntNesting > 0) {                                /* See if called from ISR ...               */
         return ((OS_EVENT *)0);                            /* ... can't CREATE from an ISR             */
     }
+#if OS_SLAB_EN > 0
+    OS_SlabEventRefill();                                  /* Grow the free list if it is empty        */
+#endif
     OS_ENTER_CRITICAL();
     pevent = OSEventFreeList;                              /* Get next free event control block        */
     if (OSEventFreeList != (OS_EVENT *)0) {                /* See if pool of free ECB pool was empty   */
@@ -116,6 +119,9 @@ OS_EVENT  *OSSemCreate (INT16U cnt)
 #if OS_EVENT_NAME_SIZE > 1
         pevent->OSEventName[0] = '?';                      /* Unknown name                             */
         pevent->OSEventName[1] = OS_ASCII_NUL;
+#endif
+#if OS_EVENT_PROF_EN > 0
+        OS_MemClr((INT8U *)&pevent->OSEventProf, sizeof(OS_EVENT_PROF));
 #endif
         OS_EventWaitListInit(pevent);                      /* Initialize to 'nobody waiting' on sem.   */
     }
@@ -200,6 +206,9 @@ OS_EVENT  *OSSemDel (OS_EVENT *pevent, INT8U opt, INT8U *perr)
 #if OS_EVENT_NAME_SIZE > 1
                  pevent->OSEventName[0] = '?';             /* Unknown name                             */
                  pevent->OSEventName[1] = OS_ASCII_NUL;
+#endif
+#if (OS_SET_EN > 0) && (OS_MAX_SETS > 0)
+                 OS_SetUnlink(pevent);
 #endif
                  pevent->OSEventType    = OS_EVENT_TYPE_UNUSED;
                  pevent->OSEventPtr     = OSEventFreeList; /* Return Event Control Block to free list  */
@@ -222,6 +231,9 @@ OS_EVENT  *OSSemDel (OS_EVENT *pevent, INT8U opt, INT8U *perr)
 #if OS_EVENT_NAME_SIZE > 1
              pevent->OSEventName[0] = '?';                 /* Unknown name                             */
              pevent->OSEventName[1] = OS_ASCII_NUL;
+#endif
+#if (OS_SET_EN > 0) && (OS_MAX_SETS > 0)
+             OS_SetUnlink(pevent);
 #endif
              pevent->OSEventType    = OS_EVENT_TYPE_UNUSED;
              pevent->OSEventPtr     = OSEventFreeList;     /* Return Event Control Block to free list  */
@@ -308,6 +320,9 @@ void  OSSemPend (OS_EVENT *pevent, INT16U timeout, INT8U *perr)
         return;
     }
     OS_ENTER_CRITICAL();
+#if OS_EVENT_PROF_EN > 0
+    pevent->OSEventProf.OSPendCtr++;
+#endif
     if (pevent->OSEventCnt > 0) {                     /* If sem. is positive, resource available ...   */
         pevent->OSEventCnt--;                         /* ... decrement semaphore only if positive.     */
         OS_EXIT_CRITICAL();
@@ -317,11 +332,14 @@ void  OSSemPend (OS_EVENT *pevent, INT16U timeout, INT8U *perr)
                                                       /* Otherwise, must wait until event occurs       */
     OSTCBCur->OSTCBStat     |= OS_STAT_SEM;           /* Resource not available, pend on semaphore     */
     OSTCBCur->OSTCBStatPend  = OS_STAT_PEND_OK;
-    OSTCBCur->OSTCBDly       = timeout;               /* Store pend timeout in TCB                     */
+    OS_TickListInsert(OSTCBCur, timeout);            /* Store pend timeout in TCB and tick list       */
     OS_EventTaskWait(pevent);                         /* Suspend task until event or timeout occurs    */
     OS_EXIT_CRITICAL();
     OS_Sched();                                       /* Find next highest priority task ready         */
     OS_ENTER_CRITICAL();
+#if OS_EVENT_PROF_EN > 0
+    OS_EventProfWake(&pevent->OSEventProf);           /* Account the blocked and the wakeup time       */
+#endif
     switch (OSTCBCur->OSTCBStatPend) {                /* See if we timed-out or aborted                */
         case OS_STAT_PEND_OK:
              *perr = OS_ERR_NONE;
@@ -346,6 +364,40 @@ void  OSSemPend (OS_EVENT *pevent, INT16U timeout, INT8U *perr)
     OS_EXIT_CRITICAL();
 }
 
+/*$PAGE*/
+/*
+*********************************************************************************************************
+*                                 PEND ON SEMAPHORE, NANOSECOND TIMEOUT
+*
+* Description: This function is OSSemPend() with a timeout in nanoseconds.  The timeout is not
+*              rounded up to clock ticks, it ends at the time stamp of the port (OSCPUTsGet()) it is due.
+*
+* Arguments  : pevent        is a pointer to the event control block associated with the desired
+*                            semaphore.
+*
+*              timeout_ns    is an optional timeout period in nanoseconds.  If you specify 0, your task
+*                            will wait forever like with OSSemPend().
+*
+*              perr          is a pointer to where an error message will be deposited, the same as for
+*                            OSSemPend().
+*
+* Returns    : none
+*********************************************************************************************************
+*/
+
+#if OS_TIME_NS_EN > 0
+void  OSSemPendNs (OS_EVENT *pevent, INT64U timeout_ns, INT8U *perr)
+{
+    if ((timeout_ns == 0) || (OSIntNesting > 0)) {   /* Wait forever, or let OSSemPend() fail         */
+        OSSemPend(pevent, 0, perr);
+        return;
+    }
+    OS_DlyNsSet(timeout_ns);
+    OSSemPend(pevent, 0, perr);
+    OS_DlyNsSet(0);
+}
+#endif
+
 /*$PAGE*/
 /*
 *********************************************************************************************************
@@ -467,6 +519,9 @@ INT8U  OSSemPost (OS_EVENT *pevent)
         return (OS_ERR_EVENT_TYPE);
     }
     OS_ENTER_CRITICAL();
+#if OS_EVENT_PROF_EN > 0
+    pevent->OSEventProf.OSPostCtr++;
+#endif
     if (pevent->OSEventGrp != 0) {                    /* See if any task waiting for semaphore         */
                                                       /* Ready HPT waiting on event                    */
         (void)OS_EventTaskRdy(pevent, (void *)0, OS_STAT_SEM, OS_STAT_PEND_OK);
@@ -476,6 +531,18 @@ INT8U  OSSemPost (OS_EVENT *pevent)
     }
     if (pevent->OSEventCnt < 65535u) {                /* Make sure semaphore will not overflow         */
         pevent->OSEventCnt++;                         /* Increment semaphore count to register event   */
+#if OS_EVENT_PROF_EN > 0
+        if (pevent->OSEventCnt > pevent->OSEventProf.OSDepthMax) {
+            pevent->OSEventProf.OSDepthMax = pevent->OSEventCnt;
+        }
+#endif
+#if (OS_SET_EN > 0) && (OS_MAX_SETS > 0)
+        if (OS_SetSignal(pevent) == OS_TRUE) {        /* Ready the task pending on the event set       */
+            OS_EXIT_CRITICAL();
+            OS_Sched();
+            return (OS_ERR_NONE);
+        }
+#endif
         OS_EXIT_CRITICAL();
         return (OS_ERR_NONE);
     }
@@ -506,13 +573,8 @@ INT8U  OSSemPost (OS_EVENT *pevent)
 #if OS_SEM_QUERY_EN > 0
 INT8U  OSSemQuery (OS_EVENT *pevent, OS_SEM_DATA *p_sem_data)
 {
-#if OS_LOWEST_PRIO <= 63
-    INT8U     *psrc;
-    INT8U     *pdest;
-#else
-    INT16U    *psrc;
-    INT16U    *pdest;
-#endif
+    OS_PRIO_TBL *psrc;
+    OS_PRIO_TBL *pdest;
     INT8U      i;
 #if OS_CRITICAL_METHOD == 3                                /* Allocate storage for CPU status register */
     OS_CPU_SR  cpu_sr = 0;
@@ -602,6 +664,15 @@ void  OSSemSet (OS_EVENT *pevent, INT16U cnt, INT8U *perr)
             *perr              = OS_ERR_TASK_WAITING;
         }
     }
+#if (OS_SET_EN > 0) && (OS_MAX_SETS > 0)
+    if (pevent->OSEventCnt > 0) {
+        if (OS_SetSignal(pevent) == OS_TRUE) {        /* Ready the task pending on the event set       */
+            OS_EXIT_CRITICAL();
+            OS_Sched();
+            return;
+        }
+    }
+#endif
     OS_EXIT_CRITICAL();
 }
 #endif
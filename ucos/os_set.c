@@ -0,0 +1,759 @@
+/*
+*********************************************************************************************************
+*                                                uC/OS-II
+*                                          The Real-Time Kernel
+*                                          EVENT SET MANAGEMENT
+*
+* File    : OS_SET.C
+* Version : V2.86
+*
+* An event set lets one task wait on many semaphores, mailboxes and queues without handing the whole list
+* to the kernel on every wait like OSEventPendMulti() does.  The events are added to the set once.  A post
+* to a member that no task is waiting on directly sets the bit of the member in the ready bitmap of the set
+* and readies the task waiting on the set.  OSSetPend() only looks at the members whose bit is set.
+*********************************************************************************************************
+*/
+
+#ifndef  OS_MASTER_FILE
+#include <ucos_ii.h>
+#endif
+
+#if (OS_SET_EN > 0) && (OS_MAX_SETS > 0)
+/*
+*********************************************************************************************************
+*                                          LOCAL FUNCTION PROTOTYPES
+*********************************************************************************************************
+*/
+
+static  INT8U    OS_SetBitLow(OS_SET_BITS bits);
+static  BOOLEAN  OS_SetEventRdy(OS_EVENT *pevent);
+static  INT8U    OS_SetRdyGet(OS_SET *pset, OS_EVENT **pevents_rdy, INT8U size);
+
+/*$PAGE*/
+/*
+*********************************************************************************************************
+*                                      ACCEPT EVENTS OF AN EVENT SET
+*
+* Description: This function returns the members of an event set that have a count or a message.  Unlike
+*              OSSetPend(), OSSetAccept() does not suspend the calling task if none has.
+*
+* Arguments  : pset          is a pointer to the event control block of the event set.
+*
+*              pevents_rdy   is a pointer to an array to return the members that have a count or a message.
+*                            The array is terminated with a NULL pointer when it is not full.
+*
+*              size          is the number of entries of 'pevents_rdy[]'.
+*
+*              perr          is a pointer to where an error message will be deposited.  Possible error
+*                            messages are:
+*
+*                            OS_ERR_NONE         The call was successful, at least one member is ready.
+*                            OS_ERR_TIMEOUT      No member has a count or a message.
+*                            OS_ERR_EVENT_TYPE   If you didn't pass a pointer to an event set.
+*                            OS_ERR_PEVENT_NULL  If 'pset' is a NULL pointer.
+*                            OS_ERR_PDATA_NULL   If 'pevents_rdy' is a NULL pointer or 'size' is 0.
+*
+* Returns    : The number of members returned in 'pevents_rdy[]'.
+*
+* Note(s)    : 1) The count or the message is NOT taken from the members.  Take it with OSSemAccept(),
+*                 OSMboxAccept() or OSQAccept(), a member that still has a count or a message is returned
+*                 again by the next call.
+*********************************************************************************************************
+*/
+
+INT8U  OSSetAccept (OS_EVENT *pset, OS_EVENT **pevents_rdy, INT8U size, INT8U *perr)
+{
+    INT8U      nbr;
+#if OS_CRITICAL_METHOD == 3                           /* Allocate storage for CPU status register      */
+    OS_CPU_SR  cpu_sr = 0;
+#endif
+
+
+
+#if OS_ARG_CHK_EN > 0
+    if (perr == (INT8U *)0) {                         /* Validate 'perr'                               */
+        return (0);
+    }
+    if (pset == (OS_EVENT *)0) {                      /* Validate 'pset'                               */
+        *perr = OS_ERR_PEVENT_NULL;
+        return (0);
+    }
+    if ((pevents_rdy == (OS_EVENT **)0) || (size == 0)) {
+        *perr = OS_ERR_PDATA_NULL;
+        return (0);
+    }
+#endif
+    if (pset->OSEventType != OS_EVENT_TYPE_SET) {     /* Validate event block type                     */
+        *perr = OS_ERR_EVENT_TYPE;
+        return (0);
+    }
+    OS_ENTER_CRITICAL();
+    nbr = OS_SetRdyGet((OS_SET *)pset->OSEventPtr, pevents_rdy, size);
+    OS_EXIT_CRITICAL();
+    if (nbr > 0) {
+        *perr = OS_ERR_NONE;
+    } else {
+        *perr = OS_ERR_TIMEOUT;
+    }
+    return (nbr);
+}
+
+/*$PAGE*/
+/*
+*********************************************************************************************************
+*                                      ADD AN EVENT TO AN EVENT SET
+*
+* Description: This function makes a semaphore, a mailbox or a queue a member of an event set.
+*
+* Arguments  : pset          is a pointer to the event control block of the event set.
+*
+*              pevent        is a pointer to the event control block of the semaphore, mailbox or queue.
+*
+*              perr          is a pointer to where an error message will be deposited.  Possible error
+*                            messages are:
+*
+*                            OS_ERR_NONE         The event is a member of the set.
+*                            OS_ERR_SET_FULL     The set already has OS_SET_SIZE members.
+*                            OS_ERR_SET_MEMBER   The event already is a member of an event set.
+*                            OS_ERR_EVENT_TYPE   If 'pset' is not an event set or 'pevent' is not a
+*                                                semaphore, a mailbox or a queue.
+*                            OS_ERR_PEVENT_NULL  If 'pset' or 'pevent' is a NULL pointer.
+*
+* Returns    : none
+*
+* Note(s)    : 1) An event can be the member of one event set only.
+*              2) An event that already has a count or a message is returned by the next OSSetPend().
+*********************************************************************************************************
+*/
+
+void  OSSetAdd (OS_EVENT *pset, OS_EVENT *pevent, INT8U *perr)
+{
+    OS_SET      *ps;
+    INT8U        bit;
+    OS_SET_BITS  bits;
+#if OS_CRITICAL_METHOD == 3                           /* Allocate storage for CPU status register      */
+    OS_CPU_SR    cpu_sr = 0;
+#endif
+
+
+
+#if OS_ARG_CHK_EN > 0
+    if (perr == (INT8U *)0) {                         /* Validate 'perr'                               */
+        return;
+    }
+    if ((pset == (OS_EVENT *)0) || (pevent == (OS_EVENT *)0)) {
+        *perr = OS_ERR_PEVENT_NULL;
+        return;
+    }
+#endif
+    if (pset->OSEventType != OS_EVENT_TYPE_SET) {     /* Validate event block types                    */
+        *perr = OS_ERR_EVENT_TYPE;
+        return;
+    }
+    switch (pevent->OSEventType) {
+        case OS_EVENT_TYPE_SEM:
+        case OS_EVENT_TYPE_MBOX:
+        case OS_EVENT_TYPE_Q:
+             break;
+
+        default:
+             *perr = OS_ERR_EVENT_TYPE;
+             return;
+    }
+    OS_ENTER_CRITICAL();
+    if (pevent->OSEventSetPtr != (OS_EVENT *)0) {     /* See if the event is in a set already          */
+        OS_EXIT_CRITICAL();
+        *perr = OS_ERR_SET_MEMBER;
+        return;
+    }
+    ps   = (OS_SET *)pset->OSEventPtr;
+    bits = (OS_SET_BITS)~ps->OSSetUsed;               /* Find a free bit                               */
+#if (OS_SET_SIZE != 32) && (OS_SET_SIZE != 64)
+    bits &= ((OS_SET_BITS)1 << OS_SET_SIZE) - 1;      /* Only the bits of OS_SET_SIZE members          */
+#endif
+    if (bits == 0) {
+        OS_EXIT_CRITICAL();
+        *perr = OS_ERR_SET_FULL;
+        return;
+    }
+    bit                   = OS_SetBitLow(bits);
+    ps->OSSetUsed        |= (OS_SET_BITS)1 << bit;
+    ps->OSSetRdy         |= (OS_SET_BITS)1 << bit;    /* Let the next pend check the event             */
+    ps->OSSetTbl[bit]     = pevent;
+    pevent->OSEventSetPtr = pset;
+    pevent->OSEventSetBit = bit;
+    OS_EXIT_CRITICAL();
+    *perr = OS_ERR_NONE;
+}
+
+/*$PAGE*/
+/*
+*********************************************************************************************************
+*                                         CREATE AN EVENT SET
+*
+* Description: This function creates an event set without members.
+*
+* Arguments  : none
+*
+* Returns    : != (OS_EVENT *)0  is a pointer to the event control block (OS_EVENT) associated with the
+*                                created event set
+*              == (OS_EVENT *)0  if no event control blocks or event set control blocks were available
+*********************************************************************************************************
+*/
+
+OS_EVENT  *OSSetCreate (void)
+{
+    OS_EVENT  *pset;
+    OS_SET    *ps;
+#if OS_CRITICAL_METHOD == 3                      /* Allocate storage for CPU status register           */
+    OS_CPU_SR  cpu_sr = 0;
+#endif
+
+
+
+    if (OSIntNesting > 0) {                      /* See if called from ISR ...                         */
+        return ((OS_EVENT *)0);                  /* ... can't CREATE from an ISR                       */
+    }
+#if OS_SLAB_EN > 0
+    OS_SlabEventRefill();                        /* Grow the free lists if they are empty              */
+    OS_SlabSetRefill();
+#endif
+    OS_ENTER_CRITICAL();
+    pset = OSEventFreeList;                      /* Get next free event control block                  */
+    if (OSEventFreeList != (OS_EVENT *)0) {      /* See if pool of free ECB pool was empty             */
+        OSEventFreeList = (OS_EVENT *)OSEventFreeList->OSEventPtr;
+    }
+    OS_EXIT_CRITICAL();
+    if (pset != (OS_EVENT *)0) {                 /* See if we have an event control block              */
+        OS_ENTER_CRITICAL();
+        ps = OSSetFreeList;                      /* Get a free event set control block                 */
+        if (ps != (OS_SET *)0) {
+            OSSetFreeList          = OSSetFreeList->OSSetPtr;
+            OS_EXIT_CRITICAL();
+            ps->OSSetUsed          = 0;
+            ps->OSSetRdy           = 0;
+            pset->OSEventType      = OS_EVENT_TYPE_SET;
+            pset->OSEventCnt       = 0;
+            pset->OSEventPtr       = ps;
+#if OS_EVENT_NAME_SIZE > 1
+            pset->OSEventName[0]   = '?';                  /* Unknown name                             */
+            pset->OSEventName[1]   = OS_ASCII_NUL;
+#endif
+            OS_EventWaitListInit(pset);                    /*      Initalize the wait list             */
+        } else {
+            pset->OSEventPtr = (void *)OSEventFreeList;    /* No,  Return event control block on error */
+            OSEventFreeList  = pset;
+            OS_EXIT_CRITICAL();
+            pset = (OS_EVENT *)0;
+        }
+    }
+    return (pset);
+}
+
+/*$PAGE*/
+/*
+*********************************************************************************************************
+*                                         DELETE AN EVENT SET
+*
+* Description: This function deletes an event set and readies all tasks pending on it.  The members are
+*              removed from the set, they are not deleted.
+*
+* Arguments  : pset          is a pointer to the event control block of the event set.
+*
+*              opt           determines delete options as follows:
+*                            opt == OS_DEL_NO_PEND   Delete the event set ONLY if no task pending
+*                            opt == OS_DEL_ALWAYS    Deletes the event set even if tasks are waiting.
+*                                                    In this case, all the tasks pending will be readied
+*                                                    and get OS_ERR_PEND_ABORT.
+*
+*              perr          is a pointer to an error code that can contain one of the following values:
+*                            OS_ERR_NONE             The call was successful and the event set was deleted
+*                            OS_ERR_DEL_ISR          If you tried to delete the event set from an ISR
+*                            OS_ERR_INVALID_OPT      An invalid option was specified
+*                            OS_ERR_TASK_WAITING     One or more tasks were waiting on the event set
+*                            OS_ERR_EVENT_TYPE       If you didn't pass a pointer to an event set
+*                            OS_ERR_PEVENT_NULL      If 'pset' is a NULL pointer.
+*
+* Returns    : pset          upon error
+*              (OS_EVENT *)0 if the event set was successfully deleted.
+*********************************************************************************************************
+*/
+
+OS_EVENT  *OSSetDel (OS_EVENT *pset, INT8U opt, INT8U *perr)
+{
+    BOOLEAN      tasks_waiting;
+    OS_SET      *ps;
+    OS_SET_BITS  bits;
+    INT8U        bit;
+#if OS_CRITICAL_METHOD == 3                                /* Allocate storage for CPU status register */
+    OS_CPU_SR    cpu_sr = 0;
+#endif
+
+
+
+#if OS_ARG_CHK_EN > 0
+    if (perr == (INT8U *)0) {                              /* Validate 'perr'                          */
+        return (pset);
+    }
+    if (pset == (OS_EVENT *)0) {                           /* Validate 'pset'                          */
+        *perr = OS_ERR_PEVENT_NULL;
+        return (pset);
+    }
+#endif
+    if (pset->OSEventType != OS_EVENT_TYPE_SET) {          /* Validate event block type                */
+        *perr = OS_ERR_EVENT_TYPE;
+        return (pset);
+    }
+    if (OSIntNesting > 0) {                                /* See if called from ISR ...               */
+        *perr = OS_ERR_DEL_ISR;                            /* ... can't DELETE from an ISR             */
+        return (pset);
+    }
+    OS_ENTER_CRITICAL();
+    if (pset->OSEventGrp != 0) {                           /* See if any tasks waiting on event set    */
+        tasks_waiting = OS_TRUE;
+    } else {
+        tasks_waiting = OS_FALSE;
+    }
+    if ((opt != OS_DEL_NO_PEND) && (opt != OS_DEL_ALWAYS)) {
+        OS_EXIT_CRITICAL();
+        *perr = OS_ERR_INVALID_OPT;
+        return (pset);
+    }
+    if ((opt == OS_DEL_NO_PEND) && (tasks_waiting == OS_TRUE)) {
+        OS_EXIT_CRITICAL();
+        *perr = OS_ERR_TASK_WAITING;
+        return (pset);
+    }
+    while (pset->OSEventGrp != 0) {                        /* Ready ALL tasks waiting on the event set */
+        (void)OS_EventTaskRdy(pset, (void *)0, OS_STAT_SET, OS_STAT_PEND_ABORT);
+    }
+    ps   = (OS_SET *)pset->OSEventPtr;
+    bits = ps->OSSetUsed;
+    while (bits != 0) {                                    /* Remove the members                       */
+        bit                                = OS_SetBitLow(bits);
+        bits                              &= ~((OS_SET_BITS)1 << bit);
+        ps->OSSetTbl[bit]->OSEventSetPtr   = (OS_EVENT *)0;
+        ps->OSSetTbl[bit]                  = (OS_EVENT *)0;
+    }
+    ps->OSSetUsed          = 0;
+    ps->OSSetRdy           = 0;
+    ps->OSSetPtr           = OSSetFreeList;                /* Return OS_SET to free list               */
+    OSSetFreeList          = ps;
+#if OS_EVENT_NAME_SIZE > 1
+    pset->OSEventName[0]   = '?';                          /* Unknown name                             */
+    pset->OSEventName[1]   = OS_ASCII_NUL;
+#endif
+    pset->OSEventType      = OS_EVENT_TYPE_UNUSED;
+    pset->OSEventPtr       = OSEventFreeList;              /* Return Event Control Block to free list  */
+    pset->OSEventCnt       = 0;
+    OSEventFreeList        = pset;
+    OS_EXIT_CRITICAL();
+    if (tasks_waiting == OS_TRUE) {                        /* Reschedule only if task(s) were waiting  */
+        OS_Sched();
+    }
+    *perr = OS_ERR_NONE;
+    return ((OS_EVENT *)0);
+}
+
+/*$PAGE*/
+/*
+*********************************************************************************************************
+*                                         PEND ON AN EVENT SET
+*
+* Description: This function waits until a member of an event set has a count or a message.
+*
+* Arguments  : pset          is a pointer to the event control block of the event set.
+*
+*              pevents_rdy   is a pointer to an array to return the members that have a count or a message.
+*                            The array is terminated with a NULL pointer when it is not full.
+*
+*              size          is the number of entries of 'pevents_rdy[]'.
+*
+*              timeout       is an optional timeout period (in clock ticks).  If non-zero, your task will
+*                            wait for a member up to the amount of time specified by this argument.  If you
+*                            specify 0, however, your task will wait forever.
+*
+*              perr          is a pointer to where an error message will be deposited.  Possible error
+*                            messages are:
+*
+*                            OS_ERR_NONE         The call was successful, see the number returned.
+*                            OS_ERR_TIMEOUT      No member got a count or a message within 'timeout'.
+*                            OS_ERR_PEND_ABORT   The wait on the event set was aborted by deleting it.
+*                            OS_ERR_EVENT_TYPE   If you didn't pass a pointer to an event set.
+*                            OS_ERR_PEND_ISR     If you called this function from an ISR and the result
+*                                                would lead to a suspension.
+*                            OS_ERR_PEVENT_NULL  If 'pset' is a NULL pointer.
+*                            OS_ERR_PDATA_NULL   If 'pevents_rdy' is a NULL pointer or 'size' is 0.
+*                            OS_ERR_PEND_LOCKED  If you called this function when the scheduler is locked
+*
+* Returns    : The number of members returned in 'pevents_rdy[]', at least 1 with OS_ERR_NONE, 0 otherwise.
+*
+* Note(s)    : 1) The count or the message is NOT taken from the members, see OSSetAccept().
+*              2) The members with a count or a message are returned in the order of their bits.  When
+*                 more than 'size' are ready the others are returned by the next call.
+*              3) A post to a member that a task pends on directly goes to that task, not to the set.
+*              4) When a higher priority task takes the count or the message of the member that readied the
+*                 caller first, the caller waits again for the rest of 'timeout'.
+*********************************************************************************************************
+*/
+
+INT8U  OSSetPend (OS_EVENT *pset, OS_EVENT **pevents_rdy, INT8U size, INT16U timeout, INT8U *perr)
+{
+    INT8U      nbr;
+    INT64U     ticks_end;
+    INT64U     ticks;
+#if OS_CRITICAL_METHOD == 3                           /* Allocate storage for CPU status register      */
+    OS_CPU_SR  cpu_sr = 0;
+#endif
+
+
+
+#if OS_ARG_CHK_EN > 0
+    if (perr == (INT8U *)0) {                         /* Validate 'perr'                               */
+        return (0);
+    }
+    if (pset == (OS_EVENT *)0) {                      /* Validate 'pset'                               */
+        *perr = OS_ERR_PEVENT_NULL;
+        return (0);
+    }
+    if ((pevents_rdy == (OS_EVENT **)0) || (size == 0)) {
+        *perr = OS_ERR_PDATA_NULL;
+        return (0);
+    }
+#endif
+    if (pset->OSEventType != OS_EVENT_TYPE_SET) {     /* Validate event block type                     */
+        *perr = OS_ERR_EVENT_TYPE;
+        return (0);
+    }
+    if (OSIntNesting > 0) {                           /* See if called from ISR ...                    */
+        *perr = OS_ERR_PEND_ISR;                      /* ... can't PEND from an ISR                    */
+        return (0);
+    }
+    if (OSLockNesting > 0) {                          /* See if called with scheduler locked ...       */
+        *perr = OS_ERR_PEND_LOCKED;                   /* ... can't PEND when locked                    */
+        return (0);
+    }
+    OS_ENTER_CRITICAL();
+    ticks_end = OSTime + timeout;                     /* Tick at which the wait times out              */
+    nbr       = OS_SetRdyGet((OS_SET *)pset->OSEventPtr, pevents_rdy, size);
+    *perr     = OS_ERR_NONE;
+    while ((nbr == 0) && (*perr == OS_ERR_NONE)) {    /* Must wait until a member is posted            */
+        ticks = 0;                                    /* Wait forever without a timeout                */
+        if (timeout > 0) {
+            if (OSTime >= ticks_end) {                /* See if the previous waits used up the timeout */
+                pevents_rdy[0] = (OS_EVENT *)0;
+                *perr = OS_ERR_TIMEOUT;
+                break;
+            }
+            ticks = ticks_end - OSTime;               /* Wait for the rest of the timeout              */
+        }
+        OSTCBCur->OSTCBStat     |= OS_STAT_SET;
+        OSTCBCur->OSTCBStatPend  = OS_STAT_PEND_OK;
+        OS_TickListInsert(OSTCBCur, (INT16U)ticks);   /* Store pend timeout in TCB and tick list       */
+        OS_EventTaskWait(pset);                       /* Suspend task until a post or timeout occurs   */
+        OS_EXIT_CRITICAL();
+        OS_Sched();                                   /* Find next highest priority task ready         */
+        OS_ENTER_CRITICAL();
+        switch (OSTCBCur->OSTCBStatPend) {            /* See if we timed-out or aborted                */
+            case OS_STAT_PEND_OK:                     /* A higher priority task may have taken it      */
+                 nbr = OS_SetRdyGet((OS_SET *)pset->OSEventPtr, pevents_rdy, size);
+                 break;
+
+            case OS_STAT_PEND_ABORT:                  /* The event set was deleted                     */
+                 pevents_rdy[0] = (OS_EVENT *)0;
+                 *perr = OS_ERR_PEND_ABORT;           /* Indicate that we aborted                      */
+                 break;
+
+            case OS_STAT_PEND_TO:
+            default:
+                 OS_EventTaskRemove(OSTCBCur, pset);
+                 pevents_rdy[0] = (OS_EVENT *)0;
+                 *perr = OS_ERR_TIMEOUT;              /* Indicate that we didn't get event within TO   */
+                 break;
+        }
+        OSTCBCur->OSTCBStat      =  OS_STAT_RDY;      /* Set   task  status to ready                   */
+        OSTCBCur->OSTCBStatPend  =  OS_STAT_PEND_OK;  /* Clear pend  status                            */
+        OSTCBCur->OSTCBEventPtr  = (OS_EVENT  *)0;    /* Clear event pointers                          */
+#if (OS_EVENT_MULTI_EN > 0)
+        OSTCBCur->OSTCBEventMultiPtr = (OS_EVENT **)0;
+#endif
+    }
+    OS_EXIT_CRITICAL();
+    return (nbr);
+}
+
+/*$PAGE*/
+/*
+*********************************************************************************************************
+*                                   REMOVE AN EVENT FROM AN EVENT SET
+*
+* Description: This function removes a member from an event set.
+*
+* Arguments  : pset          is a pointer to the event control block of the event set.
+*
+*              pevent        is a pointer to the event control block of the member.
+*
+*              perr          is a pointer to where an error message will be deposited.  Possible error
+*                            messages are:
+*
+*                            OS_ERR_NONE             The event is no longer a member of the set.
+*                            OS_ERR_SET_NOT_MEMBER   The event is not a member of the set.
+*                            OS_ERR_EVENT_TYPE       If you didn't pass a pointer to an event set.
+*                            OS_ERR_PEVENT_NULL      If 'pset' or 'pevent' is a NULL pointer.
+*
+* Returns    : none
+*
+* Note(s)    : 1) Deleting a semaphore, mailbox or queue removes it from its event set.
+*********************************************************************************************************
+*/
+
+void  OSSetRemove (OS_EVENT *pset, OS_EVENT *pevent, INT8U *perr)
+{
+#if OS_CRITICAL_METHOD == 3                           /* Allocate storage for CPU status register      */
+    OS_CPU_SR  cpu_sr = 0;
+#endif
+
+
+
+#if OS_ARG_CHK_EN > 0
+    if (perr == (INT8U *)0) {                         /* Validate 'perr'                               */
+        return;
+    }
+    if ((pset == (OS_EVENT *)0) || (pevent == (OS_EVENT *)0)) {
+        *perr = OS_ERR_PEVENT_NULL;
+        return;
+    }
+#endif
+    if (pset->OSEventType != OS_EVENT_TYPE_SET) {     /* Validate event block type                     */
+        *perr = OS_ERR_EVENT_TYPE;
+        return;
+    }
+    OS_ENTER_CRITICAL();
+    if (pevent->OSEventSetPtr != pset) {
+        OS_EXIT_CRITICAL();
+        *perr = OS_ERR_SET_NOT_MEMBER;
+        return;
+    }
+    OS_SetUnlink(pevent);
+    OS_EXIT_CRITICAL();
+    *perr = OS_ERR_NONE;
+}
+
+/*$PAGE*/
+/*
+*********************************************************************************************************
+*                                    EVENT SET MODULE INITIALIZATION
+*
+* Description : This function is called by uC/OS-II to initialize the event set module.  Your
+*               application MUST NOT call this function.
+*
+* Arguments   : none
+*
+* Returns     : none
+*
+* Note(s)    : This function is INTERNAL to uC/OS-II and your application should not call it.
+*********************************************************************************************************
+*/
+
+void  OS_SetInit (void)
+{
+    INT16U  i;
+
+
+
+    OS_MemClr((INT8U *)&OSSetTbl[0], sizeof(OSSetTbl));   /* Clear the event set table                */
+    for (i = 0; i < (OS_MAX_SETS - 1); i++) {              /* Init. list of free EVENT SET ctrl blocks */
+        OSSetTbl[i].OSSetPtr = &OSSetTbl[i + 1];
+    }
+    OSSetTbl[OS_MAX_SETS - 1].OSSetPtr = (OS_SET *)0;
+    OSSetFreeList                      = &OSSetTbl[0];
+}
+
+/*$PAGE*/
+/*
+*********************************************************************************************************
+*                                    SIGNAL THE EVENT SET OF AN EVENT
+*
+* Description: This function is called by the post services of the semaphores, mailboxes and queues when
+*              they stored a count or a message because no task was waiting.  It sets the bit of the event
+*              in its event set and readies the highest priority task waiting on the set.
+*
+* Arguments  : pevent      is a pointer to the event control block of the event posted to.
+*
+* Returns    : OS_TRUE     if a task waiting on the event set was readied, the caller has to reschedule.
+*              OS_FALSE    if the event is not in a set or no task is waiting on its set.
+*
+* Note(s)    : 1) This function is INTERNAL to uC/OS-II and your application should not call it.
+*              2) Interrupts are assumed to be disabled when this function is called.
+*********************************************************************************************************
+*/
+
+BOOLEAN  OS_SetSignal (OS_EVENT *pevent)
+{
+    OS_EVENT  *pset;
+
+
+    pset = pevent->OSEventSetPtr;
+    if (pset == (OS_EVENT *)0) {                           /* See if the event is in a set             */
+        return (OS_FALSE);
+    }
+    ((OS_SET *)pset->OSEventPtr)->OSSetRdy |= (OS_SET_BITS)1 << pevent->OSEventSetBit;
+    if (pset->OSEventGrp == 0) {                           /* See if any task waiting on the set       */
+        return (OS_FALSE);
+    }
+    (void)OS_EventTaskRdy(pset, (void *)0, OS_STAT_SET, OS_STAT_PEND_OK);
+    return (OS_TRUE);
+}
+
+/*$PAGE*/
+/*
+*********************************************************************************************************
+*                                  REMOVE AN EVENT FROM ITS EVENT SET
+*
+* Description: This function is called by OSSetRemove() and by the delete services of the semaphores,
+*              mailboxes and queues to remove an event from its event set, if it is in one.
+*
+* Arguments  : pevent      is a pointer to the event control block of the member.
+*
+* Returns    : none
+*
+* Note(s)    : 1) This function is INTERNAL to uC/OS-II and your application should not call it.
+*              2) Interrupts are assumed to be disabled when this function is called.
+*********************************************************************************************************
+*/
+
+void  OS_SetUnlink (OS_EVENT *pevent)
+{
+    OS_SET       *ps;
+    OS_SET_BITS   msk;
+
+
+    if (pevent->OSEventSetPtr == (OS_EVENT *)0) {
+        return;
+    }
+    ps                      = (OS_SET *)pevent->OSEventSetPtr->OSEventPtr;
+    msk                     = (OS_SET_BITS)1 << pevent->OSEventSetBit;
+    ps->OSSetUsed          &= ~msk;
+    ps->OSSetRdy           &= ~msk;
+    ps->OSSetTbl[pevent->OSEventSetBit] = (OS_EVENT *)0;
+    pevent->OSEventSetPtr   = (OS_EVENT *)0;
+    pevent->OSEventSetBit   = 0;
+}
+
+/*$PAGE*/
+/*
+*********************************************************************************************************
+*                                       FIND THE LOWEST BIT SET
+*
+* Description: This function returns the number of the lowest bit set in a bitmap of an event set.
+*
+* Arguments  : bits        is the bitmap, it must not be 0.
+*
+* Returns    : The number of the bit, 0 to OS_SET_SIZE - 1.
+*
+* Note(s)    : 1) With OS_SCHED_CTZ_EN the port's OS_CPU_CTZ() is used, otherwise OSUnMapTbl[] one byte
+*                 at a time.
+*********************************************************************************************************
+*/
+
+static  INT8U  OS_SetBitLow (OS_SET_BITS bits)
+{
+#if OS_SCHED_CTZ_EN > 0
+    return ((INT8U)OS_CPU_CTZ((INT64U)bits));
+#else
+    INT8U  bit;
+
+
+    bit = 0;
+    while ((bits & 0xFF) == 0) {
+        bits >>= 8;
+        bit   += 8;
+    }
+    return ((INT8U)(bit + OSUnMapTbl[bits & 0xFF]));
+#endif
+}
+
+/*$PAGE*/
+/*
+*********************************************************************************************************
+*                                   SEE IF A MEMBER HAS A COUNT OR A MESSAGE
+*
+* Description: This function checks whether a semaphore has a count, or a mailbox or a queue a message.
+*
+* Arguments  : pevent      is a pointer to the event control block of the member.
+*
+* Returns    : OS_TRUE     if the member has a count or a message.
+*              OS_FALSE    otherwise.
+*
+* Note(s)    : 1) Interrupts are assumed to be disabled when this function is called.
+*********************************************************************************************************
+*/
+
+static  BOOLEAN  OS_SetEventRdy (OS_EVENT *pevent)
+{
+    switch (pevent->OSEventType) {
+        case OS_EVENT_TYPE_SEM:
+             return ((BOOLEAN)(pevent->OSEventCnt > 0));
+
+        case OS_EVENT_TYPE_MBOX:
+             return ((BOOLEAN)(pevent->OSEventPtr != (void *)0));
+
+#if (OS_Q_EN > 0) && (OS_MAX_QS > 0)
+        case OS_EVENT_TYPE_Q:
+             return ((BOOLEAN)(((OS_Q *)pevent->OSEventPtr)->OSQEntries > 0));
+#endif
+
+        default:
+             return (OS_FALSE);
+    }
+}
+
+/*$PAGE*/
+/*
+*********************************************************************************************************
+*                                  COLLECT THE READY MEMBERS OF AN EVENT SET
+*
+* Description: This function walks the bits set in the ready bitmap of an event set.  The members that
+*              still have a count or a message are returned, the bits of the others are cleared.
+*
+* Arguments  : pset          is a pointer to the event set control block.
+*
+*              pevents_rdy   is a pointer to the array to return the members in.
+*
+*              size          is the number of entries of 'pevents_rdy[]'.
+*
+* Returns    : The number of members returned.
+*
+* Note(s)    : 1) Interrupts are assumed to be disabled when this function is called.
+*              2) The time taken depends on the number of bits set, not on the number of members.
+*********************************************************************************************************
+*/
+
+static  INT8U  OS_SetRdyGet (OS_SET *pset, OS_EVENT **pevents_rdy, INT8U size)
+{
+    OS_SET_BITS  bits;
+    OS_SET_BITS  msk;
+    OS_EVENT    *pevent;
+    INT8U        bit;
+    INT8U        nbr;
+
+
+    nbr  = 0;
+    bits = pset->OSSetRdy;
+    while ((bits != 0) && (nbr < size)) {
+        bit     = OS_SetBitLow(bits);
+        msk     = (OS_SET_BITS)1 << bit;
+        bits   &= ~msk;
+        pevent  = pset->OSSetTbl[bit];
+        if (OS_SetEventRdy(pevent) == OS_TRUE) {
+            pevents_rdy[nbr++] = pevent;
+        } else {
+            pset->OSSetRdy &= ~msk;                         /* Emptied since it was posted to           */
+        }
+    }
+    if (nbr < size) {
+        pevents_rdy[nbr] = (OS_EVENT *)0;                   /* NULL terminate the array                 */
+    }
+    return (nbr);
+}
+#endif                                                      /* OS_SET_EN                                */
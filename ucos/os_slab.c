@@ -0,0 +1,459 @@
+/*
+*********************************************************************************************************
+*                                                uC/OS-II
+*                                          The Real-Time Kernel
+*                                        SLAB ALLOCATION OF OBJECTS
+*
+* File    : OS_SLAB.C
+* Version : V2.86
+*
+* With OS_SLAB_EN the tables OSEventTbl[], OSQTbl[], OSFlagTbl[], OSMemTbl[], OSRingTbl[], OSSetTbl[],
+* OSTopicTbl[] and OSTCBTbl[] only hold the objects available from OSInit(), OS_MAX_xxx no longer limits the number of objects.  When a
+* service that creates an object finds the free list empty it calls the refill function of the list, which
+* gets a page of OS_SLAB_PAGE_SIZE bytes from the port with OSCPUSlabAlloc() and chains the objects of the
+* page into the free list.  Deleted objects go back to the free list like the objects of the tables, the
+* pages are never returned to the port.
+*
+* Objects are still found through pointers and OSTCBPrioTbl[], the lookups do not depend on where the
+* object lives.
+*********************************************************************************************************
+*/
+
+#ifndef  OS_MASTER_FILE
+#include <ucos_ii.h>
+#endif
+
+#if OS_SLAB_EN > 0
+/*
+*********************************************************************************************************
+*                                          LOCAL FUNCTION PROTOTYPES
+*********************************************************************************************************
+*/
+
+static  void  *OS_SlabPageGet(INT32U size, INT16U *pnbr);
+
+/*$PAGE*/
+/*
+*********************************************************************************************************
+*                                   REFILL THE FREE LIST OF EVENT CONTROL BLOCKS
+*
+* Description: This function is called by the services creating a semaphore, a mutex, a mailbox, a queue,
+*              a byte ring or an event set before they take an ECB from OSEventFreeList.  It adds a page of
+*              ECBs to the list if the list is empty.
+*
+* Arguments  : none
+*
+* Returns    : none
+*
+* Note(s)    : 1) This function is INTERNAL to uC/OS-II and your application should not call it.
+*              2) Interrupts must be enabled when this function is called, the page is allocated outside
+*                 of the critical section.  The creating service still checks for an empty list, the port
+*                 may have run out of memory or a higher priority task may have taken the new ECBs.
+*********************************************************************************************************
+*/
+
+#if (OS_EVENT_EN) && (OS_MAX_EVENTS > 0)
+void  OS_SlabEventRefill (void)
+{
+    OS_EVENT  *pevent;
+    INT16U     nbr;
+    INT16U     i;
+#if OS_CRITICAL_METHOD == 3                                /* Allocate storage for CPU status register */
+    OS_CPU_SR  cpu_sr = 0;
+#endif
+
+
+
+    if (OSEventFreeList != (OS_EVENT *)0) {                /* Nothing to do while ECBs are free        */
+        return;
+    }
+    pevent = (OS_EVENT *)OS_SlabPageGet(sizeof(OS_EVENT), &nbr);
+    if (pevent == (OS_EVENT *)0) {
+        return;
+    }
+    for (i = 0; i < nbr; i++) {                            /* Init. list of free EVENT control blocks  */
+        pevent[i].OSEventType    = OS_EVENT_TYPE_UNUSED;
+        pevent[i].OSEventPtr     = &pevent[i + 1];
+#if OS_EVENT_NAME_SIZE > 1
+        pevent[i].OSEventName[0] = '?';                    /* Unknown name                             */
+        pevent[i].OSEventName[1] = OS_ASCII_NUL;
+#endif
+    }
+    OS_ENTER_CRITICAL();
+    pevent[nbr - 1].OSEventPtr = OSEventFreeList;          /* Insert the page in front of the list     */
+    OSEventFreeList            = pevent;
+    OS_EXIT_CRITICAL();
+}
+#endif
+
+/*$PAGE*/
+/*
+*********************************************************************************************************
+*                                   REFILL THE FREE LIST OF EVENT FLAG GROUPS
+*
+* Description: This function is called by OSFlagCreate() before it takes a group from OSFlagFreeList.  It
+*              adds a page of event flag groups to the list if the list is empty.
+*
+* Arguments  : none
+*
+* Returns    : none
+*
+* Note(s)    : See OS_SlabEventRefill().
+*********************************************************************************************************
+*/
+
+#if (OS_FLAG_EN > 0) && (OS_MAX_FLAGS > 0)
+void  OS_SlabFlagRefill (void)
+{
+    OS_FLAG_GRP  *pgrp;
+    INT16U        nbr;
+    INT16U        i;
+#if OS_CRITICAL_METHOD == 3                                /* Allocate storage for CPU status register */
+    OS_CPU_SR     cpu_sr = 0;
+#endif
+
+
+
+    if (OSFlagFreeList != (OS_FLAG_GRP *)0) {
+        return;
+    }
+    pgrp = (OS_FLAG_GRP *)OS_SlabPageGet(sizeof(OS_FLAG_GRP), &nbr);
+    if (pgrp == (OS_FLAG_GRP *)0) {
+        return;
+    }
+    for (i = 0; i < nbr; i++) {                            /* Init. list of free EVENT FLAGS           */
+        pgrp[i].OSFlagType     = OS_EVENT_TYPE_UNUSED;
+        pgrp[i].OSFlagWaitList = (void *)&pgrp[i + 1];
+#if OS_FLAG_NAME_SIZE > 1
+        pgrp[i].OSFlagName[0]  = '?';                      /* Unknown name                             */
+        pgrp[i].OSFlagName[1]  = OS_ASCII_NUL;
+#endif
+    }
+    OS_ENTER_CRITICAL();
+    pgrp[nbr - 1].OSFlagWaitList = (void *)OSFlagFreeList;
+    OSFlagFreeList               = pgrp;
+    OS_EXIT_CRITICAL();
+}
+#endif
+
+/*$PAGE*/
+/*
+*********************************************************************************************************
+*                                   REFILL THE FREE LIST OF MEMORY PARTITIONS
+*
+* Description: This function is called by OSMemCreate() before it takes a partition from OSMemFreeList.  It
+*              adds a page of memory partition control blocks to the list if the list is empty.
+*
+* Arguments  : none
+*
+* Returns    : none
+*
+* Note(s)    : See OS_SlabEventRefill().
+*********************************************************************************************************
+*/
+
+#if (OS_MEM_EN > 0) && (OS_MAX_MEM_PART > 0)
+void  OS_SlabMemRefill (void)
+{
+    OS_MEM    *pmem;
+    INT16U     nbr;
+    INT16U     i;
+#if OS_CRITICAL_METHOD == 3                                /* Allocate storage for CPU status register */
+    OS_CPU_SR  cpu_sr = 0;
+#endif
+
+
+
+    if (OSMemFreeList != (OS_MEM *)0) {
+        return;
+    }
+    pmem = (OS_MEM *)OS_SlabPageGet(sizeof(OS_MEM), &nbr);
+    if (pmem == (OS_MEM *)0) {
+        return;
+    }
+    for (i = 0; i < nbr; i++) {                            /* Init. list of free memory partitions     */
+        pmem[i].OSMemFreeList = (void *)&pmem[i + 1];
+#if OS_MEM_NAME_SIZE > 1
+        pmem[i].OSMemName[0]  = '?';                       /* Unknown name                             */
+        pmem[i].OSMemName[1]  = OS_ASCII_NUL;
+#endif
+    }
+    OS_ENTER_CRITICAL();
+    pmem[nbr - 1].OSMemFreeList = (void *)OSMemFreeList;
+    OSMemFreeList               = pmem;
+    OS_EXIT_CRITICAL();
+}
+#endif
+
+/*$PAGE*/
+/*
+*********************************************************************************************************
+*                                  REFILL THE FREE LIST OF QUEUE CONTROL BLOCKS
+*
+* Description: This function is called by OSQCreate() before it takes a queue control block from
+*              OSQFreeList.  It adds a page of queue control blocks to the list if the list is empty.
+*
+* Arguments  : none
+*
+* Returns    : none
+*
+* Note(s)    : See OS_SlabEventRefill().
+*********************************************************************************************************
+*/
+
+#if (OS_Q_EN > 0) && (OS_MAX_QS > 0)
+void  OS_SlabQRefill (void)
+{
+    OS_Q      *pq;
+    INT16U     nbr;
+    INT16U     i;
+#if OS_CRITICAL_METHOD == 3                                /* Allocate storage for CPU status register */
+    OS_CPU_SR  cpu_sr = 0;
+#endif
+
+
+
+    if (OSQFreeList != (OS_Q *)0) {
+        return;
+    }
+    pq = (OS_Q *)OS_SlabPageGet(sizeof(OS_Q), &nbr);
+    if (pq == (OS_Q *)0) {
+        return;
+    }
+    for (i = 0; i < nbr; i++) {                            /* Init. list of free QUEUE control blocks  */
+        pq[i].OSQPtr = &pq[i + 1];
+    }
+    OS_ENTER_CRITICAL();
+    pq[nbr - 1].OSQPtr = OSQFreeList;
+    OSQFreeList        = pq;
+    OS_EXIT_CRITICAL();
+}
+#endif
+
+/*$PAGE*/
+/*
+*********************************************************************************************************
+*                                REFILL THE FREE LIST OF BYTE RING CONTROL BLOCKS
+*
+* Description: This function is called by OSRingCreate() before it takes a byte ring control block from
+*              OSRingFreeList.  It adds a page of byte ring control blocks to the list if the list is empty.
+*
+* Arguments  : none
+*
+* Returns    : none
+*
+* Note(s)    : See OS_SlabEventRefill().
+*********************************************************************************************************
+*/
+
+#if (OS_RING_EN > 0) && (OS_MAX_RINGS > 0)
+void  OS_SlabRingRefill (void)
+{
+    OS_RING   *pring;
+    INT16U     nbr;
+    INT16U     i;
+#if OS_CRITICAL_METHOD == 3                                /* Allocate storage for CPU status register */
+    OS_CPU_SR  cpu_sr = 0;
+#endif
+
+
+
+    if (OSRingFreeList != (OS_RING *)0) {
+        return;
+    }
+    pring = (OS_RING *)OS_SlabPageGet(sizeof(OS_RING), &nbr);
+    if (pring == (OS_RING *)0) {
+        return;
+    }
+    for (i = 0; i < nbr; i++) {                            /* Init. list of free BYTE RING ctrl blocks */
+        pring[i].OSRingPtr = &pring[i + 1];
+    }
+    OS_ENTER_CRITICAL();
+    pring[nbr - 1].OSRingPtr = OSRingFreeList;
+    OSRingFreeList           = pring;
+    OS_EXIT_CRITICAL();
+}
+#endif
+
+/*$PAGE*/
+/*
+*********************************************************************************************************
+*                                REFILL THE FREE LIST OF EVENT SET CONTROL BLOCKS
+*
+* Description: This function is called by OSSetCreate() before it takes an event set control block from
+*              OSSetFreeList.  It adds a page of event set control blocks to the list if the list is empty.
+*
+* Arguments  : none
+*
+* Returns    : none
+*
+* Note(s)    : See OS_SlabEventRefill().
+*********************************************************************************************************
+*/
+
+#if (OS_SET_EN > 0) && (OS_MAX_SETS > 0)
+void  OS_SlabSetRefill (void)
+{
+    OS_SET    *ps;
+    INT16U     nbr;
+    INT16U     i;
+#if OS_CRITICAL_METHOD == 3                                /* Allocate storage for CPU status register */
+    OS_CPU_SR  cpu_sr = 0;
+#endif
+
+
+
+    if (OSSetFreeList != (OS_SET *)0) {
+        return;
+    }
+    ps = (OS_SET *)OS_SlabPageGet(sizeof(OS_SET), &nbr);
+    if (ps == (OS_SET *)0) {
+        return;
+    }
+    for (i = 0; i < nbr; i++) {                            /* Init. list of free EVENT SET ctrl blocks */
+        ps[i].OSSetPtr = &ps[i + 1];
+    }
+    OS_ENTER_CRITICAL();
+    ps[nbr - 1].OSSetPtr = OSSetFreeList;
+    OSSetFreeList        = ps;
+    OS_EXIT_CRITICAL();
+}
+#endif
+
+/*$PAGE*/
+/*
+*********************************************************************************************************
+*                                  REFILL THE FREE LIST OF TOPIC CONTROL BLOCKS
+*
+* Description: This function is called by OSTopicCreate() before it takes a topic control block from
+*              OSTopicFreeList.  It adds a page of topic control blocks to the list if the list is empty.
+*
+* Arguments  : none
+*
+* Returns    : none
+*
+* Note(s)    : See OS_SlabEventRefill().
+*********************************************************************************************************
+*/
+
+#if (OS_TOPIC_EN > 0) && (OS_MAX_TOPICS > 0)
+void  OS_SlabTopicRefill (void)
+{
+    OS_TOPIC  *pt;
+    INT16U     nbr;
+    INT16U     i;
+#if OS_CRITICAL_METHOD == 3                                /* Allocate storage for CPU status register */
+    OS_CPU_SR  cpu_sr = 0;
+#endif
+
+
+
+    if (OSTopicFreeList != (OS_TOPIC *)0) {
+        return;
+    }
+    pt = (OS_TOPIC *)OS_SlabPageGet(sizeof(OS_TOPIC), &nbr);
+    if (pt == (OS_TOPIC *)0) {
+        return;
+    }
+    for (i = 0; i < nbr; i++) {                            /* Init. list of free TOPIC control blocks  */
+        pt[i].OSTopicPtr = &pt[i + 1];
+    }
+    OS_ENTER_CRITICAL();
+    pt[nbr - 1].OSTopicPtr = OSTopicFreeList;
+    OSTopicFreeList        = pt;
+    OS_EXIT_CRITICAL();
+}
+#endif
+
+/*$PAGE*/
+/*
+*********************************************************************************************************
+*                                  REFILL THE FREE LIST OF TASK CONTROL BLOCKS
+*
+* Description: This function is called by OS_TCBInit() before it takes a TCB from OSTCBFreeList.  It adds
+*              a page of TCBs to the list if the list is empty.
+*
+* Arguments  : none
+*
+* Returns    : none
+*
+* Note(s)    : 1) See OS_SlabEventRefill().
+*              2) The number of tasks remains limited by the number of priorities.
+*********************************************************************************************************
+*/
+
+void  OS_SlabTCBRefill (void)
+{
+    OS_TCB    *ptcb;
+    INT16U     nbr;
+    INT16U     i;
+#if OS_CRITICAL_METHOD == 3                                /* Allocate storage for CPU status register */
+    OS_CPU_SR  cpu_sr = 0;
+#endif
+
+
+
+    if (OSTCBFreeList != (OS_TCB *)0) {
+        return;
+    }
+    ptcb = (OS_TCB *)OS_SlabPageGet(sizeof(OS_TCB), &nbr);
+    if (ptcb == (OS_TCB *)0) {
+        return;
+    }
+    for (i = 0; i < nbr; i++) {                            /* Init. list of free TCBs                  */
+        ptcb[i].OSTCBNext        = &ptcb[i + 1];
+#if OS_TASK_NAME_SIZE > 1
+        ptcb[i].OSTCBTaskName[0] = '?';                    /* Unknown name                             */
+        ptcb[i].OSTCBTaskName[1] = OS_ASCII_NUL;
+#endif
+    }
+    OS_ENTER_CRITICAL();
+    ptcb[nbr - 1].OSTCBNext = OSTCBFreeList;
+    OSTCBFreeList           = ptcb;
+    OS_EXIT_CRITICAL();
+}
+
+/*$PAGE*/
+/*
+*********************************************************************************************************
+*                                           GET A SLAB PAGE
+*
+* Description: This function gets a cleared page for objects of 'size' bytes from the port.
+*
+* Arguments  : size        is the size of one object.
+*
+*              pnbr        is a pointer to where the number of objects in the page is returned.
+*
+* Returns    : A pointer to the page, or a NULL pointer if the port has no memory left.
+*
+* Note(s)    : A page holds at least one object, it is larger than OS_SLAB_PAGE_SIZE if an object is.
+*********************************************************************************************************
+*/
+
+static  void  *OS_SlabPageGet (INT32U size, INT16U *pnbr)
+{
+    void      *ppage;
+    INT32U     nbr;
+#if OS_CRITICAL_METHOD == 3                                /* Allocate storage for CPU status register */
+    OS_CPU_SR  cpu_sr = 0;
+#endif
+
+
+
+    nbr = OS_SLAB_PAGE_SIZE / size;
+    if (nbr == 0) {
+        nbr = 1;
+    }
+    ppage = OSCPUSlabAlloc(nbr * size);
+    if (ppage == (void *)0) {
+        return ((void *)0);
+    }
+    OS_MemClr((INT8U *)ppage, nbr * size);
+    OS_ENTER_CRITICAL();
+    OSSlabPageCtr++;
+    OSSlabBytes += nbr * size;
+    OS_EXIT_CRITICAL();
+    *pnbr = (INT16U)nbr;
+    return (ppage);
+}
+#endif                                                      /* OS_SLAB_EN                               */
@@ -0,0 +1,298 @@
+/*
+*********************************************************************************************************
+*                                                uC/OS-II
+*                                          The Real-Time Kernel
+*                                            LOAD STATISTICS
+*
+* File    : OS_STAT.C
+* Version : V2.86
+*
+* The load statistics are computed from the run time of the tasks that OSTaskSwHook() accumulates and from
+* the time spent in ISRs that OSIntEnter() and OSIntExit() measure, so they need no calibration of the idle
+* counter.  Every 1/10 second the statistic task computes the CPU share of each task and of the ISRs over
+* the last period and folds it into exponential moving averages with a time constant of 1, 10 and 60
+* seconds.
+*********************************************************************************************************
+*/
+
+#ifndef  OS_MASTER_FILE
+#include <ucos_ii.h>
+#endif
+
+#if OS_STAT_EN > 0
+/*
+*********************************************************************************************************
+*                                            LOCAL CONSTANTS
+*
+* Note(s): 1) The decay factors of the load averages are exp(-0.1 s / time constant) << OS_STAT_FSHIFT,
+*             they assume the period of 1/10 second of the statistic task.
+*********************************************************************************************************
+*/
+
+#define  OS_STAT_FIXED_1         ((INT32U)1 << OS_STAT_FSHIFT)
+
+static  INT32U  const  OSStatExpTbl[OS_STAT_LOAD_NBR] = {
+    1853u,                                                 /* exp(-0.1 /  1) << 11                     */
+    2028u,                                                 /* exp(-0.1 / 10) << 11                     */
+    2045u                                                  /* exp(-0.1 / 60) << 11                     */
+};
+
+/*
+*********************************************************************************************************
+*                                          LOCAL FUNCTION PROTOTYPES
+*********************************************************************************************************
+*/
+
+static  void    OS_StatLoadAvg(INT32U *pavg, INT16U usage);
+static  INT16U  OS_StatLoadGet(INT32U avg);
+static  INT16U  OS_StatShare(INT64U time, INT64U ts_prd);
+
+/*$PAGE*/
+/*
+*********************************************************************************************************
+*                                          GET LOAD STATISTICS
+*
+* Description: This function is called to obtain the load of the CPU, the share of the ISRs and of the
+*              tasks, and the context switch and interrupt rates computed by the statistic task.
+*
+* Arguments  : p_stat        is a pointer to a data structure of type OS_STAT_DATA.
+*
+* Returns    : OS_ERR_NONE            upon success
+*              OS_ERR_PDATA_NULL      if 'p_stat' is a NULL pointer
+*
+* Note(s)    : 1) The load of each task is returned by OSTaskProfGet().
+*              2) The averages start at 0 when the statistic task starts, the 60 second average needs a
+*                 few minutes to settle.
+*********************************************************************************************************
+*/
+
+INT8U  OSStatGet (OS_STAT_DATA *p_stat)
+{
+#if OS_CRITICAL_METHOD == 3                           /* Allocate storage for CPU status register      */
+    OS_CPU_SR  cpu_sr = 0;
+#endif
+
+
+
+#if OS_ARG_CHK_EN > 0
+    if (p_stat == (OS_STAT_DATA *)0) {                /* Validate 'p_stat'                             */
+        return (OS_ERR_PDATA_NULL);
+    }
+#endif
+    OS_ENTER_CRITICAL();
+    *p_stat              = OSStatData;
+    p_stat->OSIntTimeTot = OSStatIntTimeTot;
+    OS_EXIT_CRITICAL();
+    return (OS_ERR_NONE);
+}
+
+/*$PAGE*/
+/*
+*********************************************************************************************************
+*                                     INITIALIZE THE LOAD STATISTICS
+*
+* Description: This function is called by OSInit() to clear the load statistics.
+*
+* Arguments  : none
+*
+* Returns    : none
+*
+* Note(s)    : This function is INTERNAL to uC/OS-II and your application should not call it.
+*********************************************************************************************************
+*/
+
+void  OS_StatInit (void)
+{
+    OSStatIntStart     = 0L;
+    OSStatIntTimeTot   = 0L;
+    OSStatIntCtr       = 0L;
+    OSStatIntTimeLast  = 0L;
+    OSStatIntCtrLast   = 0L;
+    OSStatCtxSwCtrLast = 0L;
+    OS_MemClr((INT8U *)&OSStatData,          sizeof(OSStatData));
+    OS_MemClr((INT8U *)&OSStatCPULoadAvg[0], sizeof(OSStatCPULoadAvg));
+    OS_MemClr((INT8U *)&OSStatIntLoadAvg[0], sizeof(OSStatIntLoadAvg));
+}
+
+/*$PAGE*/
+/*
+*********************************************************************************************************
+*                                       ACCOUNT THE TIME OF AN ISR
+*
+* Description: This function is called by OSIntExit() when the outermost ISR completes.  OSIntEnter()
+*              stamped its start in OSStatIntStart.  The time of the ISR is added to the ISR total and the
+*              run time stamp of the interrupted task is moved forward so the ISR is not charged to it.
+*
+* Arguments  : none
+*
+* Returns    : none
+*
+* Note(s)    : 1) This function is INTERNAL to uC/OS-II and your application should not call it.
+*              2) Interrupts are assumed to be disabled when this function is called.
+*********************************************************************************************************
+*/
+
+void  OS_StatIntExit (void)
+{
+    INT64U  ts_isr;
+
+
+    ts_isr                      = OSCPUTsGet() - OSStatIntStart;
+    OSStatIntTimeTot           += ts_isr;
+    OSStatIntCtr++;
+    OSTCBCur->OSTCBCyclesStart += ts_isr;                  /* Don't charge the ISR to the task         */
+}
+
+/*$PAGE*/
+/*
+*********************************************************************************************************
+*                                        UPDATE THE LOAD STATISTICS
+*
+* Description: This function is called by OS_TaskStat() every 1/10 second, before OS_TaskStatProf() closes
+*              the period.  It computes the CPU share of every task, of the ISRs and the rates over the
+*              period and updates the load averages.
+*
+* Arguments  : none
+*
+* Returns    : none
+*
+* Note(s)    : 1) This function is INTERNAL to uC/OS-II and your application should not call it.
+*              2) The run time of the tasks at the start of the period is the newest boundary of the
+*                 profiling window, OSTaskProfTs[] and OSTCBWinCycles[] just before OSTaskProfIx.
+*              3) The CPU load is the time the idle task did not run, it includes the ISRs.
+*********************************************************************************************************
+*/
+
+void  OS_StatUpdate (void)
+{
+    OS_TCB    *ptcb;
+    INT64U     ts;
+    INT64U     ts_prd;
+    INT64U     task_time;
+    INT64U     int_time;
+    INT32U     int_ctr;
+    INT32U     ctx_sw;
+    INT16U     usage;
+    INT16U     idle_usage;
+    INT8U      ix;
+    INT8U      i;
+#if OS_CRITICAL_METHOD == 3                           /* Allocate storage for CPU status register      */
+    OS_CPU_SR  cpu_sr = 0;
+#endif
+
+
+
+    OS_ENTER_CRITICAL();
+    ts       = OSCPUTsGet();
+    int_time = OSStatIntTimeTot - OSStatIntTimeLast;
+    int_ctr  = OSStatIntCtr     - OSStatIntCtrLast;
+    ctx_sw   = OSCtxSwCtr       - OSStatCtxSwCtrLast;
+    OSStatIntTimeLast  = OSStatIntTimeTot;
+    OSStatIntCtrLast   = OSStatIntCtr;
+    OSStatCtxSwCtrLast = OSCtxSwCtr;
+    ix       = (INT8U)((OSTaskProfIx + OS_TASK_PROFILE_WIN - 1) % OS_TASK_PROFILE_WIN);
+    if ((OSTaskProfTs[ix] == 0L) || (ts <= OSTaskProfTs[ix])) {
+        OS_EXIT_CRITICAL();                           /* No period closed yet                          */
+        return;
+    }
+    ts_prd     = ts - OSTaskProfTs[ix];
+    task_time  = 0L;
+    idle_usage = 0;
+    ptcb       = OSTCBList;
+    while (ptcb != (OS_TCB *)0) {                     /* Share of every task over the period           */
+        usage = OS_StatShare(ptcb->OSTCBCyclesTot - ptcb->OSTCBWinCycles[ix], ts_prd);
+        OS_StatLoadAvg(&ptcb->OSTCBLoadAvg[0], usage);
+        if (ptcb->OSTCBPrio == OS_TASK_IDLE_PRIO) {
+            idle_usage                = usage;
+            OSStatData.OSIdleTimeTot  = ptcb->OSTCBCyclesTot;
+        } else {
+            task_time                += ptcb->OSTCBCyclesTot - ptcb->OSTCBWinCycles[ix];
+        }
+        ptcb = ptcb->OSTCBNext;
+    }
+    OSStatData.OSTaskTimeTot += task_time;
+    OSStatData.OSCPUUsage     = (INT16U)(10000 - idle_usage);
+    OSStatData.OSIntUsage     = OS_StatShare(int_time,  ts_prd);
+    OSStatData.OSTaskUsage    = OS_StatShare(task_time, ts_prd);
+    OSStatData.OSCtxSwRate    = (INT32U)(((INT64U)ctx_sw  * OS_CPU_TS_FREQ) / ts_prd);
+    OSStatData.OSIntRate      = (INT32U)(((INT64U)int_ctr * OS_CPU_TS_FREQ) / ts_prd);
+    OS_StatLoadAvg(&OSStatCPULoadAvg[0], OSStatData.OSCPUUsage);
+    OS_StatLoadAvg(&OSStatIntLoadAvg[0], OSStatData.OSIntUsage);
+    for (i = 0; i < OS_STAT_LOAD_NBR; i++) {
+        OSStatData.OSCPULoadAvg[i] = OS_StatLoadGet(OSStatCPULoadAvg[i]);
+        OSStatData.OSIntLoadAvg[i] = OS_StatLoadGet(OSStatIntLoadAvg[i]);
+    }
+    OS_EXIT_CRITICAL();
+}
+
+/*$PAGE*/
+/*
+*********************************************************************************************************
+*                                         UPDATE THE LOAD AVERAGES
+*
+* Description: This function folds the share of one period into the three load averages of a task or of
+*              the system:
+*
+*                 avg = avg * exp + usage * (1 - exp)
+*
+* Arguments  : pavg        is a pointer to the OS_STAT_LOAD_NBR averages, scaled by OS_STAT_FIXED_1.
+*
+*              usage       is the share over the period (units are 0.01 %).
+*
+* Returns    : none
+*********************************************************************************************************
+*/
+
+static  void  OS_StatLoadAvg (INT32U *pavg, INT16U usage)
+{
+    INT8U  i;
+
+
+    for (i = 0; i < OS_STAT_LOAD_NBR; i++) {
+        pavg[i] = (INT32U)(((INT64U)pavg[i] * OSStatExpTbl[i]
+                          + ((INT64U)usage << OS_STAT_FSHIFT) * (OS_STAT_FIXED_1 - OSStatExpTbl[i])
+                          + (OS_STAT_FIXED_1 / 2)) >> OS_STAT_FSHIFT);
+    }
+}
+
+/*$PAGE*/
+/*
+*********************************************************************************************************
+*                                          ROUND A LOAD AVERAGE
+*
+* Description: This function converts a load average kept by the kernel to units of 0.01 %.
+*
+* Arguments  : avg         is the average, scaled by OS_STAT_FIXED_1.
+*
+* Returns    : The average in units of 0.01 %.
+*********************************************************************************************************
+*/
+
+static  INT16U  OS_StatLoadGet (INT32U avg)
+{
+    return ((INT16U)((avg + (OS_STAT_FIXED_1 / 2)) >> OS_STAT_FSHIFT));
+}
+
+/*$PAGE*/
+/*
+*********************************************************************************************************
+*                                       SHARE OF A PERIOD
+*
+* Description: This function computes which share of a period a time is.
+*
+* Arguments  : time        is the time, in units of OSCPUTsGet().
+*
+*              ts_prd      is the length of the period, it must not be 0.
+*
+* Returns    : The share (units are 0.01 %), clamped to 100 % against the rounding at the period edges.
+*********************************************************************************************************
+*/
+
+static  INT16U  OS_StatShare (INT64U time, INT64U ts_prd)
+{
+    if (time >= ts_prd) {
+        return (10000);
+    }
+    return ((INT16U)((time * 10000L) / ts_prd));
+}
+#endif                                                      /* OS_STAT_EN                               */
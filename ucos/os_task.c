@@ -31,7 +31,8 @@
 *                                        CHANGE PRIORITY OF A TASK
 *
 * Description: This function allows you to change the priority of a task dynamically.  Note that the new
-*              priority MUST be available.
+*              priority MUST be available.  With OS_SCHED_RR_EN the new priority can be shared with other
+*              tasks and the task gets the last turn among them.
 *
 * Arguments  : oldp     is the old priority
 *
@@ -44,6 +45,9 @@
 *              OS_ERR_PRIO            there is no task with the specified OLD priority (i.e. the OLD task does
 *                                     not exist.
 *              OS_ERR_TASK_NOT_EXIST  if the task is assigned to a Mutex PIP.
+*
+* Note(s)    : 1) With OS_MUTEX_PROTOCOL_EN 'newp' is the base priority of the task, the task keeps running
+*                 at the ceiling or inherited priority of the mutexes it holds if that is higher.
 *********************************************************************************************************
 */
 
@@ -58,18 +62,17 @@ INT8U  OSTaskChangePrio (INT8U oldprio, INT8U newprio)
 #endif
     OS_TCB    *ptcb;
     INT8U      y_new;
-    INT8U      x_new;
-    INT8U      y_old;
-#if OS_LOWEST_PRIO <= 63
-    INT8U      bity_new;
-    INT8U      bitx_new;
-    INT8U      bity_old;
-    INT8U      bitx_old;
+    OS_PRIO_GRP bity_new;
+    OS_PRIO_TBL bitx_new;
+#if OS_SCHED_RR_EN > 0
+    BOOLEAN    rdy;
+#if (OS_EVENT_EN)
+    BOOLEAN    pend;
+#endif
 #else
-    INT16U     bity_new;
-    INT16U     bitx_new;
-    INT16U     bity_old;
-    INT16U     bitx_old;
+    INT8U      y_old;
+    OS_PRIO_GRP bity_old;
+    OS_PRIO_TBL bitx_old;
 #endif
 #if OS_CRITICAL_METHOD == 3
     OS_CPU_SR  cpu_sr = 0;                                  /* Storage for CPU status register         */
@@ -88,7 +91,11 @@ INT8U  OSTaskChangePrio (INT8U oldprio, INT8U newprio)
     }
 #endif
     OS_ENTER_CRITICAL();
+#if OS_SCHED_RR_EN > 0
+    if (OSTCBPrioTbl[newprio] == OS_TCB_RESERVED) {         /* New priority may be shared, not reserved*/
+#else
     if (OSTCBPrioTbl[newprio] != (OS_TCB *)0) {             /* New priority must not already exist     */
+#endif
         OS_EXIT_CRITICAL();
         return (OS_ERR_PRIO_EXIST);
     }
@@ -104,23 +111,72 @@ INT8U  OSTaskChangePrio (INT8U oldprio, INT8U newprio)
         OS_EXIT_CRITICAL();                                 /* No, can't change its priority!          */
         return (OS_ERR_TASK_NOT_EXIST);
     }
-#if OS_LOWEST_PRIO <= 63
-    y_new                 = (INT8U)(newprio >> 3);          /* Yes, compute new TCB fields             */
-    x_new                 = (INT8U)(newprio & 0x07);
-    bity_new              = (INT8U)(1 << y_new);
-    bitx_new              = (INT8U)(1 << x_new);
-#else
-    y_new                 = (INT8U)((newprio >> 4) & 0x0F);
-    x_new                 = (INT8U)( newprio & 0x0F);
-    bity_new              = (INT16U)(1 << y_new);
-    bitx_new              = (INT16U)(1 << x_new);
+#if (OS_MUTEX_EN > 0) && (OS_MUTEX_PROTOCOL_EN > 0)
+    ptcb->OSTCBBasePrio   = newprio;                        /* Keep what the task inherits by mutexes  */
+    newprio               = OS_MutexPrioGet(ptcb);
 #endif
-
+#if OS_SCHED_RR_EN > 0
+    rdy = ptcb->OSTCBRRRdy;
+    OS_RdyListRemove(ptcb);                                 /* Leave the old priority ...              */
+#if (OS_EVENT_EN)
+    pend = (BOOLEAN)((ptcb->OSTCBStat & OS_STAT_PEND_ANY) != OS_STAT_RDY);
+    if (ptcb->OSTCBEventPtr != (OS_EVENT *)0) {             /* ... and its wait list bits              */
+        OS_EventTaskRemove(ptcb, ptcb->OSTCBEventPtr);
+    }
+#if (OS_EVENT_MULTI_EN > 0)
+    if (ptcb->OSTCBEventMultiPtr != (OS_EVENT **)0) {
+        OS_EventTaskRemoveMulti(ptcb, ptcb->OSTCBEventMultiPtr);
+    }
+#endif
+#endif
+    OS_PrioRingRemove(ptcb);
+    OS_TCBPrioSet(ptcb, newprio);                           /* Set new task priority                   */
+    y_new     = ptcb->OSTCBY;
+    bity_new  = ptcb->OSTCBBitY;
+    bitx_new  = ptcb->OSTCBBitX;
+    OS_PrioRingInsert(ptcb);                                /* Join the tasks of the new priority      */
+#if (OS_EVENT_EN)
+    if (pend == OS_TRUE) {                                  /* Wait at the new priority                */
+        pevent = ptcb->OSTCBEventPtr;
+        if (pevent != (OS_EVENT *)0) {
+            pevent->OSEventGrp        |= bity_new;
+            pevent->OSEventTbl[y_new] |= bitx_new;
+        }
+#if (OS_EVENT_MULTI_EN > 0)
+        if (ptcb->OSTCBEventMultiPtr != (OS_EVENT **)0) {
+            pevents =  ptcb->OSTCBEventMultiPtr;
+            pevent  = *pevents;
+            while (pevent != (OS_EVENT *)0) {
+                pevent->OSEventGrp        |= bity_new;
+                pevent->OSEventTbl[y_new] |= bitx_new;
+                pevents++;
+                pevent                     = *pevents;
+            }
+        }
+#endif
+    }
+#endif
+    if (rdy == OS_TRUE) {                                   /* Make new priority ready to run          */
+        OS_RdyListInsert(ptcb);
+    }
+#if (OS_MUTEX_EN > 0) && (OS_MUTEX_PROTOCOL_EN > 0)
+    pevent = ptcb->OSTCBEventPtr;                           /* Owner of a mutex the task waits for ... */
+    if (((ptcb->OSTCBStat & OS_STAT_MUTEX) != OS_STAT_RDY) && (pevent != (OS_EVENT *)0)) {
+        if (pevent->OSEventMutexOpt != OS_MUTEX_OPT_PIP) {  /* ... inherits the new priority           */
+            OS_MutexPrioUpdate((OS_TCB *)pevent->OSEventPtr);
+        }
+    }
+#endif
+#else
     OSTCBPrioTbl[oldprio] = (OS_TCB *)0;                    /* Remove TCB from old priority            */
     OSTCBPrioTbl[newprio] =  ptcb;                          /* Place pointer to TCB @ new priority     */
     y_old                 =  ptcb->OSTCBY;
     bity_old              =  ptcb->OSTCBBitY;
     bitx_old              =  ptcb->OSTCBBitX;
+    OS_TCBPrioSet(ptcb, newprio);                           /* Set new task priority                   */
+    y_new                 =  ptcb->OSTCBY;
+    bity_new              =  ptcb->OSTCBBitY;
+    bitx_new              =  ptcb->OSTCBBitX;
     if ((OSRdyTbl[y_old] &   bitx_old) != 0) {              /* If task is ready make it not            */
          OSRdyTbl[y_old] &= ~bitx_old;
          if (OSRdyTbl[y_old] == 0) {
@@ -157,12 +213,7 @@ INT8U  OSTaskChangePrio (INT8U oldprio, INT8U newprio)
     }
 #endif
 #endif
-
-    ptcb->OSTCBPrio = newprio;                              /* Set new task priority                   */
-    ptcb->OSTCBY    = y_new;
-    ptcb->OSTCBX    = x_new;
-    ptcb->OSTCBBitY = bity_new;
-    ptcb->OSTCBBitX = bitx_new;
+#endif
     OS_EXIT_CRITICAL();
     if (OSRunning == OS_TRUE) {
         OS_Sched();                                         /* Find new highest priority task          */
@@ -200,7 +251,8 @@ INT8U  OSTaskChangePrio (INT8U oldprio, INT8U newprio)
 *                       memory locations.
 *
 *              prio     is the task's priority.  A unique priority MUST be assigned to each task and the
-*                       lower the number, the higher the priority.
+*                       lower the number, the higher the priority.  With OS_SCHED_RR_EN several tasks
+*                       can have the same priority (except the idle task's), they take turns to run.
 *
 * Returns    : OS_ERR_NONE             if the function was successful.
 *              OS_PRIO_EXIT            if the task priority already exist
@@ -216,6 +268,9 @@ INT8U  OSTaskCreate (void (*task)(void *p_arg), void *p_arg, OS_STK *ptos, INT8U
 {
     OS_STK    *psp;
     INT8U      err;
+#if OS_SCHED_RR_EN > 0
+    OS_TCB    *ptcb;
+#endif
 #if OS_CRITICAL_METHOD == 3                  /* Allocate storage for CPU status register               */
     OS_CPU_SR  cpu_sr = 0;
 #endif
@@ -232,8 +287,17 @@ INT8U  OSTaskCreate (void (*task)(void *p_arg), void *p_arg, OS_STK *ptos, INT8U
         OS_EXIT_CRITICAL();
         return (OS_ERR_TASK_CREATE_ISR);
     }
+#if OS_SCHED_RR_EN > 0
+    ptcb = OSTCBPrioTbl[prio];               /* Tasks may share a priority but not a reserved one ...  */
+    if ((ptcb == (OS_TCB *)0) ||             /* ... nor the one of the idle task                       */
+        ((ptcb != OS_TCB_RESERVED) && (prio != OS_TASK_IDLE_PRIO))) {
+        if (ptcb == (OS_TCB *)0) {
+            OSTCBPrioTbl[prio] = OS_TCB_RESERVED;
+        }
+#else
     if (OSTCBPrioTbl[prio] == (OS_TCB *)0) { /* Make sure task doesn't already exist at this priority  */
         OSTCBPrioTbl[prio] = OS_TCB_RESERVED;/* Reserve the priority to prevent others from doing ...  */
+#endif
                                              /* ... the same thing until task is created.              */
         OS_EXIT_CRITICAL();
         psp = OSTaskStkInit(task, p_arg, ptos, 0);              /* Initialize the task's stack         */
@@ -244,7 +308,13 @@ INT8U  OSTaskCreate (void (*task)(void *p_arg), void *p_arg, OS_STK *ptos, INT8U
             }
         } else {
             OS_ENTER_CRITICAL();
+#if OS_SCHED_RR_EN > 0
+            if (OSTCBPrioTbl[prio] == OS_TCB_RESERVED) {
+                OSTCBPrioTbl[prio] = (OS_TCB *)0;  /* Make this priority available to others           */
+            }
+#else
             OSTCBPrioTbl[prio] = (OS_TCB *)0;/* Make this priority available to others                 */
+#endif
             OS_EXIT_CRITICAL();
         }
         return (err);
@@ -284,7 +354,8 @@ INT8U  OSTaskCreate (void (*task)(void *p_arg), void *p_arg, OS_STK *ptos, INT8U
 *                        memory locations.  'ptos' MUST point to a valid 'free' data item.
 *
 *              prio      is the task's priority.  A unique priority MUST be assigned to each task and the
-*                        lower the number, the higher the priority.
+*                        lower the number, the higher the priority.  With OS_SCHED_RR_EN several tasks
+*                        can have the same priority (except the idle task's), they take turns to run.
 *
 *              id        is the task's ID (0..65535)
 *
@@ -337,6 +408,9 @@ INT8U  OSTaskCreateExt (void   (*task)(void *p_arg),
 {
     OS_STK    *psp;
     INT8U      err;
+#if OS_SCHED_RR_EN > 0
+    OS_TCB    *ptcb;
+#endif
 #if OS_CRITICAL_METHOD == 3                  /* Allocate storage for CPU status register               */
     OS_CPU_SR  cpu_sr = 0;
 #endif
@@ -353,8 +427,17 @@ INT8U  OSTaskCreateExt (void   (*task)(void *p_arg),
         OS_EXIT_CRITICAL();
         return (OS_ERR_TASK_CREATE_ISR);
     }
+#if OS_SCHED_RR_EN > 0
+    ptcb = OSTCBPrioTbl[prio];               /* Tasks may share a priority but not a reserved one ...  */
+    if ((ptcb == (OS_TCB *)0) ||             /* ... nor the one of the idle task                       */
+        ((ptcb != OS_TCB_RESERVED) && (prio != OS_TASK_IDLE_PRIO))) {
+        if (ptcb == (OS_TCB *)0) {
+            OSTCBPrioTbl[prio] = OS_TCB_RESERVED;
+        }
+#else
     if (OSTCBPrioTbl[prio] == (OS_TCB *)0) { /* Make sure task doesn't already exist at this priority  */
         OSTCBPrioTbl[prio] = OS_TCB_RESERVED;/* Reserve the priority to prevent others from doing ...  */
+#endif
                                              /* ... the same thing until task is created.              */
         OS_EXIT_CRITICAL();
 
@@ -370,7 +453,13 @@ INT8U  OSTaskCreateExt (void   (*task)(void *p_arg),
             }
         } else {
             OS_ENTER_CRITICAL();
+#if OS_SCHED_RR_EN > 0
+            if (OSTCBPrioTbl[prio] == OS_TCB_RESERVED) {       /* Unless the priority is shared ...    */
+                OSTCBPrioTbl[prio] = (OS_TCB *)0;              /* ... make it avail. to others         */
+            }
+#else
             OSTCBPrioTbl[prio] = (OS_TCB *)0;                  /* Make this priority avail. to others  */
+#endif
             OS_EXIT_CRITICAL();
         }
         return (err);
@@ -396,7 +485,8 @@ INT8U  OSTaskCreateExt (void   (*task)(void *p_arg),
 *              OS_ERR_TASK_DEL_IDLE    if you attempted to delete uC/OS-II's idle task
 *              OS_ERR_PRIO_INVALID     if the priority you specify is higher that the maximum allowed
 *                                      (i.e. >= OS_LOWEST_PRIO) or, you have not specified OS_PRIO_SELF.
-*              OS_ERR_TASK_DEL         if the task is assigned to a Mutex PIP.   
+*              OS_ERR_TASK_DEL         if the task is assigned to a Mutex PIP or, with OS_MUTEX_PROTOCOL_EN,
+*                                      owns a ceiling or inheritance mutex.
 *              OS_ERR_TASK_NOT_EXIST   if the task you want to delete does not exist.
 *              OS_ERR_TASK_DEL_ISR     if you tried to delete a task from an ISR
 *
@@ -421,6 +511,9 @@ INT8U  OSTaskDel (INT8U prio)
 {
 #if (OS_FLAG_EN > 0) && (OS_MAX_FLAGS > 0)
     OS_FLAG_NODE *pnode;
+#endif
+#if (OS_MUTEX_EN > 0) && (OS_MUTEX_PROTOCOL_EN > 0)
+    OS_EVENT     *pevent;
 #endif
     OS_TCB       *ptcb;
 #if OS_CRITICAL_METHOD == 3                             /* Allocate storage for CPU status register    */
@@ -457,12 +550,15 @@ INT8U  OSTaskDel (INT8U prio)
         OS_EXIT_CRITICAL();
         return (OS_ERR_TASK_DEL);
     }
-
-    OSRdyTbl[ptcb->OSTCBY] &= ~ptcb->OSTCBBitX;
-    if (OSRdyTbl[ptcb->OSTCBY] == 0) {                  /* Make task not ready                         */
-        OSRdyGrp           &= ~ptcb->OSTCBBitY;
+#if (OS_MUTEX_EN > 0) && (OS_MUTEX_PROTOCOL_EN > 0)
+    if (ptcb->OSTCBMutexList != (OS_EVENT *)0) {        /* Must not own a ceiling or inheritance mutex */
+        OS_EXIT_CRITICAL();
+        return (OS_ERR_TASK_DEL);
     }
-    
+#endif
+
+    OS_RdyListRemove(ptcb);                             /* Make task not ready                         */
+
 #if (OS_EVENT_EN)
     if (ptcb->OSTCBEventPtr != (OS_EVENT *)0) {
         OS_EventTaskRemove(ptcb, ptcb->OSTCBEventPtr);  /* Remove this task from any event   wait list */
@@ -473,6 +569,14 @@ INT8U  OSTaskDel (INT8U prio)
     }
 #endif
 #endif
+#if (OS_MUTEX_EN > 0) && (OS_MUTEX_PROTOCOL_EN > 0)
+    pevent = ptcb->OSTCBEventPtr;                       /* Owner of a mutex the task waited for ...    */
+    if (((ptcb->OSTCBStat & OS_STAT_MUTEX) != OS_STAT_RDY) && (pevent != (OS_EVENT *)0)) {
+        if (pevent->OSEventMutexOpt != OS_MUTEX_OPT_PIP) {  /* ... no longer inherits its priority     */
+            OS_MutexPrioUpdate((OS_TCB *)pevent->OSEventPtr);
+        }
+    }
+#endif
 
 #if (OS_FLAG_EN > 0) && (OS_MAX_FLAGS > 0)
     pnode = ptcb->OSTCBFlagNode;
@@ -481,7 +585,7 @@ INT8U  OSTaskDel (INT8U prio)
     }
 #endif
 
-    ptcb->OSTCBDly      = 0;                            /* Prevent OSTimeTick() from updating          */
+    OS_TickListRemove(ptcb);                            /* Prevent OSTimeTick() from updating          */
     ptcb->OSTCBStat     = OS_STAT_RDY;                  /* Prevent task from being resumed             */
     ptcb->OSTCBStatPend = OS_STAT_PEND_OK;
     if (OSLockNesting < 255u) {                         /* Make sure we don't context switch           */
@@ -495,7 +599,16 @@ INT8U  OSTaskDel (INT8U prio)
     }
     OSTaskDelHook(ptcb);                                /* Call user defined hook                      */
     OSTaskCtr--;                                        /* One less task being managed                 */
+#if OS_SCHED_RR_EN > 0
+    OS_PrioRingRemove(ptcb);                            /* Leave the tasks of the priority             */
+#else
     OSTCBPrioTbl[prio] = (OS_TCB *)0;                   /* Clear old priority entry                    */
+#endif
+#if (OS_TASK_STAT_STK_CHK_EN > 0) && (OS_TASK_CREATE_EXT_EN > 0)
+    if (OSTaskStatStkTCB == ptcb) {                     /* Move the stack check past the task          */
+        OSTaskStatStkTCB = ptcb->OSTCBNext;
+    }
+#endif
     if (ptcb->OSTCBPrev == (OS_TCB *)0) {               /* Remove from TCB chain                       */
         ptcb->OSTCBNext->OSTCBPrev = (OS_TCB *)0;
         OSTCBList                  = ptcb->OSTCBNext;
@@ -775,7 +888,8 @@ void  OSTaskNameSet (INT8U prio, INT8U *pname, INT8U *perr)
 * Description: This function is called to resume a previously suspended task.  This is the only call that
 *              will remove an explicit task suspension.
 *
-* Arguments  : prio     is the priority of the task to resume.
+* Arguments  : prio     is the priority of the task to resume.  With OS_SCHED_RR_EN the first suspended task
+*                       of the priority is resumed.
 *
 * Returns    : OS_ERR_NONE                if the requested task is resumed
 *              OS_ERR_PRIO_INVALID        if the priority you specify is higher that the maximum allowed
@@ -790,6 +904,9 @@ void  OSTaskNameSet (INT8U prio, INT8U *pname, INT8U *perr)
 INT8U  OSTaskResume (INT8U prio)
 {
     OS_TCB    *ptcb;
+#if OS_SCHED_RR_EN > 0
+    OS_TCB    *pfirst;
+#endif
 #if OS_CRITICAL_METHOD == 3                                   /* Storage for CPU status register       */
     OS_CPU_SR  cpu_sr = 0;
 #endif
@@ -811,12 +928,17 @@ INT8U  OSTaskResume (INT8U prio)
         OS_EXIT_CRITICAL();
         return (OS_ERR_TASK_NOT_EXIST);
     }
+#if OS_SCHED_RR_EN > 0
+    pfirst = ptcb;
+    while (((ptcb->OSTCBStat & OS_STAT_SUSPEND) == OS_STAT_RDY) && (ptcb->OSTCBRRNext != pfirst)) {
+        ptcb = ptcb->OSTCBRRNext;                             /* Find a suspended task of the priority */
+    }
+#endif
     if ((ptcb->OSTCBStat & OS_STAT_SUSPEND) != OS_STAT_RDY) { /* Task must be suspended                */
         ptcb->OSTCBStat &= ~(INT8U)OS_STAT_SUSPEND;           /* Remove suspension                     */
         if (ptcb->OSTCBStat == OS_STAT_RDY) {                 /* See if task is now ready              */
             if (ptcb->OSTCBDly == 0) {
-                OSRdyGrp               |= ptcb->OSTCBBitY;    /* Yes, Make task ready to run           */
-                OSRdyTbl[ptcb->OSTCBY] |= ptcb->OSTCBBitX;
+                OS_RdyListInsert(ptcb);                       /* Yes, Make task ready to run           */
                 OS_EXIT_CRITICAL();
                 if (OSRunning == OS_TRUE) {
                     OS_Sched();                               /* Find new highest priority task        */
@@ -851,6 +973,8 @@ INT8U  OSTaskResume (INT8U prio)
 *              OS_ERR_TASK_NOT_EXIST  if the desired task has not been created or is assigned to a Mutex PIP
 *              OS_ERR_TASK_OPT        if you did NOT specified OS_TASK_OPT_STK_CHK when the task was created
 *              OS_ERR_PDATA_NULL      if 'p_stk_data' is a NULL pointer
+*
+* Note(s)    : 1) The guard entries of OS_TASK_STK_CANARY_EN are counted as used.
 *********************************************************************************************************
 */
 #if (OS_TASK_STAT_STK_CHK_EN > 0) && (OS_TASK_CREATE_EXT_EN > 0)
@@ -900,10 +1024,12 @@ INT8U  OSTaskStkChk (INT8U prio, OS_STK_DATA *p_stk_data)
     pchk  = ptcb->OSTCBStkBottom;
     OS_EXIT_CRITICAL();
 #if OS_STK_GROWTH == 1
+    pchk += OS_TASK_STK_GUARD(size);                  /* Skip the guard entries                        */
     while (*pchk++ == (OS_STK)0) {                    /* Compute the number of zero entries on the stk */
         nfree++;
     }
 #else
+    pchk -= OS_TASK_STK_GUARD(size);
     while (*pchk-- == (OS_STK)0) {
         nfree++;
     }
@@ -916,6 +1042,79 @@ INT8U  OSTaskStkChk (INT8U prio, OS_STK_DATA *p_stk_data)
 /*$PAGE*/
 /*
 *********************************************************************************************************
+*                                            TASK PROFILE
+*
+* Description: This function is called to obtain the run time profile of the specified task: its total
+*              run time and number of context switches, and its CPU share, context switch rate and longest
+*              run without a switch over the profiling window.
+*
+* Arguments  : prio          is the task priority
+*
+*              p_prof        is a pointer to a data structure of type OS_TASK_PROF.
+*
+* Returns    : OS_ERR_NONE            upon success
+*              OS_ERR_PRIO_INVALID    if the priority you specify is higher that the maximum allowed
+*                                     (i.e. > OS_LOWEST_PRIO) or, you have not specified OS_PRIO_SELF.
+*              OS_ERR_TASK_NOT_EXIST  if the desired task has not been created or is assigned to a Mutex PIP
+*              OS_ERR_PDATA_NULL      if 'p_prof' is a NULL pointer
+*
+* Note(s)    : 1) The window values are computed by the statistic task, see OS_TaskStatProf().
+*********************************************************************************************************
+*/
+#if OS_TASK_PROFILE_EN > 0
+INT8U  OSTaskProfGet (INT8U prio, OS_TASK_PROF *p_prof)
+{
+    OS_TCB    *ptcb;
+#if OS_STAT_EN > 0
+    INT8U      i;
+#endif
+#if OS_CRITICAL_METHOD == 3                            /* Allocate storage for CPU status register     */
+    OS_CPU_SR  cpu_sr = 0;
+#endif
+
+
+
+#if OS_ARG_CHK_EN > 0
+    if (prio > OS_LOWEST_PRIO) {                       /* Make sure task priority is valid             */
+        if (prio != OS_PRIO_SELF) {
+            return (OS_ERR_PRIO_INVALID);
+        }
+    }
+    if (p_prof == (OS_TASK_PROF *)0) {                 /* Validate 'p_prof'                            */
+        return (OS_ERR_PDATA_NULL);
+    }
+#endif
+    OS_ENTER_CRITICAL();
+    if (prio == OS_PRIO_SELF) {                        /* See if profile of SELF                       */
+        prio = OSTCBCur->OSTCBPrio;
+    }
+    ptcb = OSTCBPrioTbl[prio];
+    if (ptcb == (OS_TCB *)0) {                         /* Make sure task exist                         */
+        OS_EXIT_CRITICAL();
+        return (OS_ERR_TASK_NOT_EXIST);
+    }
+    if (ptcb == OS_TCB_RESERVED) {
+        OS_EXIT_CRITICAL();
+        return (OS_ERR_TASK_NOT_EXIST);
+    }
+    p_prof->OSCyclesTot = ptcb->OSTCBCyclesTot;
+    p_prof->OSCtxSwCtr  = ptcb->OSTCBCtxSwCtr;
+    p_prof->OSCPUUsage  = ptcb->OSTCBCPUUsage;
+    p_prof->OSCtxSwRate = ptcb->OSTCBCtxSwRate;
+    p_prof->OSRunMax    = ptcb->OSTCBRunMaxWin;
+#if OS_STAT_EN > 0
+    for (i = 0; i < OS_STAT_LOAD_NBR; i++) {           /* Round the load averages to 0.01 %            */
+        p_prof->OSLoadAvg[i] = (INT16U)((ptcb->OSTCBLoadAvg[i] + ((INT32U)1 << (OS_STAT_FSHIFT - 1)))
+                                        >> OS_STAT_FSHIFT);
+    }
+#endif
+    OS_EXIT_CRITICAL();
+    return (OS_ERR_NONE);
+}
+#endif
+/*$PAGE*/
+/*
+*********************************************************************************************************
 *                                            SUSPEND A TASK
 *
 * Description: This function is called to suspend a task.  The task can be the calling task if the
@@ -942,7 +1141,6 @@ INT8U  OSTaskSuspend (INT8U prio)
 {
     BOOLEAN    self;
     OS_TCB    *ptcb;
-    INT8U      y;
 #if OS_CRITICAL_METHOD == 3                      /* Allocate storage for CPU status register           */
     OS_CPU_SR  cpu_sr = 0;
 #endif
@@ -977,11 +1175,7 @@ INT8U  OSTaskSuspend (INT8U prio)
         OS_EXIT_CRITICAL();
         return (OS_ERR_TASK_NOT_EXIST);
     }
-    y            = ptcb->OSTCBY;
-    OSRdyTbl[y] &= ~ptcb->OSTCBBitX;                            /* Make task not ready                 */
-    if (OSRdyTbl[y] == 0) {
-        OSRdyGrp &= ~ptcb->OSTCBBitY;
-    }
+    OS_RdyListRemove(ptcb);                                     /* Make task not ready                 */
     ptcb->OSTCBStat |= OS_STAT_SUSPEND;                         /* Status of task is 'SUSPENDED'       */
     OS_EXIT_CRITICAL();
     if (self == OS_TRUE) {                                      /* Context switch only if SELF         */
@@ -993,6 +1187,73 @@ INT8U  OSTaskSuspend (INT8U prio)
 /*$PAGE*/
 /*
 *********************************************************************************************************
+*                                      SET THE TIME QUANTUM OF TASKS
+*
+* Description: This function is called to set the number of ticks a task runs before the next ready task
+*              of the same priority gets its turn (see OS_SCHED_RR_EN).
+*
+* Arguments  : prio          is the priority of the tasks to change.  All the tasks sharing the priority
+*                            get the new quantum.  If you specify OS_PRIO_SELF, only the quantum of the
+*                            calling task is changed.
+*
+*              quanta        is the time quantum in ticks, 0 selects the default OS_SCHED_RR_QUANTUM.
+*
+* Returns    : OS_ERR_NONE            upon success
+*              OS_ERR_PRIO_INVALID    if the priority you specify is higher that the maximum allowed
+*                                     (i.e. > OS_LOWEST_PRIO) or, you have not specified OS_PRIO_SELF.
+*              OS_ERR_TASK_NOT_EXIST  if the desired task has not been created or is assigned to a Mutex PIP
+*
+* Note(s)    : 1) The new quantum is used from the next turn of the task on.
+*********************************************************************************************************
+*/
+#if OS_SCHED_RR_EN > 0
+INT8U  OSTaskQuantaSet (INT8U prio, INT16U quanta)
+{
+    OS_TCB    *ptcb;
+    OS_TCB    *pfirst;
+#if OS_CRITICAL_METHOD == 3                            /* Allocate storage for CPU status register     */
+    OS_CPU_SR  cpu_sr = 0;
+#endif
+
+
+
+#if OS_ARG_CHK_EN > 0
+    if (prio > OS_LOWEST_PRIO) {                       /* Make sure task priority is valid             */
+        if (prio != OS_PRIO_SELF) {
+            return (OS_ERR_PRIO_INVALID);
+        }
+    }
+#endif
+    if (quanta == 0) {                                 /* Select the default quantum                   */
+        quanta = OS_SCHED_RR_QUANTUM;
+    }
+    OS_ENTER_CRITICAL();
+    if (prio == OS_PRIO_SELF) {                        /* See if quantum of SELF                       */
+        OSTCBCur->OSTCBRRQuanta = quanta;
+        OS_EXIT_CRITICAL();
+        return (OS_ERR_NONE);
+    }
+    ptcb = OSTCBPrioTbl[prio];
+    if (ptcb == (OS_TCB *)0) {                         /* Make sure task exist                         */
+        OS_EXIT_CRITICAL();
+        return (OS_ERR_TASK_NOT_EXIST);
+    }
+    if (ptcb == OS_TCB_RESERVED) {
+        OS_EXIT_CRITICAL();
+        return (OS_ERR_TASK_NOT_EXIST);
+    }
+    pfirst = ptcb;
+    do {                                               /* All the tasks of the priority                */
+        ptcb->OSTCBRRQuanta = quanta;
+        ptcb                = ptcb->OSTCBRRNext;
+    } while (ptcb != pfirst);
+    OS_EXIT_CRITICAL();
+    return (OS_ERR_NONE);
+}
+#endif
+/*$PAGE*/
+/*
+*********************************************************************************************************
 *                                            QUERY A TASK
 *
 * Description: This function is called to obtain a copy of the desired task's TCB.
@@ -1070,25 +1331,39 @@ INT8U  OSTaskQuery (INT8U prio, OS_TCB *p_task_data)
 *                       specific.  See OS_TASK_OPT_??? in uCOS-II.H.
 *
 * Returns    : none
+*
+* Note(s)    : 1) The stack is cleared with OS_MemClr(), a word or a vector at a time, since the time to create
+*                 a task with OS_TASK_OPT_STK_CLR is mostly the time to clear its stack.
+*              2) With OS_TASK_STK_CANARY_EN the guard entries are written at the end of the stack.
 *********************************************************************************************************
 */
 #if (OS_TASK_STAT_STK_CHK_EN > 0) && (OS_TASK_CREATE_EXT_EN > 0)
 void  OS_TaskStkClr (OS_STK *pbos, INT32U size, INT16U opt)
 {
+#if OS_TASK_STK_CANARY_EN > 0
+    INT32U  i;
+#endif
+
+
     if ((opt & OS_TASK_OPT_STK_CHK) != 0x0000) {       /* See if stack checking has been enabled       */
         if ((opt & OS_TASK_OPT_STK_CLR) != 0x0000) {   /* See if stack needs to be cleared             */
 #if OS_STK_GROWTH == 1
-            while (size > 0) {                         /* Stack grows from HIGH to LOW memory          */
-                size--;
-                *pbos++ = (OS_STK)0;                   /* Clear from bottom of stack and up!           */
-            }
+            OS_MemClr((INT8U *)pbos,                   /* Stack grows from HIGH to LOW memory          */
+                      size * sizeof(OS_STK));          /* Clear from bottom of stack and up!           */
 #else
-            while (size > 0) {                         /* Stack grows from LOW to HIGH memory          */
-                size--;
-                *pbos-- = (OS_STK)0;                   /* Clear from bottom of stack and down          */
-            }
+            OS_MemClr((INT8U *)(pbos - size + 1),      /* Stack grows from LOW to HIGH memory          */
+                      size * sizeof(OS_STK));          /* Clear from bottom of stack and down          */
 #endif
         }
+#if OS_TASK_STK_CANARY_EN > 0
+        for (i = 0; i < OS_TASK_STK_GUARD(size); i++) {   /* Write the guard entries                  */
+#if OS_STK_GROWTH == 1
+            pbos[i]     = OS_TASK_STK_CANARY;
+#else
+            *(pbos - i) = OS_TASK_STK_CANARY;
+#endif
+        }
+#endif
     }
 }
 
@@ -43,7 +43,6 @@
 
 void  OSTimeDly (INT16U ticks)
 {
-    INT8U      y;
 #if OS_CRITICAL_METHOD == 3                      /* Allocate storage for CPU status register           */
     OS_CPU_SR  cpu_sr = 0;
 #endif
@@ -55,12 +54,8 @@ void  OSTimeDly (INT16U ticks)
     }
     if (ticks > 0) {                             /* 0 means no delay!                                  */
         OS_ENTER_CRITICAL();
-        y            =  OSTCBCur->OSTCBY;        /* Delay current task                                 */
-        OSRdyTbl[y] &= ~OSTCBCur->OSTCBBitX;
-        if (OSRdyTbl[y] == 0) {
-            OSRdyGrp &= ~OSTCBCur->OSTCBBitY;
-        }
-        OSTCBCur->OSTCBDly = ticks;              /* Load ticks in TCB                                  */
+        OS_RdyListRemove(OSTCBCur);              /* Delay current task                                 */
+        OS_TickListInsert(OSTCBCur, ticks);      /* Load ticks in TCB and tick list                    */
         OS_EXIT_CRITICAL();
         OS_Sched();                              /* Find next task to run!                             */
     }
@@ -140,10 +135,50 @@ INT8U  OSTimeDlyHMSM (INT8U hours, INT8U minutes, INT8U seconds, INT16U ms)
 /*$PAGE*/
 /*
 *********************************************************************************************************
+*                                     DELAY TASK FOR 'ns' NANOSECONDS
+*
+* Description: This function is called to delay execution of the currently running task for a number of
+*              nanoseconds.  The delay is not rounded up to clock ticks, it ends when the one-shot timer of
+*              the port expires (see OSTimeTickNs()).  No delay will result if the specified delay is 0.
+*
+* Arguments  : ns        is the time delay in nanoseconds.
+*
+* Returns    : none
+*
+* Note(s)    : The task can be resumed with OSTimeDlyResume() like a task delayed with OSTimeDly().
+*********************************************************************************************************
+*/
+
+#if OS_TIME_NS_EN > 0
+void  OSTimeDlyNs (INT64U ns)
+{
+#if OS_CRITICAL_METHOD == 3                      /* Allocate storage for CPU status register           */
+    OS_CPU_SR  cpu_sr = 0;
+#endif
+
+
+
+    if (OSIntNesting > 0) {                      /* See if trying to call from an ISR                  */
+        return;
+    }
+    if (ns > 0) {                                /* 0 means no delay!                                  */
+        OS_DlyNsSet(ns);
+        OS_ENTER_CRITICAL();
+        OS_RdyListRemove(OSTCBCur);              /* Delay current task                                 */
+        OS_TickListInsert(OSTCBCur, 1);          /* Load the delay in TCB and nanosecond list          */
+        OS_EXIT_CRITICAL();
+        OS_Sched();                              /* Find next task to run!                             */
+        OS_DlyNsSet(0);
+    }
+}
+#endif
+/*$PAGE*/
+/*
+*********************************************************************************************************
 *                                         RESUME A DELAYED TASK
 *
 * Description: This function is used resume a task that has been delayed through a call to either
-*              OSTimeDly() or OSTimeDlyHMSM().  Note that you can call this function to resume a
+*              OSTimeDly(), OSTimeDlyHMSM() or OSTimeDlyNs().  Note that you can call this function to resume a
 *              task that is waiting for an event with timeout.  This would make the task look
 *              like a timeout occurred.
 *
@@ -153,7 +188,8 @@ INT8U  OSTimeDlyHMSM (INT8U hours, INT8U minutes, INT8U seconds, INT16U ms)
 *
 *                  (10 Minutes * 60 + 55 Seconds + 0.35) * 100 ticks/second.
 *
-* Arguments  : prio                      specifies the priority of the task to resume
+* Arguments  : prio                      specifies the priority of the task to resume.  With OS_SCHED_RR_EN
+*                                        the first delayed task of the priority is resumed.
 *
 * Returns    : OS_ERR_NONE               Task has been resumed
 *              OS_ERR_PRIO_INVALID       if the priority you specify is higher that the maximum allowed
@@ -167,6 +203,9 @@ INT8U  OSTimeDlyHMSM (INT8U hours, INT8U minutes, INT8U seconds, INT16U ms)
 INT8U  OSTimeDlyResume (INT8U prio)
 {
     OS_TCB    *ptcb;
+#if OS_SCHED_RR_EN > 0
+    OS_TCB    *pfirst;
+#endif
 #if OS_CRITICAL_METHOD == 3                                    /* Storage for CPU status register      */
     OS_CPU_SR  cpu_sr = 0;
 #endif
@@ -186,21 +225,36 @@ INT8U  OSTimeDlyResume (INT8U prio)
         OS_EXIT_CRITICAL();
         return (OS_ERR_TASK_NOT_EXIST);                        /* The task does not exist              */
     }
+#if OS_SCHED_RR_EN > 0
+    pfirst = ptcb;
+    while ((ptcb->OSTCBDly == 0) && (ptcb->OSTCBRRNext != pfirst)) {
+        ptcb = ptcb->OSTCBRRNext;                              /* Find a delayed task of the priority  */
+    }
+#endif
     if (ptcb->OSTCBDly == 0) {                                 /* See if task is delayed               */
         OS_EXIT_CRITICAL();
         return (OS_ERR_TIME_NOT_DLY);                          /* Indicate that task was not delayed   */
     }
 
-    ptcb->OSTCBDly = 0;                                        /* Clear the time delay                 */
+    OS_TickListRemove(ptcb);                                   /* Clear the time delay                 */
     if ((ptcb->OSTCBStat & OS_STAT_PEND_ANY) != OS_STAT_RDY) {
         ptcb->OSTCBStat     &= ~OS_STAT_PEND_ANY;              /* Yes, Clear status flag               */
         ptcb->OSTCBStatPend  =  OS_STAT_PEND_TO;               /* Indicate PEND timeout                */
+#if (OS_SCHED_RR_EN > 0) && (OS_EVENT_EN)
+        if (ptcb->OSTCBEventPtr != (OS_EVENT *)0) {            /* Leave the wait list now, see         */
+            OS_EventTaskRemove(ptcb, ptcb->OSTCBEventPtr);     /* ... OS_TickListAdvance()             */
+        }
+#if (OS_EVENT_MULTI_EN > 0)
+        if (ptcb->OSTCBEventMultiPtr != (OS_EVENT **)0) {
+            OS_EventTaskRemoveMulti(ptcb, ptcb->OSTCBEventMultiPtr);
+        }
+#endif
+#endif
     } else {
         ptcb->OSTCBStatPend  =  OS_STAT_PEND_OK;
     }
     if ((ptcb->OSTCBStat & OS_STAT_SUSPEND) == OS_STAT_RDY) {  /* Is task suspended?                   */
-        OSRdyGrp               |= ptcb->OSTCBBitY;             /* No,  Make ready                      */
-        OSRdyTbl[ptcb->OSTCBY] |= ptcb->OSTCBBitX;
+        OS_RdyListInsert(ptcb);                                /* No,  Make ready                      */
         OS_EXIT_CRITICAL();
         OS_Sched();                                            /* See if this is new highest priority  */
     } else {
@@ -212,14 +266,64 @@ INT8U  OSTimeDlyResume (INT8U prio)
 /*$PAGE*/
 /*
 *********************************************************************************************************
+*                                  GIVE THE CPU TO A TASK OF THE SAME PRIORITY
+*
+* Description: This function is called by a task to end its time quantum early.  The next ready task of
+*              the same priority runs and the calling task gets its next turn after the other ready tasks
+*              of the priority, with a full quantum.  Nothing happens if no other task of the priority is
+*              ready.
+*
+* Arguments  : none
+*
+* Returns    : none
+*
+* Note(s)    : Nothing happens either when called from an ISR or with the scheduler locked.
+*********************************************************************************************************
+*/
+
+#if OS_SCHED_RR_EN > 0
+void  OSTimeDlyYield (void)
+{
+    OS_TCB    *pnext;
+#if OS_CRITICAL_METHOD == 3                      /* Allocate storage for CPU status register           */
+    OS_CPU_SR  cpu_sr = 0;
+#endif
+
+
+
+    if (OSIntNesting > 0) {                      /* See if trying to call from an ISR                  */
+        return;
+    }
+    if (OSLockNesting > 0) {                     /* See if called with scheduler locked                */
+        return;
+    }
+    OS_ENTER_CRITICAL();
+    OSTCBCur->OSTCBRRCtr = OSTCBCur->OSTCBRRQuanta;  /* Full quantum for the next turn                 */
+    pnext                = OSTCBCur->OSTCBRRNext;
+    while ((pnext != OSTCBCur) && (pnext->OSTCBRRRdy == OS_FALSE)) {
+        pnext = pnext->OSTCBRRNext;              /* Find the next ready task of the priority           */
+    }
+    if (pnext == OSTCBCur) {                     /* No other task of the priority is ready             */
+        OS_EXIT_CRITICAL();
+        return;
+    }
+    OSTCBPrioTbl[OSTCBCur->OSTCBPrio] = pnext;   /* Give it the turn                                   */
+    pnext->OSTCBRRCtr                 = pnext->OSTCBRRQuanta;
+    OS_EXIT_CRITICAL();
+    OS_Sched();                                  /* Find next task to run!                             */
+}
+#endif
+/*$PAGE*/
+/*
+*********************************************************************************************************
 *                                         GET CURRENT SYSTEM TIME
 *
-* Description: This function is used by your application to obtain the current value of the 32-bit
+* Description: This function is used by your application to obtain the low 32 bits of the 64-bit
 *              counter which keeps track of the number of clock ticks.
 *
 * Arguments  : none
 *
-* Returns    : The current value of OSTime
+* Returns    : The current value of OSTime, truncated to 32 bits
 *********************************************************************************************************
 */
 
@@ -233,6 +337,37 @@ INT32U  OSTimeGet (void)
 
 
 
+    OS_ENTER_CRITICAL();
+    ticks = (INT32U)OSTime;
+    OS_EXIT_CRITICAL();
+    return (ticks);
+}
+#endif
+
+/*
+*********************************************************************************************************
+*                                      GET CURRENT SYSTEM TIME, 64-BIT
+*
+* Description: This function is used by your application to obtain the current value of the 64-bit
+*              counter which keeps track of the number of clock ticks.  Unlike OSTimeGet() it does not
+*              wrap around during the life of the system.
+*
+* Arguments  : none
+*
+* Returns    : The current value of OSTime
+*********************************************************************************************************
+*/
+
+#if OS_TIME_GET_SET_EN > 0
+INT64U  OSTimeGet64 (void)
+{
+    INT64U     ticks;
+#if OS_CRITICAL_METHOD == 3                      /* Allocate storage for CPU status register           */
+    OS_CPU_SR  cpu_sr = 0;
+#endif
+
+
+
     OS_ENTER_CRITICAL();
     ticks = OSTime;
     OS_EXIT_CRITICAL();
@@ -244,7 +379,7 @@ INT32U  OSTimeGet (void)
 *********************************************************************************************************
 *                                            SET SYSTEM CLOCK
 *
-* Description: This function sets the 32-bit counter which keeps track of the number of clock ticks.
+* Description: This function sets the 64-bit counter which keeps track of the number of clock ticks.
 *
 * Arguments  : ticks      specifies the new value that OSTime needs to take.
 *
@@ -266,3 +401,28 @@ void  OSTimeSet (INT32U ticks)
     OS_EXIT_CRITICAL();
 }
 #endif
+
+/*
+*********************************************************************************************************
+*                                     GET CURRENT TIME IN NANOSECONDS
+*
+* Description: This function is used by your application to obtain the time of the one-shot timer of the
+*              port in nanoseconds, the time base of OSTimeDlyNs() and of the pends with a nanosecond
+*              timeout.  The time does not depend on the clock tick and is not changed by OSTimeSet().
+*
+* Arguments  : none
+*
+* Returns    : The current time in nanoseconds.
+*********************************************************************************************************
+*/
+
+#if OS_TIME_NS_EN > 0
+INT64U  OSTimeNsGet (void)
+{
+    INT64U  ts;
+
+
+    ts = OSCPUTsGet();
+    return (OS_TIME_TS_TO_NS(ts));
+}
+#endif
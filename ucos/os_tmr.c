@@ -718,6 +718,48 @@ INT8U  OSTmrSignal (void)
 }
 #endif
 
+/*$PAGE*/
+/*
+************************************************************************************************************************
+*                                          GET THE TIME TO THE NEXT TIMER EXPIRY
+*
+* Description: This function is called by a tickless port, from the idle task, to find out how long the timer task
+*              can be left alone.
+*
+* Arguments  : none
+*
+* Returns    : the number of OSTmrSignal() calls until the first running timer expires, or 0 if no timer is running.
+*
+* Note(s)    : 1) This function is INTERNAL to uC/OS-II and your application should not call it.
+*              2) Interrupts are assumed to be disabled.  The timer list is not locked, the idle task only runs when
+*                 OSTmr_Task() and every task that could change a timer are waiting.
+************************************************************************************************************************
+*/
+
+#if (OS_TMR_EN > 0) && (OS_TICKLESS_EN > 0)
+INT32U  OSTmrNextGet (void)
+{
+    OS_TMR   *ptmr;
+    INT16U    spoke;
+    INT32U    remain;
+    INT32U    next;
+
+
+    next = 0;
+    for (spoke = 0; spoke < OS_TMR_CFG_WHEEL_SIZE; spoke++) {
+        ptmr = OSTmrWheelTbl[spoke].OSTmrFirst;
+        while (ptmr != (OS_TMR *)0) {
+            remain = ptmr->OSTmrMatch - OSTmrTime;             /* Timer ticks left to timeout                       */
+            if (next == 0 || remain < next) {
+                next = remain;
+            }
+            ptmr = (OS_TMR *)ptmr->OSTmrNext;
+        }
+    }
+    return (next);
+}
+#endif
+
 /*$PAGE*/
 /*
 ************************************************************************************************************************
@@ -0,0 +1,497 @@
+/*
+*********************************************************************************************************
+*                                                uC/OS-II
+*                                          The Real-Time Kernel
+*                                     PUBLISH/SUBSCRIBE TOPIC MANAGEMENT
+*
+* File    : OS_TOPIC.C
+* Version : V2.86
+*
+* A topic fans a message out to all the message queues subscribed to it.  OSTopicPublish() posts the
+* message pointer to every subscriber inside one critical section and calls the scheduler once, instead of
+* one OSQPost() per queue with a critical section and a scheduler call each.  The subscribers get the same
+* pointer.  With OS_TOPIC_REF_EN the message can be a block of a memory partition taken with
+* OSTopicMsgGet(), each subscriber releases it with OSTopicMsgPut() and the last one returns the block to
+* its partition.
+*********************************************************************************************************
+*/
+
+#ifndef  OS_MASTER_FILE
+#include <ucos_ii.h>
+#endif
+
+#if (OS_TOPIC_EN > 0) && (OS_MAX_TOPICS > 0)
+/*$PAGE*/
+/*
+*********************************************************************************************************
+*                                            CREATE A TOPIC
+*
+* Description: This function creates a topic without subscribers.
+*
+* Arguments  : perr          is a pointer to an error code that can contain one of the following values:
+*                            OS_ERR_NONE             The call was successful and the topic was created
+*                            OS_ERR_CREATE_ISR       If you tried to create a topic from an ISR
+*                            OS_ERR_TOPIC_DEPLETED   If there are no more topic control blocks
+*
+* Returns    : A pointer to the topic control block if one was available
+*              (OS_TOPIC *)0 otherwise
+*********************************************************************************************************
+*/
+
+OS_TOPIC  *OSTopicCreate (INT8U *perr)
+{
+    OS_TOPIC  *ptopic;
+#if OS_CRITICAL_METHOD == 3                                /* Allocate storage for CPU status register */
+    OS_CPU_SR  cpu_sr = 0;
+#endif
+
+
+
+#if OS_ARG_CHK_EN > 0
+    if (perr == (INT8U *)0) {                              /* Validate 'perr'                          */
+        return ((OS_TOPIC *)0);
+    }
+#endif
+    if (OSIntNesting > 0) {                                /* See if called from ISR ...               */
+        *perr = OS_ERR_CREATE_ISR;                         /* ... can't CREATE from an ISR             */
+        return ((OS_TOPIC *)0);
+    }
+#if OS_SLAB_EN > 0
+    OS_SlabTopicRefill();                                  /* Grow the free list if it is empty        */
+#endif
+    OS_ENTER_CRITICAL();
+    ptopic = OSTopicFreeList;                              /* Get next free topic control block        */
+    if (ptopic == (OS_TOPIC *)0) {                         /* See if we have one                       */
+        OS_EXIT_CRITICAL();
+        *perr = OS_ERR_TOPIC_DEPLETED;
+        return ((OS_TOPIC *)0);
+    }
+    OSTopicFreeList       = ptopic->OSTopicPtr;
+    ptopic->OSTopicType   = OS_EVENT_TYPE_TOPIC;
+    ptopic->OSTopicSubCnt = 0;
+    ptopic->OSTopicPtr    = (OS_TOPIC *)0;
+    OS_EXIT_CRITICAL();
+    *perr = OS_ERR_NONE;
+    return (ptopic);
+}
+
+/*$PAGE*/
+/*
+*********************************************************************************************************
+*                                            DELETE A TOPIC
+*
+* Description: This function deletes a topic.  The subscribers are dropped, the queues are not deleted.
+*
+* Arguments  : ptopic        is a pointer to the topic.
+*
+*              perr          is a pointer to an error code that can contain one of the following values:
+*                            OS_ERR_NONE             The call was successful and the topic was deleted
+*                            OS_ERR_DEL_ISR          If you tried to delete the topic from an ISR
+*                            OS_ERR_EVENT_TYPE       If you didn't pass a pointer to a topic
+*                            OS_ERR_TOPIC_INVALID    If 'ptopic' is a NULL pointer
+*
+* Returns    : ptopic        upon error
+*              (OS_TOPIC *)0 if the topic was successfully deleted.
+*********************************************************************************************************
+*/
+
+OS_TOPIC  *OSTopicDel (OS_TOPIC *ptopic, INT8U *perr)
+{
+#if OS_CRITICAL_METHOD == 3                                /* Allocate storage for CPU status register */
+    OS_CPU_SR  cpu_sr = 0;
+#endif
+
+
+
+#if OS_ARG_CHK_EN > 0
+    if (perr == (INT8U *)0) {                              /* Validate 'perr'                          */
+        return (ptopic);
+    }
+    if (ptopic == (OS_TOPIC *)0) {                         /* Validate 'ptopic'                        */
+        *perr = OS_ERR_TOPIC_INVALID;
+        return (ptopic);
+    }
+#endif
+    if (OSIntNesting > 0) {                                /* See if called from ISR ...               */
+        *perr = OS_ERR_DEL_ISR;                            /* ... can't DELETE from an ISR             */
+        return (ptopic);
+    }
+    OS_ENTER_CRITICAL();
+    if (ptopic->OSTopicType != OS_EVENT_TYPE_TOPIC) {      /* Validate topic control block type        */
+        OS_EXIT_CRITICAL();
+        *perr = OS_ERR_EVENT_TYPE;
+        return (ptopic);
+    }
+    ptopic->OSTopicType   = OS_EVENT_TYPE_UNUSED;
+    ptopic->OSTopicSubCnt = 0;
+    ptopic->OSTopicPtr    = OSTopicFreeList;               /* Return topic control block to free list  */
+    OSTopicFreeList       = ptopic;
+    OS_EXIT_CRITICAL();
+    *perr = OS_ERR_NONE;
+    return ((OS_TOPIC *)0);
+}
+
+/*$PAGE*/
+/*
+*********************************************************************************************************
+*                                  GET A REFERENCE COUNTED MESSAGE
+*
+* Description: This function takes a block of a memory partition for a message that is published with
+*              OS_POST_OPT_REF.  The block starts with an OS_TOPIC_MSG header, the message is the space after
+*              it.  The caller holds the only reference until it publishes the message.
+*
+* Arguments  : pmem          is a pointer to the memory partition.  Its blocks must be larger than
+*                            sizeof(OS_TOPIC_MSG).
+*
+*              perr          is a pointer to an error code that can contain one of the following values:
+*                            OS_ERR_NONE                The call was successful
+*                            OS_ERR_MEM_NO_FREE_BLKS    If the partition has no free block
+*                            OS_ERR_MEM_INVALID_PMEM    If 'pmem' is a NULL pointer
+*                            OS_ERR_MEM_INVALID_SIZE    If the blocks of 'pmem' cannot hold the header
+*
+* Returns    : A pointer to the message if no error is detected
+*              A pointer to NULL if an error is detected
+*
+* Note(s)    : 1) A message that is never published is returned to its partition with OSTopicMsgPut().
+*********************************************************************************************************
+*/
+
+#if OS_TOPIC_REF_EN > 0
+void  *OSTopicMsgGet (OS_MEM *pmem, INT8U *perr)
+{
+    OS_TOPIC_MSG  *phdr;
+
+
+#if OS_ARG_CHK_EN > 0
+    if (perr == (INT8U *)0) {                              /* Validate 'perr'                          */
+        return ((void *)0);
+    }
+    if (pmem == (OS_MEM *)0) {                             /* Validate 'pmem'                          */
+        *perr = OS_ERR_MEM_INVALID_PMEM;
+        return ((void *)0);
+    }
+    if (pmem->OSMemBlkSize <= sizeof(OS_TOPIC_MSG)) {      /* The block must hold the header           */
+        *perr = OS_ERR_MEM_INVALID_SIZE;
+        return ((void *)0);
+    }
+#endif
+    phdr = (OS_TOPIC_MSG *)OSMemGet(pmem, perr);
+    if (phdr == (OS_TOPIC_MSG *)0) {
+        return ((void *)0);
+    }
+    phdr->OSTopicMsgMem  = pmem;
+    phdr->OSTopicMsgRefs = 1;
+    return ((void *)(phdr + 1));
+}
+
+/*$PAGE*/
+/*
+*********************************************************************************************************
+*                                 RELEASE A REFERENCE COUNTED MESSAGE
+*
+* Description: This function is called by a subscriber when it is done with a message that was published
+*              with OS_POST_OPT_REF.  The last reference returns the block to its memory partition.
+*
+* Arguments  : pmsg          is a pointer to the message returned by OSTopicMsgGet().
+*
+* Returns    : OS_ERR_NONE               The call was successful
+*              OS_ERR_MEM_FULL           If the partition of the message was already full
+*              OS_ERR_MEM_INVALID_PBLK   If 'pmsg' is a NULL pointer
+*
+* Note(s)    : 1) This function can be called from an ISR.
+*********************************************************************************************************
+*/
+
+INT8U  OSTopicMsgPut (void *pmsg)
+{
+    OS_TOPIC_MSG  *phdr;
+#if OS_CRITICAL_METHOD == 3                                /* Allocate storage for CPU status register */
+    OS_CPU_SR      cpu_sr = 0;
+#endif
+
+
+
+#if OS_ARG_CHK_EN > 0
+    if (pmsg == (void *)0) {                               /* Validate 'pmsg'                          */
+        return (OS_ERR_MEM_INVALID_PBLK);
+    }
+#endif
+    phdr = (OS_TOPIC_MSG *)pmsg - 1;                       /* Point to the header before the message   */
+    OS_ENTER_CRITICAL();
+    if (phdr->OSTopicMsgRefs > 1) {                        /* See if other subscribers still hold it   */
+        phdr->OSTopicMsgRefs--;
+        OS_EXIT_CRITICAL();
+        return (OS_ERR_NONE);
+    }
+    phdr->OSTopicMsgRefs = 0;                              /* No,  last reference                      */
+    OS_EXIT_CRITICAL();
+    return (OSMemPut(phdr->OSTopicMsgMem, (void *)phdr));  /*      Return the block to its partition   */
+}
+#endif
+
+/*$PAGE*/
+/*
+*********************************************************************************************************
+*                                        PUBLISH A MESSAGE TO A TOPIC
+*
+* Description: This function posts a message to all the queues subscribed to a topic.  The message is
+*              posted to each queue like OSQPostOpt() does, all in one critical section, and the scheduler
+*              is called once at the end.
+*
+* Arguments  : ptopic        is a pointer to the topic.
+*
+*              pmsg          is a pointer to the message to send.
+*
+*              opt           determines the type of POST performed, the options can be added:
+*                            OS_POST_OPT_NONE         POST as FIFO to the queues
+*                            OS_POST_OPT_FRONT        POST as LIFO to the queues
+*                            OS_POST_OPT_NO_SCHED     Indicates that the scheduler will NOT be invoked
+*                            OS_POST_OPT_REF          'pmsg' is a message of OSTopicMsgGet().  The
+*                                                     reference of the caller goes to the subscribers
+*                                                     that got the message, each one has to release it
+*                                                     with OSTopicMsgPut().  If none got it, the message
+*                                                     is returned to its partition.
+*
+*              perr          is a pointer to an error code that can contain one of the following values:
+*                            OS_ERR_NONE             The message was sent to all the subscribers
+*                            OS_ERR_Q_FULL           One or more subscribers were full and did not get it
+*                            OS_ERR_EVENT_TYPE       If you didn't pass a pointer to a topic
+*                            OS_ERR_TOPIC_INVALID    If 'ptopic' is a NULL pointer
+*
+* Returns    : The number of subscribers that got the message.
+*
+* Note(s)    : 1) This function can be called from an ISR.
+*              2) A subscriber that was deleted with OSQDel() without unsubscribing is skipped, unless its
+*                 event control block was reused for another queue.  Unsubscribe before deleting a queue.
+*              3) Interrupts are disabled for a time proportional to the number of subscribers.
+*********************************************************************************************************
+*/
+
+INT8U  OSTopicPublish (OS_TOPIC *ptopic, void *pmsg, INT8U opt, INT8U *perr)
+{
+    OS_EVENT     **psub;
+    OS_EVENT      *pevent;
+    INT8U          nbr;
+    INT8U          nbr_sent;
+    BOOLEAN        sched;
+#if OS_TOPIC_REF_EN > 0
+    OS_TOPIC_MSG  *phdr;
+#endif
+#if OS_CRITICAL_METHOD == 3                                /* Allocate storage for CPU status register */
+    OS_CPU_SR      cpu_sr = 0;
+#endif
+
+
+
+#if OS_ARG_CHK_EN > 0
+    if (perr == (INT8U *)0) {                              /* Validate 'perr'                          */
+        return (0);
+    }
+    if (ptopic == (OS_TOPIC *)0) {                         /* Validate 'ptopic'                        */
+        *perr = OS_ERR_TOPIC_INVALID;
+        return (0);
+    }
+#endif
+    if (ptopic->OSTopicType != OS_EVENT_TYPE_TOPIC) {      /* Validate topic control block type        */
+        *perr = OS_ERR_EVENT_TYPE;
+        return (0);
+    }
+    nbr_sent = 0;
+    sched    = OS_FALSE;
+    OS_ENTER_CRITICAL();
+    psub     = &ptopic->OSTopicSubTbl[0];
+    for (nbr = ptopic->OSTopicSubCnt; nbr > 0; nbr--) {    /* Post to every subscriber                 */
+        pevent = *psub++;
+        if (pevent->OSEventType == OS_EVENT_TYPE_Q) {      /* Skip the queues that were deleted        */
+            if (OS_QPost(pevent, pmsg, opt, &sched) == OS_ERR_NONE) {
+                nbr_sent++;
+            }
+        }
+    }
+#if OS_TOPIC_REF_EN > 0
+    phdr = (OS_TOPIC_MSG *)0;
+    if ((opt & OS_POST_OPT_REF) != 0x00) {                 /* One reference per subscriber that got it */
+        phdr = (OS_TOPIC_MSG *)pmsg - 1;
+        phdr->OSTopicMsgRefs = nbr_sent;
+    }
+#endif
+    if (nbr_sent == ptopic->OSTopicSubCnt) {
+        *perr = OS_ERR_NONE;
+    } else {
+        *perr = OS_ERR_Q_FULL;
+    }
+    OS_EXIT_CRITICAL();
+#if OS_TOPIC_REF_EN > 0
+    if ((phdr != (OS_TOPIC_MSG *)0) && (nbr_sent == 0)) {  /* Nobody got it, return it to its partition */
+        (void)OSMemPut(phdr->OSTopicMsgMem, (void *)phdr);
+    }
+#endif
+    if ((sched == OS_TRUE) && ((opt & OS_POST_OPT_NO_SCHED) == 0)) {
+        OS_Sched();                                        /* Find highest priority task ready to run  */
+    }
+    return (nbr_sent);
+}
+
+/*$PAGE*/
+/*
+*********************************************************************************************************
+*                                      SUBSCRIBE A QUEUE TO A TOPIC
+*
+* Description: This function adds a message queue to the subscribers of a topic.  A queue can subscribe to
+*              several topics.
+*
+* Arguments  : ptopic        is a pointer to the topic.
+*
+*              pevent        is a pointer to the event control block of the queue.
+*
+*              perr          is a pointer to an error code that can contain one of the following values:
+*                            OS_ERR_NONE             The queue was subscribed
+*                            OS_ERR_TOPIC_FULL       If the topic already has OS_TOPIC_SUBS subscribers
+*                            OS_ERR_TOPIC_SUB        If the queue is already subscribed to the topic
+*                            OS_ERR_EVENT_TYPE       If 'ptopic' is not a topic or 'pevent' not a queue
+*                            OS_ERR_TOPIC_INVALID    If 'ptopic' is a NULL pointer
+*                            OS_ERR_PEVENT_NULL      If 'pevent' is a NULL pointer
+*
+* Returns    : none
+*********************************************************************************************************
+*/
+
+void  OSTopicSubscribe (OS_TOPIC *ptopic, OS_EVENT *pevent, INT8U *perr)
+{
+    INT8U      i;
+#if OS_CRITICAL_METHOD == 3                                /* Allocate storage for CPU status register */
+    OS_CPU_SR  cpu_sr = 0;
+#endif
+
+
+
+#if OS_ARG_CHK_EN > 0
+    if (perr == (INT8U *)0) {                              /* Validate 'perr'                          */
+        return;
+    }
+    if (ptopic == (OS_TOPIC *)0) {                         /* Validate 'ptopic'                        */
+        *perr = OS_ERR_TOPIC_INVALID;
+        return;
+    }
+    if (pevent == (OS_EVENT *)0) {                         /* Validate 'pevent'                        */
+        *perr = OS_ERR_PEVENT_NULL;
+        return;
+    }
+#endif
+    OS_ENTER_CRITICAL();
+    if ((ptopic->OSTopicType != OS_EVENT_TYPE_TOPIC) ||    /* Validate the types                       */
+        (pevent->OSEventType != OS_EVENT_TYPE_Q)) {
+        OS_EXIT_CRITICAL();
+        *perr = OS_ERR_EVENT_TYPE;
+        return;
+    }
+    for (i = 0; i < ptopic->OSTopicSubCnt; i++) {          /* See if already subscribed                */
+        if (ptopic->OSTopicSubTbl[i] == pevent) {
+            OS_EXIT_CRITICAL();
+            *perr = OS_ERR_TOPIC_SUB;
+            return;
+        }
+    }
+    if (ptopic->OSTopicSubCnt >= OS_TOPIC_SUBS) {          /* See if there is room for one more        */
+        OS_EXIT_CRITICAL();
+        *perr = OS_ERR_TOPIC_FULL;
+        return;
+    }
+    ptopic->OSTopicSubTbl[ptopic->OSTopicSubCnt] = pevent;
+    ptopic->OSTopicSubCnt++;
+    OS_EXIT_CRITICAL();
+    *perr = OS_ERR_NONE;
+}
+
+/*$PAGE*/
+/*
+*********************************************************************************************************
+*                                    UNSUBSCRIBE A QUEUE FROM A TOPIC
+*
+* Description: This function removes a message queue from the subscribers of a topic.  The messages that
+*              are already in the queue stay there.
+*
+* Arguments  : ptopic        is a pointer to the topic.
+*
+*              pevent        is a pointer to the event control block of the queue.
+*
+*              perr          is a pointer to an error code that can contain one of the following values:
+*                            OS_ERR_NONE             The queue was unsubscribed
+*                            OS_ERR_TOPIC_NOT_SUB    If the queue is not subscribed to the topic
+*                            OS_ERR_EVENT_TYPE       If you didn't pass a pointer to a topic
+*                            OS_ERR_TOPIC_INVALID    If 'ptopic' is a NULL pointer
+*
+* Returns    : none
+*
+* Note(s)    : 1) The last subscriber takes the place of the one removed, the order of the subscribers
+*                 changes.
+*********************************************************************************************************
+*/
+
+void  OSTopicUnsubscribe (OS_TOPIC *ptopic, OS_EVENT *pevent, INT8U *perr)
+{
+    INT8U      i;
+#if OS_CRITICAL_METHOD == 3                                /* Allocate storage for CPU status register */
+    OS_CPU_SR  cpu_sr = 0;
+#endif
+
+
+
+#if OS_ARG_CHK_EN > 0
+    if (perr == (INT8U *)0) {                              /* Validate 'perr'                          */
+        return;
+    }
+    if (ptopic == (OS_TOPIC *)0) {                         /* Validate 'ptopic'                        */
+        *perr = OS_ERR_TOPIC_INVALID;
+        return;
+    }
+#endif
+    OS_ENTER_CRITICAL();
+    if (ptopic->OSTopicType != OS_EVENT_TYPE_TOPIC) {      /* Validate topic control block type        */
+        OS_EXIT_CRITICAL();
+        *perr = OS_ERR_EVENT_TYPE;
+        return;
+    }
+    for (i = 0; i < ptopic->OSTopicSubCnt; i++) {
+        if (ptopic->OSTopicSubTbl[i] == pevent) {          /* Move the last subscriber in its place    */
+            ptopic->OSTopicSubCnt--;
+            ptopic->OSTopicSubTbl[i] = ptopic->OSTopicSubTbl[ptopic->OSTopicSubCnt];
+            OS_EXIT_CRITICAL();
+            *perr = OS_ERR_NONE;
+            return;
+        }
+    }
+    OS_EXIT_CRITICAL();
+    *perr = OS_ERR_TOPIC_NOT_SUB;
+}
+
+/*$PAGE*/
+/*
+*********************************************************************************************************
+*                                      TOPIC MODULE INITIALIZATION
+*
+* Description : This function is called by uC/OS-II to initialize the topic module.  Your application
+*               MUST NOT call this function.
+*
+* Arguments   : none
+*
+* Returns     : none
+*
+* Note(s)    : This function is INTERNAL to uC/OS-II and your application should not call it.
+*********************************************************************************************************
+*/
+
+void  OS_TopicInit (void)
+{
+    INT16U  i;
+
+
+
+    OS_MemClr((INT8U *)&OSTopicTbl[0], sizeof(OSTopicTbl));/* Clear the topic table                    */
+    for (i = 0; i < (OS_MAX_TOPICS - 1); i++) {            /* Init. list of free TOPIC control blocks  */
+        OSTopicTbl[i].OSTopicPtr = &OSTopicTbl[i + 1];
+    }
+    OSTopicTbl[OS_MAX_TOPICS - 1].OSTopicPtr = (OS_TOPIC *)0;
+    OSTopicFreeList                          = &OSTopicTbl[0];
+}
+#endif                                                      /* OS_TOPIC_EN                              */
@@ -35,12 +35,11 @@ typedef unsigned short int  INT16U;
 typedef signed   short int  INT16S;
 typedef unsigned int  		INT32U;
 typedef signed   int  		INT32S;
+typedef unsigned long long	INT64U;
+typedef signed   long long	INT64S;
 typedef float          		FP32;
 typedef INT32U  			OS_STK;
-//typedef sigset_t			OS_CPU_SR;
-#ifndef OS_CPU_SR
-#define OS_CPU_SR	sigset_t new_cpu_sr; int
-#endif
+typedef unsigned char		OS_CPU_SR;	/* Previous state of the virtual interrupt flag */
 
 /*
 *********************************************************************************************************
@@ -55,20 +54,117 @@ typedef INT32U  			OS_STK;
 void OSSystemReset(void);
 #endif
 
-/* Extra functionality of this port. Minimum stack size. Pthreads creates its own stack for each thread(task) but a minimum size is needed internally for the ports use. */
+/* Tick source. When set to 1 the tick is generated by a CLOCK_MONOTONIC timerfd which is serviced by a dedicated
+   tick thread, allowing OS_TICKS_PER_SEC up to 10kHz. When set to 0 the original ualarm() tick is used. */
+#define OS_CPU_TICK_TIMERFD_EN	1
+
+#if OS_CPU_TICK_TIMERFD_EN > 0
+/* Extra functionality of this port. Statistics of the timerfd tick source, all times are in nanoseconds. */
+typedef struct os_tick_stats {
+	INT32U	OSTickCtr;			/* Number of ticks delivered to the kernel                          */
+	INT32U	OSTickOverrunCtr;	/* Number of ticks that were missed by the tick thread and caught up */
+	INT32U	OSTickJitterMin;	/* Minimum lateness of the tick thread wakeup                       */
+	INT32U	OSTickJitterMax;	/* Maximum lateness of the tick thread wakeup                       */
+	INT32U	OSTickJitterAvg;	/* Average lateness of the tick thread wakeup                       */
+} OS_TICK_STATS;
+
+void OSTickStatsGet(OS_TICK_STATS* pStats);
+void OSTickStatsReset(void);
+#endif
+
+/* Context switch method between the tasks:
+   1  The task switching mutex and a condition variable per thread (original implementation).
+   2  Direct handoff, every thread parks on its own futex word. The switching task wakes only the next task
+      and then parks itself, no lock is shared between the task threads.
+   3  Single threaded. All tasks run on their own stack in the thread that called OSStart() and a switch swaps the
+      registers in user space (os_cpu_a.S on x86-64 and ARM, swapcontext() elsewhere). Task stacks must be real
+      stacks of at least OSMinStkSize() bytes. */
+#ifndef OS_CPU_CTX_SW_METHOD
+#define OS_CPU_CTX_SW_METHOD	2
+#endif
+
+/* Extra functionality of this port. Minimum stack size in bytes. Pthreads creates its own stack for each thread(task) but a minimum size is needed internally for the ports use.
+   With OS_CPU_CTX_SW_METHOD 3 the task really runs on this stack, including the tick signal frame. */
 int OSMinStkSize();
 
+/* Extra functionality of this port. Time stamp used for the task profiling (OS_TASK_PROFILE_EN), CLOCK_MONOTONIC in
+   nanoseconds. */
+#define OS_CPU_TS_FREQ		1000000000ULL
+INT64U OSCPUTsGet(void);
+
+/* One-shot timer of OS_TIME_NS_EN. Raises the tick interrupt at the time stamp ts of OSCPUTsGet() and the tick ISR
+   calls OSTimeTickNs(). A time stamp that has passed expires at once, 0 stops the timer. Called with interrupts
+   disabled. */
+void OSCPUTimerSet(INT64U ts);
+
+/* Count of trailing zero bits of a non zero 64-bit word, the scheduler finds the highest priority ready or waiting
+   task with it when OS_SCHED_CTZ_EN is set. */
+#define OS_CPU_CTZ(x)		__builtin_ctzll( x )
+
+/* Compiler barrier between an ISR and the task it interrupts. The interrupt queues (OS_INT_Q_EN) write an entry
+   before the index that publishes it without a critical section, the ISRs of this port run on the thread of the task
+   they interrupt like the critical sections assume. */
+#define OS_CPU_BARRIER()	__atomic_signal_fence( __ATOMIC_SEQ_CST )
+
+/* Barriers and atomic operations between the threads of the process. The producer of a channel (OS_CHAN_EN) is a
+   thread that is not a task and may run on another CPU than the tasks. ACQUIRE orders the loads after it behind the
+   loads before it, RELEASE the stores after it behind the loads and stores before it, BARRIER is a full barrier. */
+#define OS_CPU_SMP_ACQUIRE()		__atomic_thread_fence( __ATOMIC_ACQUIRE )
+#define OS_CPU_SMP_RELEASE()		__atomic_thread_fence( __ATOMIC_RELEASE )
+#define OS_CPU_SMP_BARRIER()		__atomic_thread_fence( __ATOMIC_SEQ_CST )
+#define OS_CPU_XCHG(p, v)			__atomic_exchange_n( p, v, __ATOMIC_SEQ_CST )
+#define OS_CPU_CAS(p, pold, v)		__atomic_compare_exchange_n( p, pold, v, 0, __ATOMIC_SEQ_CST, __ATOMIC_SEQ_CST )
+
+/* Raises the tick interrupt from any thread of the process, the tick ISR then calls OSChanSignal(). Needs the
+   timerfd tick source. SIGALRM is sent to the thread of the running task, a task thread that was switched out in the
+   meantime passes it on to the next one. A thread that is not a task must keep SIGALRM blocked, the threads created
+   before OSStart() inherit the blocked signal, a thread created by a task has to block it itself. */
+void OSCPUIntRaise(void);
+
+/* Page of OS_SLAB_EN for the object tables of the kernel, taken from the heap of the process and never freed. */
+void* OSCPUSlabAlloc(INT32U nSize);
+
+/* Native word of the processor. OS_MemClr() and OS_MemCopy() move memory a word at a time once the destination is
+   aligned to one, the attribute allows the kernel to access any object through it. */
+typedef unsigned long __attribute__(( __may_alias__ )) OS_CPU_WORD;
+
+/* Byte order of OS_CPU_WORD. OS_MemCopy() follows it to shift the words of a source misaligned to the destination. */
+#define OS_CPU_BIG_ENDIAN	( __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__ )
+
+/* Extra functionality of this port. When set to 1 and the compiler targets SSE2 or NEON, OS_MemClr() and OS_MemCopy()
+   are done 16 bytes at a time by OSCPUMemClr() and OSCPUMemCopy() instead of the word loops of the kernel. */
+#ifndef OS_CPU_MEM_SIMD_EN
+#define OS_CPU_MEM_SIMD_EN	1
+#endif
+
+#if (OS_CPU_MEM_SIMD_EN > 0) && (defined(__SSE2__) || defined(__ARM_NEON))
+#define OS_CPU_MEM_CLR(pdest, size)			OSCPUMemClr( pdest, size )
+#define OS_CPU_MEM_COPY(pdest, psrc, size)	OSCPUMemCopy( pdest, psrc, size )
+void OSCPUMemClr(INT8U* pDest, INT32U nSize);
+void OSCPUMemCopy(INT8U* pDest, INT8U* pSrc, INT32U nSize);
+#endif
+
 void OSIntCtxSw(void);
 void OSStartHighRdy(void);
 void OSCtxSw();
+void OSTickISR(void);
 
 #define OS_CRITICAL_METHOD 3
 
-/* Block interrupts by blocking the alarm signal */
-#define OS_ENTER_CRITICAL() { cpu_sr = cpu_sr; sigset_t mask; sigemptyset( &mask ); sigaddset( &mask, SIGALRM ); sigprocmask( SIG_SETMASK, &mask, &new_cpu_sr ); }
+/* Virtual interrupt mask. Interrupts are disabled with a flag in user space instead of blocking the alarm signal,
+   so a critical section makes no system call. An alarm signal that arrives while the flag is set only marks the
+   interrupt pending and OSCPUIntEnable() runs it when the critical section is left. */
+OS_CPU_EXT volatile BOOLEAN	OSCPUIntDisabled;
+OS_CPU_EXT volatile BOOLEAN	OSCPUIntPending;
+
+void OSCPUIntEnable(void);
+
+/* Disable interrupts */
+#define OS_ENTER_CRITICAL() { cpu_sr = OSCPUIntDisabled; OSCPUIntDisabled = 1; __atomic_signal_fence( __ATOMIC_SEQ_CST ); }
 
-/* Unblock the alarm signal */
-#define OS_EXIT_CRITICAL() { sigprocmask(SIG_SETMASK, &new_cpu_sr, NULL); }
+/* Restore the previous interrupt state, run an interrupt that arrived in the meantime */
+#define OS_EXIT_CRITICAL() { __atomic_signal_fence( __ATOMIC_SEQ_CST ); OSCPUIntDisabled = cpu_sr; \
+                             if( cpu_sr == 0 && OSCPUIntPending ) OSCPUIntEnable(); }
 
 /* Stack grows high to low */
 #define  OS_STK_GROWTH      1
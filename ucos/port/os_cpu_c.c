@@ -27,9 +27,57 @@
 * is invoked by the OS_TASK_SW() call, this function simply calls OSIntCtxSw() described above and results in the same set of
 * operations.
 *
+* With OS_CPU_CTX_SW_METHOD set to 2 (the default) the condition variables are replaced by a futex word per thread. The
+* switching task sets the run word of the new task, wakes it only if it is actually sleeping, and then parks on its own
+* run word. No mutex is shared between the task threads so a switch is one wake and one wait system call. The
+* condition variables and mutex are then only used while the thread wrappers start up.
+*
+* With OS_CPU_CTX_SW_METHOD set to 3 no thread is created for the tasks. Every task runs on its own (real) stack in the
+* thread that called OSStart(). OSTaskStkInit() builds an initial register frame on the task stack and a context switch
+* saves the callee saved registers of the current task and loads those of the new task (OSCtxSwRegs() in os_cpu_a.S on
+* x86-64 and ARM, swapcontext() on other CPUs), so a switch never enters the kernel. The tick signal is delivered to
+* that one thread and the switch from an interrupt is done inside the signal handler; the handler frame stays on the
+* stack of the preempted task and returns when the task is switched back in. The stacks have to hold the task itself
+* plus the signal frame, see OSMinStkSize(). Because all tasks share one thread, library functions that take locks
+* (printf, malloc, ...) must be called inside a critical section, exactly as on a real CPU.
+*
+* The thread that called OSStart() is not a task (except with OS_CPU_CTX_SW_METHOD 3, where a thread is created for it).
+* Once the tasks run it becomes the supervisor, which sleeps in sigwaitinfo() until the process is asked to shut down
+* (SIGINT, SIGTERM) or, with OS_SYSTEM_RESET_EN, to reset (SIGHUP). These signals are blocked in every other thread so
+* they never interrupt a task.
+*
 * One extra capability of this port is to provide a system reset function which calls an externally defined function
 * void OSSystemResetHook(void). This user defined function could call execv which would cause the process to restart.
 *
+* By default the tick is not generated by the alarm signal timer itself. A dedicated tick thread waits on a CLOCK_MONOTONIC
+* timerfd and, for every expiry, adds the number of elapsed ticks to a pending count and raises SIGALRM on the process.
+* The signal is then handled by the running task exactly as before and the handler processes every pending tick, so ticks
+* missed while the process was not scheduled are caught up instead of being lost. Set OS_CPU_TICK_TIMERFD_EN to 0 in
+* os_cpu.h to go back to the ualarm() tick.
+*
+* With OS_TICKLESS_EN the idle task stops the periodic tick. It asks the kernel for the first task delay or timeout
+* (and the first timer expiry) and programs the timerfd as a one-shot for that tick, then waits for the signal. The
+* tick thread counts the ticks from the time of the expiry, so the kernel advances OSTime by all the ticks it slept
+* through with one OSTimeTickN() call. The periodic tick is restarted by OSTaskSwHook() when a task other than the
+* idle task is switched in.
+*
+* With OS_TIME_NS_EN the tick thread also waits on a second timerfd, the one-shot timer the kernel programs with
+* OSCPUTimerSet() for the first nanosecond delay or timeout. Its expiry raises SIGALRM like a tick and the tick ISR
+* calls OSTimeTickNs(), so these timeouts do not wait for the next tick.
+*
+* OSCPUIntRaise() raises the same interrupt from any other thread of the process. The producer of a channel
+* (OS_CHAN_EN) calls it when a task waits for a message and the tick ISR then calls OSChanSignal().
+*
+* Interrupts are disabled with a flag in user space (OSCPUIntDisabled), not by blocking the alarm signal. The signal
+* handler runs the tick ISR when the flag is clear and otherwise only marks the interrupt pending, OS_EXIT_CRITICAL()
+* runs it when the outermost critical section is left. The tick thread and OSCPUIntRaise() send SIGALRM to the thread
+* of the running task (threadRun) with pthread_kill(), a context switch only records the new thread and never changes
+* a signal mask. A task thread starts with SIGALRM blocked and unblocks it for good when it is first switched in. A
+* signal that reaches a task thread after it was switched out, or the process directed signal of the ualarm() tick,
+* is passed on to the running task by the signal handler. Every thread that is not a task keeps SIGALRM blocked:
+* threads created from the main thread inherit the mask InitLinuxPort() sets, threads created by a task must block it
+* themselves.
+*
 * Remember to include link to pthread when linking (-lpthread).
 *
 * Notes on debugging using gdb
@@ -49,15 +97,70 @@
 #include <unistd.h>
 #include <sys/syscall.h>
 #include <sys/types.h>
+#include <time.h>
 
+#define OS_CPU_GLOBALS
 #include <ucos_ii.h>
 
+#if OS_CPU_TICK_TIMERFD_EN > 0
+#include <sched.h>
+#include <sys/prctl.h>
+#include <sys/timerfd.h>
+#include <poll.h>
+#endif
+
+#if OS_CPU_CTX_SW_METHOD == 2
+#include <linux/futex.h>
+#endif
+
+#if (OS_CPU_CTX_SW_METHOD == 3) && !defined(__x86_64__) && !defined(__arm__)
+#include <ucontext.h>
+#endif
+
+#if defined(OS_CPU_MEM_CLR) && defined(__SSE2__)
+#include <emmintrin.h>
+#elif defined(OS_CPU_MEM_CLR)
+#include <arm_neon.h>
+#endif
+
 
 /* Check OS_VERSION for compatibility with this port */
 #if OS_VERSION < 204
 #error OS_VERSION must be >= 204. This port uses OSTCBInitHook.
 #endif
 
+#if (OS_CPU_CTX_SW_METHOD < 1) || (OS_CPU_CTX_SW_METHOD > 3)
+#error OS_CPU_CTX_SW_METHOD must be 1, 2 or 3.
+#endif
+
+#if (OS_CPU_TICK_TIMERFD_EN > 0) && (OS_TICKS_PER_SEC > 10000)
+#error OS_TICKS_PER_SEC must be <= 10000 with the timerfd tick source.
+#endif
+
+#if (OS_TICKLESS_EN > 0) && (OS_CPU_TICK_TIMERFD_EN == 0)
+#error OS_TICKLESS_EN needs the timerfd tick source, set OS_CPU_TICK_TIMERFD_EN in os_cpu.h.
+#endif
+
+#if (OS_TIME_NS_EN > 0) && (OS_CPU_TICK_TIMERFD_EN == 0)
+#error OS_TIME_NS_EN needs the timerfd tick source, set OS_CPU_TICK_TIMERFD_EN in os_cpu.h.
+#endif
+
+#if (OS_CHAN_EN > 0) && (OS_MAX_CHANS > 0) && (OS_CPU_TICK_TIMERFD_EN == 0)
+#error OS_CHAN_EN needs the timerfd tick source, set OS_CPU_TICK_TIMERFD_EN in os_cpu.h.
+#endif
+
+/* Length of one tick in nanoseconds */
+#define TICK_PERIOD_NS		(1000000000L / OS_TICKS_PER_SEC)
+
+#if OS_TMR_EN > 0
+/* Number of ticks between two OSTmrSignal() calls */
+#if OS_TICKS_PER_SEC > OS_TMR_CFG_TICKS_PER_SEC
+#define TMR_TICK_DIV		(OS_TICKS_PER_SEC / OS_TMR_CFG_TICKS_PER_SEC)
+#else
+#define TMR_TICK_DIV		1
+#endif
+#endif
+
 /*#if OS_CPU_HOOKS_EN > 0
 *********************************************************************************************************
 *                                       GLOBAL VARIABLES
@@ -79,6 +182,71 @@ pthread_t		threadTask[ OS_LOWEST_PRIO ];
 /* Context switching control mutex */
 pthread_mutex_t 	mutThread;
 
+#if OS_CPU_CTX_SW_METHOD == 2
+/* Run words of all threads. Index for thread is stored in its stack. */
+#define THREAD_PARKED		0	/* Thread must not run                               */
+#define THREAD_RUN		1	/* Thread has been handed the CPU                    */
+#define THREAD_SLEEPING		2	/* Thread is waiting in the kernel for THREAD_RUN    */
+static volatile int	gnThreadRun[ OS_LOWEST_PRIO ];
+#endif
+
+/* Signals handled by the supervisor */
+static sigset_t		setSupervisor;
+
+/* The tick interrupt signal */
+static sigset_t		setAlarm;
+
+/* Thread of the running task, the tick interrupt is sent to it */
+static volatile pthread_t	threadRun;
+
+#if OS_TMR_EN > 0
+/* Ticks since the last OSTmrSignal() */
+static INT32U		nTmrTickCtr;
+#endif
+
+#if OS_CPU_CTX_SW_METHOD == 3
+/* Supervisor thread, the thread that called OSStart() runs the tasks */
+pthread_t		threadSupervisor;
+#endif
+
+#if OS_CPU_TICK_TIMERFD_EN > 0
+/* Tick thread and the timerfd it waits on */
+pthread_t		threadTick;
+int			fdTick = -1;
+
+/* Ticks raised by the tick thread that have not been processed by the tick ISR yet */
+volatile INT32U		nTickPending;
+
+#if OS_TIME_NS_EN > 0
+/* One-shot timer of OSCPUTimerSet(), set by the tick thread when it expired until the tick ISR handles it */
+int			fdTimer = -1;
+volatile INT32U		bTimerPending;
+#endif
+
+/* Set by OSCPUIntRaise() until the tick ISR handles it */
+volatile INT32U		bIntRaised;
+
+/* Tick accounting, protected by mutTick. nTickDueNs is the monotonic time of the next tick that will be raised,
+   nTickCnt the number of ticks raised so far and nTickExpected the number of ticks the next timer expiry stands
+   for (1 for the periodic tick, more for a one-shot programmed by the idle task). */
+static pthread_mutex_t	mutTick = PTHREAD_MUTEX_INITIALIZER;
+static INT64U		nTickDueNs;
+static INT64U		nTickCnt;
+static INT64U		nTickExpected;
+
+#if OS_TICKLESS_EN > 0
+/* Set while the periodic tick is stopped by the idle task */
+static BOOLEAN		bTickSuppressed;
+#endif
+
+/* Tick statistics. Only written by the tick thread, readers use the sequence count to get a consistent copy. */
+static volatile INT32U	nTickStatsSeq;
+static volatile INT32U	bTickStatsReset;
+static OS_TICK_STATS	tickStats;
+static INT64U		nTickJitterSum;
+static INT32U		nTickJitterCnt;
+#endif
+
 
 /*
 *********************************************************************************************************
@@ -94,7 +262,46 @@ typedef struct FuncInfoType
 	int	nThreadIdx;
 } FuncInfo;
 
-int OSMinStkSize(){ return( sizeof( FuncInfo ) ); }
+#if OS_CPU_CTX_SW_METHOD == 3
+/* Minimum stack of a task: the task itself, the tick signal frame (a few KB with the AVX-512 state) and the ISR */
+#define TASK_MIN_STK_SIZE	16384
+
+#if defined(__x86_64__) || defined(__arm__)
+/* Register switch in os_cpu_a.S */
+#define CTX_SW_REGS		1
+extern void OSCtxSwRegs( OS_STK** ppSaveSp, OS_STK* pNewSp );
+extern void OSTaskStartRegs( void );
+
+/* Context of the thread that called OSStart(), it is never switched back to */
+static OS_STK*		pMainSp;
+#else
+#define CTX_SW_REGS		0
+
+/* Context stored at the top of each task stack, OSTCBStkPtr points to it */
+typedef struct TaskContextType
+{
+	ucontext_t	uc;
+	void*		pFunc;
+	void*		pArgs;
+} TaskContext;
+
+/* Context of the thread that called OSStart(), it is never switched back to */
+static ucontext_t	ucMain;
+
+static void TaskEntryContext( void );
+#endif
+
+static void TaskEntry( void (*pFunc)(void*), void* pArgs );
+#endif
+
+int OSMinStkSize()
+{
+#if OS_CPU_CTX_SW_METHOD == 3
+	return( TASK_MIN_STK_SIZE );
+#else
+	return( sizeof( FuncInfo ) );
+#endif
+}
 
 #if OS_SYSTEM_RESET_EN > 0
 extern void OSSystemResetHook(void);
@@ -102,7 +309,21 @@ extern void OSSystemResetHook(void);
 
 static void InitLinuxPort();
 static void InitTick();
+static void StopTick();
+#if OS_TICKLESS_EN > 0
+static void TickIdle();
+static void TickResume();
+#endif
+static void* Supervisor( void* pArg );
 static void AlarmSigHandler( int signum );
+static void AlarmSend();
+#if OS_CPU_CTX_SW_METHOD != 3
+static void ThreadSwitch( int nThreadIdxNew, int nThreadIdxOld );
+#endif
+#if OS_CPU_CTX_SW_METHOD == 2
+static void ThreadPark( int nThreadIdx );
+static void ThreadRun( int nThreadIdx );
+#endif
 
 /*
 *********************************************************************************************************
@@ -146,6 +367,32 @@ void OSTaskDelHook (OS_TCB *ptcb)
 }
 
 
+/*
+*********************************************************************************************************
+*                                         STACK OVERFLOW HOOK
+*
+* Description: This function is called by the statistic task when the guard entries at the end of the stack
+*              of a task were overwritten (OS_TASK_STK_CANARY_EN).
+*
+* Arguments  : ptcb   is a pointer to the task control block of the task whose stack overflowed.
+*
+* Note(s)    : 1) Interrupts are disabled during this call.
+*********************************************************************************************************
+*/
+#if OS_TASK_STK_CANARY_EN > 0
+void OSTaskStkOvfHook (OS_TCB *ptcb)
+{
+#if OS_CPU_HOOKS_EN > 0
+#if OS_TASK_NAME_SIZE > 1
+	fprintf( stderr, "uC/OS-II: stack overflow of task %u (%s)\n", ptcb->OSTCBPrio, ptcb->OSTCBTaskName );
+#else
+	fprintf( stderr, "uC/OS-II: stack overflow of task %u\n", ptcb->OSTCBPrio );
+#endif
+#endif
+}
+#endif
+
+
 /*
 *********************************************************************************************************
 *                                           TASK SWITCH HOOK
@@ -164,6 +411,25 @@ void OSTaskDelHook (OS_TCB *ptcb)
 void OSTaskSwHook (void)
 {
 #if (OS_CPU_HOOKS_EN > 0)
+#if OS_TASK_PROFILE_EN > 0
+	/* Charge the time since the last switch to the task being switched out */
+	INT64U nNow = OSCPUTsGet();
+	INT64U nRun;
+
+	if( OSRunning == OS_TRUE )
+	{
+		nRun = nNow - OSTCBCur->OSTCBCyclesStart;
+		OSTCBCur->OSTCBCyclesTot += nRun;
+		if( nRun > OSTCBCur->OSTCBRunMax )
+			OSTCBCur->OSTCBRunMax = ( nRun > 0xFFFFFFFFULL ) ? 0xFFFFFFFF : (INT32U)nRun;
+	}
+	OSTCBHighRdy->OSTCBCyclesStart = nNow;
+#endif
+#if OS_TICKLESS_EN > 0
+	/* The periodic tick is only stopped while the idle task runs */
+	if( OSTCBHighRdy->OSTCBPrio != OS_TASK_IDLE_PRIO )
+		TickResume();
+#endif
 #endif
 }
 
@@ -197,6 +463,14 @@ void OSTaskStatHook (void)
 void OSTimeTickHook (void)
 {
 #if (OS_CPU_HOOKS_EN > 0) && (OS_TIME_TICK_HOOK_EN > 0)
+#if OS_TMR_EN > 0
+	/* Drive the timer task at OS_TMR_CFG_TICKS_PER_SEC */
+	if( ++nTmrTickCtr >= TMR_TICK_DIV )
+	{
+		nTmrTickCtr = 0;
+		OSTmrSignal();
+	}
+#endif
 #endif
 }
 
@@ -236,8 +510,12 @@ void OSInitHookEnd (void)
 void OSTaskIdleHook (void)
 {
 #if OS_CPU_HOOKS_EN > 0 && OS_VERSION >= 251
+#if OS_TICKLESS_EN > 0
+    TickIdle();
+#else
     select(0, NULL, NULL, NULL, NULL);
 #endif
+#endif
 }
 
 
@@ -257,13 +535,89 @@ void OSTaskIdleHook (void)
 */
 OS_STK* OSTaskStkInit (void (*task)(void* pd), void* pdata, OS_STK* ptos, INT16U opt)
 {
+#if (OS_CPU_CTX_SW_METHOD == 3) && (CTX_SW_REGS > 0)
+	/* Initial frame popped by OSCtxSwRegs(), see os_cpu_a.S for the layout */
+	unsigned long* pStk = (unsigned long*)( (unsigned long)( ptos + 1 ) & ~15UL );
+#if defined(__x86_64__)
+	*--pStk = (unsigned long)OSTaskStartRegs;	/* Return address          */
+	*--pStk = 0;					/* rbp                     */
+	*--pStk = 0;					/* rbx                     */
+	*--pStk = (unsigned long)TaskEntry;		/* r12 = C entry point     */
+	*--pStk = (unsigned long)task;			/* r13 = task function     */
+	*--pStk = (unsigned long)pdata;			/* r14 = task argument     */
+	*--pStk = 0;					/* r15                     */
+	*--pStk = 0x037F00001F80UL;			/* x87 control word, MXCSR */
+#else
+	int i;
+
+	*--pStk = (unsigned long)OSTaskStartRegs;	/* lr                      */
+	for( i = 11; i >= 7; i-- )
+		*--pStk = 0;				/* r11 - r7                */
+	*--pStk = (unsigned long)pdata;			/* r6 = task argument      */
+	*--pStk = (unsigned long)task;			/* r5 = task function      */
+	*--pStk = (unsigned long)TaskEntry;		/* r4 = C entry point      */
+#if defined(__VFP_FP__) && !defined(__SOFTFP__)
+	for( i = 0; i < 16; i++ )
+		*--pStk = 0;				/* d8 - d15                */
+#endif
+#endif
+	return ((OS_STK*)pStk);
+
+#elif OS_CPU_CTX_SW_METHOD == 3
+	TaskContext* pCtx = (TaskContext*)( ( (unsigned long)( ptos + 1 ) - sizeof( TaskContext ) ) & ~15UL );
+
+	/* The task stack is below the context. makecontext() only uses the top of the stack it is given. */
+	getcontext( &pCtx->uc );
+	pCtx->uc.uc_link = NULL;
+	pCtx->uc.uc_stack.ss_sp = ((INT8U*)pCtx) - TASK_MIN_STK_SIZE;
+	pCtx->uc.uc_stack.ss_size = TASK_MIN_STK_SIZE;
+	sigdelset( &pCtx->uc.uc_sigmask, SIGALRM );
+	pCtx->pFunc = task;
+	pCtx->pArgs = pdata;
+	makecontext( &pCtx->uc, (void (*)(void))TaskEntryContext, 0 );
+
+	return ((OS_STK*)pCtx);
+
+#else
 	FuncInfo* pFuncInfo = (FuncInfo*)( ((INT8U*)ptos) - sizeof( FuncInfo ) );
 	pFuncInfo->pFunc = task;
 	pFuncInfo->pArgs = pdata;
 
 	return ((OS_STK*)pFuncInfo);
+#endif
+}
+
+#if OS_CPU_CTX_SW_METHOD == 3
+/*
+*********************************************************************************************************
+*                                               TaskEntry
+*
+* Description:	First function executed by a task with the single threaded context switch. The task is started
+*				from a context switch, i.e. with interrupts disabled, so interrupts are enabled here. The alarm
+*				signal is still blocked in this thread when the first task starts.
+*
+* Arguments  :	pFunc		pointer to task function.
+*				pArgs		pointer to task data.
+*********************************************************************************************************
+*/
+static void TaskEntry( void (*pFunc)(void*), void* pArgs )
+{
+	pthread_sigmask( SIG_UNBLOCK, &setAlarm, 0 );
+	OSCPUIntEnable();
+
+	( *pFunc )( pArgs );
 }
 
+#if CTX_SW_REGS == 0
+static void TaskEntryContext( void )
+{
+	TaskContext* pCtx = (TaskContext*)OSTCBCur->OSTCBStkPtr;
+
+	TaskEntry( (void (*)(void*))pCtx->pFunc, pCtx->pArgs );
+}
+#endif
+#endif
+
 
 /*
 *********************************************************************************************************
@@ -279,7 +633,7 @@ void OSSystemReset(void)
 {
 #if OS_SYSTEM_RESET_EN > 0
 	/* Stop alarm for system reset */
-	alarm(0);
+	StopTick();
 
 	/* Call application defined system reset hook */
 	OSSystemResetHook();
@@ -313,25 +667,46 @@ void OSStartHighRdy(void)
 	OSTaskSwHook();
 	OSRunning = OS_TRUE;
 
+#if OS_CPU_CTX_SW_METHOD == 3
+	/* Start interrupts, they stay blocked until the first task runs */
+	threadRun = pthread_self();
+	InitTick();
+
+	/* This thread runs the tasks, shutdown and reset are handled by a separate supervisor thread */
+	pthread_create( &threadSupervisor, NULL, Supervisor, NULL );
+
+	/* Switch to the highest priority task. This thread carries on as the tasks and never comes back here. */
+#if CTX_SW_REGS > 0
+	OSCtxSwRegs( &pMainSp, OSTCBHighRdy->OSTCBStkPtr );
+#else
+	swapcontext( &ucMain, &((TaskContext*)OSTCBHighRdy->OSTCBStkPtr)->uc );
+#endif
+#else
 	/* Wait until all task wrappers have started */
 	pthread_mutex_lock (&mutThread);
 	if( nNumThreadsCreated != nNumThreadsStarted )
 		pthread_cond_wait (&cvThreadWrapper, &mutThread);
 	pthread_mutex_unlock (&mutThread);
 
-	/* All tasks are ready so start interrupts */
-	InitTick();
-
 	/* Get pointer highest priority thread  */
 	FuncInfo* pFuncInfo = (FuncInfo*)OSTCBCur->OSTCBStkPtr;
 
+	/* All tasks are ready so start interrupts, they go to the highest priority thread */
+	threadRun = threadTask[ pFuncInfo->nThreadIdx ];
+	InitTick();
+
 	/* Let highest prio thread go  */
+#if OS_CPU_CTX_SW_METHOD == 2
+	ThreadRun( pFuncInfo->nThreadIdx );
+#else
 	pthread_mutex_lock( &mutThread );
 	pthread_cond_signal( &grcvThread[ pFuncInfo->nThreadIdx ] );
 	pthread_mutex_unlock( &mutThread );
+#endif
 
-	/* Main thread must be kept going otherwise process turns into zombie */
-	while(1);
+	/* Main thread must be kept going otherwise process turns into zombie, sleep until shutdown */
+	Supervisor( NULL );
+#endif
 
 }
 
@@ -346,9 +721,22 @@ void OSStartHighRdy(void)
 */
 void OSIntCtxSw(void)
 {
-	/* Grab task switching mutex */
-	pthread_mutex_lock( &mutThread );
+	OSTaskSwHook();
+
+#if OS_CPU_CTX_SW_METHOD == 3
+	OS_TCB* ptcbOld = OSTCBCur;
 
+	/* Set current context to highest priority */
+	OSTCBCur = OSTCBHighRdy;
+	OSPrioCur = OSPrioHighRdy;
+
+	/* Save the registers of the current task and continue with the new task */
+#if CTX_SW_REGS > 0
+	OSCtxSwRegs( &ptcbOld->OSTCBStkPtr, OSTCBCur->OSTCBStkPtr );
+#else
+	swapcontext( &((TaskContext*)ptcbOld->OSTCBStkPtr)->uc, &((TaskContext*)OSTCBCur->OSTCBStkPtr)->uc );
+#endif
+#else
 	/* Get ptrs to new and old context */
 	FuncInfo* pFuncInfoNew = (FuncInfo*)OSTCBHighRdy->OSTCBStkPtr;
 	FuncInfo* pFuncInfoOld = (FuncInfo*)OSTCBCur->OSTCBStkPtr;
@@ -357,15 +745,96 @@ void OSIntCtxSw(void)
 	OSTCBCur = OSTCBHighRdy;
 	OSPrioCur = OSPrioHighRdy;
 
+	ThreadSwitch( pFuncInfoNew->nThreadIdx, pFuncInfoOld->nThreadIdx );
+#endif
+}
+
+#if OS_CPU_CTX_SW_METHOD != 3
+/*
+*********************************************************************************************************
+*                                           ThreadSwitch
+*
+* Description: Hands the CPU to the thread of the new task and waits until the calling thread gets it back.
+* The new thread is recorded first so the tick interrupt is sent to it. A signal that still reaches the calling
+* thread is passed on by AlarmSigHandler(), the signal mask is left alone. Called with interrupts disabled.
+*
+* Arguments  :	nThreadIdxNew	index of the thread to run.
+*				nThreadIdxOld	index of the calling thread.
+*********************************************************************************************************
+*/
+static void ThreadSwitch( int nThreadIdxNew, int nThreadIdxOld )
+{
+	__atomic_store_n( &threadRun, threadTask[ nThreadIdxNew ], __ATOMIC_RELEASE );
+
+#if OS_CPU_CTX_SW_METHOD == 2
+	/* Hand the CPU to the highest priority thread and park until a task hands it back */
+	ThreadRun( nThreadIdxNew );
+	ThreadPark( nThreadIdxOld );
+#else
+	/* Grab task switching mutex */
+	pthread_mutex_lock( &mutThread );
+
 	/* Signal highest priority thread to start by setting its condition variable */
-	pthread_cond_signal( &grcvThread[ pFuncInfoNew->nThreadIdx ] );
+	pthread_cond_signal( &grcvThread[ nThreadIdxNew ] );
 
 	/* Wait for this threads condition variable to change ( i.e. the next ctx switch ). */
-	pthread_cond_wait( &grcvThread[ pFuncInfoOld->nThreadIdx ], &mutThread );
+	pthread_cond_wait( &grcvThread[ nThreadIdxOld ], &mutThread );
 
 	/* Variable change automatically locks mutex, so unlock */
 	pthread_mutex_unlock( &mutThread );
+#endif
+}
+#endif
+
+#if OS_CPU_CTX_SW_METHOD == 2
+/*
+*********************************************************************************************************
+*                                           ThreadPark
+*
+* Description: Blocks the calling thread until another thread hands it the CPU with ThreadRun(). Returns
+* immediately if the CPU was already handed over, e.g. when the next task switched straight back to this one
+* before it got to park.
+*
+* Arguments  :	nThreadIdx	index of the calling thread.
+*********************************************************************************************************
+*/
+static void ThreadPark( int nThreadIdx )
+{
+	volatile int* pRun = &gnThreadRun[ nThreadIdx ];
+	int nState;
+
+	for(;;)
+	{
+		nState = THREAD_RUN;
+		if( __atomic_compare_exchange_n( pRun, &nState, THREAD_PARKED, 0, __ATOMIC_ACQUIRE, __ATOMIC_RELAXED ) )
+			return;
+
+		/* Announce that this thread sleeps so ThreadRun() knows to wake it */
+		if( nState == THREAD_PARKED &&
+			!__atomic_compare_exchange_n( pRun, &nState, THREAD_SLEEPING, 0, __ATOMIC_RELAXED, __ATOMIC_RELAXED ) )
+			continue;
+
+		syscall( SYS_futex, pRun, FUTEX_WAIT_PRIVATE, THREAD_SLEEPING, NULL, NULL, 0 );
+	}
+}
+
+/*
+*********************************************************************************************************
+*                                           ThreadRun
+*
+* Description: Hands the CPU to a thread. The futex is only woken when the thread is sleeping in the kernel.
+*
+* Arguments  :	nThreadIdx	index of the thread to run.
+*********************************************************************************************************
+*/
+static void ThreadRun( int nThreadIdx )
+{
+	volatile int* pRun = &gnThreadRun[ nThreadIdx ];
+
+	if( __atomic_exchange_n( pRun, THREAD_RUN, __ATOMIC_RELEASE ) == THREAD_SLEEPING )
+		syscall( SYS_futex, pRun, FUTEX_WAKE_PRIVATE, 1, NULL, NULL, 0 );
 }
+#endif
 
 /*
 *********************************************************************************************************
@@ -386,23 +855,90 @@ void OSCtxSw()
 *********************************************************************************************************
 *                                           OSTickISR
 *
-* Description: This function processes time ticks.
+* Description: This function processes time ticks. With the timerfd tick source all ticks raised by the tick
+* thread since the last interrupt are processed, so a late or merged SIGALRM does not lose ticks. The expiry of
+* the one-shot timer of OS_TIME_NS_EN and an interrupt of OSCPUIntRaise() are processed first. Called with
+* interrupts disabled.
 *
 * Arguments  : none
 *********************************************************************************************************
 */
 void OSTickISR(void)
 {
+#if OS_CPU_TICK_TIMERFD_EN > 0
+	INT32U nTicks = __atomic_exchange_n( &nTickPending, 0, __ATOMIC_ACQ_REL );
+	INT32U bRaised = __atomic_exchange_n( &bIntRaised, 0, __ATOMIC_ACQ_REL );
+#if OS_TIME_NS_EN > 0
+	INT32U bTimer = __atomic_exchange_n( &bTimerPending, 0, __ATOMIC_ACQ_REL );
+
+	/* Signal was merged with one that was already handled */
+	if( nTicks == 0 && !bTimer && !bRaised )
+		return;
+
+	OSIntEnter();
+	if( bTimer )
+		OSTimeTickNs();
+#else
+	/* Signal was merged with one that was already handled */
+	if( nTicks == 0 && !bRaised )
+		return;
+
+	OSIntEnter();
+#endif
+#if (OS_CHAN_EN > 0) && (OS_MAX_CHANS > 0)
+	if( bRaised )
+		OSChanSignal();
+#endif
+#if OS_TICKLESS_EN > 0
+	OSTimeTickN( nTicks );
+#else
+	while( nTicks-- > 0 )
+		OSTimeTick();
+#endif
+	OSIntExit();
+#else
 	OSIntEnter();
 	OSTimeTick();
 	OSIntExit();
+#endif
+}
+
+/*
+*********************************************************************************************************
+*                                           OSCPUIntEnable
+*
+* Description: Enables interrupts and runs the tick ISR for an alarm signal that arrived while they were
+* disabled. Called by OS_EXIT_CRITICAL() when an interrupt is pending and by a task when it starts.
+*
+* Arguments  : none
+*********************************************************************************************************
+*/
+void OSCPUIntEnable(void)
+{
+	for(;;)
+	{
+		OSCPUIntDisabled = 0;
+		__atomic_signal_fence( __ATOMIC_SEQ_CST );
+		if( !OSCPUIntPending )
+			return;
+
+		/* Run the pending interrupt with interrupts disabled, exactly as the signal handler does */
+		OSCPUIntDisabled = 1;
+		__atomic_signal_fence( __ATOMIC_SEQ_CST );
+		if( __atomic_exchange_n( &OSCPUIntPending, 0, __ATOMIC_RELAXED ) )
+			OSTickISR();
+	}
 }
 
 /*
 *********************************************************************************************************
 *                                           AlarmSigHandler
 *
-* Description: This function is called when ever a interrupt is delivered.
+* Description: This function is called when ever a interrupt is delivered. The tick ISR runs straight away
+* when interrupts are enabled, otherwise the interrupt is left pending for OS_EXIT_CRITICAL(). The signal is
+* not blocked while the handler runs (SA_NODEFER), a nested signal finds interrupts disabled and returns. A
+* signal delivered to a task thread that is not running, sent before a switch or directed to the process, is
+* sent on to the running task.
 *
 * Arguments  : none of these args are used.
 *********************************************************************************************************
@@ -410,23 +946,678 @@ void OSTickISR(void)
 //void AlarmSigHandler(int signo, siginfo_t* info, void* uc)
 void AlarmSigHandler( int signum )
 {
+#if OS_CPU_CTX_SW_METHOD != 3
+	if( !pthread_equal( pthread_self(), __atomic_load_n( &threadRun, __ATOMIC_ACQUIRE ) ) )
+	{
+		AlarmSend();
+		return;
+	}
+#endif
+
+	if( OSCPUIntDisabled )
+	{
+		OSCPUIntPending = 1;
+		return;
+	}
+
+	OSCPUIntDisabled = 1;
+	__atomic_signal_fence( __ATOMIC_SEQ_CST );
+	OSCPUIntPending = 0;
+
 	OSTickISR();
+
+	OSCPUIntEnable();
+}
+
+/*
+*********************************************************************************************************
+*                                           AlarmSend
+*
+* Description: Raises the tick interrupt, sends SIGALRM to the thread of the running task. Can be called from
+* any thread and from the signal handler.
+*
+* Arguments  : none
+*********************************************************************************************************
+*/
+static void AlarmSend()
+{
+	pthread_kill( __atomic_load_n( &threadRun, __ATOMIC_ACQUIRE ), SIGALRM );
 }
 
 
+/*
+*********************************************************************************************************
+*                                           OSCPUIntRaise
+*
+* Description: Raises the tick interrupt from a thread that is not a task. Only the first call after the tick
+* ISR handled the previous one sends a signal. Makes no kernel call and takes no lock. The signal is sent to the
+* running task, see AlarmSend().
+*
+* Arguments  : none
+*********************************************************************************************************
+*/
+#if OS_CPU_TICK_TIMERFD_EN > 0
+void OSCPUIntRaise(void)
+{
+	if( __atomic_exchange_n( &bIntRaised, 1, __ATOMIC_ACQ_REL ) == 0 )
+		AlarmSend();
+}
+#endif
+
+/*
+*********************************************************************************************************
+*                                           OSCPUTsGet
+*
+* Description: Returns CLOCK_MONOTONIC in nanoseconds. This is the time stamp of the task profiling and the
+* time base of the timerfd tick.
+*
+* Arguments  : none
+*********************************************************************************************************
+*/
+INT64U OSCPUTsGet(void)
+{
+	struct timespec ts;
+
+	clock_gettime( CLOCK_MONOTONIC, &ts );
+	return( (INT64U)ts.tv_sec * 1000000000ULL + (INT64U)ts.tv_nsec );
+}
+
+/*
+*********************************************************************************************************
+*                                           OSCPUTimerSet
+*
+* Description: Programs the one-shot timer of OS_TIME_NS_EN to expire at a time stamp of OSCPUTsGet(), which
+* is CLOCK_MONOTONIC like the timerfd. Called by the kernel with interrupts disabled.
+*
+* Arguments  :	ts		time stamp of the expiry, 0 to stop the timer.
+*********************************************************************************************************
+*/
+#if OS_TIME_NS_EN > 0
+void OSCPUTimerSet(INT64U ts)
+{
+	struct itimerspec its = { { 0, 0 }, { 0, 0 } };
+
+	if( fdTimer < 0 )
+		return;
+
+	its.it_value.tv_sec  = ts / 1000000000ULL;
+	its.it_value.tv_nsec = ts % 1000000000ULL;
+	timerfd_settime( fdTimer, TFD_TIMER_ABSTIME, &its, NULL );
+}
+#endif
+
+/*
+*********************************************************************************************************
+*                                           OSCPUSlabAlloc
+*
+* Description: Returns a page for the object tables of the kernel (OS_SLAB_EN) from the heap of the process.
+* The page is never freed. The allocation is done in a critical section because with OS_CPU_CTX_SW_METHOD 3 all
+* the tasks share the lock of malloc().
+*
+* Arguments  : nSize	size of the page in bytes.
+*
+* Returns    : A pointer to the page, NULL when the heap is exhausted.
+*********************************************************************************************************
+*/
+void* OSCPUSlabAlloc(INT32U nSize)
+{
+	void* pPage;
+#if OS_CRITICAL_METHOD == 3
+	OS_CPU_SR cpu_sr = 0;
+#endif
+
+	OS_ENTER_CRITICAL();
+	pPage = malloc( nSize );
+	OS_EXIT_CRITICAL();
+	return( pPage );
+}
+
+#if defined(OS_CPU_MEM_CLR)
+
+/* 16 byte vector of SSE2 or NEON. The stores are aligned, the loads of OSCPUMemCopy() may be unaligned. */
+#if defined(__SSE2__)
+typedef __m128i					MemVec;
+#define MemVecZero()			_mm_setzero_si128()
+#define MemVecLoad(p)			_mm_loadu_si128( (const __m128i*)(p) )
+#define MemVecStore(p, v)		_mm_store_si128( (__m128i*)(p), v )
+#else
+typedef uint8x16_t				MemVec;
+#define MemVecZero()			vdupq_n_u8( 0 )
+#define MemVecLoad(p)			vld1q_u8( p )
+#define MemVecStore(p, v)		vst1q_u8( p, v )
+#endif
+
+#define MEM_VEC_SIZE			16
+
+/* The port is built without optimization, the vectors would go through the stack between every load and store */
+#define MEM_VEC_OPTIMIZE		__attribute__(( optimize( "O2" ) ))
+
+/*
+*********************************************************************************************************
+*                                           OSCPUMemClr
+*
+* Description: OS_MemClr() of this port. Clears byte wise up to a 16 byte boundary, then four vectors per loop,
+* then the rest byte wise.
+*
+* Arguments  :	pDest	start of the memory to clear.
+*				nSize	number of bytes to clear.
+*********************************************************************************************************
+*/
+MEM_VEC_OPTIMIZE void OSCPUMemClr(INT8U* pDest, INT32U nSize)
+{
+	MemVec vZero = MemVecZero();
+
+	while( nSize > 0 && ( (size_t)pDest & ( MEM_VEC_SIZE - 1 ) ) != 0 )
+	{
+		*pDest++ = 0;
+		nSize--;
+	}
+
+	while( nSize >= 4 * MEM_VEC_SIZE )
+	{
+		MemVecStore( pDest, vZero );
+		MemVecStore( pDest + MEM_VEC_SIZE, vZero );
+		MemVecStore( pDest + 2 * MEM_VEC_SIZE, vZero );
+		MemVecStore( pDest + 3 * MEM_VEC_SIZE, vZero );
+		pDest += 4 * MEM_VEC_SIZE;
+		nSize -= 4 * MEM_VEC_SIZE;
+	}
+
+	while( nSize >= MEM_VEC_SIZE )
+	{
+		MemVecStore( pDest, vZero );
+		pDest += MEM_VEC_SIZE;
+		nSize -= MEM_VEC_SIZE;
+	}
+
+	while( nSize > 0 )
+	{
+		*pDest++ = 0;
+		nSize--;
+	}
+}
+
+/*
+*********************************************************************************************************
+*                                           OSCPUMemCopy
+*
+* Description: OS_MemCopy() of this port. Copies byte wise until the destination is on a 16 byte boundary, then
+* four vectors per loop with unaligned loads, so the alignment of the source does not matter, then the rest byte
+* wise. The blocks must not overlap.
+*
+* Arguments  :	pDest	start of the destination.
+*				pSrc	start of the source.
+*				nSize	number of bytes to copy.
+*********************************************************************************************************
+*/
+MEM_VEC_OPTIMIZE void OSCPUMemCopy(INT8U* pDest, INT8U* pSrc, INT32U nSize)
+{
+	MemVec v0, v1, v2, v3;
+
+	while( nSize > 0 && ( (size_t)pDest & ( MEM_VEC_SIZE - 1 ) ) != 0 )
+	{
+		*pDest++ = *pSrc++;
+		nSize--;
+	}
+
+	while( nSize >= 4 * MEM_VEC_SIZE )
+	{
+		v0 = MemVecLoad( pSrc );
+		v1 = MemVecLoad( pSrc + MEM_VEC_SIZE );
+		v2 = MemVecLoad( pSrc + 2 * MEM_VEC_SIZE );
+		v3 = MemVecLoad( pSrc + 3 * MEM_VEC_SIZE );
+		MemVecStore( pDest, v0 );
+		MemVecStore( pDest + MEM_VEC_SIZE, v1 );
+		MemVecStore( pDest + 2 * MEM_VEC_SIZE, v2 );
+		MemVecStore( pDest + 3 * MEM_VEC_SIZE, v3 );
+		pSrc += 4 * MEM_VEC_SIZE;
+		pDest += 4 * MEM_VEC_SIZE;
+		nSize -= 4 * MEM_VEC_SIZE;
+	}
+
+	while( nSize >= MEM_VEC_SIZE )
+	{
+		MemVecStore( pDest, MemVecLoad( pSrc ) );
+		pSrc += MEM_VEC_SIZE;
+		pDest += MEM_VEC_SIZE;
+		nSize -= MEM_VEC_SIZE;
+	}
+
+	while( nSize > 0 )
+	{
+		*pDest++ = *pSrc++;
+		nSize--;
+	}
+}
+
+#endif
+
+#if OS_CPU_TICK_TIMERFD_EN > 0
+
+/*
+*********************************************************************************************************
+*                                           UpdateTickStats
+*
+* Description: Accounts the ticks raised by one wakeup of the tick thread. Called from the tick thread only.
+*
+* Arguments  :	nTicks		number of ticks raised.
+*				nOverrun	number of those ticks the tick thread missed.
+*				nLateNs		time between the last tick and the tick thread waking up.
+*********************************************************************************************************
+*/
+static void UpdateTickStats( INT32U nTicks, INT32U nOverrun, INT64U nLateNs )
+{
+	INT32U nLate = ( nLateNs > 0xFFFFFFFFULL ) ? 0xFFFFFFFF : (INT32U)nLateNs;
+
+	nTickStatsSeq++;
+	__atomic_thread_fence( __ATOMIC_RELEASE );
+
+	if( bTickStatsReset )
+	{
+		bTickStatsReset = 0;
+		tickStats.OSTickCtr        = 0;
+		tickStats.OSTickOverrunCtr = 0;
+		tickStats.OSTickJitterMin  = 0xFFFFFFFF;
+		tickStats.OSTickJitterMax  = 0;
+		tickStats.OSTickJitterAvg  = 0;
+		nTickJitterSum = 0;
+		nTickJitterCnt = 0;
+	}
+
+	tickStats.OSTickCtr        += nTicks;
+	tickStats.OSTickOverrunCtr += nOverrun;
+	if( nLate < tickStats.OSTickJitterMin )
+		tickStats.OSTickJitterMin = nLate;
+	if( nLate > tickStats.OSTickJitterMax )
+		tickStats.OSTickJitterMax = nLate;
+	nTickJitterSum += nLate;
+	nTickJitterCnt++;
+	tickStats.OSTickJitterAvg = (INT32U)( nTickJitterSum / nTickJitterCnt );
+
+	__atomic_thread_fence( __ATOMIC_RELEASE );
+	nTickStatsSeq++;
+}
+
+/*
+*********************************************************************************************************
+*                                           TickThread
+*
+* Description: Waits on the tick timerfd and raises the tick interrupt. The ticks are counted from the time the
+* tick thread wakes up, not from the timerfd expiry count, so a one-shot programmed by the idle task raises every
+* tick it covered and ticks the process missed are caught up. They are added to the pending tick count for the
+* ISR. The signal is sent to the running task, see AlarmSend(), SIGALRM is blocked in this thread (inherited from
+* the main thread). With OS_TIME_NS_EN the thread waits on the one-shot timer of OSCPUTimerSet() as well.
+*
+* Arguments  : none of these args are used.
+*********************************************************************************************************
+*/
+static void* TickThread( void* pArg )
+{
+	INT64U	nExp;
+	INT64U	nNow;
+	INT64U	nTicks;
+	INT64U	nLast;
+#if OS_TIME_NS_EN > 0
+	struct pollfd	fds[ 2 ];
+
+	fds[ 0 ].fd     = fdTick;
+	fds[ 0 ].events = POLLIN;
+	fds[ 1 ].fd     = fdTimer;
+	fds[ 1 ].events = POLLIN;
+#endif
+
+	/* Wake up at the expiry, not up to the default 50us timer slack later */
+	prctl( PR_SET_TIMERSLACK, 1UL, 0, 0, 0 );
+
+	for(;;)
+	{
+#if OS_TIME_NS_EN > 0
+		if( poll( fds, 2, -1 ) <= 0 )
+			continue;
+
+		if( ( fds[ 1 ].revents & POLLIN ) && read( fdTimer, &nExp, sizeof( nExp ) ) == sizeof( nExp ) )
+		{
+			__atomic_store_n( &bTimerPending, 1, __ATOMIC_RELEASE );
+			AlarmSend();
+		}
+
+		if( !( fds[ 0 ].revents & POLLIN ) )
+			continue;
+#endif
+		if( read( fdTick, &nExp, sizeof( nExp ) ) != sizeof( nExp ) )
+			continue;
+
+		nNow = OSCPUTsGet();
+
+		pthread_mutex_lock( &mutTick );
+
+		/* Expiry of a timer setting that was replaced in the meantime */
+		if( nNow < nTickDueNs )
+		{
+			pthread_mutex_unlock( &mutTick );
+			continue;
+		}
+
+		nTicks = ( nNow - nTickDueNs ) / TICK_PERIOD_NS + 1;
+		nLast  = nTickDueNs + ( nTicks - 1 ) * TICK_PERIOD_NS;
+		UpdateTickStats( (INT32U)nTicks, ( nTicks > nTickExpected ) ? (INT32U)( nTicks - nTickExpected ) : 0,
+						 nNow - nLast );
+
+		nTickDueNs   += nTicks * TICK_PERIOD_NS;
+		nTickCnt     += nTicks;
+		nTickExpected = 1;
+		__atomic_add_fetch( &nTickPending, (INT32U)nTicks, __ATOMIC_ACQ_REL );
+
+		pthread_mutex_unlock( &mutTick );
+
+		/* Raise the tick interrupt, the running task handles it */
+		AlarmSend();
+	}
+
+	return( NULL );
+}
+
+/*
+*********************************************************************************************************
+*                                           TickArmPeriodic
+*
+* Description: Arms the timerfd as the periodic tick with the next expiry at nTickDueNs. If that time has
+* already passed the timer expires at once and the tick thread raises all ticks that were skipped. Must be
+* called with mutTick held.
+*
+* Arguments  :	nNow		current monotonic time.
+*********************************************************************************************************
+*/
+static void TickArmPeriodic( INT64U nNow )
+{
+	struct itimerspec its;
+
+	nTickExpected = ( nNow > nTickDueNs ) ? ( nNow - nTickDueNs ) / TICK_PERIOD_NS + 1 : 1;
+
+	its.it_value.tv_sec     = nTickDueNs / 1000000000ULL;
+	its.it_value.tv_nsec    = nTickDueNs % 1000000000ULL;
+	its.it_interval.tv_sec  = TICK_PERIOD_NS / 1000000000L;
+	its.it_interval.tv_nsec = TICK_PERIOD_NS % 1000000000L;
+	timerfd_settime( fdTick, TFD_TIMER_ABSTIME, &its, NULL );
+}
+
+#if OS_TICKLESS_EN > 0
+/*
+*********************************************************************************************************
+*                                           TickSuppress
+*
+* Description: Stops the periodic tick until the kernel needs the next tick. Ticks that were raised but not
+* processed by the kernel yet count towards the deadline. Called by the idle task with interrupts disabled.
+*
+* Arguments  :	nTicks		ticks from the kernel's current time to its next deadline, 0 if there is none.
+*********************************************************************************************************
+*/
+static void TickSuppress( INT32U nTicks )
+{
+	struct itimerspec its = { { 0, 0 }, { 0, 0 } };
+	INT64U nDeadline;
+	INT64U nSkip;
+	INT64U nAt;
+
+	pthread_mutex_lock( &mutTick );
+
+	nDeadline = nTickCnt - nTickPending + nTicks;
+	if( nTicks == 0 )
+	{
+		/* Nothing to wait for, only a signal from outside wakes the system up */
+		timerfd_settime( fdTick, 0, &its, NULL );
+		bTickSuppressed = OS_TRUE;
+	}
+	else if( nDeadline > nTickCnt + 1 )
+	{
+		/* One-shot at the deadline tick, it stands for all the ticks up to the deadline */
+		nSkip = nDeadline - nTickCnt;
+		nAt   = nTickDueNs + ( nSkip - 1 ) * TICK_PERIOD_NS;
+		its.it_value.tv_sec  = nAt / 1000000000ULL;
+		its.it_value.tv_nsec = nAt % 1000000000ULL;
+		timerfd_settime( fdTick, TFD_TIMER_ABSTIME, &its, NULL );
+		nTickExpected   = nSkip;
+		bTickSuppressed = OS_TRUE;
+	}
+	else if( bTickSuppressed )
+	{
+		/* The deadline is the next tick, a previous one-shot has expired so tick periodically again */
+		bTickSuppressed = OS_FALSE;
+		TickArmPeriodic( OSCPUTsGet() );
+	}
+
+	pthread_mutex_unlock( &mutTick );
+}
+
+/*
+*********************************************************************************************************
+*                                           TickResume
+*
+* Description: Restarts the periodic tick if the idle task stopped it. The phase of the tick is kept. Called
+* from OSTaskSwHook() with interrupts disabled.
+*
+* Arguments  : none
+*********************************************************************************************************
+*/
+static void TickResume()
+{
+	if( !bTickSuppressed )
+		return;
+
+	pthread_mutex_lock( &mutTick );
+	bTickSuppressed = OS_FALSE;
+	TickArmPeriodic( OSCPUTsGet() );
+	pthread_mutex_unlock( &mutTick );
+}
+
+/*
+*********************************************************************************************************
+*                                           TickIdle
+*
+* Description: Called by the idle task. Programs the tick for the next kernel deadline and waits for the tick
+* interrupt. The deadline is computed with interrupts disabled and the alarm signal blocked, sigsuspend()
+* unblocks the signal atomically, so a tick can not slip in between and leave the idle task waiting for a timer
+* that was already handled. The signal only marks the interrupt pending, it runs in OS_EXIT_CRITICAL().
+*
+* Arguments  : none
+*********************************************************************************************************
+*/
+static void TickIdle()
+{
+	INT32U nTicks;
+#if OS_TMR_EN > 0
+	INT32U nTmr;
+#endif
+	sigset_t setWait;
+	sigset_t setOld;
+#if OS_CRITICAL_METHOD == 3
+	OS_CPU_SR cpu_sr = 0;
+#endif
+
+	pthread_sigmask( SIG_BLOCK, &setAlarm, &setOld );
+	OS_ENTER_CRITICAL();
+
+	nTicks = OSTimeTickNextGet();
+#if OS_TMR_EN > 0
+	/* Ticks until the OSTmrSignal() that expires the first timer */
+	nTmr = OSTmrNextGet();
+	if( nTmr != 0 )
+	{
+		nTmr = ( nTmr - 1 ) * TMR_TICK_DIV + ( TMR_TICK_DIV - nTmrTickCtr );
+		if( nTicks == 0 || nTmr < nTicks )
+			nTicks = nTmr;
+	}
+#endif
+	TickSuppress( nTicks );
+
+	if( !OSCPUIntPending )
+	{
+		setWait = setOld;
+		sigdelset( &setWait, SIGALRM );
+		sigsuspend( &setWait );
+	}
+
+	pthread_sigmask( SIG_SETMASK, &setOld, NULL );
+	OS_EXIT_CRITICAL();
+}
+#endif
+
+/*
+*********************************************************************************************************
+*                                           OSTickStatsGet
+*
+* Description: Returns a consistent copy of the tick statistics. Can be called by any task.
+*
+* Arguments  :	pStats		structure that receives the statistics.
+*********************************************************************************************************
+*/
+void OSTickStatsGet(OS_TICK_STATS* pStats)
+{
+	INT32U nSeq;
+
+	do
+	{
+		nSeq = nTickStatsSeq;
+		__atomic_thread_fence( __ATOMIC_ACQUIRE );
+		*pStats = tickStats;
+		__atomic_thread_fence( __ATOMIC_ACQUIRE );
+	} while( ( nSeq & 1 ) || nSeq != nTickStatsSeq );
+
+	if( pStats->OSTickJitterMin == 0xFFFFFFFF )
+		pStats->OSTickJitterMin = 0;
+}
+
+/*
+*********************************************************************************************************
+*                                           OSTickStatsReset
+*
+* Description: Clears the tick statistics. The statistics are cleared by the tick thread on the next tick.
+*
+* Arguments  : none
+*********************************************************************************************************
+*/
+void OSTickStatsReset(void)
+{
+	bTickStatsReset = 1;
+}
+#endif
+
+
 /*
 *********************************************************************************************************
 *                                           InitTick
 *
-* Description: This function starts the alarm interrupt at the appropriate frequency. Note: Linux can only
-* deliver 10ms resolution on this alarm even though it is set in usecs.
+* Description: This function starts the tick interrupt at the appropriate frequency. With the timerfd tick source
+* the tick thread is created the first time and the timer is armed with an absolute start time so the tick
+* does not drift. Note: the ualarm() tick can only deliver 10ms resolution even though it is set in usecs.
 *
 * Arguments  : none
 *********************************************************************************************************
 */
 static void InitTick()
 {
-   ualarm(1000000/OS_TICKS_PER_SEC, 1000000/OS_TICKS_PER_SEC);
+#if OS_CPU_TICK_TIMERFD_EN > 0
+	struct sched_param param;
+	pthread_attr_t attr;
+	INT64U nNow;
+
+	if( fdTick < 0 )
+	{
+		fdTick = timerfd_create( CLOCK_MONOTONIC, TFD_CLOEXEC );
+		if( fdTick < 0 )
+		{
+			printf("timerfd_create failed for the tick\n" );
+			return;
+		}
+#if OS_TIME_NS_EN > 0
+		fdTimer = timerfd_create( CLOCK_MONOTONIC, TFD_CLOEXEC );
+		if( fdTimer < 0 )
+			printf("timerfd_create failed for the one-shot timer\n" );
+#endif
+
+		/* Run the tick thread at real time priority when allowed to */
+		pthread_attr_init( &attr );
+		pthread_attr_setinheritsched( &attr, PTHREAD_EXPLICIT_SCHED );
+		pthread_attr_setschedpolicy( &attr, SCHED_FIFO );
+		param.sched_priority = sched_get_priority_max( SCHED_FIFO );
+		pthread_attr_setschedparam( &attr, &param );
+		if( pthread_create( &threadTick, &attr, TickThread, NULL ) != 0 )
+			pthread_create( &threadTick, NULL, TickThread, NULL );
+		pthread_attr_destroy( &attr );
+
+		bTickStatsReset = 1;
+	}
+
+	pthread_mutex_lock( &mutTick );
+	nNow = OSCPUTsGet();
+	nTickDueNs = nNow + TICK_PERIOD_NS;
+#if OS_TICKLESS_EN > 0
+	bTickSuppressed = OS_FALSE;
+#endif
+	TickArmPeriodic( nNow );
+	pthread_mutex_unlock( &mutTick );
+#else
+	ualarm(1000000/OS_TICKS_PER_SEC, 1000000/OS_TICKS_PER_SEC);
+#endif
+}
+
+/*
+*********************************************************************************************************
+*                                           StopTick
+*
+* Description: This function stops the tick interrupt.
+*
+* Arguments  : none
+*********************************************************************************************************
+*/
+static void StopTick()
+{
+#if OS_CPU_TICK_TIMERFD_EN > 0
+	struct itimerspec its = { { 0, 0 }, { 0, 0 } };
+
+	pthread_mutex_lock( &mutTick );
+	if( fdTick >= 0 )
+		timerfd_settime( fdTick, 0, &its, NULL );
+	pthread_mutex_unlock( &mutTick );
+#else
+	ualarm(0, 0);
+#endif
+}
+
+/*
+*********************************************************************************************************
+*                                           Supervisor
+*
+* Description: Sleeps until a shutdown or reset signal is sent to the process, so the thread that called
+* OSStart() does not use any CPU time. SIGINT and SIGTERM stop the tick and terminate the process, SIGHUP calls
+* OSSystemReset() when OS_SYSTEM_RESET_EN is set and is ignored otherwise.
+*
+* Arguments  : none of these args are used.
+*********************************************************************************************************
+*/
+static void* Supervisor( void* pArg )
+{
+	siginfo_t info;
+
+	for(;;)
+	{
+		if( sigwaitinfo( &setSupervisor, &info ) < 0 )
+			continue;
+
+		if( info.si_signo == SIGHUP )
+		{
+#if OS_SYSTEM_RESET_EN > 0
+			OSSystemReset();
+#endif
+			continue;
+		}
+
+		/* Shutdown */
+		StopTick();
+		exit( EXIT_SUCCESS );
+	}
+
+	return( NULL );
 }
 
 /*
@@ -434,12 +1625,14 @@ static void InitTick()
 *                                           ThreadWrapper
 *
 * Description: 	Every Task is wrapped with this function. When the tasks thread is first created it executes
-* 				this wrapper function which stops the thread from executing.
+* 				this wrapper function which stops the thread from executing. The thread is created with the
+*				alarm signal blocked, see OSTCBInitHook(), and unblocks it once it is switched in.
 *
 * Arguments  :	pTaskInfo	Pointer to a FuncInfo structure. This structure holds the information about
 *				the task that should be exectued in this thread.
 *********************************************************************************************************
 */
+#if OS_CPU_CTX_SW_METHOD != 3
 void ThreadWrapper(void* pTaskInfo)
 {
 	/* Grab thread index */
@@ -455,19 +1648,24 @@ void ThreadWrapper(void* pTaskInfo)
 	if( nNumThreadsCreated == nNumThreadsStarted )
 		pthread_cond_signal( &cvThreadWrapper );
 
+#if OS_CPU_CTX_SW_METHOD == 2
+	/* Unlock task switching mutex and wait until this thread is handed the CPU */
+	pthread_mutex_unlock( &mutThread );
+	ThreadPark( nThreadIdx );
+#else
 	/* Wait on this threads condition variable and unlock task switching mutex */
 	pthread_cond_wait( &grcvThread[  nThreadIdx  ], &mutThread );
 	pthread_mutex_unlock( &mutThread );
+#endif
 
-	/* Unblock alarm signals. */
-	sigset_t set;
-	sigemptyset(&set);
-	sigaddset(&set, SIGALRM);
-	sigprocmask(SIG_UNBLOCK, &set, 0);
+	/* Unblock alarm signals and enable interrupts, the task was switched in with interrupts disabled. */
+	pthread_sigmask(SIG_UNBLOCK, &setAlarm, 0);
+	OSCPUIntEnable();
 
 	pF = (( FuncInfo* )( pTaskInfo ))->pFunc;
 	( *pF )( (( FuncInfo* )( pTaskInfo ))->pArgs );
 }
+#endif
 
 /*
 *********************************************************************************************************
@@ -481,9 +1679,10 @@ void ThreadWrapper(void* pTaskInfo)
 */
 void OSTCBInitHook(OS_TCB *ptcb)
 {
-#if OS_VERSION >= 204
+#if (OS_VERSION >= 204) && (OS_CPU_CTX_SW_METHOD != 3)
 	/* Grab task info that was previously stored on task stack */
 	FuncInfo* pFuncInfo = (FuncInfo*)ptcb->OSTCBStkPtr;
+	sigset_t setOld;
 
 	/* Store index of thread and condition variable on stk for use in ctx switching */
 	pFuncInfo->nThreadIdx = nNumThreadsCreated;
@@ -491,7 +1690,24 @@ void OSTCBInitHook(OS_TCB *ptcb)
 
 	/* Initialize thread condition variable and create thread */
 	pthread_cond_init(&grcvThread[ pFuncInfo->nThreadIdx ], NULL);
+
+	/* The thread inherits the signal mask of the caller, a running task has the alarm signal unblocked. The
+	   thread must start with it blocked, it would otherwise take the tick while it waits to be switched in. */
+	pthread_sigmask( SIG_BLOCK, &setAlarm, &setOld );
 	pthread_create(&threadTask[ pFuncInfo->nThreadIdx ], NULL, (void*)&ThreadWrapper, (void*)(pFuncInfo) );
+	pthread_sigmask( SIG_SETMASK, &setOld, NULL );
+
+#if OS_CPU_CTX_SW_METHOD == 1
+	/* A task created by a running task may be switched to right away. Wait until its thread waits on its
+	   condition variable, a signal sent before that would be lost. */
+	if( OSRunning == OS_TRUE )
+	{
+		pthread_mutex_lock( &mutThread );
+		while( nNumThreadsCreated != nNumThreadsStarted )
+			pthread_cond_wait( &cvThreadWrapper, &mutThread );
+		pthread_mutex_unlock( &mutThread );
+	}
+#endif
 #endif
 }
 
@@ -499,8 +1715,8 @@ void OSTCBInitHook(OS_TCB *ptcb)
 *********************************************************************************************************
 *                                           InitLinuxPort
 *
-* Description: Creates the signal handler for the alarm interrupt. Blocks all alarm signals, threads will
-* also inherit this blocking when they are created. Sets up context switching mutex.
+* Description: Creates the signal handler for the alarm interrupt. Blocks all alarm signals and the supervisor
+* signals, threads will also inherit this blocking when they are created. Sets up context switching mutex.
 *
 * Arguments  :	none
 *********************************************************************************************************
@@ -512,17 +1728,24 @@ static void InitLinuxPort()
 	sigset_t mask;
 	sigemptyset(&mask);
 
+	// The handler masks interrupts itself, see AlarmSigHandler
 	act.sa_sigaction = (void*)AlarmSigHandler;
-	act.sa_flags = 0;
+	act.sa_flags = SA_NODEFER;
 	act.sa_mask = mask;
 	if ( sigaction(SIGALRM, &act, NULL) )
 		printf("Sigaction failed for SIGALRM\n" );
 
 	//Block all signals in this the main thread. It should not call any signal handler
-	sigset_t set;
-	sigemptyset(&set);
-	sigaddset(&set, SIGALRM);
-	sigprocmask(SIG_BLOCK, &set,  0);
+	sigemptyset(&setAlarm);
+	sigaddset(&setAlarm, SIGALRM);
+	sigprocmask(SIG_BLOCK, &setAlarm,  0);
+
+	// Shutdown and reset signals are only taken by the supervisor
+	sigemptyset(&setSupervisor);
+	sigaddset(&setSupervisor, SIGINT);
+	sigaddset(&setSupervisor, SIGTERM);
+	sigaddset(&setSupervisor, SIGHUP);
+	sigprocmask(SIG_BLOCK, &setSupervisor, 0);
 
 	// Setup context switching mutex
 	pthread_mutex_init(&mutThread, NULL);
@@ -25,15 +25,22 @@
 #if 0
 
 #define  OS_MASTER_FILE                       /* Prevent the following files from including includes.h */
+#include <os_chan.c>
 #include <os_core.c>
 #include <os_flag.c>
+#include <os_intq.c>
 #include <os_mbox.c>
 #include <os_mem.c>
 #include <os_mutex.c>
 #include <os_q.c>
+#include <os_ring.c>
 #include <os_sem.c>
+#include <os_set.c>
+#include <os_slab.c>
+#include <os_stat.c>
 #include <os_task.c>
 #include <os_time.c>
 #include <os_tmr.c>
+#include <os_topic.c>
 
 #endif
@@ -78,7 +78,10 @@ extern "C" {
 #define  OS_TASK_STAT_PRIO  (OS_LOWEST_PRIO - 1)        /* Statistic task priority                     */
 #define  OS_TASK_IDLE_PRIO  (OS_LOWEST_PRIO)            /* IDLE      task priority                     */
 
-#if OS_LOWEST_PRIO <= 63
+#if OS_SCHED_CTZ_EN > 0
+#define  OS_EVENT_TBL_SIZE ((OS_LOWEST_PRIO) / 64 + 1)  /* Size of event table                         */
+#define  OS_RDY_TBL_SIZE   ((OS_LOWEST_PRIO) / 64 + 1)  /* Size of ready table                         */
+#elif OS_LOWEST_PRIO <= 63
 #define  OS_EVENT_TBL_SIZE ((OS_LOWEST_PRIO) / 8 + 1)   /* Size of event table                         */
 #define  OS_RDY_TBL_SIZE   ((OS_LOWEST_PRIO) / 8 + 1)   /* Size of ready table                         */
 #else
@@ -89,11 +92,25 @@ extern "C" {
 #define  OS_TASK_IDLE_ID          65535u                /* ID numbers for Idle, Stat and Timer tasks   */
 #define  OS_TASK_STAT_ID          65534u
 #define  OS_TASK_TMR_ID           65533u
+#define  OS_TASK_INT_Q_ID         65532u
 
-#define  OS_EVENT_EN           (((OS_Q_EN > 0) && (OS_MAX_QS > 0)) || (OS_MBOX_EN > 0) || (OS_SEM_EN > 0) || (OS_MUTEX_EN > 0))
+#define  OS_EVENT_EN           (((OS_Q_EN > 0) && (OS_MAX_QS > 0)) || (OS_MBOX_EN > 0) || (OS_SEM_EN > 0) || (OS_MUTEX_EN > 0) || \
+                                ((OS_RING_EN > 0) && (OS_MAX_RINGS > 0)) || ((OS_CHAN_EN > 0) && (OS_MAX_CHANS > 0)))
 
 #define  OS_TCB_RESERVED        ((OS_TCB *)1)
 
+#if OS_TIME_NS_EN > 0                                   /* Nanoseconds <-> time stamps of OSCPUTsGet() */
+#if OS_CPU_TS_FREQ == 1000000000uLL
+#define  OS_TIME_NS_TO_TS(ns)   (ns)
+#define  OS_TIME_TS_TO_NS(ts)   (ts)
+#else
+#define  OS_TIME_NS_TO_TS(ns)   (((ns) / 1000000000uLL) * OS_CPU_TS_FREQ                               \
+                                 + (((ns) % 1000000000uLL) * OS_CPU_TS_FREQ) / 1000000000uLL)
+#define  OS_TIME_TS_TO_NS(ts)   (((ts) / OS_CPU_TS_FREQ) * 1000000000uLL                               \
+                                 + (((ts) % OS_CPU_TS_FREQ) * 1000000000uLL) / OS_CPU_TS_FREQ)
+#endif
+#endif
+
 /*$PAGE*/
 /*
 *********************************************************************************************************
@@ -103,13 +120,14 @@ extern "C" {
 #define  OS_STAT_RDY               0x00u    /* Ready to run                                            */
 #define  OS_STAT_SEM               0x01u    /* Pending on semaphore                                    */
 #define  OS_STAT_MBOX              0x02u    /* Pending on mailbox                                      */
-#define  OS_STAT_Q                 0x04u    /* Pending on queue                                        */
+#define  OS_STAT_Q                 0x04u    /* Pending on queue or byte ring                           */
 #define  OS_STAT_SUSPEND           0x08u    /* Task is suspended                                       */
 #define  OS_STAT_MUTEX             0x10u    /* Pending on mutual exclusion semaphore                   */
 #define  OS_STAT_FLAG              0x20u    /* Pending on event flag group                             */
+#define  OS_STAT_SET               0x40u    /* Pending on event set                                    */
 #define  OS_STAT_MULTI             0x80u    /* Pending on multiple events                              */
 
-#define  OS_STAT_PEND_ANY         (OS_STAT_SEM | OS_STAT_MBOX | OS_STAT_Q | OS_STAT_MUTEX | OS_STAT_FLAG)
+#define  OS_STAT_PEND_ANY         (OS_STAT_SEM | OS_STAT_MBOX | OS_STAT_Q | OS_STAT_MUTEX | OS_STAT_FLAG | OS_STAT_SET)
 
 /*
 *********************************************************************************************************
@@ -131,6 +149,10 @@ extern "C" {
 #define  OS_EVENT_TYPE_SEM            3u
 #define  OS_EVENT_TYPE_MUTEX          4u
 #define  OS_EVENT_TYPE_FLAG           5u
+#define  OS_EVENT_TYPE_SET            6u
+#define  OS_EVENT_TYPE_RING           7u
+#define  OS_EVENT_TYPE_CHAN           8u
+#define  OS_EVENT_TYPE_TOPIC          9u
 
 #define  OS_TMR_TYPE                100u    /* Used to identify Timers ...                             */
                                             /* ... (Must be different value than OS_EVENT_TYPE_xxx)    */
@@ -181,6 +203,15 @@ extern "C" {
 #define  OS_DEL_NO_PEND               0u
 #define  OS_DEL_ALWAYS                1u
 
+/*
+*********************************************************************************************************
+*                                 MUTEX OPTIONS (see OSMutexCreateExt())
+*********************************************************************************************************
+*/
+#define  OS_MUTEX_OPT_PIP             0u    /* Raise the owner to the PIP reserved for the mutex       */
+#define  OS_MUTEX_OPT_CEILING         1u    /* Immediate priority ceiling, no priority reserved        */
+#define  OS_MUTEX_OPT_INHERIT         2u    /* Transitive priority inheritance                         */
+
 /*
 *********************************************************************************************************
 *                                        OS???Pend() OPTIONS
@@ -202,6 +233,15 @@ extern "C" {
 #define  OS_POST_OPT_BROADCAST     0x01u    /* Broadcast message to ALL tasks waiting                  */
 #define  OS_POST_OPT_FRONT         0x02u    /* Post to highest priority task waiting                   */
 #define  OS_POST_OPT_NO_SCHED      0x04u    /* Do not call the scheduler if this option is selected    */
+#define  OS_POST_OPT_REF           0x08u    /* Reference counted message of OSTopicPublish()           */
+
+/*
+*********************************************************************************************************
+*                              OSEventProfGet() AND OSFlagProfGet() OPTIONS
+*********************************************************************************************************
+*/
+#define  OS_PROF_OPT_NONE             0u    /* Read the statistics                                     */
+#define  OS_PROF_OPT_CLR              1u    /* Read the statistics and clear them                      */
 
 /*
 *********************************************************************************************************
@@ -213,6 +253,27 @@ extern "C" {
 #define  OS_TASK_OPT_STK_CLR     0x0002u    /* Clear the stack when the task is create                 */
 #define  OS_TASK_OPT_SAVE_FP     0x0004u    /* Save the contents of any floating-point registers       */
 
+/*
+*********************************************************************************************************
+*                                       TASK STACK CHECKING
+*
+* Note(s): 1) The incremental check of the statistic task scans a stack from the last high-water mark
+*             towards its end and stops after OS_TASK_STK_CHK_RUN free (zero) entries in a row.
+*          2) With OS_TASK_STK_CANARY_EN the last OS_TASK_STK_CANARY_SIZE entries of a stack created with
+*             OS_TASK_OPT_STK_CHK hold OS_TASK_STK_CANARY, they are not counted as free.
+*********************************************************************************************************
+*/
+
+#define  OS_TASK_STK_CHK_RUN           8u    /* Free entries in a row that end an incremental scan      */
+
+#if OS_TASK_STK_CANARY_EN > 0
+#define  OS_TASK_STK_CANARY  ((OS_STK)0xC0DEFACEu)  /* Value of the guard entries                      */
+#define  OS_TASK_STK_CANARY_SIZE       4u    /* Number of guard entries at the end of a stack           */
+#define  OS_TASK_STK_GUARD(size)    (((size) > OS_TASK_STK_CANARY_SIZE) ? OS_TASK_STK_CANARY_SIZE : 0u)
+#else
+#define  OS_TASK_STK_GUARD(size)       0u
+#endif
+
 /*
 *********************************************************************************************************
 *                            TIMER OPTIONS (see OSTmrStart() and OSTmrStop())
@@ -266,6 +327,7 @@ extern "C" {
 
 #define OS_ERR_Q_FULL                30u
 #define OS_ERR_Q_EMPTY               31u
+#define OS_ERR_Q_PRIO_INVALID        32u
 
 #define OS_ERR_PRIO_EXIST            40u
 #define OS_ERR_PRIO                  41u
@@ -332,6 +394,33 @@ extern "C" {
 #define OS_ERR_TMR_STOPPED          142u
 #define OS_ERR_TMR_NO_CALLBACK      143u
 
+#define OS_ERR_SET_FULL             150u
+#define OS_ERR_SET_MEMBER           151u
+#define OS_ERR_SET_NOT_MEMBER       152u
+
+#define OS_ERR_INT_Q_FULL           160u
+#define OS_ERR_INT_Q_DEPLETED       161u
+#define OS_ERR_INT_Q_INVALID        162u
+#define OS_ERR_INT_Q_SIZE           163u
+
+#define OS_ERR_RING_FULL            170u
+#define OS_ERR_RING_EMPTY           171u
+#define OS_ERR_RING_SIZE            172u
+#define OS_ERR_RING_INVALID         173u
+#define OS_ERR_RING_DEPLETED        174u
+
+#define OS_ERR_CHAN_FULL            180u
+#define OS_ERR_CHAN_EMPTY           181u
+#define OS_ERR_CHAN_DEPLETED        182u
+#define OS_ERR_CHAN_INVALID         183u
+#define OS_ERR_CHAN_SIZE            184u
+
+#define OS_ERR_TOPIC_INVALID        190u
+#define OS_ERR_TOPIC_DEPLETED       191u
+#define OS_ERR_TOPIC_FULL           192u
+#define OS_ERR_TOPIC_SUB            193u
+#define OS_ERR_TOPIC_NOT_SUB        194u
+
 /*
 *********************************************************************************************************
 *                                    OLD ERROR CODE NAMES (< V2.84)
@@ -381,6 +470,55 @@ extern "C" {
 /*$PAGE*/
 /*
 *********************************************************************************************************
+*                                      READY LIST AND WAIT LIST TYPES
+*
+* Note(s): The ready list and the event wait lists are a table with one bit per priority and a group with
+*          one bit per table entry.  With OS_SCHED_CTZ_EN the table entries are 64-bit words which are
+*          searched with OS_CPU_CTZ() instead of OSUnMapTbl[], 256 priorities take 4 entries.
+*********************************************************************************************************
+*/
+
+#if OS_SCHED_CTZ_EN > 0
+typedef  INT8U    OS_PRIO_GRP;              /* Ready or wait group, one bit per table entry            */
+typedef  INT64U   OS_PRIO_TBL;              /* Ready or wait table entry, one bit per priority         */
+#elif OS_LOWEST_PRIO <= 63
+typedef  INT8U    OS_PRIO_GRP;
+typedef  INT8U    OS_PRIO_TBL;
+#else
+typedef  INT16U   OS_PRIO_GRP;
+typedef  INT16U   OS_PRIO_TBL;
+#endif
+
+/*
+*********************************************************************************************************
+*                                       KERNEL OBJECT STATISTICS
+*
+* Note(s): 1) The times are in OSCPUTsGet() units.  Bucket n of a histogram counts the times t with
+*             2^n <= t < 2^(n+1), bucket 0 also counts 0 and the last bucket every longer time.
+*          2) A pend blocks from the time the task is put in the wait list until it is made ready by a
+*             post, a timeout or an abort.  The wakeup time goes from the post until the task runs.
+*          3) OSDepthMax is the highest count of a semaphore and the most messages held by a mailbox or
+*             a queue after a post, it stays 0 for mutexes and event flag groups.
+*********************************************************************************************************
+*/
+
+#if OS_EVENT_PROF_EN > 0
+typedef struct os_event_prof {
+    INT32U   OSPostCtr;                      /* Number of posts                                         */
+    INT32U   OSPendCtr;                      /* Number of pends                                         */
+    INT32U   OSPendBlockCtr;                 /* Number of pends that blocked the task                   */
+    INT32U   OSPendTOCtr;                    /* Number of pends that timed out                          */
+    INT32U   OSDepthMax;                     /* Highest count or number of messages (see Note #3)       */
+    INT32U   OSBlockMax;                     /* Longest time a pend blocked                             */
+    INT32U   OSWakeMax;                      /* Longest time from a post until the task ran             */
+    INT32U   OSBlockHist[OS_EVENT_PROF_BINS];   /* Histogram of the blocked times (see Note #1)         */
+    INT32U   OSWakeHist[OS_EVENT_PROF_BINS];    /* Histogram of the wakeup times                        */
+} OS_EVENT_PROF;
+#endif
+
+/*$PAGE*/
+/*
+*********************************************************************************************************
 *                                          EVENT CONTROL BLOCK
 *********************************************************************************************************
 */
@@ -390,12 +528,30 @@ typedef struct os_event {
     INT8U    OSEventType;                    /* Type of event control block (see OS_EVENT_TYPE_xxxx)    */
     void    *OSEventPtr;                     /* Pointer to message or queue structure                   */
     INT16U   OSEventCnt;                     /* Semaphore Count (not used if other EVENT type)          */
-#if OS_LOWEST_PRIO <= 63
-    INT8U    OSEventGrp;                     /* Group corresponding to tasks waiting for event to occur */
-    INT8U    OSEventTbl[OS_EVENT_TBL_SIZE];  /* List of tasks waiting for event to occur                */
-#else
-    INT16U   OSEventGrp;                     /* Group corresponding to tasks waiting for event to occur */
-    INT16U   OSEventTbl[OS_EVENT_TBL_SIZE];  /* List of tasks waiting for event to occur                */
+    OS_PRIO_GRP  OSEventGrp;                 /* Group corresponding to tasks waiting for event to occur */
+    OS_PRIO_TBL  OSEventTbl[OS_EVENT_TBL_SIZE]; /* List of tasks waiting for event to occur             */
+
+#if (OS_SET_EN > 0) && (OS_MAX_SETS > 0)
+    struct os_event *OSEventSetPtr;          /* Event set the event is a member of (see OSSetAdd())     */
+    INT8U    OSEventSetBit;                  /* Bit of the event in the ready bitmap of the set         */
+#endif
+
+#if OS_MUTEX_EN > 0
+#if OS_MUTEX_PROTOCOL_EN > 0
+    struct os_event *OSEventMutexNext;       /* Next mutex held by the owner (see OSTCBMutexList)       */
+    INT8U    OSEventMutexOpt;                /* Protocol of the mutex (see OS_MUTEX_OPT_xxx)            */
+#endif
+#if OS_MUTEX_STAT_EN > 0
+    INT64U   OSEventMutexTs;                 /* Time stamp of the last lock (OSCPUTsGet())              */
+    INT64U   OSEventMutexHoldTot;            /* Total time the mutex was held                           */
+    INT32U   OSEventMutexHoldMax;            /* Longest time the mutex was held                         */
+    INT32U   OSEventMutexLockCtr;            /* Number of times the mutex was locked                    */
+    INT32U   OSEventMutexContCtr;            /* Number of times the mutex was found locked              */
+#endif
+#endif
+
+#if OS_EVENT_PROF_EN > 0
+    OS_EVENT_PROF OSEventProf;               /* Pend and post statistics                                */
 #endif
 
 #if OS_EVENT_NAME_SIZE > 1
@@ -430,6 +586,9 @@ typedef struct os_flag_grp {                /* Event Flag Group
     INT8U         OSFlagType;               /* Should be set to OS_EVENT_TYPE_FLAG                     */
     void         *OSFlagWaitList;           /* Pointer to first NODE of task waiting on event flag     */
     OS_FLAGS      OSFlagFlags;              /* 8, 16 or 32 bit flags                                   */
+#if OS_EVENT_PROF_EN > 0
+    OS_EVENT_PROF OSFlagProf;               /* Pend and post statistics                                */
+#endif
 #if OS_FLAG_NAME_SIZE > 1
     INT8U         OSFlagName[OS_FLAG_NAME_SIZE];
 #endif
@@ -451,6 +610,67 @@ typedef struct os_flag_node {               /* Event Flag Wait List Node
 } OS_FLAG_NODE;
 #endif
 
+/*$PAGE*/
+/*
+*********************************************************************************************************
+*                                       ISR DEFERRED POST QUEUES
+*
+* Note(s): 1) An interrupt queue is a ring written by one ISR and read by OS_TaskIntQ(), OSIntQIn is only
+*             written by the ISR and OSIntQOut only by the task so neither side needs a critical section.
+*********************************************************************************************************
+*/
+
+#if (OS_INT_Q_EN > 0) && (OS_MAX_INT_QS > 0)
+typedef struct os_int_q_entry {             /* Post deferred by an ISR                                 */
+    void         *OSIntQObj;                /* Pointer to the ECB or event flag group to post to       */
+    void         *OSIntQMsg;                /* Message to post to a mailbox or a queue                 */
+#if (OS_FLAG_EN > 0) && (OS_MAX_FLAGS > 0)
+    OS_FLAGS      OSIntQFlags;              /* Flags to set or clear in an event flag group            */
+#endif
+    INT8U         OSIntQOpt;                /* Option of the post (OS_POST_OPT_xxx, OS_FLAG_SET/CLR)   */
+    INT8U         OSIntQType;               /* Type of the object (see OS_EVENT_TYPE_xxxx)             */
+} OS_INT_Q_ENTRY;
+
+
+typedef struct os_int_q {                   /* INTERRUPT QUEUE CONTROL BLOCK                           */
+    OS_INT_Q_ENTRY  *OSIntQStart;           /* Pointer to the storage of the ring                      */
+    INT16U           OSIntQSize;            /* Number of entries of the ring, one is always left empty */
+    volatile INT16U  OSIntQIn;              /* Next entry the ISR writes                               */
+    volatile INT16U  OSIntQOut;             /* Next entry the task posts                               */
+    INT16U           OSIntQMax;             /* Most entries that were ever waiting                     */
+    INT32U           OSIntQOvfCtr;          /* Number of posts lost because the ring was full          */
+    INT32U           OSIntQErrCtr;          /* Number of deferred posts that returned an error         */
+} OS_INT_Q;
+#endif
+
+/*
+*********************************************************************************************************
+*                                         NATIVE THREAD CHANNELS
+*
+* Note(s): 1) A channel is a ring of messages written by one thread that is not a task and read by the
+*             tasks.  OSChanIn is only written by the producer and OSChanOut only by the kernel, the
+*             producer takes no critical section and makes no kernel call.
+*
+*          2) A task that waits on an empty channel sets OSChanWaiting.  The producer that clears it puts
+*             the channel on OSChanSigList and raises the tick interrupt with OSCPUIntRaise(), the ISR
+*             readies the waiting tasks with OSChanSignal().  OSChanSig is set while the channel is on the
+*             list so it is never put on it twice.
+*********************************************************************************************************
+*/
+
+#if (OS_CHAN_EN > 0) && (OS_MAX_CHANS > 0)
+typedef struct os_chan {                    /* NATIVE THREAD CHANNEL CONTROL BLOCK                     */
+    void           **OSChanStart;           /* Pointer to the storage of the ring                      */
+    INT16U           OSChanSize;            /* Number of entries of the ring, one is always left empty */
+    volatile INT16U  OSChanIn;              /* Next entry the producer writes                          */
+    volatile INT16U  OSChanOut;             /* Next entry the tasks read                               */
+    volatile INT8U   OSChanWaiting;         /* Tasks wait for a message (Note #2)                      */
+    volatile INT8U   OSChanSig;             /* Channel is on OSChanSigList (Note #2)                   */
+    struct os_chan  *OSChanSigNext;         /* Next channel of OSChanSigList                           */
+    OS_EVENT         OSChanEvent;           /* Wait list of the tasks waiting for a message            */
+} OS_CHAN;
+#endif
+
 /*$PAGE*/
 /*
 *********************************************************************************************************
@@ -461,13 +681,8 @@ typedef struct os_flag_node {               /* Event Flag Wait List Node
 #if OS_MBOX_EN > 0
 typedef struct os_mbox_data {
     void   *OSMsg;                         /* Pointer to message in mailbox                            */
-#if OS_LOWEST_PRIO <= 63
-    INT8U   OSEventTbl[OS_EVENT_TBL_SIZE]; /* List of tasks waiting for event to occur                 */
-    INT8U   OSEventGrp;                    /* Group corresponding to tasks waiting for event to occur  */
-#else
-    INT16U  OSEventTbl[OS_EVENT_TBL_SIZE]; /* List of tasks waiting for event to occur                 */
-    INT16U  OSEventGrp;                    /* Group corresponding to tasks waiting for event to occur  */
-#endif
+    OS_PRIO_TBL OSEventTbl[OS_EVENT_TBL_SIZE]; /* List of tasks waiting for event to occur             */
+    OS_PRIO_GRP OSEventGrp;                /* Group corresponding to tasks waiting for event to occur  */
 } OS_MBOX_DATA;
 #endif
 
@@ -509,16 +724,20 @@ typedef struct os_mem_data {
 
 #if OS_MUTEX_EN > 0
 typedef struct os_mutex_data {
-#if OS_LOWEST_PRIO <= 63
-    INT8U   OSEventTbl[OS_EVENT_TBL_SIZE];  /* List of tasks waiting for event to occur                */
-    INT8U   OSEventGrp;                     /* Group corresponding to tasks waiting for event to occur */
-#else
-    INT16U  OSEventTbl[OS_EVENT_TBL_SIZE];  /* List of tasks waiting for event to occur                */
-    INT16U  OSEventGrp;                     /* Group corresponding to tasks waiting for event to occur */
-#endif
+    OS_PRIO_TBL OSEventTbl[OS_EVENT_TBL_SIZE]; /* List of tasks waiting for event to occur             */
+    OS_PRIO_GRP OSEventGrp;                 /* Group corresponding to tasks waiting for event to occur */
     BOOLEAN OSValue;                        /* Mutex value (OS_FALSE = used, OS_TRUE = available)      */
     INT8U   OSOwnerPrio;                    /* Mutex owner's task priority or 0xFF if no owner         */
     INT8U   OSMutexPIP;                     /* Priority Inheritance Priority or 0xFF if no owner       */
+#if OS_MUTEX_PROTOCOL_EN > 0
+    INT8U   OSMutexOpt;                     /* Protocol of the mutex (see OS_MUTEX_OPT_xxx)            */
+#endif
+#if OS_MUTEX_STAT_EN > 0
+    INT32U  OSLockCtr;                      /* Number of times the mutex was locked                    */
+    INT32U  OSContCtr;                      /* Number of times the mutex was found locked              */
+    INT64U  OSHoldTimeTot;                  /* Total time the mutex was held (OSCPUTsGet() units)      */
+    INT32U  OSHoldTimeMax;                  /* Longest time the mutex was held                         */
+#endif
 } OS_MUTEX_DATA;
 #endif
 
@@ -529,6 +748,13 @@ typedef struct os_mutex_data {
 */
 
 #if OS_Q_EN > 0
+#if OS_Q_PRIO_EN > 0
+typedef struct os_q_msg {               /* ENTRY OF A PRIORITY QUEUE                                   */
+    struct os_q_msg *OSQMsgNext;        /* Next message of the same priority, or next free entry       */
+    void          *OSQMsgPtr;           /* Message                                                     */
+} OS_Q_MSG;
+#endif
+
 typedef struct os_q {                   /* QUEUE CONTROL BLOCK                                         */
     struct os_q   *OSQPtr;              /* Link to next queue control block in list of free blocks     */
     void         **OSQStart;            /* Pointer to start of queue data                              */
@@ -537,6 +763,14 @@ typedef struct os_q {                   /* QUEUE CONTROL BLOCK
     void         **OSQOut;              /* Pointer to where next message will be extracted from the Q  */
     INT16U         OSQSize;             /* Size of queue (maximum number of entries)                   */
     INT16U         OSQEntries;          /* Current number of entries in the queue                      */
+#if OS_Q_PRIO_EN > 0
+    BOOLEAN        OSQPrio;             /* OS_TRUE for a priority queue of OSQCreatePrio()             */
+    INT8U          OSQPrioGrp;          /* Bit 'p' is set when priority 'p' has messages               */
+    INT16U         OSQPrioEntries[OS_Q_PRIO_LEVELS];  /* Number of messages of each priority          */
+    OS_Q_MSG      *OSQPrioHead[OS_Q_PRIO_LEVELS];     /* Oldest message of each priority              */
+    OS_Q_MSG      *OSQPrioTail[OS_Q_PRIO_LEVELS];     /* Newest message of each priority              */
+    OS_Q_MSG      *OSQPrioFree;         /* List of free entries of a priority queue                    */
+#endif
 } OS_Q;
 
 
@@ -544,16 +778,57 @@ typedef struct os_q_data {
     void          *OSMsg;               /* Pointer to next message to be extracted from queue          */
     INT16U         OSNMsgs;             /* Number of messages in message queue                         */
     INT16U         OSQSize;             /* Size of message queue                                       */
-#if OS_LOWEST_PRIO <= 63
-    INT8U          OSEventTbl[OS_EVENT_TBL_SIZE];  /* List of tasks waiting for event to occur         */
-    INT8U          OSEventGrp;          /* Group corresponding to tasks waiting for event to occur     */
-#else
-    INT16U         OSEventTbl[OS_EVENT_TBL_SIZE];  /* List of tasks waiting for event to occur         */
-    INT16U         OSEventGrp;          /* Group corresponding to tasks waiting for event to occur     */
+#if OS_Q_PRIO_EN > 0
+    INT16U         OSNMsgsPrio[OS_Q_PRIO_LEVELS];  /* Number of messages of each priority              */
 #endif
+    OS_PRIO_TBL    OSEventTbl[OS_EVENT_TBL_SIZE];  /* List of tasks waiting for event to occur         */
+    OS_PRIO_GRP    OSEventGrp;          /* Group corresponding to tasks waiting for event to occur     */
 } OS_Q_DATA;
 #endif
 
+/*
+*********************************************************************************************************
+*                                        BYTE RING CONTROL BLOCK
+*
+* Note(s): 1) Every message of a byte ring starts with an OS_RING_HDR at a multiple of OS_RING_ALIGN.  The
+*             low bits of OSRingHdrSize hold the state of the message, the other bits the size of the slot
+*             including the header and the padding.  A wrap record fills the end of the storage when the
+*             next message did not fit there.
+*
+*          2) The messages from OSRingOut to OSRingRd are being read or released but not reclaimed yet, the
+*             messages from OSRingRd to OSRingIn are reserved or committed.  The tasks waiting for messages
+*             are in the wait list of the ECB of the ring, the tasks waiting for space in OSRingSpace.
+*********************************************************************************************************
+*/
+
+#if (OS_RING_EN > 0) && (OS_MAX_RINGS > 0)
+#define  OS_RING_ALIGN                8u    /* Alignment of the messages, must be >= sizeof(OS_RING_HDR)*/
+
+#define  OS_RING_REC_RESERVED         0u    /* States of a message, see OS_RING_HDR                    */
+#define  OS_RING_REC_COMMITTED        1u
+#define  OS_RING_REC_READING          2u
+#define  OS_RING_REC_FREE             3u
+#define  OS_RING_REC_WRAP             4u
+#define  OS_RING_REC_MSK              7u
+
+typedef struct os_ring_hdr {                /* BYTE RING MESSAGE HEADER                                */
+    INT32U          OSRingHdrSize;          /* Size of the slot and state of the message (Note #1)     */
+    INT32U          OSRingHdrLen;           /* Length of the message, reserved length until committed  */
+} OS_RING_HDR;
+
+typedef struct os_ring {                    /* BYTE RING CONTROL BLOCK                                 */
+    struct os_ring *OSRingPtr;              /* Link to next byte ring control block in the free list   */
+    INT8U          *OSRingStart;            /* Pointer to the storage, aligned on OS_RING_ALIGN        */
+    INT32U          OSRingSize;             /* Size of the storage, multiple of OS_RING_ALIGN          */
+    INT32U          OSRingUsed;             /* Bytes from OSRingOut to OSRingIn, wrap records included */
+    INT32U          OSRingIn;               /* Offset of the next message reserved                     */
+    INT32U          OSRingRd;               /* Offset of the next message given to a consumer          */
+    INT32U          OSRingOut;              /* Offset of the oldest message not reclaimed              */
+    INT32U          OSRingRdCnt;            /* Number of messages from OSRingRd to OSRingIn            */
+    OS_EVENT        OSRingSpace;            /* Wait list of the tasks waiting for space (Note #2)      */
+} OS_RING;
+#endif
+
 /*
 *********************************************************************************************************
 *                                           SEMAPHORE DATA
@@ -563,14 +838,61 @@ typedef struct os_q_data {
 #if OS_SEM_EN > 0
 typedef struct os_sem_data {
     INT16U  OSCnt;                          /* Semaphore count                                         */
-#if OS_LOWEST_PRIO <= 63
-    INT8U   OSEventTbl[OS_EVENT_TBL_SIZE];  /* List of tasks waiting for event to occur                */
-    INT8U   OSEventGrp;                     /* Group corresponding to tasks waiting for event to occur */
+    OS_PRIO_TBL OSEventTbl[OS_EVENT_TBL_SIZE]; /* List of tasks waiting for event to occur             */
+    OS_PRIO_GRP OSEventGrp;                 /* Group corresponding to tasks waiting for event to occur */
+} OS_SEM_DATA;
+#endif
+
+/*
+*********************************************************************************************************
+*                                         EVENT SET CONTROL BLOCK
+*
+* Note(s): The semaphores, mailboxes and queues added to an event set stay members until they are removed.
+*          A post to a member sets the bit of the member in OSSetRdy, a pend on the set returns the members
+*          whose bit is set and that still have a count or a message.
+*********************************************************************************************************
+*/
+
+#if (OS_SET_EN > 0) && (OS_MAX_SETS > 0)
+
+#if OS_SET_SIZE > 32
+typedef  INT64U   OS_SET_BITS;              /* One bit per member of an event set                      */
 #else
-    INT16U  OSEventTbl[OS_EVENT_TBL_SIZE];  /* List of tasks waiting for event to occur                */
-    INT16U  OSEventGrp;                     /* Group corresponding to tasks waiting for event to occur */
+typedef  INT32U   OS_SET_BITS;
+#endif
+
+typedef struct os_set {                     /* EVENT SET CONTROL BLOCK                                 */
+    struct os_set *OSSetPtr;                /* Link to next event set control block in the free list   */
+    OS_SET_BITS    OSSetUsed;               /* Bits of the members                                     */
+    OS_SET_BITS    OSSetRdy;                /* Bits of the members posted to since they were empty     */
+    OS_EVENT      *OSSetTbl[OS_SET_SIZE];   /* Members, indexed by their bit                           */
+} OS_SET;
+#endif
+
+/*
+*********************************************************************************************************
+*                                    PUBLISH/SUBSCRIBE TOPIC CONTROL BLOCK
+*
+* Note(s): The queues subscribed to a topic stay subscribed until they unsubscribe or the topic is deleted.
+*          A reference counted message is a block of a memory partition that starts with an OS_TOPIC_MSG,
+*          the message posted is the space after it.
+*********************************************************************************************************
+*/
+
+#if (OS_TOPIC_EN > 0) && (OS_MAX_TOPICS > 0)
+typedef struct os_topic {                   /* PUBLISH/SUBSCRIBE TOPIC CONTROL BLOCK                   */
+    struct os_topic *OSTopicPtr;            /* Link to next topic control block in the free list       */
+    INT8U          OSTopicType;             /* Should be set to OS_EVENT_TYPE_TOPIC                    */
+    INT8U          OSTopicSubCnt;           /* Number of queues subscribed                             */
+    OS_EVENT      *OSTopicSubTbl[OS_TOPIC_SUBS];  /* Queues subscribed, in the order they subscribed   */
+} OS_TOPIC;
+
+#if OS_TOPIC_REF_EN > 0
+typedef struct os_topic_msg {               /* HEADER OF A REFERENCE COUNTED MESSAGE                   */
+    OS_MEM        *OSTopicMsgMem;           /* Partition the block goes back to                        */
+    INT16U         OSTopicMsgRefs;          /* Number of subscribers that did not release the message  */
+} OS_TOPIC_MSG;
 #endif
-} OS_SEM_DATA;
 #endif
 
 /*
@@ -586,6 +908,62 @@ typedef struct os_stk_data {
 } OS_STK_DATA;
 #endif
 
+/*
+*********************************************************************************************************
+*                                            LOAD STATISTICS
+*
+* Note(s): 1) Times are in units of OSCPUTsGet(), OS_CPU_TS_FREQ per second.
+*          2) The period values are computed by the statistic task every 1/10 second.  The load averages
+*             are exponential moving averages of them with a time constant of 1, 10 and 60 seconds.
+*          3) The time spent in ISRs is not charged to the interrupted task, the CPU load includes it.
+*********************************************************************************************************
+*/
+
+#if OS_STAT_EN > 0
+#define  OS_STAT_LOAD_1S             0u    /* Indexes of the load averages                             */
+#define  OS_STAT_LOAD_10S            1u
+#define  OS_STAT_LOAD_60S            2u
+#define  OS_STAT_LOAD_NBR            3u
+
+#define  OS_STAT_FSHIFT             11u    /* Fraction bits of the load averages kept by the kernel    */
+
+typedef struct os_stat_data {
+    INT16U  OSCPUUsage;                     /* CPU load over the last period (units are 0.01 %)        */
+    INT16U  OSCPULoadAvg[OS_STAT_LOAD_NBR]; /* Average CPU load (units are 0.01 %)                     */
+    INT16U  OSIntUsage;                     /* Share of the ISRs over the last period (0.01 %)         */
+    INT16U  OSIntLoadAvg[OS_STAT_LOAD_NBR]; /* Average share of the ISRs (units are 0.01 %)            */
+    INT16U  OSTaskUsage;                    /* Share of the tasks but idle, last period (0.01 %)       */
+    INT32U  OSCtxSwRate;                    /* Number of context switches per second, last period      */
+    INT32U  OSIntRate;                      /* Number of interrupts per second, last period            */
+    INT64U  OSIntTimeTot;                   /* Total time spent in ISRs                                */
+    INT64U  OSIdleTimeTot;                  /* Total time the idle task ran, at the last period        */
+    INT64U  OSTaskTimeTot;                  /* Total time the other tasks ran, at the last period      */
+} OS_STAT_DATA;
+#endif
+
+/*
+*********************************************************************************************************
+*                                          TASK PROFILING DATA
+*
+* Note(s): 1) Times are in units of OSCPUTsGet(), OS_CPU_TS_FREQ per second.
+*          2) The window values are computed by the statistic task over the last OS_TASK_PROFILE_WIN
+*             statistic task periods and are 0 without it.
+*********************************************************************************************************
+*/
+
+#if OS_TASK_PROFILE_EN > 0
+typedef struct os_task_prof {
+    INT64U  OSCyclesTot;               /* Total time the task has been running                         */
+    INT32U  OSCtxSwCtr;                /* Number of times the task was switched in                     */
+    INT16U  OSCPUUsage;                /* CPU share of the task over the window (units are 0.01 %)     */
+    INT32U  OSCtxSwRate;               /* Number of times the task was switched in per second          */
+    INT32U  OSRunMax;                  /* Longest time the task ran without a switch over the window   */
+#if OS_STAT_EN > 0
+    INT16U  OSLoadAvg[OS_STAT_LOAD_NBR];  /* 1 s, 10 s and 60 s average CPU share (units are 0.01 %)   */
+#endif
+} OS_TASK_PROF;
+#endif
+
 /*$PAGE*/
 /*
 *********************************************************************************************************
@@ -601,6 +979,8 @@ typedef struct os_tcb {
     OS_STK          *OSTCBStkBottom;        /* Pointer to bottom of stack                              */
     INT32U           OSTCBStkSize;          /* Size of task stack (in number of stack elements)        */
     INT16U           OSTCBOpt;              /* Task options as passed by OSTaskCreateExt()             */
+    INT32U           OSTCBStkFree;          /* Free stack entries at the last incremental stack check  */
+    BOOLEAN          OSTCBStkOvf;           /* Overflow of the guard entries reported                  */
     INT16U           OSTCBId;               /* Task ID (0..65535)                                      */
 #endif
 
@@ -615,7 +995,8 @@ typedef struct os_tcb {
     OS_EVENT       **OSTCBEventMultiPtr;    /* Pointer to multiple event control blocks                */
 #endif
 
-#if ((OS_Q_EN > 0) && (OS_MAX_QS > 0)) || (OS_MBOX_EN > 0)
+#if ((OS_Q_EN > 0) && (OS_MAX_QS > 0)) || (OS_MBOX_EN > 0) || ((OS_RING_EN > 0) && (OS_MAX_RINGS > 0)) || \
+    ((OS_CHAN_EN > 0) && (OS_MAX_CHANS > 0))
     void            *OSTCBMsg;              /* Message received from OSMboxPost() or OSQPost()         */
 #endif
 
@@ -626,31 +1007,66 @@ typedef struct os_tcb {
     OS_FLAGS         OSTCBFlagsRdy;         /* Event flags that made task ready to run                 */
 #endif
 
+#if (OS_RING_EN > 0) && (OS_MAX_RINGS > 0)
+    INT32U           OSTCBRingLen;          /* Length the task waits to reserve in a byte ring         */
+#endif
+
+#if OS_EVENT_PROF_EN > 0
+    INT64U           OSTCBPendTs;           /* Time stamp of the last pend that blocked the task       */
+    INT64U           OSTCBRdyTs;            /* Time stamp of the last post that readied the task       */
+#endif
+
+    struct os_tcb   *OSTCBTickNext;         /* Pointer to next     TCB in the tick list                */
+    struct os_tcb   *OSTCBTickPrev;         /* Pointer to previous TCB in the tick list                */
+    INT32U           OSTCBTickMatch;        /* Value of OSTickCtr at which the delay or timeout ends   */
     INT16U           OSTCBDly;              /* Nbr ticks to delay task or, timeout waiting for event   */
+#if OS_TIME_NS_EN > 0
+    INT64U           OSTCBDlyNsMatch;       /* Value of OSCPUTsGet() at which the delay or timeout ends*/
+    BOOLEAN          OSTCBDlyNs;            /* Delay or timeout in OSDlyNsList, see OS_DlyNsSet()      */
+#endif
+                                            /* ... (!= 0 while the TCB is in the tick list)            */
     INT8U            OSTCBStat;             /* Task      status                                        */
     INT8U            OSTCBStatPend;         /* Task PEND status                                        */
     INT8U            OSTCBPrio;             /* Task priority (0 == highest)                            */
 
     INT8U            OSTCBX;                /* Bit position in group  corresponding to task priority   */
     INT8U            OSTCBY;                /* Index into ready table corresponding to task priority   */
-#if OS_LOWEST_PRIO <= 63
-    INT8U            OSTCBBitX;             /* Bit mask to access bit position in ready table          */
-    INT8U            OSTCBBitY;             /* Bit mask to access bit position in ready group          */
-#else
-    INT16U           OSTCBBitX;             /* Bit mask to access bit position in ready table          */
-    INT16U           OSTCBBitY;             /* Bit mask to access bit position in ready group          */
-#endif
+    OS_PRIO_TBL      OSTCBBitX;             /* Bit mask to access bit position in ready table          */
+    OS_PRIO_GRP      OSTCBBitY;             /* Bit mask to access bit position in ready group          */
 
 #if OS_TASK_DEL_EN > 0
     INT8U            OSTCBDelReq;           /* Indicates whether a task needs to delete itself         */
 #endif
 
+#if OS_SCHED_RR_EN > 0
+    struct os_tcb   *OSTCBRRNext;           /* Pointer to next     TCB of the same priority (circular) */
+    struct os_tcb   *OSTCBRRPrev;           /* Pointer to previous TCB of the same priority (circular) */
+    BOOLEAN          OSTCBRRRdy;            /* Indicates whether the task is in the ready list         */
+    INT16U           OSTCBRRQuanta;         /* Time quantum of the task (# of ticks)                   */
+    INT16U           OSTCBRRCtr;            /* Ticks left of the current time quantum                  */
+#endif
+
+#if (OS_MUTEX_EN > 0) && (OS_MUTEX_PROTOCOL_EN > 0)
+    INT8U            OSTCBBasePrio;         /* Priority of the task without the boost of its mutexes   */
+    OS_EVENT        *OSTCBMutexList;        /* Ceiling and inheritance mutexes held by the task        */
+#endif
+
 #if OS_TASK_PROFILE_EN > 0
     INT32U           OSTCBCtxSwCtr;         /* Number of time the task was switched in                 */
-    INT32U           OSTCBCyclesTot;        /* Total number of clock cycles the task has been running  */
-    INT32U           OSTCBCyclesStart;      /* Snapshot of cycle counter at start of task resumption   */
+    INT64U           OSTCBCyclesTot;        /* Total time the task has been running (OSCPUTsGet())     */
+    INT64U           OSTCBCyclesStart;      /* Snapshot of OSCPUTsGet() at start of task resumption    */
+    INT32U           OSTCBRunMax;           /* Longest run of the task in the current stat. period     */
     OS_STK          *OSTCBStkBase;          /* Pointer to the beginning of the task stack              */
     INT32U           OSTCBStkUsed;          /* Number of bytes used from the stack                     */
+    INT64U           OSTCBWinCycles[OS_TASK_PROFILE_WIN];  /* OSTCBCyclesTot at the window boundaries  */
+    INT32U           OSTCBWinCtxSw[OS_TASK_PROFILE_WIN];   /* OSTCBCtxSwCtr  at the window boundaries  */
+    INT32U           OSTCBWinRunMax[OS_TASK_PROFILE_WIN];  /* OSTCBRunMax of the periods in the window */
+    INT16U           OSTCBCPUUsage;         /* CPU share over the window (units are 0.01 %)            */
+    INT32U           OSTCBCtxSwRate;        /* Number of times switched in per second over the window  */
+    INT32U           OSTCBRunMaxWin;        /* Longest run of the task over the window                 */
+#if OS_STAT_EN > 0
+    INT32U           OSTCBLoadAvg[OS_STAT_LOAD_NBR];       /* Average CPU share, 0.01 % << OS_STAT_FSHIFT  */
+#endif
 #endif
 
 #if OS_TASK_NAME_SIZE > 1
@@ -722,6 +1138,26 @@ OS_EXT  INT32U            OSIdleCtrMax;             /* Max. value that idle ctr
 OS_EXT  INT32U            OSIdleCtrRun;             /* Val. reached by idle ctr at run time in 1 sec.  */
 OS_EXT  BOOLEAN           OSStatRdy;                /* Flag indicating that the statistic task is rdy  */
 OS_EXT  OS_STK            OSTaskStatStk[OS_TASK_STAT_STK_SIZE];      /* Statistics task stack          */
+#if OS_TASK_PROFILE_EN > 0
+OS_EXT  INT64U            OSTaskProfTs[OS_TASK_PROFILE_WIN];         /* Time stamps of window boundaries */
+OS_EXT  INT8U             OSTaskProfIx;             /* Oldest window boundary                          */
+#endif
+#endif
+
+#if (OS_TASK_STAT_STK_CHK_EN > 0) && (OS_TASK_CREATE_EXT_EN > 0)
+OS_EXT  OS_TCB           *OSTaskStatStkTCB;         /* Next task of the incremental stack check        */
+#endif
+
+#if OS_STAT_EN > 0
+OS_EXT  INT64U            OSStatIntStart;           /* Time stamp at entry of the outermost ISR        */
+OS_EXT  INT64U            OSStatIntTimeTot;         /* Total time spent in ISRs                        */
+OS_EXT  INT32U            OSStatIntCtr;             /* Number of outermost ISRs                        */
+OS_EXT  OS_STAT_DATA      OSStatData;               /* Load statistics of the last period              */
+OS_EXT  INT32U            OSStatCPULoadAvg[OS_STAT_LOAD_NBR];  /* CPU load averages << OS_STAT_FSHIFT  */
+OS_EXT  INT32U            OSStatIntLoadAvg[OS_STAT_LOAD_NBR];  /* ISR  load averages << OS_STAT_FSHIFT  */
+OS_EXT  INT64U            OSStatIntTimeLast;        /* OSStatIntTimeTot at the last period             */
+OS_EXT  INT32U            OSStatIntCtrLast;         /* OSStatIntCtr     at the last period             */
+OS_EXT  INT32U            OSStatCtxSwCtrLast;       /* OSCtxSwCtr       at the last period             */
 #endif
 
 OS_EXT  INT8U             OSIntNesting;             /* Interrupt nesting level                         */
@@ -731,13 +1167,8 @@ OS_EXT  INT8U             OSLockNesting;            /* Multitasking lock nesting
 OS_EXT  INT8U             OSPrioCur;                /* Priority of current task                        */
 OS_EXT  INT8U             OSPrioHighRdy;            /* Priority of highest priority task               */
 
-#if OS_LOWEST_PRIO <= 63
-OS_EXT  INT8U             OSRdyGrp;                        /* Ready list group                         */
-OS_EXT  INT8U             OSRdyTbl[OS_RDY_TBL_SIZE];       /* Table of tasks which are ready to run    */
-#else
-OS_EXT  INT16U            OSRdyGrp;                        /* Ready list group                         */
-OS_EXT  INT16U            OSRdyTbl[OS_RDY_TBL_SIZE];       /* Table of tasks which are ready to run    */
-#endif
+OS_EXT  OS_PRIO_GRP       OSRdyGrp;                        /* Ready list group                         */
+OS_EXT  OS_PRIO_TBL       OSRdyTbl[OS_RDY_TBL_SIZE];       /* Table of tasks which are ready to run    */
 
 OS_EXT  BOOLEAN           OSRunning;                       /* Flag indicating that kernel is running   */
 
@@ -755,6 +1186,13 @@ OS_EXT  OS_TCB           *OSTCBList;                       /* Pointer to doubly
 OS_EXT  OS_TCB           *OSTCBPrioTbl[OS_LOWEST_PRIO + 1];/* Table of pointers to created TCBs        */
 OS_EXT  OS_TCB            OSTCBTbl[OS_MAX_TASKS + OS_N_SYS_TASKS];   /* Table of TCBs                  */
 
+OS_EXT  OS_TCB           *OSTickList;               /* Delayed TCBs, sorted by OSTCBTickMatch          */
+OS_EXT  INT32U            OSTickCtr;                /* Number of ticks processed by OSTimeTick()       */
+
+#if OS_TIME_NS_EN > 0
+OS_EXT  OS_TCB           *OSDlyNsList;              /* TCBs delayed in ns, sorted by OSTCBDlyNsMatch   */
+#endif
+
 #if OS_TICK_STEP_EN > 0
 OS_EXT  INT8U             OSTickStepState;          /* Indicates the state of the tick step feature    */
 #endif
@@ -769,8 +1207,42 @@ OS_EXT  OS_Q             *OSQFreeList;              /* Pointer to list of free Q
 OS_EXT  OS_Q              OSQTbl[OS_MAX_QS];        /* Table of QUEUE control blocks                   */
 #endif
 
+#if (OS_RING_EN > 0) && (OS_MAX_RINGS > 0)
+OS_EXT  OS_RING          *OSRingFreeList;           /* Pointer to list of free BYTE RING control blocks*/
+OS_EXT  OS_RING           OSRingTbl[OS_MAX_RINGS];  /* Table of BYTE RING control blocks               */
+#endif
+
+#if (OS_SET_EN > 0) && (OS_MAX_SETS > 0)
+OS_EXT  OS_SET           *OSSetFreeList;            /* Pointer to list of free EVENT SET control blocks*/
+OS_EXT  OS_SET            OSSetTbl[OS_MAX_SETS];    /* Table of EVENT SET control blocks               */
+#endif
+
+#if (OS_TOPIC_EN > 0) && (OS_MAX_TOPICS > 0)
+OS_EXT  OS_TOPIC         *OSTopicFreeList;          /* Pointer to list of free TOPIC control blocks    */
+OS_EXT  OS_TOPIC          OSTopicTbl[OS_MAX_TOPICS];/* Table of TOPIC control blocks                   */
+#endif
+
+#if (OS_INT_Q_EN > 0) && (OS_MAX_INT_QS > 0)
+OS_EXT  OS_INT_Q          OSIntQTbl[OS_MAX_INT_QS]; /* Table of interrupt queues                       */
+OS_EXT  INT8U             OSIntQCtr;                /* Number of interrupt queues created              */
+OS_EXT  volatile  BOOLEAN OSIntQPend;               /* An ISR deferred a post since the last pass      */
+OS_EXT  OS_TCB           *OSIntQTCB;                /* TCB of the task of the deferred posts           */
+OS_EXT  OS_STK            OSTaskIntQStk[OS_TASK_INT_Q_STK_SIZE];
+#endif
+
+#if (OS_CHAN_EN > 0) && (OS_MAX_CHANS > 0)
+OS_EXT  OS_CHAN           OSChanTbl[OS_MAX_CHANS];  /* Table of native thread channels                 */
+OS_EXT  INT8U             OSChanCtr;                /* Number of channels created                      */
+OS_EXT  OS_CHAN *volatile OSChanSigList;            /* Channels with a message for waiting tasks       */
+#endif
+
+#if OS_SLAB_EN > 0
+OS_EXT  INT32U            OSSlabPageCtr;            /* Number of slab pages taken from the port        */
+OS_EXT  INT32U            OSSlabBytes;              /* Size of the slab pages taken from the port      */
+#endif
+
 #if OS_TIME_GET_SET_EN > 0
-OS_EXT  volatile  INT32U  OSTime;                   /* Current value of system time (in ticks)         */
+OS_EXT  volatile  INT64U  OSTime;                   /* Current value of system time (in ticks)         */
 #endif
 
 #if OS_TMR_EN > 0
@@ -824,6 +1296,12 @@ INT16U        OSEventPendMulti        (OS_EVENT       **pevents_pend,
                                        INT8U           *perr);
 #endif
 
+#if OS_EVENT_PROF_EN > 0
+INT8U         OSEventProfGet          (OS_EVENT        *pevent,
+                                       OS_EVENT_PROF   *p_prof,
+                                       INT8U            opt);
+#endif
+
 #endif
 
 /*
@@ -867,17 +1345,80 @@ OS_FLAGS      OSFlagPend              (OS_FLAG_GRP     *pgrp,
                                        INT8U           *perr);
 
 OS_FLAGS      OSFlagPendGetFlagsRdy   (void);
+
+#if OS_TIME_NS_EN > 0
+OS_FLAGS      OSFlagPendNs            (OS_FLAG_GRP     *pgrp,
+                                       OS_FLAGS         flags,
+                                       INT8U            wait_type,
+                                       INT64U           timeout_ns,
+                                       INT8U           *perr);
+#endif
+
 OS_FLAGS      OSFlagPost              (OS_FLAG_GRP     *pgrp,
                                        OS_FLAGS         flags,
                                        INT8U            opt,
                                        INT8U           *perr);
 
+#if OS_EVENT_PROF_EN > 0
+INT8U         OSFlagProfGet           (OS_FLAG_GRP     *pgrp,
+                                       OS_EVENT_PROF   *p_prof,
+                                       INT8U            opt);
+#endif
+
 #if OS_FLAG_QUERY_EN > 0
 OS_FLAGS      OSFlagQuery             (OS_FLAG_GRP     *pgrp,
                                        INT8U           *perr);
 #endif
 #endif
 
+/*
+*********************************************************************************************************
+*                                     NATIVE THREAD CHANNEL MANAGEMENT
+*********************************************************************************************************
+*/
+
+#if (OS_CHAN_EN > 0) && (OS_MAX_CHANS > 0)
+void         *OSChanAccept            (OS_CHAN         *pchan,
+                                       INT8U           *perr);
+
+OS_CHAN      *OSChanCreate            (void           **pstart,
+                                       INT16U           size,
+                                       INT8U           *perr);
+
+void         *OSChanPend              (OS_CHAN         *pchan,
+                                       INT16U           timeout,
+                                       INT8U           *perr);
+
+INT8U         OSChanPost              (OS_CHAN         *pchan,
+                                       void            *pmsg);
+
+void          OSChanSignal            (void);
+#endif
+
+/*
+*********************************************************************************************************
+*                                       ISR DEFERRED POST MANAGEMENT
+*********************************************************************************************************
+*/
+
+#if (OS_INT_Q_EN > 0) && (OS_MAX_INT_QS > 0)
+OS_INT_Q     *OSIntQCreate            (OS_INT_Q_ENTRY  *pstart,
+                                       INT16U           size,
+                                       INT8U           *perr);
+
+#if (OS_FLAG_EN > 0) && (OS_MAX_FLAGS > 0)
+INT8U         OSIntQFlagPost          (OS_INT_Q        *pq,
+                                       OS_FLAG_GRP     *pgrp,
+                                       OS_FLAGS         flags,
+                                       INT8U            opt);
+#endif
+
+INT8U         OSIntQPost              (OS_INT_Q        *pq,
+                                       OS_EVENT        *pevent,
+                                       void            *pmsg,
+                                       INT8U            opt);
+#endif
+
 /*
 *********************************************************************************************************
 *                                        MESSAGE MAILBOX MANAGEMENT
@@ -902,6 +1443,12 @@ void         *OSMboxPend              (OS_EVENT        *pevent,
                                        INT16U           timeout,
                                        INT8U           *perr);
 
+#if OS_TIME_NS_EN > 0
+void         *OSMboxPendNs            (OS_EVENT        *pevent,
+                                       INT64U           timeout_ns,
+                                       INT8U           *perr);
+#endif
+
 #if OS_MBOX_PEND_ABORT_EN > 0
 INT8U         OSMboxPendAbort         (OS_EVENT        *pevent,
                                        INT8U            opt,
@@ -975,6 +1522,12 @@ BOOLEAN       OSMutexAccept           (OS_EVENT        *pevent,
 OS_EVENT     *OSMutexCreate           (INT8U            prio,
                                        INT8U           *perr);
 
+#if OS_MUTEX_PROTOCOL_EN > 0
+OS_EVENT     *OSMutexCreateExt        (INT8U            prio,
+                                       INT8U            opt,
+                                       INT8U           *perr);
+#endif
+
 #if OS_MUTEX_DEL_EN > 0
 OS_EVENT     *OSMutexDel              (OS_EVENT        *pevent,
                                        INT8U            opt,
@@ -985,6 +1538,12 @@ void          OSMutexPend             (OS_EVENT        *pevent,
                                        INT16U           timeout,
                                        INT8U           *perr);
 
+#if OS_TIME_NS_EN > 0
+void          OSMutexPendNs           (OS_EVENT        *pevent,
+                                       INT64U           timeout_ns,
+                                       INT8U           *perr);
+#endif
+
 INT8U         OSMutexPost             (OS_EVENT        *pevent);
 
 #if OS_MUTEX_QUERY_EN > 0
@@ -1011,6 +1570,11 @@ void         *OSQAccept               (OS_EVENT        *pevent,
 OS_EVENT     *OSQCreate               (void           **start,
                                        INT16U           size);
 
+#if OS_Q_PRIO_EN > 0
+OS_EVENT     *OSQCreatePrio           (OS_Q_MSG        *start,
+                                       INT16U           size);
+#endif
+
 #if OS_Q_DEL_EN > 0
 OS_EVENT     *OSQDel                  (OS_EVENT        *pevent,
                                        INT8U            opt,
@@ -1025,12 +1589,26 @@ void         *OSQPend                 (OS_EVENT        *pevent,
                                        INT16U           timeout,
                                        INT8U           *perr);
 
+#if OS_TIME_NS_EN > 0
+void         *OSQPendNs               (OS_EVENT        *pevent,
+                                       INT64U           timeout_ns,
+                                       INT8U           *perr);
+#endif
+
 #if OS_Q_PEND_ABORT_EN > 0
 INT8U         OSQPendAbort            (OS_EVENT        *pevent,
                                        INT8U            opt,
                                        INT8U           *perr);
 #endif
 
+#if OS_Q_PEND_N_EN > 0
+INT16U        OSQPendN                (OS_EVENT        *pevent,
+                                       void           **pmsgs,
+                                       INT16U           nmsgs,
+                                       INT16U           timeout,
+                                       INT8U           *perr);
+#endif
+
 #if OS_Q_POST_EN > 0
 INT8U         OSQPost                 (OS_EVENT        *pevent,
                                        void            *pmsg);
@@ -1041,12 +1619,25 @@ INT8U         OSQPostFront            (OS_EVENT        *pevent,
                                        void            *pmsg);
 #endif
 
+#if OS_Q_POST_N_EN > 0
+INT16U        OSQPostN                (OS_EVENT        *pevent,
+                                       void           **pmsgs,
+                                       INT16U           nmsgs,
+                                       INT8U           *perr);
+#endif
+
 #if OS_Q_POST_OPT_EN > 0
 INT8U         OSQPostOpt              (OS_EVENT        *pevent,
                                        void            *pmsg,
                                        INT8U            opt);
 #endif
 
+#if OS_Q_PRIO_EN > 0
+INT8U         OSQPostPrio             (OS_EVENT        *pevent,
+                                       void            *pmsg,
+                                       INT8U            prio);
+#endif
+
 #if OS_Q_QUERY_EN > 0
 INT8U         OSQQuery                (OS_EVENT        *pevent,
                                        OS_Q_DATA       *p_q_data);
@@ -1057,30 +1648,75 @@ INT8U         OSQQuery                (OS_EVENT        *pevent,
 /*$PAGE*/
 /*
 *********************************************************************************************************
-*                                          SEMAPHORE MANAGEMENT
+*                                          BYTE RING MANAGEMENT
 *********************************************************************************************************
 */
-#if OS_SEM_EN > 0
+#if (OS_RING_EN > 0) && (OS_MAX_RINGS > 0)
 
-#if OS_SEM_ACCEPT_EN > 0
-INT16U        OSSemAccept             (OS_EVENT        *pevent);
-#endif
+void         *OSRingAccept            (OS_EVENT        *pevent,
+                                       INT32U          *plen,
+                                       INT8U           *perr);
 
-OS_EVENT     *OSSemCreate             (INT16U           cnt);
+INT8U         OSRingCommit            (OS_EVENT        *pevent,
+                                       void            *pdata,
+                                       INT32U           len);
 
-#if OS_SEM_DEL_EN > 0
-OS_EVENT     *OSSemDel                (OS_EVENT        *pevent,
+OS_EVENT     *OSRingCreate            (void            *pstart,
+                                       INT32U           size,
+                                       INT8U           *perr);
+
+OS_EVENT     *OSRingDel               (OS_EVENT        *pevent,
                                        INT8U            opt,
                                        INT8U           *perr);
-#endif
 
-void          OSSemPend               (OS_EVENT        *pevent,
+void         *OSRingPend              (OS_EVENT        *pevent,
+                                       INT32U          *plen,
                                        INT16U           timeout,
                                        INT8U           *perr);
 
-#if OS_SEM_PEND_ABORT_EN > 0
-INT8U         OSSemPendAbort          (OS_EVENT        *pevent,
-                                       INT8U            opt,
+INT8U         OSRingRelease           (OS_EVENT        *pevent,
+                                       void            *pdata);
+
+void         *OSRingReserve           (OS_EVENT        *pevent,
+                                       INT32U           len,
+                                       INT16U           timeout,
+                                       INT8U           *perr);
+
+#endif
+
+/*$PAGE*/
+/*
+*********************************************************************************************************
+*                                          SEMAPHORE MANAGEMENT
+*********************************************************************************************************
+*/
+#if OS_SEM_EN > 0
+
+#if OS_SEM_ACCEPT_EN > 0
+INT16U        OSSemAccept             (OS_EVENT        *pevent);
+#endif
+
+OS_EVENT     *OSSemCreate             (INT16U           cnt);
+
+#if OS_SEM_DEL_EN > 0
+OS_EVENT     *OSSemDel                (OS_EVENT        *pevent,
+                                       INT8U            opt,
+                                       INT8U           *perr);
+#endif
+
+void          OSSemPend               (OS_EVENT        *pevent,
+                                       INT16U           timeout,
+                                       INT8U           *perr);
+
+#if OS_TIME_NS_EN > 0
+void          OSSemPendNs             (OS_EVENT        *pevent,
+                                       INT64U           timeout_ns,
+                                       INT8U           *perr);
+#endif
+
+#if OS_SEM_PEND_ABORT_EN > 0
+INT8U         OSSemPendAbort          (OS_EVENT        *pevent,
+                                       INT8U            opt,
                                        INT8U           *perr);
 #endif
 
@@ -1099,6 +1735,76 @@ void          OSSemSet                (OS_EVENT        *pevent,
 
 #endif
 
+/*$PAGE*/
+/*
+*********************************************************************************************************
+*                                          EVENT SET MANAGEMENT
+*********************************************************************************************************
+*/
+#if (OS_SET_EN > 0) && (OS_MAX_SETS > 0)
+
+INT8U         OSSetAccept             (OS_EVENT        *pset,
+                                       OS_EVENT       **pevents_rdy,
+                                       INT8U            size,
+                                       INT8U           *perr);
+
+void          OSSetAdd                (OS_EVENT        *pset,
+                                       OS_EVENT        *pevent,
+                                       INT8U           *perr);
+
+OS_EVENT     *OSSetCreate             (void);
+
+OS_EVENT     *OSSetDel                (OS_EVENT        *pset,
+                                       INT8U            opt,
+                                       INT8U           *perr);
+
+INT8U         OSSetPend               (OS_EVENT        *pset,
+                                       OS_EVENT       **pevents_rdy,
+                                       INT8U            size,
+                                       INT16U           timeout,
+                                       INT8U           *perr);
+
+void          OSSetRemove             (OS_EVENT        *pset,
+                                       OS_EVENT        *pevent,
+                                       INT8U           *perr);
+
+#endif
+
+/*$PAGE*/
+/*
+*********************************************************************************************************
+*                                    PUBLISH/SUBSCRIBE TOPIC MANAGEMENT
+*********************************************************************************************************
+*/
+#if (OS_TOPIC_EN > 0) && (OS_MAX_TOPICS > 0)
+
+OS_TOPIC     *OSTopicCreate           (INT8U           *perr);
+
+OS_TOPIC     *OSTopicDel              (OS_TOPIC        *ptopic,
+                                       INT8U           *perr);
+
+#if OS_TOPIC_REF_EN > 0
+void         *OSTopicMsgGet           (OS_MEM          *pmem,
+                                       INT8U           *perr);
+
+INT8U         OSTopicMsgPut           (void            *pmsg);
+#endif
+
+INT8U         OSTopicPublish          (OS_TOPIC        *ptopic,
+                                       void            *pmsg,
+                                       INT8U            opt,
+                                       INT8U           *perr);
+
+void          OSTopicSubscribe        (OS_TOPIC        *ptopic,
+                                       OS_EVENT        *pevent,
+                                       INT8U           *perr);
+
+void          OSTopicUnsubscribe      (OS_TOPIC        *ptopic,
+                                       OS_EVENT        *pevent,
+                                       INT8U           *perr);
+
+#endif
+
 /*$PAGE*/
 /*
 *********************************************************************************************************
@@ -1154,6 +1860,16 @@ INT8U         OSTaskStkChk            (INT8U            prio,
                                        OS_STK_DATA     *p_stk_data);
 #endif
 
+#if OS_TASK_PROFILE_EN > 0
+INT8U         OSTaskProfGet           (INT8U            prio,
+                                       OS_TASK_PROF    *p_prof);
+#endif
+
+#if OS_SCHED_RR_EN > 0
+INT8U         OSTaskQuantaSet         (INT8U            prio,
+                                       INT16U           quanta);
+#endif
+
 #if OS_TASK_QUERY_EN > 0
 INT8U         OSTaskQuery             (INT8U            prio,
                                        OS_TCB          *p_task_data);
@@ -1175,17 +1891,40 @@ INT8U         OSTimeDlyHMSM           (INT8U            hours,
                                        INT16U           milli);
 #endif
 
+#if OS_TIME_NS_EN > 0
+void          OSTimeDlyNs             (INT64U           ns);
+#endif
+
 #if OS_TIME_DLY_RESUME_EN > 0
 INT8U         OSTimeDlyResume         (INT8U            prio);
 #endif
 
+#if OS_SCHED_RR_EN > 0
+void          OSTimeDlyYield          (void);
+#endif
+
 #if OS_TIME_GET_SET_EN > 0
 INT32U        OSTimeGet               (void);
+INT64U        OSTimeGet64             (void);
 void          OSTimeSet               (INT32U           ticks);
 #endif
 
+#if OS_TIME_NS_EN > 0
+INT64U        OSTimeNsGet             (void);
+#endif
+
 void          OSTimeTick              (void);
 
+#if OS_TICKLESS_EN > 0
+void          OSTimeTickN             (INT32U           ticks);
+
+INT32U        OSTimeTickNextGet       (void);
+#endif
+
+#if OS_TIME_NS_EN > 0
+void          OSTimeTickNs            (void);
+#endif
+
 /*
 *********************************************************************************************************
 *                                            TIMER MANAGEMENT
@@ -1224,6 +1963,10 @@ BOOLEAN      OSTmrStop                (OS_TMR          *ptmr,
                                        INT8U           *perr);
 
 INT8U        OSTmrSignal              (void);
+
+#if OS_TICKLESS_EN > 0
+INT32U       OSTmrNextGet             (void);
+#endif
 #endif
 
 /*
@@ -1246,6 +1989,10 @@ void          OSStart                 (void);
 
 void          OSStatInit              (void);
 
+#if OS_STAT_EN > 0
+INT8U         OSStatGet               (OS_STAT_DATA    *p_stat);
+#endif
+
 INT16U        OSVersion               (void);
 
 /*$PAGE*/
@@ -1261,6 +2008,8 @@ void          OS_Dummy                (void);
 #endif
 
 #if (OS_EVENT_EN)
+OS_TCB       *OS_EventTaskHighest     (OS_EVENT        *pevent);
+
 INT8U         OS_EventTaskRdy         (OS_EVENT        *pevent,
                                        void            *pmsg,
                                        INT8U            msk,
@@ -1281,28 +2030,121 @@ void          OS_EventTaskRemoveMulti (OS_TCB          *ptcb,
 void          OS_EventWaitListInit    (OS_EVENT        *pevent);
 #endif
 
+#if OS_EVENT_PROF_EN > 0
+void          OS_EventProfWake        (OS_EVENT_PROF   *pprof);
+#endif
+
 #if (OS_FLAG_EN > 0) && (OS_MAX_FLAGS > 0)
 void          OS_FlagInit             (void);
 void          OS_FlagUnlink           (OS_FLAG_NODE    *pnode);
 #endif
 
 void          OS_MemClr               (INT8U           *pdest,
-                                       INT16U           size);
+                                       INT32U           size);
 
 void          OS_MemCopy              (INT8U           *pdest,
                                        INT8U           *psrc,
-                                       INT16U           size);
+                                       INT32U           size);
+
+#if (OS_CHAN_EN > 0) && (OS_MAX_CHANS > 0)
+void          OS_ChanInit             (void);
+#endif
+
+#if (OS_INT_Q_EN > 0) && (OS_MAX_INT_QS > 0)
+void          OS_IntQInit             (void);
+
+void          OS_IntQSignal           (void);
+
+void          OS_TaskIntQ             (void            *p_arg);
+#endif
 
 #if (OS_MEM_EN > 0) && (OS_MAX_MEM_PART > 0)
 void          OS_MemInit              (void);
 #endif
 
+#if (OS_MUTEX_EN > 0) && (OS_MUTEX_PROTOCOL_EN > 0)
+INT8U         OS_MutexPrioGet         (OS_TCB          *ptcb);
+
+void          OS_MutexPrioUpdate      (OS_TCB          *ptcb);
+#endif
+
 #if OS_Q_EN > 0
 void          OS_QInit                (void);
 #endif
 
+#if (OS_Q_EN > 0) && (OS_MAX_QS > 0) && (OS_TOPIC_EN > 0) && (OS_MAX_TOPICS > 0)
+INT8U         OS_QPost                (OS_EVENT        *pevent,
+                                       void            *pmsg,
+                                       INT8U            opt,
+                                       BOOLEAN         *psched);
+#endif
+
+#if (OS_Q_EN > 0) && (OS_MAX_QS > 0) && (OS_Q_PRIO_EN > 0)
+void         *OS_QPrioGet             (OS_Q            *pq);
+#endif
+
+#if (OS_RING_EN > 0) && (OS_MAX_RINGS > 0)
+void          OS_RingInit             (void);
+#endif
+
+#if (OS_SET_EN > 0) && (OS_MAX_SETS > 0)
+void          OS_SetInit              (void);
+
+BOOLEAN       OS_SetSignal            (OS_EVENT        *pevent);
+
+void          OS_SetUnlink            (OS_EVENT        *pevent);
+#endif
+
 void          OS_Sched                (void);
 
+#if OS_SLAB_EN > 0
+#if (OS_EVENT_EN) && (OS_MAX_EVENTS > 0)
+void          OS_SlabEventRefill      (void);
+#endif
+
+#if (OS_FLAG_EN > 0) && (OS_MAX_FLAGS > 0)
+void          OS_SlabFlagRefill       (void);
+#endif
+
+#if (OS_MEM_EN > 0) && (OS_MAX_MEM_PART > 0)
+void          OS_SlabMemRefill        (void);
+#endif
+
+#if (OS_Q_EN > 0) && (OS_MAX_QS > 0)
+void          OS_SlabQRefill          (void);
+#endif
+
+#if (OS_RING_EN > 0) && (OS_MAX_RINGS > 0)
+void          OS_SlabRingRefill       (void);
+#endif
+
+#if (OS_SET_EN > 0) && (OS_MAX_SETS > 0)
+void          OS_SlabSetRefill        (void);
+#endif
+
+#if (OS_TOPIC_EN > 0) && (OS_MAX_TOPICS > 0)
+void          OS_SlabTopicRefill      (void);
+#endif
+
+void          OS_SlabTCBRefill        (void);
+#endif
+
+#if OS_SCHED_RR_EN > 0
+void          OS_RdyListInsert        (OS_TCB          *ptcb);
+
+void          OS_RdyListRemove        (OS_TCB          *ptcb);
+
+void          OS_PrioRingInsert       (OS_TCB          *ptcb);
+
+void          OS_PrioRingRemove       (OS_TCB          *ptcb);
+#else                                                   /* One task per priority, only the ready bits  */
+#define  OS_RdyListInsert(ptcb)  { OSRdyGrp                 |=  (ptcb)->OSTCBBitY;                  \
+                                   OSRdyTbl[(ptcb)->OSTCBY] |=  (ptcb)->OSTCBBitX; }
+#define  OS_RdyListRemove(ptcb)  { if ((OSRdyTbl[(ptcb)->OSTCBY] &= ~(ptcb)->OSTCBBitX) == 0) {       \
+                                       OSRdyGrp &= ~(ptcb)->OSTCBBitY;                              \
+                                   } }
+#endif
+
 #if (OS_EVENT_NAME_SIZE > 1) || (OS_FLAG_NAME_SIZE > 1) || (OS_MEM_NAME_SIZE > 1) || (OS_TASK_NAME_SIZE > 1)
 INT8U         OS_StrCopy              (INT8U           *pdest,
                                        INT8U           *psrc);
@@ -1326,6 +2168,27 @@ void          OS_TaskStkClr           (OS_STK          *pbos,
 void          OS_TaskStatStkChk       (void);
 #endif
 
+#if (OS_TASK_STAT_EN > 0) && (OS_TASK_PROFILE_EN > 0)
+void          OS_TaskStatProf         (void);
+#endif
+
+#if OS_STAT_EN > 0
+void          OS_StatInit             (void);
+
+void          OS_StatIntExit          (void);
+
+void          OS_StatUpdate           (void);
+#endif
+
+void          OS_TickListInsert       (OS_TCB          *ptcb,
+                                       INT16U           ticks);
+
+void          OS_TickListRemove       (OS_TCB          *ptcb);
+
+#if OS_TIME_NS_EN > 0
+void          OS_DlyNsSet             (INT64U           ns);
+#endif
+
 INT8U         OS_TCBInit              (INT8U            prio,
                                        OS_STK          *ptos,
                                        OS_STK          *pbos,
@@ -1334,10 +2197,17 @@ INT8U         OS_TCBInit              (INT8U            prio,
                                        void            *pext,
                                        INT16U           opt);
 
+void          OS_TCBPrioSet           (OS_TCB          *ptcb,
+                                       INT8U            prio);
+
 #if OS_TMR_EN > 0
 void          OSTmr_Init              (void);
 #endif
 
+#if (OS_TOPIC_EN > 0) && (OS_MAX_TOPICS > 0)
+void          OS_TopicInit            (void);
+#endif
+
 /*$PAGE*/
 /*
 *********************************************************************************************************
@@ -1359,6 +2229,11 @@ void          OSTaskDelHook           (OS_TCB          *ptcb);
 void          OSTaskIdleHook          (void);
 
 void          OSTaskStatHook          (void);
+
+#if OS_TASK_STK_CANARY_EN > 0
+void          OSTaskStkOvfHook        (OS_TCB          *ptcb);
+#endif
+
 OS_STK       *OSTaskStkInit           (void           (*task)(void *p_arg),
                                        void            *p_arg,
                                        OS_STK          *ptos,
@@ -1469,6 +2344,74 @@ void          OSCtxSw                 (void);
     #endif
 #endif
 
+/*
+*********************************************************************************************************
+*                                         NATIVE THREAD CHANNELS
+*********************************************************************************************************
+*/
+
+#ifndef OS_CHAN_EN
+#error  "OS_CFG.H, Missing OS_CHAN_EN: Enable (1) or Disable (0) the channels from native threads"
+#else
+    #ifndef OS_MAX_CHANS
+    #error  "OS_CFG.H, Missing OS_MAX_CHANS: Max. number of native thread channels in your application"
+    #else
+        #if     OS_MAX_CHANS > 255u
+        #error  "OS_CFG.H, OS_MAX_CHANS must be <= 255"
+        #endif
+    #endif
+
+    #if     (OS_CHAN_EN > 0) && (OS_MAX_CHANS > 0)
+        #if     OS_MAX_EVENTS == 0
+        #error  "OS_CFG.H, OS_MAX_EVENTS must be > 0 when enabling CHANNELS, a channel has an event control block"
+        #endif
+
+        #if     !defined(OS_CPU_SMP_ACQUIRE) || !defined(OS_CPU_SMP_RELEASE) || !defined(OS_CPU_SMP_BARRIER)
+        #error  "OS_CPU.H, Missing OS_CPU_SMP_ACQUIRE(), OS_CPU_SMP_RELEASE() or OS_CPU_SMP_BARRIER(): Order the channels between threads"
+        #endif
+
+        #if     !defined(OS_CPU_XCHG) || !defined(OS_CPU_CAS)
+        #error  "OS_CPU.H, Missing OS_CPU_XCHG() or OS_CPU_CAS(): Atomic operations of the channel producers"
+        #endif
+    #endif
+#endif
+
+/*
+*********************************************************************************************************
+*                                         ISR DEFERRED POSTS
+*********************************************************************************************************
+*/
+
+#ifndef OS_INT_Q_EN
+#error  "OS_CFG.H, Missing OS_INT_Q_EN: Enable (1) or Disable (0) the deferred posts of the ISRs"
+#else
+    #ifndef OS_MAX_INT_QS
+    #error  "OS_CFG.H, Missing OS_MAX_INT_QS: Max. number of interrupt queues in your application"
+    #else
+        #if     OS_MAX_INT_QS > 255u
+        #error  "OS_CFG.H, OS_MAX_INT_QS must be <= 255"
+        #endif
+    #endif
+
+    #if     (OS_INT_Q_EN > 0) && (OS_MAX_INT_QS > 0)
+        #ifndef OS_TASK_INT_Q_PRIO
+        #error  "OS_CFG.H, Missing OS_TASK_INT_Q_PRIO: Priority of the task that does the deferred posts"
+        #else
+            #if     OS_TASK_INT_Q_PRIO >= OS_TASK_STAT_PRIO
+            #error  "OS_CFG.H, OS_TASK_INT_Q_PRIO must be < OS_LOWEST_PRIO - 1"
+            #endif
+        #endif
+
+        #ifndef OS_TASK_INT_Q_STK_SIZE
+        #error  "OS_CFG.H, Missing OS_TASK_INT_Q_STK_SIZE: Determines the size of the interrupt queue task's stack"
+        #endif
+
+        #ifndef OS_CPU_BARRIER
+        #error  "OS_CPU.H, Missing OS_CPU_BARRIER(): Orders the entries of an interrupt queue before its index"
+        #endif
+    #endif
+#endif
+
 /*
 *********************************************************************************************************
 *                                           MESSAGE MAILBOXES
@@ -1549,6 +2492,18 @@ void          OSCtxSw                 (void);
     #ifndef OS_MUTEX_QUERY_EN
     #error  "OS_CFG.H, Missing OS_MUTEX_QUERY_EN: Include code for OSMutexQuery()"
     #endif
+
+    #ifndef OS_MUTEX_PROTOCOL_EN
+    #error  "OS_CFG.H, Missing OS_MUTEX_PROTOCOL_EN: Include code for ceiling and inheritance mutexes"
+    #else
+        #if     (OS_MUTEX_EN > 0) && (OS_MUTEX_PROTOCOL_EN > 0) && (OS_SCHED_RR_EN == 0)
+        #error  "OS_CFG.H, OS_SCHED_RR_EN must be enabled for ceiling and inheritance mutexes, they share priorities"
+        #endif
+    #endif
+
+    #ifndef OS_MUTEX_STAT_EN
+    #error  "OS_CFG.H, Missing OS_MUTEX_STAT_EN: Include lock hold time and contention counters of mutexes"
+    #endif
 #endif
 
 /*
@@ -1584,6 +2539,10 @@ void          OSCtxSw                 (void);
     #error  "OS_CFG.H, Missing OS_Q_PEND_ABORT_EN: Include code for OSQPendAbort()"
     #endif
 
+    #ifndef OS_Q_PEND_N_EN
+    #error  "OS_CFG.H, Missing OS_Q_PEND_N_EN: Include code for OSQPendN()"
+    #endif
+
     #ifndef OS_Q_POST_EN
     #error  "OS_CFG.H, Missing OS_Q_POST_EN: Include code for OSQPost()"
     #endif
@@ -1592,15 +2551,55 @@ void          OSCtxSw                 (void);
     #error  "OS_CFG.H, Missing OS_Q_POST_FRONT_EN: Include code for OSQPostFront()"
     #endif
 
+    #ifndef OS_Q_POST_N_EN
+    #error  "OS_CFG.H, Missing OS_Q_POST_N_EN: Include code for OSQPostN()"
+    #endif
+
     #ifndef OS_Q_POST_OPT_EN
     #error  "OS_CFG.H, Missing OS_Q_POST_OPT_EN: Include code for OSQPostOpt()"
     #endif
 
+    #ifndef OS_Q_PRIO_EN
+    #error  "OS_CFG.H, Missing OS_Q_PRIO_EN: Include code for OSQCreatePrio() and OSQPostPrio()"
+    #else
+        #if OS_Q_PRIO_EN > 0
+            #ifndef OS_Q_PRIO_LEVELS
+            #error  "OS_CFG.H, Missing OS_Q_PRIO_LEVELS: Number of message priorities of a priority queue"
+            #else
+                #if (OS_Q_PRIO_LEVELS < 1) || (OS_Q_PRIO_LEVELS > 8)
+                #error  "OS_CFG.H, OS_Q_PRIO_LEVELS must be between 1 and 8"
+                #endif
+            #endif
+        #endif
+    #endif
+
     #ifndef OS_Q_QUERY_EN
     #error  "OS_CFG.H, Missing OS_Q_QUERY_EN: Include code for OSQQuery()"
     #endif
 #endif
 
+/*
+*********************************************************************************************************
+*                                              BYTE RINGS
+*********************************************************************************************************
+*/
+
+#ifndef OS_RING_EN
+#error  "OS_CFG.H, Missing OS_RING_EN: Enable (1) or Disable (0) code generation for BYTE RINGS"
+#else
+    #ifndef OS_MAX_RINGS
+    #error  "OS_CFG.H, Missing OS_MAX_RINGS: Max. number of byte rings in your application"
+    #else
+        #if     OS_MAX_RINGS > 65500u
+        #error  "OS_CFG.H, OS_MAX_RINGS must be <= 65500"
+        #endif
+    #endif
+
+    #if     (OS_RING_EN > 0) && (OS_MAX_RINGS > 0) && (OS_MAX_EVENTS == 0)
+    #error  "OS_CFG.H, OS_MAX_EVENTS must be > 0 when enabling BYTE RINGS, a byte ring takes an event control block"
+    #endif
+#endif
+
 /*
 *********************************************************************************************************
 *                                              SEMAPHORES
@@ -1631,6 +2630,74 @@ void          OSCtxSw                 (void);
     #endif
 #endif
 
+/*
+*********************************************************************************************************
+*                                              EVENT SETS
+*********************************************************************************************************
+*/
+
+#ifndef OS_SET_EN
+#error  "OS_CFG.H, Missing OS_SET_EN: Enable (1) or Disable (0) code generation for EVENT SETS"
+#else
+    #ifndef OS_MAX_SETS
+    #error  "OS_CFG.H, Missing OS_MAX_SETS: Max. number of event sets in your application"
+    #else
+        #if     OS_MAX_SETS > 65500u
+        #error  "OS_CFG.H, OS_MAX_SETS must be <= 65500"
+        #endif
+    #endif
+
+    #ifndef OS_SET_SIZE
+    #error  "OS_CFG.H, Missing OS_SET_SIZE: Max. number of events in one event set"
+    #else
+        #if     (OS_SET_SIZE < 1) || (OS_SET_SIZE > 64)
+        #error  "OS_CFG.H, OS_SET_SIZE must be >= 1 and <= 64"
+        #endif
+    #endif
+
+    #if     (OS_SET_EN > 0) && (OS_MAX_SETS > 0) && (OS_MAX_EVENTS == 0)
+    #error  "OS_CFG.H, OS_MAX_EVENTS must be > 0 when enabling EVENT SETS, an event set takes an event control block"
+    #endif
+#endif
+
+/*
+*********************************************************************************************************
+*                                         PUBLISH/SUBSCRIBE TOPICS
+*********************************************************************************************************
+*/
+
+#ifndef OS_TOPIC_EN
+#error  "OS_CFG.H, Missing OS_TOPIC_EN: Enable (1) or Disable (0) code generation for TOPICS"
+#else
+    #ifndef OS_MAX_TOPICS
+    #error  "OS_CFG.H, Missing OS_MAX_TOPICS: Max. number of topics in your application"
+    #else
+        #if     OS_MAX_TOPICS > 65500u
+        #error  "OS_CFG.H, OS_MAX_TOPICS must be <= 65500"
+        #endif
+    #endif
+
+    #ifndef OS_TOPIC_SUBS
+    #error  "OS_CFG.H, Missing OS_TOPIC_SUBS: Max. number of queues subscribed to one topic"
+    #else
+        #if     (OS_TOPIC_SUBS < 1) || (OS_TOPIC_SUBS > 255)
+        #error  "OS_CFG.H, OS_TOPIC_SUBS must be >= 1 and <= 255"
+        #endif
+    #endif
+
+    #ifndef OS_TOPIC_REF_EN
+    #error  "OS_CFG.H, Missing OS_TOPIC_REF_EN: Include code for reference counted messages"
+    #endif
+
+    #if     (OS_TOPIC_EN > 0) && (OS_MAX_TOPICS > 0) && ((OS_Q_EN == 0) || (OS_MAX_QS == 0))
+    #error  "OS_CFG.H, OS_Q_EN must be enabled and OS_MAX_QS > 0 when enabling TOPICS, the subscribers are queues"
+    #endif
+
+    #if     (OS_TOPIC_EN > 0) && (OS_MAX_TOPICS > 0) && (OS_TOPIC_REF_EN > 0) && ((OS_MEM_EN == 0) || (OS_MAX_MEM_PART == 0))
+    #error  "OS_CFG.H, OS_MEM_EN must be enabled and OS_MAX_MEM_PART > 0 when enabling OS_TOPIC_REF_EN"
+    #endif
+#endif
+
 /*
 *********************************************************************************************************
 *                                             TASK MANAGEMENT
@@ -1670,6 +2737,24 @@ void          OSCtxSw                 (void);
 #error  "OS_CFG.H, Missing OS_TASK_STAT_STK_CHK_EN: Check task stacks from statistics task"
 #endif
 
+#if (OS_TASK_STAT_STK_CHK_EN > 0) && (OS_TASK_CREATE_EXT_EN > 0)
+#ifndef OS_TASK_STAT_STK_CHK_NBR
+#error  "OS_CFG.H, Missing OS_TASK_STAT_STK_CHK_NBR: Max. # of task stacks scanned per statistic period"
+#else
+    #if     OS_TASK_STAT_STK_CHK_NBR < 1
+    #error  "OS_CFG.H,         OS_TASK_STAT_STK_CHK_NBR must be >= 1"
+    #endif
+#endif
+#endif
+
+#ifndef OS_TASK_STK_CANARY_EN
+#error  "OS_CFG.H, Missing OS_TASK_STK_CANARY_EN: Guard words at the end of the task stacks"
+#else
+    #if     (OS_TASK_STK_CANARY_EN > 0) && ((OS_TASK_STAT_STK_CHK_EN == 0) || (OS_TASK_CREATE_EXT_EN == 0))
+    #error  "OS_CFG.H,         OS_TASK_STK_CANARY_EN needs OS_TASK_STAT_STK_CHK_EN and OS_TASK_CREATE_EXT_EN"
+    #endif
+#endif
+
 #ifndef OS_TASK_CHANGE_PRIO_EN
 #error  "OS_CFG.H, Missing OS_TASK_CHANGE_PRIO_EN: Include code for OSTaskChangePrio()"
 #endif
@@ -1720,6 +2805,14 @@ void          OSCtxSw                 (void);
 #error  "OS_CFG.H, Missing OS_TIME_GET_SET_EN: Include code for OSTimeGet() and OSTimeSet()"
 #endif
 
+#ifndef OS_TICKLESS_EN
+#error  "OS_CFG.H, Missing OS_TICKLESS_EN: Stop the periodic tick while the idle task runs"
+#endif
+
+#ifndef OS_TIME_NS_EN
+#error  "OS_CFG.H, Missing OS_TIME_NS_EN: Include the pends and delays with nanosecond timeouts"
+#endif
+
 /*
 *********************************************************************************************************
 *                                             TIMER MANAGEMENT
@@ -1803,6 +2896,26 @@ void          OSCtxSw                 (void);
 #endif
 
 
+#ifndef OS_SCHED_CTZ_EN
+#error  "OS_CFG.H, Missing OS_SCHED_CTZ_EN: Keep the ready and wait lists in 64-bit words searched with OS_CPU_CTZ()"
+#endif
+
+
+#ifndef OS_SCHED_RR_EN
+#error  "OS_CFG.H, Missing OS_SCHED_RR_EN: Allow several tasks per priority, scheduled round-robin"
+#else
+    #if     OS_SCHED_RR_EN > 0
+        #ifndef OS_SCHED_RR_QUANTUM
+        #error  "OS_CFG.H, Missing OS_SCHED_RR_QUANTUM: Default time quantum of a task (# of ticks)"
+        #else
+            #if     OS_SCHED_RR_QUANTUM == 0
+            #error  "OS_CFG.H, OS_SCHED_RR_QUANTUM must be > 0"
+            #endif
+        #endif
+    #endif
+#endif
+
+
 #ifndef OS_MAX_EVENTS
 #error  "OS_CFG.H, Missing OS_MAX_EVENTS: Max. number of event control blocks in your application"
 #else
@@ -1812,6 +2925,21 @@ void          OSCtxSw                 (void);
 #endif
 
 
+#ifndef OS_SLAB_EN
+#error  "OS_CFG.H, Missing OS_SLAB_EN: Grow the object tables beyond OS_MAX_xxx from slab pages"
+#else
+    #if     OS_SLAB_EN > 0
+        #ifndef OS_SLAB_PAGE_SIZE
+        #error  "OS_CFG.H, Missing OS_SLAB_PAGE_SIZE: Size of a slab page (bytes)"
+        #else
+            #if     (OS_SLAB_PAGE_SIZE < 256) || (OS_SLAB_PAGE_SIZE > 65535u)
+            #error  "OS_CFG.H, OS_SLAB_PAGE_SIZE must be >= 256 and <= 65535"
+            #endif
+        #endif
+    #endif
+#endif
+
+
 #ifndef OS_SCHED_LOCK_EN
 #error  "OS_CFG.H, Missing OS_SCHED_LOCK_EN: Include code for OSSchedLock() and OSSchedUnlock()"
 #endif
@@ -1822,10 +2950,44 @@ void          OSCtxSw                 (void);
 #endif
 
 
+#ifndef OS_EVENT_PROF_EN
+#error  "OS_CFG.H, Missing OS_EVENT_PROF_EN: Include the pend and post statistics of the kernel objects"
+#else
+    #if OS_EVENT_PROF_EN > 0
+        #ifndef OS_EVENT_PROF_BINS
+        #error  "OS_CFG.H, Missing OS_EVENT_PROF_BINS: Number of log2 buckets of the blocked time histograms"
+        #else
+            #if     (OS_EVENT_PROF_BINS < 1) || (OS_EVENT_PROF_BINS > 64)
+            #error  "OS_CFG.H,         OS_EVENT_PROF_BINS must be between 1 and 64"
+            #endif
+        #endif
+    #endif
+#endif
+
+
 #ifndef OS_TASK_PROFILE_EN
 #error  "OS_CFG.H, Missing OS_TASK_PROFILE_EN: Include data structure for run-time task profiling"
 #endif
 
+#if OS_TASK_PROFILE_EN > 0
+#ifndef OS_TASK_PROFILE_WIN
+#error  "OS_CFG.H, Missing OS_TASK_PROFILE_WIN: Profiling window in statistic task periods"
+#else
+    #if     OS_TASK_PROFILE_WIN < 1
+    #error  "OS_CFG.H,         OS_TASK_PROFILE_WIN must be >= 1"
+    #endif
+#endif
+#endif
+
+
+#ifndef OS_STAT_EN
+#error  "OS_CFG.H, Missing OS_STAT_EN: Load statistics from the task profiles"
+#else
+    #if     (OS_STAT_EN > 0) && ((OS_TASK_STAT_EN == 0) || (OS_TASK_PROFILE_EN == 0))
+    #error  "OS_CFG.H,         OS_STAT_EN needs OS_TASK_STAT_EN and OS_TASK_PROFILE_EN"
+    #endif
+#endif
+
 
 #ifndef OS_TASK_SW_HOOK_EN
 #error  "OS_CFG.H, Missing OS_TASK_SW_HOOK_EN: Allows you to include the code for OSTaskSwHook() or not"
@@ -1873,6 +3035,10 @@ void          OSCtxSw                 (void);
 #error "OS_CFG.H, VSC_VALIDATION_MODE must be disabled for safety-critical release code"
 #endif
 
+#if    OS_SLAB_EN > 0
+#error "OS_CFG.H, OS_SLAB_EN must be disabled for safety-critical release code"
+#endif
+
 #if    OS_TASK_STAT_EN > 0
 #error "OS_CFG.H, OS_TASK_STAT_EN must be disabled for safety-critical release code"
 #endif